@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <folly/container/F14Map.h>
+#include <folly/futures/SharedPromise.h>
+#include <folly/hash/Hash.h>
+#include <folly/lang/Align.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/caching/SimpleLRUCache.h"
+
+namespace facebook::velox {
+
+/// Same as CachedFactory but divides the keys into shards with a cache and a
+/// lock each, so that threads asking for different keys do not contend.
+/// Concurrent requests for a key that is not cached share one call of the
+/// Generator: the first request runs it and the others wait for its result.
+///
+/// Unlike CachedFactory, does not record a process::TraceContext per call,
+/// since that takes a process-wide lock.
+///
+/// Generator should take a single Key argument and return a Value. The Value
+/// should be either a value type or should manage its own lifecycle
+/// (shared_ptr). The Generator is called concurrently for different keys, so
+/// it must be thread-safe.
+template <typename Key, typename Value, typename Generator>
+class ShardedCachedFactory {
+ public:
+  static constexpr int32_t kDefaultNumShards = 32;
+
+  /// Caches up to 'maxSize' values, divided evenly between 'numShards'
+  /// shards. 0 means no limit. If 'maxSize' is less than 'numShards', there is
+  /// one shard per value.
+  ShardedCachedFactory(
+      size_t maxSize,
+      std::unique_ptr<Generator> generator,
+      int32_t numShards = kDefaultNumShards);
+
+  /// Returns the generator's output on the given key. If the output is in the
+  /// cache, returns immediately. Otherwise, blocks until the output is ready.
+  /// The boolean in the pair is false if this call ran the generator and true
+  /// if the value came from the cache or from a concurrent call.
+  std::pair<bool, Value> generate(const Key& key);
+
+  /// Total number of elements cached (NOT the maximum size/limit).
+  int64_t currentSize() const;
+
+  /// The maximum size of the underlying caches.
+  int64_t maxSize() const {
+    return maxSize_;
+  }
+
+  int32_t numShards() const {
+    return shards_.size();
+  }
+
+  SimpleLRUCacheStats cacheStats();
+
+  /// Clear the cache and return the current cache status.
+  SimpleLRUCacheStats clearCache();
+
+  ShardedCachedFactory(const ShardedCachedFactory&) = delete;
+  ShardedCachedFactory& operator=(const ShardedCachedFactory&) = delete;
+
+ private:
+  using PromisePtr = std::shared_ptr<folly::SharedPromise<Value>>;
+
+  struct alignas(folly::hardware_destructive_interference_size) Shard {
+    explicit Shard(size_t maxSize) : cache(maxSize) {}
+
+    mutable std::mutex mutex;
+    SimpleLRUCache<Key, Value> cache;
+    // Keys being generated. The promise is fulfilled when the generation
+    // finishes.
+    folly::F14FastMap<Key, PromisePtr> pending;
+  };
+
+  Shard& shardOf(const Key& key) {
+    return *shards_[folly::hasher<Key>()(key) % shards_.size()];
+  }
+
+  // Returns the value of 'key' from the cache or sets 'future' to the result of
+  // a pending generation of 'key'. Otherwise, registers a generation of 'key'
+  // and returns its promise in 'promise'.
+  std::optional<Value> lookup(
+      Shard& shard,
+      const Key& key,
+      folly::SemiFuture<Value>& future,
+      PromisePtr& promise);
+
+  // Runs the generator for 'key', caches the value and fulfills 'promise'.
+  // Throws the generator's exception after setting it in 'promise'.
+  Value generateAndCache(Shard& shard, const Key& key, PromisePtr promise);
+
+  const std::unique_ptr<Generator> generator_;
+  const size_t maxSize_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+//
+// End of public API. Implementation follows.
+//
+
+template <typename Key, typename Value, typename Generator>
+ShardedCachedFactory<Key, Value, Generator>::ShardedCachedFactory(
+    size_t maxSize,
+    std::unique_ptr<Generator> generator,
+    int32_t numShards)
+    : generator_(std::move(generator)), maxSize_(maxSize) {
+  VELOX_CHECK_GT(numShards, 0);
+  // A shard with a max size of 0 is unlimited, so there are no more shards
+  // than values to cache.
+  const size_t numCacheShards =
+      maxSize > 0 ? std::min<size_t>(numShards, maxSize) : numShards;
+  shards_.reserve(numCacheShards);
+  // The first shards get one more value each if 'maxSize' is not a multiple
+  // of the number of shards.
+  const size_t sizePerShard = maxSize / numCacheShards;
+  const size_t numLargerShards = maxSize % numCacheShards;
+  for (size_t i = 0; i < numCacheShards; ++i) {
+    shards_.push_back(std::make_unique<Shard>(
+        sizePerShard + (i < numLargerShards ? 1 : 0)));
+  }
+}
+
+template <typename Key, typename Value, typename Generator>
+std::optional<Value> ShardedCachedFactory<Key, Value, Generator>::lookup(
+    Shard& shard,
+    const Key& key,
+    folly::SemiFuture<Value>& future,
+    PromisePtr& promise) {
+  std::lock_guard<std::mutex> l(shard.mutex);
+  auto value = shard.cache.get(key);
+  if (value) {
+    return value;
+  }
+  auto it = shard.pending.find(key);
+  if (it != shard.pending.end()) {
+    future = it->second->getSemiFuture();
+    return std::nullopt;
+  }
+  promise = std::make_shared<folly::SharedPromise<Value>>();
+  shard.pending.emplace(key, promise);
+  return std::nullopt;
+}
+
+template <typename Key, typename Value, typename Generator>
+Value ShardedCachedFactory<Key, Value, Generator>::generateAndCache(
+    Shard& shard,
+    const Key& key,
+    PromisePtr promise) {
+  Value value;
+  try {
+    value = (*generator_)(key);
+  } catch (...) {
+    {
+      std::lock_guard<std::mutex> l(shard.mutex);
+      shard.pending.erase(key);
+    }
+    promise->setException(folly::exception_wrapper(std::current_exception()));
+    throw;
+  }
+  {
+    std::lock_guard<std::mutex> l(shard.mutex);
+    shard.cache.add(key, value);
+    shard.pending.erase(key);
+  }
+  promise->setValue(value);
+  return value;
+}
+
+template <typename Key, typename Value, typename Generator>
+std::pair<bool, Value> ShardedCachedFactory<Key, Value, Generator>::generate(
+    const Key& key) {
+  auto& shard = shardOf(key);
+  auto future = folly::SemiFuture<Value>::makeEmpty();
+  PromisePtr promise;
+  if (auto value = lookup(shard, key, future, promise)) {
+    return std::make_pair(true, std::move(value.value()));
+  }
+  if (promise != nullptr) {
+    return std::make_pair(false, generateAndCache(shard, key, promise));
+  }
+  return std::make_pair(true, std::move(future).get());
+}
+
+template <typename Key, typename Value, typename Generator>
+int64_t ShardedCachedFactory<Key, Value, Generator>::currentSize() const {
+  int64_t size = 0;
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> l(shard->mutex);
+    size += shard->cache.currentSize();
+  }
+  return size;
+}
+
+template <typename Key, typename Value, typename Generator>
+SimpleLRUCacheStats ShardedCachedFactory<Key, Value, Generator>::cacheStats() {
+  size_t size = 0;
+  size_t numHits = 0;
+  size_t numLookups = 0;
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> l(shard->mutex);
+    const auto stats = shard->cache.getStats();
+    size += stats.curSize;
+    numHits += stats.numHits;
+    numLookups += stats.numLookups;
+  }
+  return {static_cast<size_t>(maxSize()), size, numHits, numLookups};
+}
+
+template <typename Key, typename Value, typename Generator>
+SimpleLRUCacheStats ShardedCachedFactory<Key, Value, Generator>::clearCache() {
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> l(shard->mutex);
+    shard->cache.clear();
+  }
+  return cacheStats();
+}
+
+} // namespace facebook::velox
@@ -16,38 +16,71 @@
 
 #include "velox/common/caching/StringIdMap.h"
 
+#include <mutex>
+#include <shared_mutex>
+
 namespace facebook::velox {
 
 uint64_t StringIdMap::id(std::string_view string) {
-  std::lock_guard<std::mutex> l(mutex_);
-  auto it = stringToId_.find(string);
-  if (it != stringToId_.end()) {
+  auto& shard = shards_[shardIndex(string)];
+  std::shared_lock<folly::SharedMutex> l(shard.mutex);
+  auto it = shard.stringToId.find(string);
+  if (it != shard.stringToId.end()) {
     return it->second;
   }
   return kNoId;
 }
 
+std::string StringIdMap::string(uint64_t id) {
+  auto& shard = shardOf(id);
+  std::shared_lock<folly::SharedMutex> l(shard.mutex);
+  auto it = shard.idToString.find(id);
+  return it == shard.idToString.end() ? "" : it->second.string;
+}
+
 void StringIdMap::release(uint64_t id) {
-  std::lock_guard<std::mutex> l(mutex_);
-  auto it = idToString_.find(id);
-  if (it != idToString_.end()) {
+  auto& shard = shardOf(id);
+  {
+    // Drops a reference that is not the last one without an exclusive lock.
+    std::shared_lock<folly::SharedMutex> l(shard.mutex);
+    auto it = shard.idToString.find(id);
+    if (it == shard.idToString.end()) {
+      return;
+    }
+    auto& numInUse = it->second.numInUse;
+    auto count = numInUse.load();
+    for (;;) {
+      VELOX_CHECK_LT(0, count, "Extra release of id in StringIdMap");
+      if (count == 1) {
+        break;
+      }
+      if (numInUse.compare_exchange_weak(count, count - 1)) {
+        return;
+      }
+    }
+  }
+
+  std::unique_lock<folly::SharedMutex> l(shard.mutex);
+  auto it = shard.idToString.find(id);
+  if (it != shard.idToString.end()) {
     VELOX_CHECK_LT(
         0, it->second.numInUse, "Extra release of id in StringIdMap");
     if (--it->second.numInUse == 0) {
       pinnedSize_ -= it->second.string.size();
-      auto strIter = stringToId_.find(it->second.string);
-      assert(strIter != stringToId_.end());
-      stringToId_.erase(strIter);
-      idToString_.erase(it);
+      auto strIter = shard.stringToId.find(it->second.string);
+      assert(strIter != shard.stringToId.end());
+      shard.stringToId.erase(strIter);
+      shard.idToString.erase(it);
     }
   }
 }
 
 void StringIdMap::addReference(uint64_t id) {
-  std::lock_guard<std::mutex> l(mutex_);
-  auto it = idToString_.find(id);
+  auto& shard = shardOf(id);
+  std::shared_lock<folly::SharedMutex> l(shard.mutex);
+  auto it = shard.idToString.find(id);
   VELOX_CHECK(
-      it != idToString_.end(),
+      it != shard.idToString.end(),
       "Trying to add a reference to id {} that is not in StringIdMap",
       id);
 
@@ -55,33 +88,46 @@ void StringIdMap::addReference(uint64_t id) {
 }
 
 uint64_t StringIdMap::makeId(std::string_view string) {
-  std::lock_guard<std::mutex> l(mutex_);
-  auto it = stringToId_.find(string);
-  if (it != stringToId_.end()) {
-    auto entry = idToString_.find(it->second);
-    VELOX_CHECK(entry != idToString_.end());
-    if (++entry->second.numInUse == 1) {
-      pinnedSize_ += entry->second.string.size();
+  const auto index = shardIndex(string);
+  auto& shard = shards_[index];
+  {
+    // A mapping in the shard is referenced, so adding a reference under a
+    // shared lock cannot race with dropping it.
+    std::shared_lock<folly::SharedMutex> l(shard.mutex);
+    auto it = shard.stringToId.find(string);
+    if (it != shard.stringToId.end()) {
+      auto entry = shard.idToString.find(it->second);
+      VELOX_CHECK(entry != shard.idToString.end());
+      ++entry->second.numInUse;
+      return it->second;
     }
+  }
 
+  std::unique_lock<folly::SharedMutex> l(shard.mutex);
+  // Another thread may have added 'string' between the locks.
+  auto it = shard.stringToId.find(string);
+  if (it != shard.stringToId.end()) {
+    auto entry = shard.idToString.find(it->second);
+    VELOX_CHECK(entry != shard.idToString.end());
+    ++entry->second.numInUse;
     return it->second;
   }
-  Entry entry;
-  entry.string = std::string(string);
   // Check that we do not use an id twice. In practice this never
   // happens because the int64 counter would have to wrap around for
   // this. Even if this happened, the time spent in the loop would
   // have a low cap since the number of mappings would in practice
   // be in the 100K range.
+  uint64_t id;
   do {
-    entry.id = ++lastId_;
-  } while (idToString_.find(entry.id) != idToString_.end());
+    id = (++shard.lastId << kShardBits) | index;
+  } while (id == kNoId ||
+           shard.idToString.find(id) != shard.idToString.end());
+  auto& entry = shard.idToString[id];
+  entry.string = std::string(string);
   entry.numInUse = 1;
   pinnedSize_ += entry.string.size();
-  auto id = entry.id;
-  auto& entryInTable = idToString_[id] = std::move(entry);
-  stringToId_[entryInTable.string] = entry.id;
-  return lastId_;
+  shard.stringToId[entry.string] = id;
+  return id;
 }
 
 } // namespace facebook::velox
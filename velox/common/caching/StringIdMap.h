@@ -16,14 +16,27 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <string_view>
 
+#include <folly/SharedMutex.h>
 #include <folly/container/F14Map.h>
+#include <folly/lang/Align.h>
 
 #include "velox/common/base/Exceptions.h"
 
 namespace facebook::velox {
 
+// Maps strings, e.g. file paths, to ids that are used in their place as
+// keys of caches. The mappings are reference counted and are dropped when no
+// longer referenced.
+//
+// The mappings are divided into shards by the hash of the string, so that
+// threads working on different strings do not contend. An id encodes its
+// shard. Lookups and changes of the reference count of a mapping that stays
+// referenced take a shared lock on the shard. Only adding and dropping a
+// mapping take an exclusive lock on the shard.
 class StringIdMap {
  public:
   static constexpr uint64_t kNoId = ~0UL;
@@ -57,24 +70,39 @@ class StringIdMap {
 
   // Returns a copy of the string associated with id or empty string if id has
   // no string.
-  std::string string(uint64_t id) {
-    std::lock_guard<std::mutex> l(mutex_);
-    auto it = idToString_.find(id);
-    return it == idToString_.end() ? "" : it->second.string;
-  }
+  std::string string(uint64_t id);
 
  private:
+  static constexpr int32_t kShardBits = 5;
+  static constexpr int32_t kNumShards = 1 << kShardBits;
+
   struct Entry {
     std::string string;
-    uint64_t id;
-    uint32_t numInUse{};
+    // Atomic so that a reference can be added or dropped under a shared lock.
+    std::atomic<uint32_t> numInUse{0};
+  };
+
+  struct alignas(folly::hardware_destructive_interference_size) Shard {
+    folly::SharedMutex mutex;
+    folly::F14FastMap<std::string, uint64_t> stringToId;
+    // Node map, so that entries do not move.
+    folly::F14NodeMap<uint64_t, Entry> idToString;
+    uint64_t lastId{0};
   };
 
-  std::mutex mutex_;
-  folly::F14FastMap<std::string, uint64_t> stringToId_;
-  folly::F14FastMap<uint64_t, Entry> idToString_;
-  uint64_t lastId_{};
-  uint64_t pinnedSize_{};
+  static int32_t shardIndex(std::string_view string) {
+    // The top bits, so that the shard is independent of the bucket of the
+    // string in the shard.
+    return static_cast<int32_t>(
+        std::hash<std::string_view>()(string) >> (64 - kShardBits));
+  }
+
+  Shard& shardOf(uint64_t id) {
+    return shards_[id & (kNumShards - 1)];
+  }
+
+  std::array<Shard, kNumShards> shards_;
+  std::atomic<int64_t> pinnedSize_{0};
 };
 
 // Keeps a string-id association live for the duration of this.
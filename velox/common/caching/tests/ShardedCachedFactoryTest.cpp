@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/ShardedCachedFactory.h"
+
+#include "folly/executors/CPUThreadPoolExecutor.h"
+#include "folly/synchronization/Baton.h"
+#include "folly/synchronization/Latch.h"
+#include "gtest/gtest.h"
+
+using namespace facebook::velox;
+
+namespace {
+
+struct DoublerGenerator {
+  int operator()(const int& value) {
+    if (value < 0) {
+      throw std::invalid_argument("negative");
+    }
+    ++generated_;
+    return value * 2;
+  }
+  std::atomic<int> generated_ = 0;
+};
+
+// Blocks in the generation of the first value until 'release' is posted.
+struct BlockingGenerator {
+  int operator()(const int& value) {
+    if (generated_++ == 0) {
+      started.post();
+      release.wait();
+    }
+    return value * 2;
+  }
+  std::atomic<int> generated_ = 0;
+  folly::Baton<> started;
+  folly::Baton<> release;
+};
+
+using DoublerFactory = ShardedCachedFactory<int, int, DoublerGenerator>;
+
+} // namespace
+
+TEST(ShardedCachedFactoryTest, basicGeneration) {
+  auto generator = std::make_unique<DoublerGenerator>();
+  auto* generated = &generator->generated_;
+  DoublerFactory factory(1000, std::move(generator), 8);
+  EXPECT_EQ(8, factory.numShards());
+  EXPECT_EQ(1000, factory.maxSize());
+
+  EXPECT_EQ(std::make_pair(false, 2), factory.generate(1));
+  EXPECT_EQ(std::make_pair(true, 2), factory.generate(1));
+  EXPECT_EQ(std::make_pair(false, 4), factory.generate(2));
+  EXPECT_EQ(2, *generated);
+  EXPECT_EQ(2, factory.currentSize());
+
+  auto stats = factory.cacheStats();
+  EXPECT_EQ(2, stats.curSize);
+  EXPECT_EQ(3, stats.numLookups);
+  EXPECT_EQ(1, stats.numHits);
+
+  stats = factory.clearCache();
+  EXPECT_EQ(0, stats.curSize);
+  EXPECT_EQ(std::make_pair(false, 2), factory.generate(1));
+  EXPECT_EQ(3, *generated);
+}
+
+TEST(ShardedCachedFactoryTest, eviction) {
+  // The first 2 shards cache 3 values and the other 2 cache 2.
+  DoublerFactory factory(10, std::make_unique<DoublerGenerator>(), 4);
+  EXPECT_EQ(10, factory.maxSize());
+  EXPECT_EQ(10, factory.cacheStats().maxSize);
+  for (auto i = 0; i < 1'000; ++i) {
+    EXPECT_EQ(2 * i, factory.generate(i).second);
+  }
+  EXPECT_LE(factory.currentSize(), 10);
+}
+
+TEST(ShardedCachedFactoryTest, fewerValuesThanShards) {
+  // There is one shard per value, so that no shard is unlimited.
+  DoublerFactory factory(3, std::make_unique<DoublerGenerator>(), 8);
+  EXPECT_EQ(3, factory.numShards());
+  EXPECT_EQ(3, factory.maxSize());
+  for (auto i = 0; i < 1'000; ++i) {
+    EXPECT_EQ(2 * i, factory.generate(i).second);
+  }
+  EXPECT_LE(factory.currentSize(), 3);
+}
+
+TEST(ShardedCachedFactoryTest, unlimited) {
+  DoublerFactory factory(0, std::make_unique<DoublerGenerator>(), 4);
+  EXPECT_EQ(4, factory.numShards());
+  EXPECT_EQ(0, factory.maxSize());
+  for (auto i = 0; i < 1'000; ++i) {
+    EXPECT_EQ(2 * i, factory.generate(i).second);
+  }
+  EXPECT_EQ(1'000, factory.currentSize());
+}
+
+TEST(ShardedCachedFactoryTest, exceptions) {
+  auto generator = std::make_unique<DoublerGenerator>();
+  auto* generated = &generator->generated_;
+  DoublerFactory factory(1000, std::move(generator));
+  EXPECT_THROW(factory.generate(-1), std::invalid_argument);
+  EXPECT_EQ(0, factory.currentSize());
+  EXPECT_EQ(std::make_pair(false, 8), factory.generate(4));
+  EXPECT_EQ(1, *generated);
+}
+
+TEST(ShardedCachedFactoryTest, waitForPending) {
+  auto generator = std::make_unique<BlockingGenerator>();
+  auto* blocking = generator.get();
+  ShardedCachedFactory<int, int, BlockingGenerator> factory(
+      1000, std::move(generator));
+
+  std::thread first([&]() {
+    EXPECT_EQ(std::make_pair(false, 6), factory.generate(3));
+  });
+  blocking->started.wait();
+  // A second request for the same key does not run the generator again.
+  std::thread second([&]() {
+    EXPECT_EQ(std::make_pair(true, 6), factory.generate(3));
+  });
+  // Other keys are not blocked.
+  EXPECT_EQ(std::make_pair(false, 8), factory.generate(4));
+  blocking->release.post();
+  first.join();
+  second.join();
+  EXPECT_EQ(2, blocking->generated_);
+}
+
+TEST(ShardedCachedFactoryTest, multiThreadedGeneration) {
+  auto generator = std::make_unique<DoublerGenerator>();
+  auto* generated = &generator->generated_;
+  DoublerFactory factory(1000, std::move(generator));
+  folly::CPUThreadPoolExecutor pool(32);
+  constexpr int32_t kNumValues = 100;
+  constexpr int32_t kRequestsPerValue = 20;
+  folly::Latch latch(kNumValues * kRequestsPerValue);
+  for (auto i = 0; i < kRequestsPerValue; ++i) {
+    for (auto j = 0; j < kNumValues; ++j) {
+      pool.add([&, j]() {
+        EXPECT_EQ(2 * j, factory.generate(j).second);
+        latch.count_down();
+      });
+    }
+  }
+  latch.wait();
+  EXPECT_EQ(kNumValues, *generated);
+  EXPECT_EQ(kNumValues, factory.currentSize());
+}
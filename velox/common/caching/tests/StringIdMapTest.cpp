@@ -18,6 +18,8 @@
 
 #include "gtest/gtest.h"
 
+#include <thread>
+
 using namespace facebook::velox;
 
 TEST(StringIdMapTest, basic) {
@@ -53,3 +55,49 @@ TEST(StringIdMapTest, rehash) {
     EXPECT_EQ(ids[i].id(), StringIdLease(map, name).id());
   }
 }
+
+TEST(StringIdMapTest, concurrent) {
+  constexpr int32_t kNumThreads = 16;
+  constexpr int32_t kNumStrings = 100;
+  StringIdMap map;
+  // A lease held for the duration of the test keeps the ids of the first half
+  // of the strings stable. The other half is dropped and added again.
+  std::vector<StringIdLease> pinned;
+  for (auto i = 0; i < kNumStrings / 2; ++i) {
+    pinned.emplace_back(map, fmt::format("filename_{}", i));
+  }
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      for (auto j = 0; j < 1'000; ++j) {
+        const auto index = (i * 7 + j) % kNumStrings;
+        const auto name = fmt::format("filename_{}", index);
+        StringIdLease lease(map, name);
+        EXPECT_EQ(name, map.string(lease.id()));
+        EXPECT_EQ(lease.id(), map.id(name));
+        if (index < kNumStrings / 2) {
+          EXPECT_EQ(pinned[index].id(), lease.id());
+        }
+        StringIdLease copy(map, lease.id());
+        EXPECT_EQ(lease.id(), copy.id());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  int64_t pinnedSize = 0;
+  for (auto i = 0; i < kNumStrings; ++i) {
+    const auto name = fmt::format("filename_{}", i);
+    if (i < kNumStrings / 2) {
+      EXPECT_EQ(pinned[i].id(), map.id(name));
+      pinnedSize += name.size();
+    } else {
+      EXPECT_EQ(StringIdMap::kNoId, map.id(name));
+    }
+  }
+  EXPECT_EQ(pinnedSize, map.pinnedSize());
+  pinned.clear();
+  EXPECT_EQ(0, map.pinnedSize());
+}
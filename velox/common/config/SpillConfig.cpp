@@ -30,6 +30,7 @@ SpillConfig::SpillConfig(
     uint8_t _aggregationPartitionBits,
     bool _aggregationSpillAll,
     int32_t _maxSpillLevel,
+    int32_t _joinSpillSkewedKeyPct,
     int32_t _testSpillPct,
     const std::string& _compressionKind)
     : filePath(_filePath),
@@ -46,6 +47,7 @@ SpillConfig::SpillConfig(
       aggregationPartitionBits(_aggregationPartitionBits),
       aggregationSpillAll(_aggregationSpillAll),
       maxSpillLevel(_maxSpillLevel),
+      joinSpillSkewedKeyPct(_joinSpillSkewedKeyPct),
       testSpillPct(_testSpillPct),
       compressionKind(common::stringToCompressionKind(_compressionKind)) {
   VELOX_USER_CHECK_GE(
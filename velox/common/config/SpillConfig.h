@@ -36,6 +36,7 @@ struct SpillConfig {
       uint8_t _aggregationPartitionBits,
       bool _aggregationSpillAll,
       int32_t _maxSpillLevel,
+      int32_t _joinSpillSkewedKeyPct,
       int32_t _testSpillPct,
       const std::string& _compressionKind);
 
@@ -104,6 +105,12 @@ struct SpillConfig {
   /// partition bits at the end.
   int32_t maxSpillLevel;
 
+  /// The min percentage of the rows of a hash join spill partition with the
+  /// same join key hash for the partition to be skewed. A skewed partition
+  /// which doesn't fit in memory is built in chunks instead of being spilled
+  /// recursively. Zero disables the skew detection.
+  int32_t joinSpillSkewedKeyPct;
+
   /// Percentage of input batches to be spilled for testing. 0 means no
   /// spilling for test.
   int32_t testSpillPct;
@@ -15,9 +15,11 @@
  */
 #include "velox/common/hyperloglog/DenseHll.h"
 
+#include <array>
 #include <exception>
 #include <sstream>
 #include "velox/common/base/IOUtils.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/common/hyperloglog/BiasCorrection.h"
 #include "velox/common/hyperloglog/HllUtils.h"
 
@@ -143,6 +145,12 @@ void DenseHll::insertHash(uint64_t hash) {
   insert(index, value);
 }
 
+void DenseHll::insertHashes(const uint64_t* hashes, int32_t numHashes) {
+  for (auto i = 0; i < numHashes; ++i) {
+    insertHash(hashes[i]);
+  }
+}
+
 void DenseHll::insert(int32_t index, int8_t value) {
   auto delta = value - baseline_;
   auto oldDelta = getDelta(index);
@@ -205,12 +213,15 @@ struct DenseHllView {
 int64_t cardinalityImpl(const DenseHllView& hll) {
   auto numBuckets = 1 << hll.indexBitLength;
 
-  int32_t baselineCount = 0;
-  for (int i = 0; i < numBuckets; i++) {
-    if (hll.getDelta(i) == 0) {
-      baselineCount++;
-    }
+  // Number of buckets with each delta. Counting the deltas a byte at a time
+  // avoids looking up the overflows for each bucket.
+  std::array<int32_t, kMaxDelta + 1> deltaCounts{};
+  const auto* deltas = reinterpret_cast<const uint8_t*>(hll.deltas);
+  for (int i = 0; i < numBuckets / 2; i++) {
+    ++deltaCounts[deltas[i] >> kBitsPerBucket];
+    ++deltaCounts[deltas[i] & kBucketMask];
   }
+  int32_t baselineCount = deltaCounts[0];
 
   // If baseline is zero, then baselineCount is the number of buckets with value
   // 0.
@@ -219,10 +230,19 @@ int64_t cardinalityImpl(const DenseHllView& hll) {
     return std::round(linearCounting(baselineCount, numBuckets));
   }
 
+  // The terms are powers of 2, so the sum does not depend on the order in
+  // which they are added.
   double sum = 0;
-  for (int i = 0; i < numBuckets; i++) {
-    int value = hll.getValue(i);
-    sum += 1.0 / (1L << value);
+  for (int delta = 0; delta <= kMaxDelta; delta++) {
+    sum += deltaCounts[delta] * (1.0 / (1L << (hll.baseline + delta)));
+  }
+  // The buckets with overflows were counted with kMaxDelta.
+  for (int i = 0; i < hll.overflows; i++) {
+    if (hll.getDelta(hll.overflowBuckets[i]) == kMaxDelta) {
+      int value = hll.baseline + kMaxDelta;
+      sum += 1.0 / (1L << (value + hll.overflowValues[i])) -
+          1.0 / (1L << value);
+    }
   }
 
   double estimate = (alpha(hll.indexBitLength) * numBuckets * numBuckets) / sum;
@@ -567,6 +587,11 @@ void DenseHll::mergeWith(
     int16_t otherOverflows,
     const uint16_t* otherOverflowBuckets,
     const int8_t* otherOverflowValues) {
+  if (baseline_ == otherBaseline && overflows_ == 0 && otherOverflows == 0) {
+    mergeDeltas(otherDeltas);
+    return;
+  }
+
   int8_t newBaseline = std::max(baseline_, otherBaseline);
   int32_t baselineCount = 0;
 
@@ -622,6 +647,42 @@ void DenseHll::mergeWith(
   adjustBaselineIfNeeded();
 }
 
+void DenseHll::mergeDeltas(const int8_t* otherDeltas) {
+  // With the same baseline, the larger value has the larger delta. Without
+  // overflows, the larger of two deltas is at most kMaxDelta.
+  using Batch = xsimd::batch<uint8_t>;
+  const auto lowMask = Batch::broadcast(kBucketMask);
+  const auto highMask =
+      Batch::broadcast(static_cast<uint8_t>(kBucketMask << kBitsPerBucket));
+  const auto zero = Batch::broadcast(0);
+  auto* deltas = reinterpret_cast<uint8_t*>(deltas_.data());
+  const auto* other = reinterpret_cast<const uint8_t*>(otherDeltas);
+  const int32_t numBytes = deltas_.size();
+
+  int32_t baselineCount = 0;
+  int32_t i = 0;
+  for (; i + Batch::size <= numBytes; i += Batch::size) {
+    const auto left = Batch::load_unaligned(deltas + i);
+    const auto right = Batch::load_unaligned(other + i);
+    const auto low = xsimd::max(left & lowMask, right & lowMask);
+    const auto high = xsimd::max(left & highMask, right & highMask);
+    (low | high).store_unaligned(deltas + i);
+    baselineCount += __builtin_popcountll(simd::toBitMask(low == zero)) +
+        __builtin_popcountll(simd::toBitMask(high == zero));
+  }
+  for (; i < numBytes; ++i) {
+    const uint8_t low =
+        std::max(deltas[i] & kBucketMask, other[i] & kBucketMask);
+    const uint8_t high =
+        std::max(deltas[i] >> kBitsPerBucket, other[i] >> kBitsPerBucket);
+    deltas[i] = (high << kBitsPerBucket) | low;
+    baselineCount += (low == 0) + (high == 0);
+  }
+
+  baselineCount_ = baselineCount;
+  adjustBaselineIfNeeded();
+}
+
 int8_t
 DenseHll::updateOverflow(int32_t index, int overflowEntry, int8_t delta) {
   if (delta > kMaxDelta) {
@@ -48,6 +48,9 @@ class DenseHll {
 
   void insertHash(uint64_t hash);
 
+  /// Inserts 'numHashes' hashes. Same as calling insertHash() for each.
+  void insertHashes(const uint64_t* hashes, int32_t numHashes);
+
   /// Inserts pre-computed {bucket, value} pair. These value must be compatible
   /// with computeIndex and computeValue methods called with the indexBitLength
   /// value of this HLL. Used by SparseHll.toDense().
@@ -109,6 +112,10 @@ class DenseHll {
 
   void removeOverflow(int overflowEntry);
 
+  /// Merges the deltas of an HLL with the same baseline where neither HLL has
+  /// overflows.
+  void mergeDeltas(const int8_t* otherDeltas);
+
   void mergeWith(
       int8_t otherBaseline,
       const int8_t* otherDeltas,
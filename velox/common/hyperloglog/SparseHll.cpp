@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/common/hyperloglog/SparseHll.h"
+
+#include <algorithm>
+
 #include "velox/common/base/IOUtils.h"
 #include "velox/common/hyperloglog/HllUtils.h"
 
@@ -88,6 +91,33 @@ bool SparseHll::insertHash(uint64_t hash) {
   return overLimit();
 }
 
+bool SparseHll::insertHashes(const uint64_t* hashes, int32_t numHashes) {
+  if (numHashes == 0) {
+    return overLimit();
+  }
+
+  std::vector<uint32_t> newEntries(numHashes);
+  for (auto i = 0; i < numHashes; i++) {
+    newEntries[i] = encode(
+        computeIndex(hashes[i], kIndexBitLength),
+        numberOfLeadingZeros(hashes[i], kIndexBitLength));
+  }
+  // Entries with the same index are sorted by value. Keep the last one.
+  std::sort(newEntries.begin(), newEntries.end());
+  int32_t numNewEntries = 0;
+  for (auto entry : newEntries) {
+    if (numNewEntries > 0 &&
+        decodeIndex(newEntries[numNewEntries - 1]) == decodeIndex(entry)) {
+      newEntries[numNewEntries - 1] = entry;
+    } else {
+      newEntries[numNewEntries++] = entry;
+    }
+  }
+
+  mergeWith(numNewEntries, newEntries.data());
+  return overLimit();
+}
+
 int64_t SparseHll::cardinality() const {
   // Estimate the cardinality using linear counting over the theoretical
   // 2^kIndexBitLength buckets available due to the fact that we're
@@ -239,9 +269,13 @@ void SparseHll::verify() const {
 void SparseHll::toDense(DenseHll& denseHll) const {
   auto indexBitLength = denseHll.indexBitLength();
 
+  // The entries are sorted by index, so the entries of each dense bucket are
+  // adjacent. Only the largest value of each bucket is inserted.
+  int32_t bucket = -1;
+  int8_t maxValue = 0;
   for (auto i = 0; i < entries_.size(); i++) {
     auto entry = entries_[i];
-    auto index = entry >> (32 - indexBitLength);
+    int32_t index = entry >> (32 - indexBitLength);
     auto shiftedValue = entry << indexBitLength;
     auto zeros = shiftedValue == 0 ? 32 : __builtin_clz(shiftedValue);
 
@@ -253,7 +287,17 @@ void SparseHll::toDense(DenseHll& denseHll) const {
       zeros = bits + decodeValue(entry);
     }
 
-    denseHll.insert(index, zeros + 1);
+    if (index != bucket) {
+      if (bucket >= 0) {
+        denseHll.insert(bucket, maxValue);
+      }
+      bucket = index;
+      maxValue = 0;
+    }
+    maxValue = std::max<int8_t>(maxValue, zeros + 1);
+  }
+  if (bucket >= 0) {
+    denseHll.insert(bucket, maxValue);
   }
 }
 
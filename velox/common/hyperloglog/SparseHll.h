@@ -40,6 +40,11 @@ class SparseHll {
   /// Returns true if soft memory limit has been reached. False, otherwise.
   bool insertHash(uint64_t hash);
 
+  /// Inserts 'numHashes' hashes. Sorts them and merges them into the entries
+  /// in one pass instead of inserting one at a time. Returns true if soft
+  /// memory limit has been reached. False, otherwise.
+  bool insertHashes(const uint64_t* hashes, int32_t numHashes);
+
   int64_t cardinality() const;
 
   /// Returns cardinality estimate from the specified serialized digest.
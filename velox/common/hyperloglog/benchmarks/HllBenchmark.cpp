@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <memory>
+#include <vector>
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include "velox/common/hyperloglog/DenseHll.h"
+#include "velox/common/hyperloglog/SparseHll.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::common::hll;
+
+namespace {
+
+constexpr int8_t kIndexBitLength = 11;
+constexpr int32_t kNumHashes = 1'000'000;
+constexpr int32_t kNumGroups = 10'000;
+
+// Mirrors the accumulator of approx_distinct: starts sparse and converts to
+// dense once the sparse entries reach the size of the dense layout.
+class Hll {
+ public:
+  explicit Hll(HashStringAllocator* allocator)
+      : sparseHll_{allocator}, denseHll_{allocator} {
+    sparseHll_.setSoftMemoryLimit(
+        DenseHll::estimateInMemorySize(kIndexBitLength));
+  }
+
+  void insertHash(uint64_t hash) {
+    if (isSparse_) {
+      if (sparseHll_.insertHash(hash)) {
+        toDense();
+      }
+    } else {
+      denseHll_.insertHash(hash);
+    }
+  }
+
+  void insertHashes(const uint64_t* hashes, int32_t numHashes) {
+    if (isSparse_) {
+      if (sparseHll_.insertHashes(hashes, numHashes)) {
+        toDense();
+      }
+    } else {
+      denseHll_.insertHashes(hashes, numHashes);
+    }
+  }
+
+  int64_t cardinality() const {
+    return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
+  }
+
+ private:
+  void toDense() {
+    isSparse_ = false;
+    denseHll_.initialize(kIndexBitLength);
+    sparseHll_.toDense(denseHll_);
+    sparseHll_.reset();
+  }
+
+  bool isSparse_{true};
+  SparseHll sparseHll_;
+  DenseHll denseHll_;
+};
+
+class HllBenchmark {
+ public:
+  HllBenchmark() {
+    hashes_.reserve(kNumHashes);
+    for (int64_t i = 0; i < kNumHashes; ++i) {
+      hashes_.push_back(XXH64(&i, sizeof(i), 0));
+    }
+
+    // Rows of the many-groups case, grouped the way a batch of input rows
+    // with the same group is passed to the accumulator.
+    groupHashes_.resize(kNumGroups);
+    for (auto i = 0; i < kNumHashes; ++i) {
+      groupHashes_[i % kNumGroups].push_back(hashes_[i]);
+    }
+
+    for (auto i = 0; i < 2; ++i) {
+      auto& denseHll = denseHlls_.emplace_back(kIndexBitLength, &allocator_);
+      for (auto j = i; j < kNumHashes; j += 2) {
+        denseHll.insertHash(hashes_[j]);
+      }
+    }
+  }
+
+  int64_t singleGroup(bool batch) {
+    Hll hll{&allocator_};
+    if (batch) {
+      hll.insertHashes(hashes_.data(), hashes_.size());
+    } else {
+      for (auto hash : hashes_) {
+        hll.insertHash(hash);
+      }
+    }
+    return hll.cardinality();
+  }
+
+  int64_t manyGroups(bool batch) {
+    std::vector<std::unique_ptr<Hll>> hlls;
+    hlls.reserve(kNumGroups);
+    for (auto i = 0; i < kNumGroups; ++i) {
+      hlls.push_back(std::make_unique<Hll>(&allocator_));
+    }
+    if (batch) {
+      for (auto i = 0; i < kNumGroups; ++i) {
+        hlls[i]->insertHashes(groupHashes_[i].data(), groupHashes_[i].size());
+      }
+    } else {
+      for (auto i = 0; i < kNumHashes; ++i) {
+        hlls[i % kNumGroups]->insertHash(hashes_[i]);
+      }
+    }
+    int64_t sum = 0;
+    for (const auto& hll : hlls) {
+      sum += hll->cardinality();
+    }
+    return sum;
+  }
+
+  int64_t denseMerge() {
+    DenseHll hll{kIndexBitLength, &allocator_};
+    hll.mergeWith(denseHlls_[0]);
+    hll.mergeWith(denseHlls_[1]);
+    return hll.cardinality();
+  }
+
+ private:
+  std::shared_ptr<memory::MemoryPool> pool_{memory::addDefaultLeafMemoryPool()};
+  HashStringAllocator allocator_{pool_.get()};
+  std::vector<uint64_t> hashes_;
+  std::vector<std::vector<uint64_t>> groupHashes_;
+  std::vector<DenseHll> denseHlls_;
+};
+
+std::unique_ptr<HllBenchmark> benchmark;
+
+BENCHMARK(singleGroup) {
+  folly::doNotOptimizeAway(benchmark->singleGroup(false));
+}
+
+BENCHMARK_RELATIVE(singleGroupBatch) {
+  folly::doNotOptimizeAway(benchmark->singleGroup(true));
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(manyGroups) {
+  folly::doNotOptimizeAway(benchmark->manyGroups(false));
+}
+
+BENCHMARK_RELATIVE(manyGroupsBatch) {
+  folly::doNotOptimizeAway(benchmark->manyGroups(true));
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(denseMergeAndCardinality) {
+  folly::doNotOptimizeAway(benchmark->denseMerge());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  benchmark = std::make_unique<HllBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
@@ -153,6 +153,22 @@ TEST_P(DenseHllTest, highCardinality) {
   ASSERT_EQ(denseHll.cardinality(), DenseHll::cardinality(serialized.data()));
 }
 
+TEST_P(DenseHllTest, insertHashes) {
+  int8_t indexBitLength = GetParam();
+
+  DenseHll expected{indexBitLength, &allocator_};
+  DenseHll denseHll{indexBitLength, &allocator_};
+  std::vector<uint64_t> hashes;
+  for (int i = 0; i < 100'000; i++) {
+    hashes.push_back(hashOne(i));
+    expected.insertHash(hashes.back());
+  }
+  denseHll.insertHashes(hashes.data(), hashes.size());
+
+  ASSERT_EQ(serialize(expected), serialize(denseHll));
+  ASSERT_EQ(expected.cardinality(), denseHll.cardinality());
+}
+
 namespace {
 template <typename T>
 std::vector<T> sequence(T start, T end) {
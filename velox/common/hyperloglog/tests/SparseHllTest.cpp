@@ -151,6 +151,25 @@ std::vector<T> sequence(T start, T end) {
 }
 } // namespace
 
+TEST_F(SparseHllTest, insertHashes) {
+  SparseHll expected{&allocator_};
+  SparseHll sparseHll{&allocator_};
+  // Batches with duplicates within and across the batches.
+  for (auto batch = 0; batch < 10; batch++) {
+    std::vector<uint64_t> hashes;
+    for (auto i = 0; i < 100; i++) {
+      hashes.push_back(hashOne((batch * 100 + i) % 317));
+      expected.insertHash(hashes.back());
+    }
+    sparseHll.insertHashes(hashes.data(), hashes.size());
+    sparseHll.verify();
+    ASSERT_EQ(serialize(11, expected), serialize(11, sparseHll));
+  }
+  sparseHll.insertHashes(nullptr, 0);
+  ASSERT_EQ(serialize(11, expected), serialize(11, sparseHll));
+  ASSERT_EQ(expected.cardinality(), sparseHll.cardinality());
+}
+
 TEST_F(SparseHllTest, mergeWith) {
   // with overlap
   testMergeWith(sequence(0, 100), sequence(50, 150));
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <folly/Synchronized.h>
+#include <gflags/gflags.h>
+
+DECLARE_int32(velox_profiler_sample_interval_micros);
+
+namespace facebook::velox::process {
+
+namespace detail {
+thread_local ThreadProfileState threadProfileState;
+} // namespace detail
+
+namespace {
+
+// Background thread that samples the threads in scope of a ScopedProfile.
+// Started on first use and runs until the end of the process.
+class Sampler {
+ public:
+  static Sampler& instance() {
+    // Not destroyed, so that threads that exit after static destruction can
+    // still unregister.
+    static auto* sampler = new Sampler();
+    return *sampler;
+  }
+
+  void add(detail::ThreadProfileState* state, Profile* profile) {
+    std::lock_guard<std::mutex> l(mutex_);
+    threads_[state] = profile;
+    if (!started_) {
+      std::thread([this]() { run(); }).detach();
+      started_ = true;
+    }
+  }
+
+  void remove(detail::ThreadProfileState* state) {
+    std::lock_guard<std::mutex> l(mutex_);
+    threads_.erase(state);
+  }
+
+  // Holds 'mutex_' while reading the frames, so that a thread cannot leave its
+  // ScopedProfile and free its Profile during the sample.
+  void sample() {
+    std::vector<const char*> frames;
+    std::lock_guard<std::mutex> l(mutex_);
+    for (auto& [state, profile] : threads_) {
+      const auto depth = std::min(
+          state->depth.load(std::memory_order_acquire), kMaxProfileFrames);
+      frames.resize(depth);
+      for (auto i = 0; i < depth; ++i) {
+        frames[i] = state->frames[i].load(std::memory_order_relaxed);
+      }
+      profile->addSample(frames);
+    }
+  }
+
+ private:
+  void run() {
+    for (;;) {
+      std::this_thread::sleep_for(std::chrono::microseconds(
+          std::max(1, FLAGS_velox_profiler_sample_interval_micros)));
+      sample();
+    }
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<detail::ThreadProfileState*, Profile*> threads_;
+  bool started_{false};
+};
+
+} // namespace
+
+void Profile::addSample(const std::vector<const char*>& frames) {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++counts_[frames];
+  ++numSamples_;
+}
+
+uint64_t Profile::numSamples() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numSamples_;
+}
+
+std::map<std::vector<std::string>, uint64_t> Profile::samples() const {
+  std::map<std::vector<std::string>, uint64_t> result;
+  std::lock_guard<std::mutex> l(mutex_);
+  for (const auto& [frames, count] : counts_) {
+    result[std::vector<std::string>(frames.begin(), frames.end())] += count;
+  }
+  return result;
+}
+
+std::string Profile::toFolded(const std::string& root) const {
+  std::stringstream out;
+  for (const auto& [frames, count] : samples()) {
+    if (frames.empty() && root.empty()) {
+      continue;
+    }
+    out << root;
+    for (auto i = 0; i < frames.size(); ++i) {
+      if (i > 0 || !root.empty()) {
+        out << ";";
+      }
+      out << frames[i];
+    }
+    out << " " << count << std::endl;
+  }
+  return out.str();
+}
+
+ScopedProfile::ScopedProfile(Profile* profile) {
+  auto& state = detail::threadProfileState;
+  if (profile == nullptr || state.profile != nullptr) {
+    return;
+  }
+  state.profile = profile;
+  state.depth = 0;
+  registered_ = true;
+  Sampler::instance().add(&state, profile);
+}
+
+ScopedProfile::~ScopedProfile() {
+  if (registered_) {
+    auto& state = detail::threadProfileState;
+    Sampler::instance().remove(&state);
+    state.profile = nullptr;
+  }
+}
+
+const char* internProfileLabel(std::string_view label) {
+  // Not destroyed, so that the labels outlive all uses.
+  static auto* labels =
+      new folly::Synchronized<std::unordered_set<std::string>>();
+  return labels->withWLock([&](auto& set) {
+    return set.emplace(label).first->c_str();
+  });
+}
+
+void sampleProfiledThreads() {
+  Sampler::instance().sample();
+}
+
+} // namespace facebook::velox::process
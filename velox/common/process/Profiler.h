@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <folly/CPortability.h>
+
+namespace facebook::velox::process {
+
+/// Sample counts of the stacks of labeled frames of the threads that ran with
+/// a ScopedProfile for 'this'. A stack consists of the labels of the
+/// ProfileFrames that were in scope on the thread when it was sampled,
+/// outermost first. Thread safe.
+class Profile {
+ public:
+  /// Counts a sample of the stack 'frames'.
+  void addSample(const std::vector<const char*>& frames);
+
+  uint64_t numSamples() const;
+
+  /// Returns the number of samples of each distinct stack.
+  std::map<std::vector<std::string>, uint64_t> samples() const;
+
+  /// Returns the samples in the folded stack format read by flame graph
+  /// tools: a line per distinct stack with the frames separated by ';',
+  /// followed by a space and the number of samples. If 'root' is not empty, it
+  /// is added as the outermost frame of each stack. Samples with no frames
+  /// are left out unless there is a 'root'.
+  std::string toFolded(const std::string& root = "") const;
+
+ private:
+  mutable std::mutex mutex_;
+  // Frame labels are compared by address. The same label may have more than
+  // one address, so that samples() and toFolded() merge by content.
+  std::map<std::vector<const char*>, uint64_t> counts_;
+  uint64_t numSamples_{0};
+};
+
+/// Maximum number of frames recorded per sample. Frames pushed beyond this
+/// are not recorded and their samples are counted for the innermost recorded
+/// frame.
+constexpr int32_t kMaxProfileFrames = 32;
+
+namespace detail {
+// Frames of a thread. Written only by the thread and read by the sampler
+// thread. Reads may see a frame that is being replaced, which is acceptable
+// for a statistical profile.
+struct ThreadProfileState {
+  Profile* profile{nullptr};
+  // Number of frames in scope. Can be larger than kMaxProfileFrames.
+  std::atomic<int32_t> depth{0};
+  std::array<std::atomic<const char*>, kMaxProfileFrames> frames{};
+};
+
+extern thread_local ThreadProfileState threadProfileState;
+} // namespace detail
+
+/// Samples of the current thread are counted in 'profile' while in scope. The
+/// thread is sampled every FLAGS_velox_profiler_sample_interval_micros by a
+/// background thread. Does nothing if 'profile' is nullptr or if the thread is
+/// already in scope of another ScopedProfile. 'profile' must outlive 'this'.
+class ScopedProfile {
+ public:
+  explicit ScopedProfile(Profile* profile);
+
+  ~ScopedProfile();
+
+  ScopedProfile(const ScopedProfile&) = delete;
+  ScopedProfile& operator=(const ScopedProfile&) = delete;
+
+ private:
+  bool registered_{false};
+};
+
+/// Adds a frame with 'label' to the samples of the current thread while in
+/// scope. 'label' must have process lifetime, e.g. a literal or the result of
+/// internProfileLabel(). Costs a thread local read when the thread is not in
+/// scope of a ScopedProfile. Does nothing if 'label' is nullptr.
+class ProfileFrame {
+ public:
+  explicit ProfileFrame(const char* label) {
+    auto& state = detail::threadProfileState;
+    if (FOLLY_LIKELY(state.profile == nullptr) || label == nullptr) {
+      return;
+    }
+    state_ = &state;
+    const auto depth = state.depth.load(std::memory_order_relaxed);
+    if (depth < kMaxProfileFrames) {
+      state.frames[depth].store(label, std::memory_order_relaxed);
+    }
+    state.depth.store(depth + 1, std::memory_order_release);
+  }
+
+  ~ProfileFrame() {
+    if (state_ != nullptr) {
+      state_->depth.store(
+          state_->depth.load(std::memory_order_relaxed) - 1,
+          std::memory_order_release);
+    }
+  }
+
+  ProfileFrame(const ProfileFrame&) = delete;
+  ProfileFrame& operator=(const ProfileFrame&) = delete;
+
+  /// Returns true if the current thread is in scope of a ScopedProfile. Lets
+  /// callers skip making a label when no samples are taken.
+  static bool isProfiling() {
+    return detail::threadProfileState.profile != nullptr;
+  }
+
+ private:
+  detail::ThreadProfileState* state_{nullptr};
+};
+
+/// Returns a copy of 'label' that lives until the end of the process. Returns
+/// the same copy for equal labels. Used for labels that are not literals, like
+/// plan node ids and function names. Takes a lock, so callers keep the result
+/// instead of calling this for each frame.
+const char* internProfileLabel(std::string_view label);
+
+/// Takes a sample of all threads in scope of a ScopedProfile. Called by the
+/// background sampler thread. Exposed for testing.
+void sampleProfiledThreads();
+
+} // namespace facebook::velox::process
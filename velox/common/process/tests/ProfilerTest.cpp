@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/Profiler.h"
+#include <fmt/format.h>
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace facebook::velox::process;
+
+TEST(ProfilerTest, internLabel) {
+  const std::string label = "plan node 1";
+  const auto* interned = internProfileLabel(label);
+  EXPECT_EQ(label, interned);
+  EXPECT_NE(label.c_str(), interned);
+  EXPECT_EQ(interned, internProfileLabel("plan node 1"));
+  EXPECT_NE(interned, internProfileLabel("plan node 2"));
+}
+
+TEST(ProfilerTest, samples) {
+  Profile profile;
+  folly::Baton<> inFrames;
+  folly::Baton<> done;
+  std::thread thread([&]() {
+    // Frames out of scope of a ScopedProfile are not recorded.
+    ProfileFrame outside("outside");
+    EXPECT_FALSE(ProfileFrame::isProfiling());
+    ScopedProfile scopedProfile(&profile);
+    EXPECT_TRUE(ProfileFrame::isProfiling());
+    {
+      // A nested ScopedProfile does nothing.
+      Profile other;
+      ScopedProfile nested(&other);
+    }
+    EXPECT_TRUE(ProfileFrame::isProfiling());
+    ProfileFrame operatorFrame(internProfileLabel("0:FilterProject"));
+    ProfileFrame methodFrame("getOutput");
+    ProfileFrame noFrame(nullptr);
+    ProfileFrame exprFrame("plus");
+    inFrames.post();
+    done.wait();
+  });
+
+  inFrames.wait();
+  for (auto i = 0; i < 3; ++i) {
+    sampleProfiledThreads();
+  }
+  done.post();
+  thread.join();
+  EXPECT_FALSE(ProfileFrame::isProfiling());
+
+  // The background sampler may have taken samples of the thread before it
+  // entered the frames.
+  const std::vector<std::string> stack{"0:FilterProject", "getOutput", "plus"};
+  const auto samples = profile.samples();
+  ASSERT_EQ(1, samples.count(stack));
+  EXPECT_GE(samples.at(stack), 3);
+  EXPECT_GE(profile.numSamples(), 3);
+
+  const auto folded = profile.toFolded("task");
+  EXPECT_NE(
+      std::string::npos,
+      folded.find(fmt::format(
+          "task;0:FilterProject;getOutput;plus {}\n", samples.at(stack))));
+
+  // Samples after the thread left its ScopedProfile are not counted.
+  const auto numSamples = profile.numSamples();
+  sampleProfiledThreads();
+  EXPECT_EQ(numSamples, profile.numSamples());
+}
+
+TEST(ProfilerTest, maxFrames) {
+  Profile profile;
+  std::thread thread([&]() {
+    ScopedProfile scopedProfile(&profile);
+    std::vector<std::unique_ptr<ProfileFrame>> frames;
+    for (auto i = 0; i < kMaxProfileFrames + 10; ++i) {
+      frames.push_back(std::make_unique<ProfileFrame>("frame"));
+    }
+    sampleProfiledThreads();
+  });
+  thread.join();
+
+  std::vector<std::string> stack(kMaxProfileFrames, "frame");
+  EXPECT_GE(profile.samples().at(stack), 1);
+}
+
+TEST(ProfilerTest, folded) {
+  Profile profile;
+  profile.addSample({"a", "b"});
+  profile.addSample({"a", "b"});
+  profile.addSample({"a"});
+  profile.addSample({});
+  EXPECT_EQ(4, profile.numSamples());
+  EXPECT_EQ("a 1\na;b 2\n", profile.toFolded());
+  EXPECT_EQ("t 1\nt;a 1\nt;a;b 2\n", profile.toFolded("t"));
+}
@@ -0,0 +1,905 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/columnar/ColumnarCache.h"
+
+#include <fstream>
+
+#include "velox/vector/BiasVector.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DictionaryVector.h"
+#include "velox/vector/FlatVector.h"
+#include "velox/vector/SequenceVector.h"
+#include "velox/vector/VectorSaver.h"
+
+namespace facebook::velox::connector::columnar {
+
+namespace {
+
+// Integer columns with at most one run per this many rows are run length
+// encoded.
+constexpr vector_size_t kMinAverageRunLength = 4;
+
+// String columns with at most one distinct value per this many rows are
+// dictionary encoded.
+constexpr vector_size_t kMinRowsPerDistinct = 2;
+
+// Calls 'func' with a value of the integer type of 'kind'. Returns false if
+// 'kind' is not an integer kind.
+template <typename Func>
+bool dispatchInteger(TypeKind kind, Func func) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      func(int8_t{});
+      return true;
+    case TypeKind::SMALLINT:
+      func(int16_t{});
+      return true;
+    case TypeKind::INTEGER:
+      func(int32_t{});
+      return true;
+    case TypeKind::BIGINT:
+      func(int64_t{});
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename T>
+VectorPtr makeSequence(
+    const FlatVector<T>& flat,
+    vector_size_t numRuns,
+    memory::MemoryPool* pool) {
+  auto runValues =
+      BaseVector::create<FlatVector<T>>(flat.type(), numRuns, pool);
+  auto lengths = allocateIndices(numRuns, pool);
+  auto* rawRunValues = runValues->mutableRawValues();
+  auto* rawLengths = lengths->asMutable<vector_size_t>();
+  const auto* values = flat.rawValues();
+  vector_size_t run = 0;
+  rawRunValues[0] = values[0];
+  rawLengths[0] = 1;
+  for (auto i = 1; i < flat.size(); ++i) {
+    if (values[i] == values[i - 1]) {
+      ++rawLengths[run];
+    } else {
+      ++run;
+      rawRunValues[run] = values[i];
+      rawLengths[run] = 1;
+    }
+  }
+  return std::make_shared<SequenceVector<T>>(
+      pool, flat.size(), std::move(runValues), std::move(lengths));
+}
+
+template <typename T, typename TDelta>
+VectorPtr makeBias(
+    const FlatVector<T>& flat,
+    T min,
+    uint64_t range,
+    memory::MemoryPool* pool) {
+  // See BiasVector.h for the choice of bias.
+  const T bias = static_cast<T>(static_cast<uint64_t>(min) + (range + 1) / 2);
+  auto deltas = AlignedBuffer::allocate<TDelta>(flat.size(), pool);
+  auto* rawDeltas = deltas->template asMutable<TDelta>();
+  const auto* values = flat.rawValues();
+  for (auto i = 0; i < flat.size(); ++i) {
+    // Values at null positions are arbitrary and may be out of range.
+    rawDeltas[i] = flat.isNullAt(i)
+        ? 0
+        : static_cast<TDelta>(
+              static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(bias));
+  }
+  return std::make_shared<BiasVector<T>>(
+      pool,
+      flat.nulls(),
+      flat.size(),
+      CppToType<TDelta>::typeKind,
+      std::move(deltas),
+      bias);
+}
+
+template <typename T>
+VectorPtr encodeInteger(const VectorPtr& vector, memory::MemoryPool* pool) {
+  const auto& flat = *vector->asUnchecked<FlatVector<T>>();
+  const auto size = flat.size();
+  const auto* values = flat.rawValues();
+  if (!flat.mayHaveNulls()) {
+    vector_size_t numRuns = 1;
+    for (auto i = 1; i < size; ++i) {
+      numRuns += values[i] != values[i - 1];
+    }
+    if (static_cast<int64_t>(numRuns) * kMinAverageRunLength <= size) {
+      return makeSequence<T>(flat, numRuns, pool);
+    }
+  }
+
+  std::optional<T> min;
+  std::optional<T> max;
+  for (auto i = 0; i < size; ++i) {
+    if (flat.isNullAt(i)) {
+      continue;
+    }
+    if (!min.has_value() || values[i] < min.value()) {
+      min = values[i];
+    }
+    if (!max.has_value() || values[i] > max.value()) {
+      max = values[i];
+    }
+  }
+  if (!min.has_value()) {
+    return vector;
+  }
+  const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(*max)) -
+      static_cast<uint64_t>(static_cast<int64_t>(*min));
+  if constexpr (sizeof(T) > sizeof(int8_t)) {
+    if (range <= std::numeric_limits<uint8_t>::max()) {
+      return makeBias<T, int8_t>(flat, *min, range, pool);
+    }
+  }
+  if constexpr (sizeof(T) > sizeof(int16_t)) {
+    if (range <= std::numeric_limits<uint16_t>::max()) {
+      return makeBias<T, int16_t>(flat, *min, range, pool);
+    }
+  }
+  if constexpr (sizeof(T) > sizeof(int32_t)) {
+    if (range <= std::numeric_limits<uint32_t>::max()) {
+      return makeBias<T, int32_t>(flat, *min, range, pool);
+    }
+  }
+  return vector;
+}
+
+VectorPtr encodeStrings(const VectorPtr& vector, memory::MemoryPool* pool) {
+  const auto& flat = *vector->asUnchecked<FlatVector<StringView>>();
+  const auto size = flat.size();
+  const auto maxDistinct = size / kMinRowsPerDistinct;
+  folly::F14FastMap<StringView, vector_size_t, std::hash<StringView>> distinct;
+  auto indices = allocateIndices(size, pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  for (auto i = 0; i < size; ++i) {
+    if (flat.isNullAt(i)) {
+      rawIndices[i] = 0;
+      continue;
+    }
+    auto it = distinct.try_emplace(flat.valueAt(i), distinct.size()).first;
+    if (distinct.size() > maxDistinct) {
+      return vector;
+    }
+    rawIndices[i] = it->second;
+  }
+  // Copy the distinct values into compact string buffers so that the string
+  // buffers of 'vector' can be freed.
+  auto values = BaseVector::create<FlatVector<StringView>>(
+      flat.type(), distinct.size(), pool);
+  for (const auto& [value, index] : distinct) {
+    values->set(index, value);
+  }
+  return BaseVector::wrapInDictionary(
+      flat.nulls(), std::move(indices), size, std::move(values));
+}
+
+// Calls 'test' for rows [begin, end) or for 'rows' if not null, and appends
+// the rows for which 'test' is true to 'passed'.
+template <typename Test>
+void forEachRow(
+    vector_size_t begin,
+    vector_size_t end,
+    const std::vector<vector_size_t>* rows,
+    std::vector<vector_size_t>& passed,
+    Test test) {
+  if (rows) {
+    for (auto row : *rows) {
+      if (test(row)) {
+        passed.push_back(row);
+      }
+    }
+  } else {
+    for (auto row = begin; row < end; ++row) {
+      if (test(row)) {
+        passed.push_back(row);
+      }
+    }
+  }
+}
+
+template <TypeKind kind>
+void filterTyped(
+    const BaseVector& column,
+    const common::Filter& filter,
+    vector_size_t begin,
+    vector_size_t end,
+    const std::vector<vector_size_t>* rows,
+    std::vector<vector_size_t>& passed) {
+  using T = typename TypeTraits<kind>::NativeType;
+  const bool nullPasses = filter.testNull();
+  switch (column.encoding()) {
+    case VectorEncoding::Simple::DICTIONARY: {
+      // Tests each distinct value at most once.
+      constexpr int8_t kUnknown = -1;
+      const auto* base = column.valueVector()->as<SimpleVector<T>>();
+      const auto* indices = column.wrapInfo()->as<vector_size_t>();
+      std::vector<int8_t> results(base->size(), kUnknown);
+      forEachRow(begin, end, rows, passed, [&](vector_size_t row) {
+        if (column.isNullAt(row)) {
+          return nullPasses;
+        }
+        auto index = indices[row];
+        if (results[index] == kUnknown) {
+          results[index] = base->isNullAt(index)
+              ? nullPasses
+              : applyFilter(filter, base->valueAt(index));
+        }
+        return results[index] != 0;
+      });
+      break;
+    }
+    case VectorEncoding::Simple::SEQUENCE: {
+      // Tests each run once. Rows are visited in ascending order.
+      const auto& sequence = static_cast<const SequenceVector<T>&>(column);
+      const auto* lengths =
+          sequence.getSequenceLengths()->template as<vector_size_t>();
+      const auto* values =
+          sequence.getSequenceValues()->template as<SimpleVector<T>>();
+      vector_size_t run = 0;
+      vector_size_t runEnd = lengths[0];
+      vector_size_t testedRun = -1;
+      bool result = false;
+      forEachRow(begin, end, rows, passed, [&](vector_size_t row) {
+        while (row >= runEnd) {
+          runEnd += lengths[++run];
+        }
+        if (testedRun != run) {
+          testedRun = run;
+          result = values->isNullAt(run)
+              ? nullPasses
+              : applyFilter(filter, values->valueAt(run));
+        }
+        return result;
+      });
+      break;
+    }
+    default: {
+      const auto* simple = column.as<SimpleVector<T>>();
+      forEachRow(begin, end, rows, passed, [&](vector_size_t row) {
+        if (simple->isNullAt(row)) {
+          return nullPasses;
+        }
+        return applyFilter(filter, simple->valueAt(row));
+      });
+      break;
+    }
+  }
+}
+
+// Decodes 'rows' of 'column' into a flat vector allocated from 'pool'. For a
+// sequence encoded 'column', 'rows' must be ascending. Does not use the
+// SequenceVector accessors, which are not safe for concurrent use by
+// different drivers. Strings are copied into the string buffers of the
+// result.
+template <typename T>
+VectorPtr decodeRows(
+    const BaseVector& column,
+    const std::vector<vector_size_t>& rows,
+    const TypePtr& type,
+    memory::MemoryPool* pool) {
+  auto result = BaseVector::create<FlatVector<T>>(type, rows.size(), pool);
+  if (column.encoding() == VectorEncoding::Simple::SEQUENCE) {
+    const auto& sequence = static_cast<const SequenceVector<T>&>(column);
+    const auto* lengths =
+        sequence.getSequenceLengths()->template as<vector_size_t>();
+    const auto* values =
+        sequence.getSequenceValues()->template as<SimpleVector<T>>();
+    vector_size_t run = 0;
+    vector_size_t runEnd = lengths[0];
+    for (auto i = 0; i < rows.size(); ++i) {
+      while (rows[i] >= runEnd) {
+        runEnd += lengths[++run];
+      }
+      if (values->isNullAt(run)) {
+        result->setNull(i, true);
+      } else {
+        result->set(i, values->valueAt(run));
+      }
+    }
+    return result;
+  }
+  const auto* simple = column.as<SimpleVector<T>>();
+  for (auto i = 0; i < rows.size(); ++i) {
+    if (simple->isNullAt(rows[i])) {
+      result->setNull(i, true);
+    } else {
+      result->set(i, simple->valueAt(rows[i]));
+    }
+  }
+  return result;
+}
+
+template <TypeKind kind>
+VectorPtr decodeRowsTyped(
+    const BaseVector& column,
+    const std::vector<vector_size_t>& rows,
+    const TypePtr& type,
+    memory::MemoryPool* pool) {
+  return decodeRows<typename TypeTraits<kind>::NativeType>(
+      column, rows, type, pool);
+}
+
+// Copies the strings of 'vector', which is flat or a complex type with flat
+// children, into string buffers allocated from the pool of 'vector'. Used
+// after BaseVector::copy(), which shares the string buffers of the source.
+void copyStrings(BaseVector& vector) {
+  switch (vector.typeKind()) {
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      auto* flat = vector.asFlatVector<StringView>();
+      // Keeps the shared buffers alive while their strings are copied.
+      const auto sharedBuffers = flat->stringBuffers();
+      flat->clearStringBuffers();
+      for (auto i = 0; i < flat->size(); ++i) {
+        if (!flat->isNullAt(i)) {
+          flat->set(i, flat->valueAt(i));
+        }
+      }
+      break;
+    }
+    case TypeKind::ARRAY:
+      copyStrings(*vector.as<ArrayVector>()->elements());
+      break;
+    case TypeKind::MAP:
+      copyStrings(*vector.as<MapVector>()->mapKeys());
+      copyStrings(*vector.as<MapVector>()->mapValues());
+      break;
+    case TypeKind::ROW:
+      for (const auto& child : vector.as<RowVector>()->children()) {
+        copyStrings(*child);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+// Layout of a column evicted to SSD: the encoding, the number of rows and
+// then the parts of the column serialized with saveVector(). Bias and
+// sequence columns, which saveVector() does not support, are written as
+// their flat component vectors.
+void writeColumn(const BaseVector& column, const std::string& path) {
+  std::ofstream out(path, std::ofstream::binary);
+  VELOX_CHECK(out.good(), "Cannot open columnar cache file {}", path);
+  const int32_t encoding = static_cast<int32_t>(column.encoding());
+  const int32_t size = column.size();
+  out.write(reinterpret_cast<const char*>(&encoding), sizeof(encoding));
+  out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+  switch (column.encoding()) {
+    case VectorEncoding::Simple::BIASED:
+      dispatchInteger(column.typeKind(), [&](auto tag) {
+        using T = decltype(tag);
+        const auto& biased = static_cast<const BiasVector<T>&>(column);
+        const int64_t bias = biased.bias();
+        out.write(reinterpret_cast<const char*>(&bias), sizeof(bias));
+        dispatchInteger(biased.valueType(), [&](auto deltaTag) {
+          using TDelta = decltype(deltaTag);
+          FlatVector<TDelta> deltas(
+              column.pool(),
+              CppToType<TDelta>::create(),
+              column.nulls(),
+              column.size(),
+              biased.values(),
+              std::vector<BufferPtr>{});
+          saveVector(deltas, out);
+        });
+      });
+      break;
+    case VectorEncoding::Simple::SEQUENCE:
+      dispatchInteger(column.typeKind(), [&](auto tag) {
+        using T = decltype(tag);
+        const auto& sequence = static_cast<const SequenceVector<T>&>(column);
+        saveVector(*sequence.getSequenceValues(), out);
+        FlatVector<vector_size_t> lengths(
+            column.pool(),
+            INTEGER(),
+            nullptr,
+            sequence.numSequences(),
+            sequence.getSequenceLengths(),
+            std::vector<BufferPtr>{});
+        saveVector(lengths, out);
+      });
+      break;
+    default:
+      saveVector(column, out);
+      break;
+  }
+  VELOX_CHECK(out.good(), "Error writing columnar cache file {}", path);
+}
+
+VectorPtr readColumn(
+    const std::string& path,
+    const TypePtr& type,
+    memory::MemoryPool* pool) {
+  std::ifstream in(path, std::ifstream::binary);
+  VELOX_CHECK(in.good(), "Cannot open columnar cache file {}", path);
+  int32_t encoding;
+  int32_t size;
+  in.read(reinterpret_cast<char*>(&encoding), sizeof(encoding));
+  in.read(reinterpret_cast<char*>(&size), sizeof(size));
+  VectorPtr result;
+  switch (static_cast<VectorEncoding::Simple>(encoding)) {
+    case VectorEncoding::Simple::BIASED:
+      dispatchInteger(type->kind(), [&](auto tag) {
+        using T = decltype(tag);
+        int64_t bias;
+        in.read(reinterpret_cast<char*>(&bias), sizeof(bias));
+        auto deltas = restoreVector(in, pool);
+        result = std::make_shared<BiasVector<T>>(
+            pool,
+            deltas->nulls(),
+            size,
+            deltas->typeKind(),
+            deltas->values(),
+            static_cast<T>(bias));
+      });
+      break;
+    case VectorEncoding::Simple::SEQUENCE:
+      dispatchInteger(type->kind(), [&](auto tag) {
+        using T = decltype(tag);
+        auto values = restoreVector(in, pool);
+        auto lengths = restoreVector(in, pool);
+        result = std::make_shared<SequenceVector<T>>(
+            pool, size, std::move(values), lengths->values());
+      });
+      break;
+    default:
+      result = restoreVector(in, pool);
+      break;
+  }
+  VELOX_CHECK_NOT_NULL(result);
+  VELOX_CHECK_EQ(result->size(), size);
+  return result;
+}
+
+class ColumnarCacheReclaimer : public memory::MemoryReclaimer {
+ public:
+  explicit ColumnarCacheReclaimer(ColumnarCache* cache) : cache_(cache) {}
+
+  bool reclaimableBytes(
+      const memory::MemoryPool& pool,
+      uint64_t& reclaimableBytes) const override {
+    // Excludes the columns in use by scans and the columns being read from
+    // the source connectors, which are allocated from 'pool' but cannot be
+    // released.
+    reclaimableBytes = cache_->reclaimableBytes();
+    return true;
+  }
+
+  uint64_t reclaim(
+      memory::MemoryPool* /*pool*/,
+      uint64_t targetBytes,
+      Stats& /*stats*/) override {
+    return cache_->shrink(targetBytes);
+  }
+
+  void abort(memory::MemoryPool* /*pool*/, const std::exception_ptr& /*error*/)
+      override {
+    cache_->clear();
+  }
+
+ private:
+  ColumnarCache* const cache_;
+};
+
+} // namespace
+
+VectorPtr encodeColumn(const VectorPtr& vector, memory::MemoryPool* pool) {
+  if (vector->encoding() != VectorEncoding::Simple::FLAT ||
+      vector->size() == 0) {
+    return vector;
+  }
+  VectorPtr result = vector;
+  if (dispatchInteger(vector->typeKind(), [&](auto tag) {
+        result = encodeInteger<decltype(tag)>(vector, pool);
+      })) {
+    return result;
+  }
+  switch (vector->typeKind()) {
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return encodeStrings(vector, pool);
+    default:
+      return vector;
+  }
+}
+
+void filterColumn(
+    const BaseVector& column,
+    const common::Filter& filter,
+    vector_size_t begin,
+    vector_size_t end,
+    const std::vector<vector_size_t>* rows,
+    std::vector<vector_size_t>& passed) {
+  VELOX_CHECK(
+      column.type()->isPrimitiveType(),
+      "Filters on {} columns are not supported by the columnar cache",
+      column.type()->toString());
+  VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+      filterTyped, column.typeKind(), column, filter, begin, end, rows, passed);
+}
+
+VectorPtr extractColumn(
+    const VectorPtr& column,
+    const std::vector<vector_size_t>& rows,
+    const TypePtr& type,
+    memory::MemoryPool* pool) {
+  // Copies the rows since 'column' is allocated from the pool of the cache,
+  // which may be destroyed before the result.
+  if (type->isPrimitiveType()) {
+    return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        decodeRowsTyped, type->kind(), *column, rows, type, pool);
+  }
+  // Complex type columns are cached flat.
+  const vector_size_t numRows = rows.size();
+  auto result = BaseVector::create(type, numRows, pool);
+  result->copy(column.get(), SelectivityVector(numRows), rows.data());
+  copyStrings(*result);
+  return result;
+}
+
+ColumnarCache::ColumnarCache(uint64_t maxBytes, std::string ssdPath)
+    : maxBytes_(maxBytes), ssdPath_(std::move(ssdPath)) {
+  static std::atomic<int64_t> cacheId{0};
+  rootPool_ = memory::defaultMemoryManager().addRootPool(
+      fmt::format("columnarCache_{}", cacheId++),
+      memory::kMaxMemory,
+      std::make_unique<ColumnarCacheReclaimer>(this));
+  pool_ = rootPool_->addLeafChild("columnarCache");
+}
+
+ColumnarCache::~ColumnarCache() {
+  clear();
+}
+
+VectorPtr ColumnarCache::find(
+    const std::string& splitKey,
+    const std::string& column) {
+  std::string ssdFile;
+  TypePtr type;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto* entry = findEntryLocked(splitKey, column);
+    if (!entry) {
+      ++stats_.numMisses;
+      return nullptr;
+    }
+    if (entry->vector) {
+      ++stats_.numHits;
+      touchLocked(*entry);
+      return entry->vector;
+    }
+    if (entry->evicting) {
+      // Being written to SSD.
+      ++stats_.numHits;
+      return entry->evicting;
+    }
+    ssdFile = entry->ssdFile;
+    type = entry->type;
+  }
+
+  // Reads outside of 'mutex_' since allocating may need to shrink 'this'.
+  auto vector = readColumn(ssdFile, type, pool_.get());
+  std::vector<Victim> victims;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    ++stats_.numSsdReads;
+    auto* entry = findEntryLocked(splitKey, column);
+    if (!entry) {
+      // Cleared while reading.
+      return vector;
+    }
+    ++stats_.numHits;
+    if (entry->vector) {
+      // Read by another thread.
+      touchLocked(*entry);
+      return entry->vector;
+    }
+    // 'entry' may be evicted again if it alone exceeds the capacity.
+    addLocked(splitKey, column, *entry, vector, victims);
+  }
+  writeVictims(victims);
+  return vector;
+}
+
+std::optional<vector_size_t> ColumnarCache::numRows(
+    const std::string& splitKey) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = splits_.find(splitKey);
+  if (it == splits_.end()) {
+    return std::nullopt;
+  }
+  return it->second.numRows;
+}
+
+VectorPtr ColumnarCache::insert(
+    const std::string& splitKey,
+    uint64_t generation,
+    const std::string& column,
+    const VectorPtr& vector) {
+  auto encoded = encodeColumn(vector, pool_.get());
+  std::vector<Victim> victims;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto* splitEntry = findSplitLocked(splitKey, generation);
+    if (!splitEntry) {
+      // Read before a version change or invalidation of the split.
+      return encoded;
+    }
+    auto& split = *splitEntry;
+    if (split.numRows.has_value()) {
+      VELOX_CHECK_EQ(
+          split.numRows.value(),
+          encoded->size(),
+          "Columns of split {} have different sizes",
+          splitKey);
+    } else {
+      split.numRows = encoded->size();
+    }
+    auto& entry = split.columns[column];
+    if (entry.vector) {
+      // Added by another thread.
+      touchLocked(entry);
+      return entry.vector;
+    }
+    entry.type = vector->type();
+    addLocked(splitKey, column, entry, encoded, victims);
+  }
+  writeVictims(victims);
+  return encoded;
+}
+
+void ColumnarCache::setNumRows(
+    const std::string& splitKey,
+    uint64_t generation,
+    vector_size_t numRows) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* split = findSplitLocked(splitKey, generation);
+  if (!split) {
+    return;
+  }
+  if (split->numRows.has_value()) {
+    VELOX_CHECK_EQ(split->numRows.value(), numRows);
+  } else {
+    split->numRows = numRows;
+  }
+}
+
+uint64_t ColumnarCache::setVersion(
+    const std::string& splitKey,
+    const std::string& version) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = splits_.find(splitKey);
+  if (it != splits_.end()) {
+    if (it->second.version == version) {
+      return it->second.generation;
+    }
+    eraseSplitLocked(it);
+  }
+  auto& split = splits_[splitKey];
+  split.version = version;
+  split.generation = nextGeneration_++;
+  return split.generation;
+}
+
+void ColumnarCache::invalidate(const std::string& splitKey) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = splits_.find(splitKey);
+  if (it != splits_.end()) {
+    eraseSplitLocked(it);
+  }
+}
+
+uint64_t ColumnarCache::shrink(uint64_t targetBytes) {
+  std::vector<Victim> victims;
+  uint64_t releasedBytes;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    releasedBytes = shrinkLocked(targetBytes, true, victims);
+  }
+  writeVictims(victims);
+  return releasedBytes;
+}
+
+uint64_t ColumnarCache::reclaimableBytes() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  uint64_t bytes = 0;
+  for (const auto& [splitKey, split] : splits_) {
+    for (const auto& [column, entry] : split.columns) {
+      if (entry.vector && !isPinned(entry)) {
+        bytes += entry.bytes;
+      }
+    }
+  }
+  return bytes;
+}
+
+void ColumnarCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto& [splitKey, split] : splits_) {
+    for (auto& [column, entry] : split.columns) {
+      if (!entry.ssdFile.empty()) {
+        std::remove(entry.ssdFile.c_str());
+      }
+    }
+  }
+  splits_.clear();
+  lru_.clear();
+  cachedBytes_ = 0;
+}
+
+ColumnarCache::Stats ColumnarCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto stats = stats_;
+  stats.numColumns = lru_.size();
+  stats.memoryBytes = cachedBytes_;
+  return stats;
+}
+
+ColumnarCache::ColumnEntry* ColumnarCache::findEntryLocked(
+    const std::string& splitKey,
+    const std::string& column) {
+  auto split = splits_.find(splitKey);
+  if (split == splits_.end()) {
+    return nullptr;
+  }
+  auto it = split->second.columns.find(column);
+  if (it == split->second.columns.end()) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+void ColumnarCache::addLocked(
+    const std::string& splitKey,
+    const std::string& column,
+    ColumnEntry& entry,
+    VectorPtr vector,
+    std::vector<Victim>& victims) {
+  entry.vector = std::move(vector);
+  entry.bytes = entry.vector->retainedSize();
+  lru_.emplace_front(splitKey, column);
+  entry.lruPosition = lru_.begin();
+  cachedBytes_ += entry.bytes;
+  if (cachedBytes_ > maxBytes_) {
+    shrinkLocked(cachedBytes_ - maxBytes_, false, victims);
+  }
+}
+
+void ColumnarCache::touchLocked(ColumnEntry& entry) {
+  lru_.splice(lru_.begin(), lru_, entry.lruPosition);
+}
+
+ColumnarCache::SplitEntry* ColumnarCache::findSplitLocked(
+    const std::string& splitKey,
+    uint64_t generation) {
+  auto it = splits_.find(splitKey);
+  if (it == splits_.end() || it->second.generation != generation) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+uint64_t ColumnarCache::evictLocked(
+    const std::string& splitKey,
+    const std::string& column,
+    ColumnEntry& entry,
+    std::vector<Victim>& victims) {
+  const auto bytes = entry.bytes;
+  lru_.erase(entry.lruPosition);
+  cachedBytes_ -= bytes;
+  ++stats_.numEvictions;
+  Victim victim{splitKey, column, std::move(entry.vector), ""};
+  entry.bytes = 0;
+  if (!entry.ssdFile.empty() || entry.evicting) {
+    // Already on SSD or being written there.
+  } else if (!ssdPath_.empty()) {
+    victim.ssdFile =
+        fmt::format("{}/columnar_cache_{}", ssdPath_, fileCounter_++);
+    entry.evicting = victim.vector;
+  } else {
+    splits_[splitKey].columns.erase(column);
+  }
+  victims.push_back(std::move(victim));
+  return bytes;
+}
+
+uint64_t ColumnarCache::shrinkLocked(
+    uint64_t targetBytes,
+    bool skipPinned,
+    std::vector<Victim>& victims) {
+  if (targetBytes == 0) {
+    targetBytes = std::numeric_limits<uint64_t>::max();
+  }
+  // Selects the columns first since evicting erases them from 'lru_'.
+  std::vector<std::pair<std::string, std::string>> selected;
+  uint64_t selectedBytes = 0;
+  for (auto it = lru_.rbegin();
+       it != lru_.rend() && selectedBytes < targetBytes;
+       ++it) {
+    auto* entry = findEntryLocked(it->first, it->second);
+    VELOX_CHECK_NOT_NULL(entry);
+    if (skipPinned && isPinned(*entry)) {
+      continue;
+    }
+    selected.push_back(*it);
+    selectedBytes += entry->bytes;
+  }
+  uint64_t releasedBytes = 0;
+  for (const auto& [splitKey, column] : selected) {
+    auto* entry = findEntryLocked(splitKey, column);
+    releasedBytes += evictLocked(splitKey, column, *entry, victims);
+  }
+  return releasedBytes;
+}
+
+void ColumnarCache::eraseSplitLocked(
+    folly::F14FastMap<std::string, SplitEntry>::iterator it) {
+  for (auto& [column, entry] : it->second.columns) {
+    if (entry.vector) {
+      lru_.erase(entry.lruPosition);
+      cachedBytes_ -= entry.bytes;
+    }
+    if (!entry.ssdFile.empty()) {
+      std::remove(entry.ssdFile.c_str());
+    }
+  }
+  splits_.erase(it);
+}
+
+void ColumnarCache::writeVictims(std::vector<Victim>& victims) {
+  for (auto& victim : victims) {
+    if (victim.ssdFile.empty()) {
+      continue;
+    }
+    bool written = true;
+    try {
+      writeColumn(*victim.vector, victim.ssdFile);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to write columnar cache file " << victim.ssdFile
+                 << ": " << e.what();
+      std::remove(victim.ssdFile.c_str());
+      written = false;
+    }
+    std::lock_guard<std::mutex> l(mutex_);
+    auto* entry = findEntryLocked(victim.splitKey, victim.column);
+    if (!entry || entry->evicting != victim.vector) {
+      // Cleared while writing.
+      if (written) {
+        std::remove(victim.ssdFile.c_str());
+      }
+      continue;
+    }
+    entry->evicting = nullptr;
+    if (written) {
+      entry->ssdFile = std::move(victim.ssdFile);
+      ++stats_.numSsdWrites;
+    } else if (!entry->vector) {
+      splits_[victim.splitKey].columns.erase(victim.column);
+    }
+  }
+  // Frees the evicted vectors outside of 'mutex_'.
+  victims.clear();
+}
+
+} // namespace facebook::velox::connector::columnar
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <list>
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/memory/Memory.h"
+#include "velox/type/Filter.h"
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox::connector::columnar {
+
+/// Re-encodes 'vector' into the most compact of flat, dictionary, bias or
+/// sequence encoding. 'vector' must be flat or a complex type. The result is
+/// allocated from 'pool'.
+VectorPtr encodeColumn(const VectorPtr& vector, memory::MemoryPool* pool);
+
+/// Tests rows [begin, end) of a column produced by encodeColumn() against
+/// 'filter' and appends the passing row numbers to 'passed'. If 'rows' is
+/// given, only tests the rows in 'rows', which must be in [begin, end).
+/// Dictionary and sequence encoded columns test each distinct value or run
+/// once.
+void filterColumn(
+    const BaseVector& column,
+    const common::Filter& filter,
+    vector_size_t begin,
+    vector_size_t end,
+    const std::vector<vector_size_t>* rows,
+    std::vector<vector_size_t>& passed);
+
+/// Returns the values of 'column' at 'rows' as a flat vector of 'type'
+/// allocated from 'pool'. The result does not reference the memory of
+/// 'column', so that it can outlive the cache 'column' is in.
+VectorPtr extractColumn(
+    const VectorPtr& column,
+    const std::vector<vector_size_t>& rows,
+    const TypePtr& type,
+    memory::MemoryPool* pool);
+
+/// Process wide cache of decoded table columns, keyed on split and column
+/// name. Memory is accounted in a root memory pool owned by the cache.
+/// When the cache is over capacity or the memory arbitrator asks the pool
+/// to reclaim, least recently used columns are written to files under
+/// 'ssdPath' and dropped from memory. Without an 'ssdPath' they are dropped
+/// outright.
+class ColumnarCache {
+ public:
+  struct Stats {
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+    uint64_t numSsdReads{0};
+    uint64_t numSsdWrites{0};
+    uint64_t numEvictions{0};
+    uint64_t numColumns{0};
+    uint64_t memoryBytes{0};
+  };
+
+  ColumnarCache(uint64_t maxBytes, std::string ssdPath = "");
+
+  ~ColumnarCache();
+
+  /// Returns the cached column 'column' of split 'splitKey' or nullptr if not
+  /// cached. Reads the column back from SSD if it was spilled.
+  VectorPtr find(const std::string& splitKey, const std::string& column);
+
+  /// Returns the number of rows of 'splitKey' or std::nullopt if no column of
+  /// the split has been added.
+  std::optional<vector_size_t> numRows(const std::string& splitKey);
+
+  /// Adds 'vector' as 'column' of 'splitKey' and returns the encoded copy.
+  /// The copy is retained in the cache only if the columns of 'splitKey' are
+  /// still at 'generation', i.e. have not been dropped by setVersion() or
+  /// invalidate() since 'vector' was read. Evicts other columns if over
+  /// capacity.
+  VectorPtr insert(
+      const std::string& splitKey,
+      uint64_t generation,
+      const std::string& column,
+      const VectorPtr& vector);
+
+  /// Records that 'splitKey' has 'numRows' rows if its columns are still at
+  /// 'generation'. Used for splits read without any columns.
+  void setNumRows(
+      const std::string& splitKey,
+      uint64_t generation,
+      vector_size_t numRows);
+
+  /// Records that the columns of 'splitKey' are for 'version' of the data of
+  /// the split. Drops the columns cached for any other version, so that a
+  /// rewritten file is read again. Returns the generation of the columns to
+  /// pass to insert() and setNumRows().
+  uint64_t setVersion(const std::string& splitKey, const std::string& version);
+
+  /// Drops the cached columns of 'splitKey', including the ones spilled to
+  /// SSD.
+  void invalidate(const std::string& splitKey);
+
+  /// Evicts least recently used columns that are not in use by a scan until
+  /// at least 'targetBytes' of memory is released or no such column is left.
+  /// Returns the released bytes.
+  uint64_t shrink(uint64_t targetBytes);
+
+  /// Returns the bytes of the in-memory columns that are not in use by a scan.
+  /// These are the bytes shrink() can release.
+  uint64_t reclaimableBytes() const;
+
+  /// Drops all cached columns, including the ones spilled to SSD.
+  void clear();
+
+  Stats stats() const;
+
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+ private:
+  struct ColumnEntry {
+    TypePtr type;
+    VectorPtr vector;
+    uint64_t bytes{0};
+    // Path of the file holding 'vector' if it was evicted to SSD.
+    std::string ssdFile;
+    // The evicted vector while it is being written to SSD. Returned by find()
+    // until the write completes.
+    VectorPtr evicting;
+    // Position in 'lru_' while 'vector' is in memory.
+    std::list<std::pair<std::string, std::string>>::iterator lruPosition;
+  };
+
+  struct SplitEntry {
+    std::optional<vector_size_t> numRows;
+    // See setVersion().
+    std::string version;
+    uint64_t generation{0};
+    folly::F14FastMap<std::string, ColumnEntry> columns;
+  };
+
+  // Column removed from memory under 'mutex_'. Its vector is written to
+  // 'ssdFile' and released after 'mutex_' is released.
+  struct Victim {
+    std::string splitKey;
+    std::string column;
+    VectorPtr vector;
+    // Empty if 'vector' is dropped without writing.
+    std::string ssdFile;
+  };
+
+  ColumnEntry* findEntryLocked(
+      const std::string& splitKey,
+      const std::string& column);
+
+  // Sets the in-memory 'vector' of 'entry'. If over capacity, evicts other
+  // columns and adds them to 'victims'.
+  void addLocked(
+      const std::string& splitKey,
+      const std::string& column,
+      ColumnEntry& entry,
+      VectorPtr vector,
+      std::vector<Victim>& victims);
+
+  // Moves 'entry' to the most recently used position.
+  void touchLocked(ColumnEntry& entry);
+
+  // Returns the split entry of 'splitKey' if it is at 'generation', otherwise
+  // nullptr.
+  SplitEntry* findSplitLocked(const std::string& splitKey, uint64_t generation);
+
+  // True if the in-memory vector of 'entry' is referenced outside of the
+  // cache, e.g. by a scan of its split. Evicting it does not free memory.
+  static bool isPinned(const ColumnEntry& entry) {
+    return entry.vector.use_count() > 1;
+  }
+
+  // Removes 'entry' of column 'column' of split 'splitKey' from memory and
+  // adds it to 'victims'. Returns the bytes released from the cache.
+  uint64_t evictLocked(
+      const std::string& splitKey,
+      const std::string& column,
+      ColumnEntry& entry,
+      std::vector<Victim>& victims);
+
+  // Evicts least recently used columns until 'targetBytes' are released. If
+  // 'skipPinned' is true, columns for which isPinned() is true are kept.
+  uint64_t shrinkLocked(
+      uint64_t targetBytes,
+      bool skipPinned,
+      std::vector<Victim>& victims);
+
+  // Drops the columns of the split at 'it' and erases it from 'splits_'.
+  void eraseSplitLocked(
+      folly::F14FastMap<std::string, SplitEntry>::iterator it);
+
+  // Writes 'victims' to SSD and releases their vectors. Must be called
+  // without holding 'mutex_' so that lookups do not wait for the writes.
+  void writeVictims(std::vector<Victim>& victims);
+
+  const uint64_t maxBytes_;
+  const std::string ssdPath_;
+
+  std::shared_ptr<memory::MemoryPool> rootPool_;
+  std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, SplitEntry> splits_;
+  // (splitKey, column) of in-memory columns, most recently used first.
+  std::list<std::pair<std::string, std::string>> lru_;
+  uint64_t cachedBytes_{0};
+  uint64_t fileCounter_{0};
+  uint64_t nextGeneration_{0};
+  Stats stats_;
+};
+
+} // namespace facebook::velox::connector::columnar
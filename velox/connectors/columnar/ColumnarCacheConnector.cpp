@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/columnar/ColumnarCacheConnector.h"
+
+#include <numeric>
+
+#include "velox/core/Config.h"
+
+namespace facebook::velox::connector::columnar {
+
+namespace {
+
+// Batch size for reading a split from the source connector.
+constexpr uint64_t kSourceBatchSize = 10'000;
+
+std::shared_ptr<ColumnarColumnHandle> toColumnarHandle(
+    const std::shared_ptr<ColumnHandle>& handle) {
+  auto columnarHandle =
+      std::dynamic_pointer_cast<ColumnarColumnHandle>(handle);
+  VELOX_CHECK_NOT_NULL(
+      columnarHandle,
+      "ColumnHandle must be an instance of ColumnarColumnHandle");
+  return columnarHandle;
+}
+
+} // namespace
+
+std::string ColumnarTableHandle::toString() const {
+  std::stringstream out;
+  out << "table: " << tableName_
+      << ", source: " << sourceTableHandle_->toString();
+  if (!filters_.empty()) {
+    out << ", filters: [";
+    for (auto i = 0; i < filters_.size(); ++i) {
+      if (i > 0) {
+        out << ", ";
+      }
+      out << "(" << filters_[i].column->name() << ", "
+          << filters_[i].filter->toString() << ")";
+    }
+    out << "]";
+  }
+  return out.str();
+}
+
+ColumnarDataSource::ColumnarDataSource(
+    const RowTypePtr& outputType,
+    const std::shared_ptr<ConnectorTableHandle>& tableHandle,
+    const std::unordered_map<
+        std::string,
+        std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+    ColumnarCache* cache,
+    ConnectorQueryCtx* connectorQueryCtx)
+    : outputType_(outputType),
+      cache_(cache),
+      connectorQueryCtx_(connectorQueryCtx),
+      pool_(connectorQueryCtx->memoryPool()) {
+  tableHandle_ = std::dynamic_pointer_cast<ColumnarTableHandle>(tableHandle);
+  VELOX_CHECK_NOT_NULL(
+      tableHandle_,
+      "TableHandle must be an instance of ColumnarTableHandle");
+  for (const auto& name : outputType_->names()) {
+    auto it = columnHandles.find(name);
+    VELOX_CHECK(
+        it != columnHandles.end(),
+        "ColumnHandle is missing for output column: {}",
+        name);
+    outputHandles_.push_back(toColumnarHandle(it->second));
+  }
+  filters_ = tableHandle_->filters();
+}
+
+void ColumnarDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
+  VELOX_CHECK_NULL(
+      split_,
+      "Previous split has not been processed yet. "
+      "Call next to process the split.");
+  split_ = std::dynamic_pointer_cast<ColumnarConnectorSplit>(split);
+  VELOX_CHECK_NOT_NULL(split_, "Wrong type of split");
+  splitKey_ = ColumnarCacheConnector::splitKey(
+      tableHandle_->tableName(), *split_->sourceSplit);
+  generation_ = cache_->setVersion(splitKey_, split_->version);
+  nextRow_ = 0;
+  loadColumns();
+}
+
+void ColumnarDataSource::loadColumns() {
+  loaded_.clear();
+  std::vector<std::shared_ptr<ColumnarColumnHandle>> missing;
+  auto lookup = [&](const std::shared_ptr<ColumnarColumnHandle>& handle) {
+    if (loaded_.count(handle->name())) {
+      return;
+    }
+    auto column = cache_->find(splitKey_, handle->name());
+    if (column) {
+      loaded_[handle->name()] = std::move(column);
+      return;
+    }
+    for (const auto& other : missing) {
+      if (other->name() == handle->name()) {
+        return;
+      }
+    }
+    missing.push_back(handle);
+  };
+  for (const auto& handle : outputHandles_) {
+    lookup(handle);
+  }
+  for (const auto& filter : filters_) {
+    lookup(filter.column);
+  }
+
+  auto numRows = cache_->numRows(splitKey_);
+  if (missing.empty() && numRows.has_value()) {
+    ++numSplitHits_;
+    setColumns(numRows.value());
+  } else {
+    ++numSplitMisses_;
+    startReadFromSource(std::move(missing));
+  }
+}
+
+void ColumnarDataSource::startReadFromSource(
+    std::vector<std::shared_ptr<ColumnarColumnHandle>> columns) {
+  const auto& sourceTableHandle = tableHandle_->sourceTableHandle();
+  auto connector = getConnector(sourceTableHandle->connectorId());
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  std::unordered_map<std::string, std::shared_ptr<ColumnHandle>> assignments;
+  for (const auto& column : columns) {
+    names.push_back(column->name());
+    types.push_back(column->type());
+    assignments[column->name()] = column->sourceHandle();
+  }
+  source_ = connector->createDataSource(
+      ROW(std::move(names), std::move(types)),
+      sourceTableHandle,
+      assignments,
+      connectorQueryCtx_);
+  source_->addSplit(split_->sourceSplit);
+
+  // The columns are accumulated in the cache's pool since they are retained
+  // after the query.
+  sourceVectors_.clear();
+  for (const auto& column : columns) {
+    sourceVectors_.push_back(
+        BaseVector::create(column->type(), 0, cache_->pool()));
+  }
+  sourceColumns_ = std::move(columns);
+  sourceRows_ = 0;
+}
+
+bool ColumnarDataSource::readFromSource(velox::ContinueFuture& future) {
+  for (;;) {
+    auto result = source_->next(kSourceBatchSize, future);
+    if (!result.has_value()) {
+      return false;
+    }
+    auto batch = std::move(result.value());
+    if (!batch) {
+      break;
+    }
+    const auto batchSize = batch->size();
+    if (batchSize == 0) {
+      continue;
+    }
+    for (auto i = 0; i < sourceColumns_.size(); ++i) {
+      auto child = BaseVector::loadedVectorShared(batch->childAt(i));
+      sourceVectors_[i]->resize(sourceRows_ + batchSize);
+      sourceVectors_[i]->copy(child.get(), sourceRows_, 0, batchSize);
+    }
+    sourceRows_ += batchSize;
+  }
+  completedBytes_ += source_->getCompletedBytes();
+  source_.reset();
+
+  // The columns are not cached if the split changed version or was
+  // invalidated while it was read. They are still used for this scan.
+  cache_->setNumRows(splitKey_, generation_, sourceRows_);
+  for (auto i = 0; i < sourceColumns_.size(); ++i) {
+    loaded_[sourceColumns_[i]->name()] = cache_->insert(
+        splitKey_, generation_, sourceColumns_[i]->name(), sourceVectors_[i]);
+  }
+  sourceColumns_.clear();
+  sourceVectors_.clear();
+  setColumns(sourceRows_);
+  return true;
+}
+
+void ColumnarDataSource::setColumns(vector_size_t numRows) {
+  numRows_ = numRows;
+  outputColumns_.clear();
+  for (const auto& handle : outputHandles_) {
+    outputColumns_.push_back(loaded_[handle->name()]);
+  }
+  filterColumns_.clear();
+  for (const auto& filter : filters_) {
+    filterColumns_.push_back(loaded_[filter.column->name()]);
+  }
+  loaded_.clear();
+}
+
+std::optional<RowVectorPtr> ColumnarDataSource::next(
+    uint64_t size,
+    velox::ContinueFuture& future) {
+  VELOX_CHECK_NOT_NULL(split_, "No split to process. Call addSplit first.");
+  if (source_ && !readFromSource(future)) {
+    return std::nullopt;
+  }
+  while (nextRow_ < numRows_) {
+    const auto begin = nextRow_;
+    const auto end = static_cast<vector_size_t>(
+        std::min<uint64_t>(numRows_, begin + size));
+    nextRow_ = end;
+    completedRows_ += end - begin;
+
+    const std::vector<vector_size_t>* candidates = nullptr;
+    for (auto i = 0; i < filters_.size(); ++i) {
+      passed_.clear();
+      filterColumn(
+          *filterColumns_[i],
+          *filters_[i].filter,
+          begin,
+          end,
+          candidates,
+          passed_);
+      std::swap(rows_, passed_);
+      candidates = &rows_;
+      if (rows_.empty()) {
+        break;
+      }
+    }
+    if (!candidates) {
+      rows_.resize(end - begin);
+      std::iota(rows_.begin(), rows_.end(), begin);
+    }
+    if (rows_.empty()) {
+      continue;
+    }
+
+    std::vector<VectorPtr> children;
+    children.reserve(outputColumns_.size());
+    for (auto i = 0; i < outputColumns_.size(); ++i) {
+      children.push_back(extractColumn(
+          outputColumns_[i], rows_, outputType_->childAt(i), pool_));
+    }
+    return std::make_shared<RowVector>(
+        pool_, outputType_, nullptr, rows_.size(), std::move(children));
+  }
+  split_ = nullptr;
+  outputColumns_.clear();
+  filterColumns_.clear();
+  return nullptr;
+}
+
+void ColumnarDataSource::addDynamicFilter(
+    column_index_t outputChannel,
+    const std::shared_ptr<common::Filter>& filter) {
+  const auto& handle = outputHandles_[outputChannel];
+  for (auto i = 0; i < filters_.size(); ++i) {
+    if (filters_[i].column->name() == handle->name()) {
+      filters_[i].filter = filters_[i].filter->mergeWith(filter.get());
+      return;
+    }
+  }
+  filters_.push_back({handle, filter});
+  // While the split is read from the source, setColumns() adds the column
+  // when the read is done.
+  if (split_ && !source_) {
+    filterColumns_.push_back(outputColumns_[outputChannel]);
+  }
+}
+
+std::unordered_map<std::string, RuntimeCounter>
+ColumnarDataSource::runtimeStats() {
+  return {
+      {"columnarCacheSplitHits", RuntimeCounter(numSplitHits_)},
+      {"columnarCacheSplitMisses", RuntimeCounter(numSplitMisses_)}};
+}
+
+// static
+std::string ColumnarCacheConnector::splitKey(
+    const std::string& tableName,
+    const ConnectorSplit& sourceSplit) {
+  return fmt::format("{}:{}", tableName, sourceSplit.toString());
+}
+
+ColumnarCacheConnector::ColumnarCacheConnector(
+    const std::string& id,
+    std::shared_ptr<const Config> properties,
+    folly::Executor* FOLLY_NULLABLE /*executor*/)
+    : Connector(id, properties),
+      cache_(std::make_unique<ColumnarCache>(
+          properties ? properties->get<uint64_t>(kMaxBytes, kDefaultMaxBytes)
+                     : kDefaultMaxBytes,
+          properties ? properties->get<std::string>(kSsdPath, "") : "")) {}
+
+VELOX_REGISTER_CONNECTOR_FACTORY(
+    std::make_shared<ColumnarCacheConnectorFactory>())
+
+} // namespace facebook::velox::connector::columnar
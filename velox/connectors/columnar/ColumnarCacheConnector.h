@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/columnar/ColumnarCache.h"
+
+namespace facebook::velox::connector::columnar {
+
+/// Column of a table cached by the columnar cache connector. 'sourceHandle'
+/// is the handle of the same column in the connector that populates the
+/// cache.
+class ColumnarColumnHandle : public ColumnHandle {
+ public:
+  ColumnarColumnHandle(
+      std::string name,
+      TypePtr type,
+      std::shared_ptr<ColumnHandle> sourceHandle)
+      : name_(std::move(name)),
+        type_(std::move(type)),
+        sourceHandle_(std::move(sourceHandle)) {}
+
+  const std::string& name() const {
+    return name_;
+  }
+
+  const TypePtr& type() const {
+    return type_;
+  }
+
+  const std::shared_ptr<ColumnHandle>& sourceHandle() const {
+    return sourceHandle_;
+  }
+
+ private:
+  const std::string name_;
+  const TypePtr type_;
+  const std::shared_ptr<ColumnHandle> sourceHandle_;
+};
+
+/// Filter on a column of a cached table. The filter is evaluated on the
+/// cached encoding of the column.
+struct ColumnarColumnFilter {
+  std::shared_ptr<ColumnarColumnHandle> column;
+  std::shared_ptr<common::Filter> filter;
+};
+
+/// Table cached by the columnar cache connector. A split missing from the
+/// cache is read with 'sourceTableHandle' from the connector with id
+/// 'sourceTableHandle->connectorId()'. 'sourceTableHandle' must not filter
+/// rows since the cached columns are shared by all scans of 'tableName'.
+/// Row filters go in 'filters' and are applied to the cached data.
+class ColumnarTableHandle : public ConnectorTableHandle {
+ public:
+  ColumnarTableHandle(
+      std::string connectorId,
+      std::string tableName,
+      std::shared_ptr<ConnectorTableHandle> sourceTableHandle,
+      std::vector<ColumnarColumnFilter> filters = {})
+      : ConnectorTableHandle(std::move(connectorId)),
+        tableName_(std::move(tableName)),
+        sourceTableHandle_(std::move(sourceTableHandle)),
+        filters_(std::move(filters)) {
+    VELOX_CHECK_NOT_NULL(sourceTableHandle_);
+  }
+
+  std::string toString() const override;
+
+  const std::string& tableName() const {
+    return tableName_;
+  }
+
+  const std::shared_ptr<ConnectorTableHandle>& sourceTableHandle() const {
+    return sourceTableHandle_;
+  }
+
+  const std::vector<ColumnarColumnFilter>& filters() const {
+    return filters_;
+  }
+
+ private:
+  const std::string tableName_;
+  const std::shared_ptr<ConnectorTableHandle> sourceTableHandle_;
+  const std::vector<ColumnarColumnFilter> filters_;
+};
+
+/// Split of a cached table. Wraps a split of the source connector.
+/// 'version' identifies the contents of the source split, e.g. the size and
+/// modification time of its file. Columns cached for another version of the
+/// same split are dropped and read again.
+struct ColumnarConnectorSplit : public ConnectorSplit {
+  ColumnarConnectorSplit(
+      const std::string& connectorId,
+      std::shared_ptr<ConnectorSplit> _sourceSplit,
+      std::string _version = "")
+      : ConnectorSplit(connectorId),
+        sourceSplit(std::move(_sourceSplit)),
+        version(std::move(_version)) {
+    VELOX_CHECK_NOT_NULL(sourceSplit);
+  }
+
+  std::string toString() const override {
+    return fmt::format(
+        "[columnar split: {}, version: {}]", sourceSplit->toString(), version);
+  }
+
+  const std::shared_ptr<ConnectorSplit> sourceSplit;
+  const std::string version;
+};
+
+class ColumnarDataSource : public DataSource {
+ public:
+  ColumnarDataSource(
+      const RowTypePtr& outputType,
+      const std::shared_ptr<ConnectorTableHandle>& tableHandle,
+      const std::unordered_map<
+          std::string,
+          std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+      ColumnarCache* cache,
+      ConnectorQueryCtx* connectorQueryCtx);
+
+  void addSplit(std::shared_ptr<ConnectorSplit> split) override;
+
+  std::optional<RowVectorPtr> next(uint64_t size, velox::ContinueFuture& future)
+      override;
+
+  void addDynamicFilter(
+      column_index_t outputChannel,
+      const std::shared_ptr<common::Filter>& filter) override;
+
+  uint64_t getCompletedBytes() override {
+    return completedBytes_;
+  }
+
+  uint64_t getCompletedRows() override {
+    return completedRows_;
+  }
+
+  std::unordered_map<std::string, RuntimeCounter> runtimeStats() override;
+
+ private:
+  // Looks up the columns of the current split in the cache. Starts reading
+  // the columns that are not cached from the source connector.
+  void loadColumns();
+
+  // Creates 'source_' for reading 'columns' of the current split from the
+  // source connector.
+  void startReadFromSource(
+      std::vector<std::shared_ptr<ColumnarColumnHandle>> columns);
+
+  // Reads from 'source_' until the split is done and adds the read columns to
+  // the cache. Returns false and sets 'future' if 'source_' has to wait
+  // before the split is done. Reading continues in the next call.
+  bool readFromSource(velox::ContinueFuture& future);
+
+  // Sets 'outputColumns_' and 'filterColumns_' for the current split from
+  // 'loaded_' and 'numRows_' to 'numRows'.
+  void setColumns(vector_size_t numRows);
+
+  const RowTypePtr outputType_;
+  std::shared_ptr<ColumnarTableHandle> tableHandle_;
+  ColumnarCache* const cache_;
+  ConnectorQueryCtx* const connectorQueryCtx_;
+  memory::MemoryPool* const pool_;
+
+  // Handle for each column of 'outputType_'.
+  std::vector<std::shared_ptr<ColumnarColumnHandle>> outputHandles_;
+
+  // Filters from the table handle and dynamic filters.
+  std::vector<ColumnarColumnFilter> filters_;
+
+  std::shared_ptr<ColumnarConnectorSplit> split_;
+  std::string splitKey_;
+  // Generation of the cached columns of the current split. See
+  // ColumnarCache::setVersion().
+  uint64_t generation_{0};
+
+  // Columns of the current split by name, while 'source_' reads the ones that
+  // are not cached.
+  folly::F14FastMap<std::string, VectorPtr> loaded_;
+
+  // Reads 'sourceColumns_' of the current split into 'sourceVectors_'. Set
+  // while the split is read from the source connector.
+  std::unique_ptr<DataSource> source_;
+  std::vector<std::shared_ptr<ColumnarColumnHandle>> sourceColumns_;
+  std::vector<VectorPtr> sourceVectors_;
+  vector_size_t sourceRows_{0};
+
+  // Cached columns of the current split for each output column and filter.
+  std::vector<VectorPtr> outputColumns_;
+  std::vector<VectorPtr> filterColumns_;
+
+  vector_size_t numRows_{0};
+  vector_size_t nextRow_{0};
+
+  // Rows passing the filters in the current batch and a temporary.
+  std::vector<vector_size_t> rows_;
+  std::vector<vector_size_t> passed_;
+
+  uint64_t completedRows_{0};
+  uint64_t completedBytes_{0};
+  uint64_t numSplitHits_{0};
+  uint64_t numSplitMisses_{0};
+};
+
+/// Connector that keeps the columns of repeatedly scanned tables in memory in
+/// a compact encoding. Scans of a cached split skip file IO and decoding.
+class ColumnarCacheConnector final : public Connector {
+ public:
+  /// Maximum bytes of cached columns kept in memory.
+  static constexpr const char* kMaxBytes = "columnar-cache.max-bytes";
+  /// Directory for columns evicted from memory. Evicted columns are dropped
+  /// if not set.
+  static constexpr const char* kSsdPath = "columnar-cache.ssd-path";
+
+  static constexpr uint64_t kDefaultMaxBytes = 1UL << 30;
+
+  ColumnarCacheConnector(
+      const std::string& id,
+      std::shared_ptr<const Config> properties,
+      folly::Executor* FOLLY_NULLABLE /*executor*/);
+
+  bool canAddDynamicFilter() const override {
+    return true;
+  }
+
+  std::unique_ptr<DataSource> createDataSource(
+      const RowTypePtr& outputType,
+      const std::shared_ptr<ConnectorTableHandle>& tableHandle,
+      const std::unordered_map<
+          std::string,
+          std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+      ConnectorQueryCtx* connectorQueryCtx) override final {
+    return std::make_unique<ColumnarDataSource>(
+        outputType,
+        tableHandle,
+        columnHandles,
+        cache_.get(),
+        connectorQueryCtx);
+  }
+
+  std::unique_ptr<DataSink> createDataSink(
+      RowTypePtr /*inputType*/,
+      std::shared_ptr<
+          ConnectorInsertTableHandle> /*connectorInsertTableHandle*/,
+      ConnectorQueryCtx* /*connectorQueryCtx*/,
+      CommitStrategy /*commitStrategy*/) override final {
+    VELOX_NYI("ColumnarCacheConnector does not support data sink.");
+  }
+
+  ColumnarCache& cache() const {
+    return *cache_;
+  }
+
+  /// Returns the key of the columns of 'sourceSplit' of 'tableName' in
+  /// cache().
+  static std::string splitKey(
+      const std::string& tableName,
+      const ConnectorSplit& sourceSplit);
+
+  /// Drops the cached columns of 'sourceSplit' of 'tableName'. Used when the
+  /// data of the split changes without a change of version.
+  void invalidate(
+      const std::string& tableName,
+      const ConnectorSplit& sourceSplit) {
+    cache_->invalidate(splitKey(tableName, sourceSplit));
+  }
+
+ private:
+  const std::unique_ptr<ColumnarCache> cache_;
+};
+
+class ColumnarCacheConnectorFactory : public ConnectorFactory {
+ public:
+  static constexpr const char* FOLLY_NONNULL kColumnarCacheConnectorName{
+      "columnar-cache"};
+
+  ColumnarCacheConnectorFactory()
+      : ConnectorFactory(kColumnarCacheConnectorName) {}
+
+  explicit ColumnarCacheConnectorFactory(
+      const char* FOLLY_NONNULL connectorName)
+      : ConnectorFactory(connectorName) {}
+
+  std::shared_ptr<Connector> newConnector(
+      const std::string& id,
+      std::shared_ptr<const Config> properties,
+      folly::Executor* FOLLY_NULLABLE executor = nullptr) override {
+    return std::make_shared<ColumnarCacheConnector>(id, properties, executor);
+  }
+};
+
+} // namespace facebook::velox::connector::columnar
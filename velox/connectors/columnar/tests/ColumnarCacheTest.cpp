@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/columnar/ColumnarCacheConnector.h"
+#include <gtest/gtest.h>
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+namespace facebook::velox::connector::columnar {
+namespace {
+
+using namespace facebook::velox::exec::test;
+
+class ColumnarCacheTest : public HiveConnectorTestBase {
+ protected:
+  const std::string kColumnarConnectorId = "test-columnar";
+
+  void TearDown() override {
+    unregisterConnector(kColumnarConnectorId);
+    HiveConnectorTestBase::TearDown();
+  }
+
+  std::shared_ptr<ColumnarCacheConnector> registerColumnarConnector(
+      std::unordered_map<std::string, std::string> config = {}) {
+    auto connector = getConnectorFactory(
+                         ColumnarCacheConnectorFactory::
+                             kColumnarCacheConnectorName)
+                         ->newConnector(
+                             kColumnarConnectorId,
+                             std::make_shared<core::MemConfig>(
+                                 std::move(config)));
+    registerConnector(connector);
+    return std::dynamic_pointer_cast<ColumnarCacheConnector>(connector);
+  }
+
+  std::unordered_map<std::string, std::shared_ptr<ColumnHandle>> assignments(
+      const RowTypePtr& rowType) {
+    std::unordered_map<std::string, std::shared_ptr<ColumnHandle>> result;
+    for (auto i = 0; i < rowType->size(); ++i) {
+      result[rowType->nameOf(i)] = columnHandle(rowType, i);
+    }
+    return result;
+  }
+
+  std::shared_ptr<ColumnarColumnHandle> columnHandle(
+      const RowTypePtr& rowType,
+      int32_t channel) {
+    const auto& name = rowType->nameOf(channel);
+    const auto& type = rowType->childAt(channel);
+    return std::make_shared<ColumnarColumnHandle>(
+        name, type, regularColumn(name, type));
+  }
+
+  std::vector<exec::Split> makeSplits(
+      const std::vector<std::shared_ptr<TempFilePath>>& filePaths,
+      const std::string& version = "") {
+    std::vector<exec::Split> splits;
+    for (const auto& filePath : filePaths) {
+      splits.emplace_back(std::make_shared<ColumnarConnectorSplit>(
+          kColumnarConnectorId,
+          makeHiveConnectorSplit(filePath->path),
+          version));
+    }
+    return splits;
+  }
+
+  // Checks filterColumn() and extractColumn() on 'column' against a row by
+  // row evaluation of 'filter' on the flat 'expected'.
+  void testFilter(
+      const VectorPtr& column,
+      const VectorPtr& expected,
+      const common::Filter& filter) {
+    std::vector<vector_size_t> passed;
+    filterColumn(*column, filter, 0, column->size(), nullptr, passed);
+    std::vector<vector_size_t> expectedPassed;
+    for (auto i = 0; i < expected->size(); ++i) {
+      if (expected->isNullAt(i)) {
+        if (filter.testNull()) {
+          expectedPassed.push_back(i);
+        }
+      } else if (
+          expected->typeKind() == TypeKind::VARCHAR
+              ? filter.testBytes(
+                    expected->asFlatVector<StringView>()->valueAt(i).data(),
+                    expected->asFlatVector<StringView>()->valueAt(i).size())
+              : filter.testInt64(expected->asFlatVector<int64_t>()->valueAt(
+                    i))) {
+        expectedPassed.push_back(i);
+      }
+    }
+    ASSERT_EQ(expectedPassed, passed);
+
+    auto result = extractColumn(column, passed, expected->type(), pool());
+    ASSERT_EQ(passed.size(), result->size());
+    for (auto i = 0; i < passed.size(); ++i) {
+      ASSERT_TRUE(result->equalValueAt(expected.get(), i, passed[i]));
+    }
+  }
+};
+
+TEST_F(ColumnarCacheTest, encodings) {
+  constexpr vector_size_t kSize = 1'000;
+
+  // Long runs become a sequence.
+  auto runs =
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row / 100; });
+  auto encoded = encodeColumn(runs, pool());
+  EXPECT_EQ(VectorEncoding::Simple::SEQUENCE, encoded->encoding());
+  testFilter(encoded, runs, common::BigintRange(2, 4, false));
+
+  // A narrow range of values becomes a bias vector.
+  auto narrow = makeFlatVector<int64_t>(
+      kSize, [](auto row) { return 1'000'000 + (row * 7) % 200; });
+  encoded = encodeColumn(narrow, pool());
+  EXPECT_EQ(VectorEncoding::Simple::BIASED, encoded->encoding());
+  testFilter(
+      encoded, narrow, common::BigintRange(1'000'010, 1'000'050, false));
+
+  // Few distinct strings become a dictionary.
+  auto strings = makeFlatVector<std::string>(
+      kSize,
+      [](auto row) { return fmt::format("string value {}", row % 13); },
+      nullEvery(11));
+  encoded = encodeColumn(strings, pool());
+  EXPECT_EQ(VectorEncoding::Simple::DICTIONARY, encoded->encoding());
+  testFilter(
+      encoded,
+      strings,
+      common::BytesValues({"string value 1", "string value 5"}, true));
+
+  // Unique wide values stay flat.
+  auto wide = makeFlatVector<int64_t>(
+      kSize, [](auto row) { return row * 1'000'000'007L; });
+  encoded = encodeColumn(wide, pool());
+  EXPECT_EQ(VectorEncoding::Simple::FLAT, encoded->encoding());
+  testFilter(encoded, wide, common::BigintRange(0, 100'000'000'000L, false));
+}
+
+TEST_F(ColumnarCacheTest, scan) {
+  auto rowType = ROW({"c0", "c1", "c2"}, {BIGINT(), BIGINT(), VARCHAR()});
+  auto filePaths = makeFilePaths(3);
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < filePaths.size(); ++i) {
+    vectors.push_back(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int64_t>(2'000, [&](auto row) { return i; }),
+         makeFlatVector<int64_t>(2'000, [](auto row) { return row % 50; }),
+         makeFlatVector<std::string>(
+             2'000, [](auto row) { return fmt::format("s{}", row % 7); })}));
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  auto connector = registerColumnarConnector();
+  auto tableHandle = std::make_shared<ColumnarTableHandle>(
+      kColumnarConnectorId,
+      "t",
+      makeTableHandle(),
+      std::vector<ColumnarColumnFilter>{
+          {columnHandle(rowType, 1),
+           std::make_shared<common::BigintRange>(10, 20, false)}});
+  auto plan = PlanBuilder()
+                  .tableScan(rowType, tableHandle, assignments(rowType))
+                  .planNode();
+
+  // The first scan reads from the files and fills the cache. The second scan
+  // is served from the cache.
+  for (auto i = 0; i < 2; ++i) {
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .splits(makeSplits(filePaths))
+        .assertResults("SELECT * FROM tmp WHERE c1 BETWEEN 10 AND 20");
+  }
+  auto stats = connector->cache().stats();
+  EXPECT_EQ(3 * rowType->size(), stats.numColumns);
+  EXPECT_EQ(3 * rowType->size(), stats.numHits);
+  EXPECT_LT(0, stats.memoryBytes);
+
+  // A projection of a subset of the cached columns.
+  auto projectedType = ROW({"c2"}, {VARCHAR()});
+  plan = PlanBuilder()
+             .tableScan(
+                 projectedType,
+                 std::make_shared<ColumnarTableHandle>(
+                     kColumnarConnectorId, "t", makeTableHandle()),
+                 assignments(projectedType))
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .splits(makeSplits(filePaths))
+      .assertResults("SELECT c2 FROM tmp");
+}
+
+TEST_F(ColumnarCacheTest, ssdEviction) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  auto filePaths = makeFilePaths(4);
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < filePaths.size(); ++i) {
+    vectors.push_back(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int64_t>(1'000, [&](auto row) { return row * i; }),
+         makeFlatVector<std::string>(1'000, [&](auto row) {
+           return fmt::format("a long string value {} {}", i, row % 20);
+         })}));
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  // The cache holds about one split so that scanning the others evicts it.
+  auto ssdDirectory = TempDirectoryPath::create();
+  auto connector = registerColumnarConnector(
+      {{ColumnarCacheConnector::kMaxBytes, "20000"},
+       {ColumnarCacheConnector::kSsdPath, ssdDirectory->path}});
+  auto plan = PlanBuilder()
+                  .tableScan(
+                      rowType,
+                      std::make_shared<ColumnarTableHandle>(
+                          kColumnarConnectorId, "t", makeTableHandle()),
+                      assignments(rowType))
+                  .planNode();
+  for (auto i = 0; i < 2; ++i) {
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .splits(makeSplits(filePaths))
+        .assertResults("SELECT * FROM tmp");
+  }
+  auto stats = connector->cache().stats();
+  EXPECT_LT(0, stats.numEvictions);
+  EXPECT_LT(0, stats.numSsdWrites);
+  EXPECT_LT(0, stats.numSsdReads);
+  EXPECT_LE(stats.memoryBytes, 20'000);
+
+  connector->cache().clear();
+  EXPECT_EQ(0, connector->cache().stats().numColumns);
+}
+
+TEST_F(ColumnarCacheTest, splitVersion) {
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  auto filePaths = makeFilePaths(1);
+  auto writeFile = [&](int64_t value) {
+    writeToFile(
+        filePaths[0]->path,
+        makeRowVector(
+            rowType->names(),
+            {makeFlatVector<int64_t>(100, [&](auto row) { return value; })}));
+    // Makes the source connector see the new file instead of the handle and
+    // data it cached for the old one.
+    asyncDataCache_->clear();
+    resetHiveConnector(std::make_shared<core::MemConfig>());
+  };
+  auto connector = registerColumnarConnector();
+  auto plan = PlanBuilder()
+                  .tableScan(
+                      rowType,
+                      std::make_shared<ColumnarTableHandle>(
+                          kColumnarConnectorId, "t", makeTableHandle()),
+                      assignments(rowType))
+                  .planNode();
+  auto assertSum = [&](const std::string& version, int64_t expected) {
+    auto result = AssertQueryBuilder(plan)
+                      .splits(makeSplits(filePaths, version))
+                      .copyResults(pool());
+    int64_t sum = 0;
+    for (auto i = 0; i < result->size(); ++i) {
+      sum += result->childAt(0)->asFlatVector<int64_t>()->valueAt(i);
+    }
+    EXPECT_EQ(expected, sum);
+  };
+
+  writeFile(1);
+  assertSum("1", 100);
+
+  // The same version is served from the cache even if the file changed.
+  writeFile(2);
+  assertSum("1", 100);
+  // A new version drops the stale columns.
+  assertSum("2", 200);
+  EXPECT_EQ(1, connector->cache().stats().numColumns);
+
+  // Invalidating the split makes the next scan read the file again.
+  writeFile(3);
+  connector->invalidate("t", *makeHiveConnectorSplit(filePaths[0]->path));
+  EXPECT_EQ(0, connector->cache().stats().numColumns);
+  assertSum("2", 300);
+}
+
+TEST_F(ColumnarCacheTest, staleInsert) {
+  ColumnarCache cache(1UL << 30);
+  auto column = makeFlatVector<int64_t>(100, [](auto row) { return row; });
+  const auto generation = cache.setVersion("split", "1");
+
+  // A column read before a version change is not cached.
+  cache.setVersion("split", "2");
+  cache.setNumRows("split", generation, column->size());
+  auto result = cache.insert("split", generation, "c0", column);
+  EXPECT_EQ(column->size(), result->size());
+  EXPECT_EQ(nullptr, cache.find("split", "c0"));
+  EXPECT_FALSE(cache.numRows("split").has_value());
+
+  // Nor is a column read before an invalidation.
+  const auto newGeneration = cache.setVersion("split", "2");
+  cache.invalidate("split");
+  cache.insert("split", newGeneration, "c0", column);
+  EXPECT_EQ(nullptr, cache.find("split", "c0"));
+  EXPECT_EQ(0, cache.stats().numColumns);
+}
+
+TEST_F(ColumnarCacheTest, reclaim) {
+  ColumnarCache cache(1UL << 30);
+  auto makeColumn = [&]() {
+    return makeFlatVector<int64_t>(
+        1'000, [](auto row) { return row * 1'000'000'007L; });
+  };
+  const auto generation = cache.setVersion("split", "");
+  cache.setNumRows("split", generation, 1'000);
+  // 'pinned' is in use as if by a scan of the split.
+  auto pinned = cache.insert("split", generation, "c0", makeColumn());
+  const auto unpinnedBytes =
+      cache.insert("split", generation, "c1", makeColumn())->retainedSize();
+
+  auto* rootPool = cache.pool()->root();
+  uint64_t reclaimableBytes;
+  ASSERT_TRUE(rootPool->reclaimableBytes(reclaimableBytes));
+  EXPECT_EQ(unpinnedBytes, reclaimableBytes);
+
+  // Reclaim evicts only the column that is not in use.
+  memory::MemoryReclaimer::Stats stats;
+  EXPECT_EQ(unpinnedBytes, rootPool->reclaim(0, stats));
+  EXPECT_EQ(1, cache.stats().numColumns);
+  EXPECT_EQ(1, cache.stats().numEvictions);
+  EXPECT_EQ(pinned, cache.find("split", "c0"));
+  ASSERT_TRUE(rootPool->reclaimableBytes(reclaimableBytes));
+  EXPECT_EQ(0, reclaimableBytes);
+
+  pinned.reset();
+  ASSERT_TRUE(rootPool->reclaimableBytes(reclaimableBytes));
+  EXPECT_LT(0, reclaimableBytes);
+  EXPECT_EQ(reclaimableBytes, rootPool->reclaim(0, stats));
+  EXPECT_EQ(0, cache.stats().numColumns);
+}
+
+TEST_F(ColumnarCacheTest, dynamicFilter) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  auto filePaths = makeFilePaths(2);
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < filePaths.size(); ++i) {
+    vectors.push_back(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 100; }),
+         makeFlatVector<std::string>(1'000, [&](auto row) {
+           return fmt::format("a long string value {} {}", i, row);
+         })}));
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+  createDuckDbTable("t", vectors);
+  std::vector<RowVectorPtr> buildVectors = {makeRowVector(
+      {"u0"}, {makeFlatVector<int64_t>({3, 17, 42, 1'000})})};
+  createDuckDbTable("u", buildVectors);
+
+  registerColumnarConnector();
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId scanNodeId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .tableScan(
+                      rowType,
+                      std::make_shared<ColumnarTableHandle>(
+                          kColumnarConnectorId, "t", makeTableHandle()),
+                      assignments(rowType))
+                  .capturePlanNodeId(scanNodeId)
+                  .hashJoin(
+                      {"c0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors)
+                          .planNode(),
+                      "",
+                      {"c0", "c1"})
+                  .planNode();
+
+  // The first scan reads from the files and the second from the cache. Both
+  // apply the join keys as a filter on the cached 'c0'.
+  for (auto i = 0; i < 2; ++i) {
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .splits(scanNodeId, makeSplits(filePaths))
+            .assertResults("SELECT c0, c1 FROM t, u WHERE c0 = u0");
+    auto scanStats = exec::toPlanStats(task->taskStats()).at(scanNodeId);
+    EXPECT_EQ(1, scanStats.customStats.at("dynamicFiltersAccepted").sum);
+    EXPECT_LT(scanStats.outputRows, 1'000 * filePaths.size());
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::connector::columnar
@@ -18,6 +18,7 @@
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/process/TraceContext.h"
 #include "velox/common/time/Timer.h"
 
 #include <atomic>
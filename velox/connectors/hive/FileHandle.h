@@ -19,9 +19,9 @@
 // we open a file we might build a hash map saying what region(s) on disk
 // correspond to a given column in a given stripe.
 //
-// The FileHandle will normally be used in conjunction with a CachedFactory
-// to speed up queries that hit the same files repeatedly; see the
-// FileHandleCache and FileHandleFactory.
+// The FileHandle will normally be used in conjunction with a
+// ShardedCachedFactory to speed up queries that hit the same files
+// repeatedly; see the FileHandleFactory.
 
 #pragma once
 
@@ -29,8 +29,8 @@
 #include <memory>
 #include <string>
 
-#include "velox/common/caching/CachedFactory.h"
 #include "velox/common/caching/FileIds.h"
+#include "velox/common/caching/ShardedCachedFactory.h"
 #include "velox/common/file/File.h"
 #include "velox/dwio/common/InputStream.h"
 
@@ -59,9 +59,8 @@ struct FileHandle {
   // first diff we'll not include the map.
 };
 
-using FileHandleCache = SimpleLRUCache<std::string, FileHandle>;
-
-// Creates FileHandles via the Generator interface the CachedFactory requires.
+// Creates FileHandles via the Generator interface the ShardedCachedFactory
+// requires.
 class FileHandleGenerator {
  public:
   FileHandleGenerator() {}
@@ -73,7 +72,9 @@ class FileHandleGenerator {
   const std::shared_ptr<const Config> properties_;
 };
 
-using FileHandleFactory = CachedFactory<
+// Opens of different files do not contend and concurrent opens of the same
+// file share one FileHandle.
+using FileHandleFactory = ShardedCachedFactory<
     std::string,
     std::shared_ptr<FileHandle>,
     FileHandleGenerator>;
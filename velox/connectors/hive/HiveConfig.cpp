@@ -66,6 +66,11 @@ uint32_t HiveConfig::maxPartitionsPerWriters(const Config* config) {
   return config->get<uint32_t>(kMaxPartitionsPerWriters, 100);
 }
 
+// static
+uint64_t HiveConfig::sortWriterMaxBufferedBytes(const Config* config) {
+  return config->get<uint64_t>(kSortWriterMaxBufferedBytes, 256UL << 20);
+}
+
 // static
 bool HiveConfig::immutablePartitions(const Config* config) {
   return config->get<bool>(kImmutablePartitions, false);
@@ -165,4 +170,9 @@ int32_t HiveConfig::numCacheFileHandles(const Config* config) {
   return config->get<int32_t>(kNumCacheFileHandles, 20'000);
 }
 
+// static.
+bool HiveConfig::isPreserveStringDictionary(const Config* config) {
+  return config->get<bool>(kPreserveStringDictionary, false);
+}
+
 } // namespace facebook::velox::connector::hive
@@ -44,6 +44,13 @@ class HiveConfig {
   static constexpr const char* kMaxPartitionsPerWriters =
       "max_partitions_per_writers";
 
+  /// Maximum bytes of rows buffered for sorting across all the open writers
+  /// of a sorted bucketed table. When exceeded, the writers buffering the most
+  /// rows write them to disk as sorted runs. The runs of a writer are merged
+  /// when it is closed. Only applies if spilling is enabled.
+  static constexpr const char* kSortWriterMaxBufferedBytes =
+      "sort_writer_max_buffered_bytes";
+
   /// Whether new data can be inserted into an unpartition table.
   /// Velox currently does not support appending data to existing partitions.
   static constexpr const char* kImmutablePartitions =
@@ -107,11 +114,19 @@ class HiveConfig {
   /// Maximum number of entries in the file handle cache.
   static constexpr const char* kNumCacheFileHandles = "num_cached_file_handles";
 
+  /// Return string columns that are dictionary encoded in the file as
+  /// dictionary vectors, even when few rows pass the filters. All batches read
+  /// from one file dictionary then share the same dictionary base.
+  static constexpr const char* kPreserveStringDictionary =
+      "preserve_string_dictionary";
+
   static InsertExistingPartitionsBehavior insertExistingPartitionsBehavior(
       const Config* config);
 
   static uint32_t maxPartitionsPerWriters(const Config* config);
 
+  static uint64_t sortWriterMaxBufferedBytes(const Config* config);
+
   static bool immutablePartitions(const Config* config);
 
   static bool s3UseVirtualAddressing(const Config* config);
@@ -147,6 +162,8 @@ class HiveConfig {
   static int32_t maxCoalescedDistanceBytes(const Config* config);
 
   static int32_t numCacheFileHandles(const Config* config);
+
+  static bool isPreserveStringDictionary(const Config* config);
 };
 
 } // namespace facebook::velox::connector::hive
@@ -58,9 +58,7 @@ HiveConnector::HiveConnector(
     folly::Executor* FOLLY_NULLABLE executor)
     : Connector(id, properties),
       fileHandleFactory_(
-          std::make_unique<
-              SimpleLRUCache<std::string, std::shared_ptr<FileHandle>>>(
-              numCachedFileHandles(properties.get())),
+          numCachedFileHandles(properties.get()),
           std::make_unique<FileHandleGenerator>(properties)),
       executor_(executor) {
   LOG(INFO) << "Hive connector " << connectorId() << " created with maximum of "
@@ -85,6 +83,8 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
           connectorQueryCtx->config()));
   options.setUseColumnNamesForColumnMapping(
       HiveConfig::isOrcUseColumnNames(connectorQueryCtx->config()));
+  options.setPreserveStringDictionary(
+      HiveConfig::isPreserveStringDictionary(connectorQueryCtx->config()));
 
   return std::make_unique<HiveDataSource>(
       outputType,
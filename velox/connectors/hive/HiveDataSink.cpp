@@ -302,7 +302,9 @@ HiveDataSink::HiveDataSink(
                        : nullptr),
       writerFactory_(dwio::common::getWriterFactory(
           insertTableHandle_->tableStorageFormat())),
-      spillConfig_(connectorQueryCtx->getSpillConfig()) {
+      spillConfig_(connectorQueryCtx->getSpillConfig()),
+      sortWriterMaxBufferedBytes_(HiveConfig::sortWriterMaxBufferedBytes(
+          connectorQueryCtx_->config())) {
   VELOX_USER_CHECK(
       !isBucketed() || isPartitioned(), "A bucket table must be partitioned");
   if (isBucketed()) {
@@ -377,6 +379,32 @@ void HiveDataSink::appendData(RowVectorPtr input) {
     writers_[index]->write(writerInput);
     writerInfo_[index]->numWrittenRows += partitionSize;
   }
+  maybeSpillSortingWriters();
+}
+
+void HiveDataSink::maybeSpillSortingWriters() {
+  if (sortingWriters_.empty() || spillConfig_ == nullptr) {
+    return;
+  }
+  uint64_t totalBytes{0};
+  std::vector<std::pair<uint64_t, uint32_t>> writerBytes;
+  writerBytes.reserve(sortingWriters_.size());
+  for (auto i = 0; i < sortingWriters_.size(); ++i) {
+    const auto bytes = sortingWriters_[i]->bufferedBytes();
+    totalBytes += bytes;
+    writerBytes.emplace_back(bytes, i);
+  }
+  if (totalBytes <= sortWriterMaxBufferedBytes_) {
+    return;
+  }
+  std::sort(writerBytes.begin(), writerBytes.end(), std::greater<>());
+  for (const auto& [bytes, index] : writerBytes) {
+    if (totalBytes <= sortWriterMaxBufferedBytes_ / 2 || bytes == 0) {
+      break;
+    }
+    sortingWriters_[index]->spill();
+    totalBytes -= bytes;
+  }
 }
 
 void HiveDataSink::computePartitionAndBucketIds(const RowVectorPtr& input) {
@@ -453,6 +481,8 @@ void HiveDataSink::closeInternal(bool abort) {
     return;
   }
 
+  // Closed or aborted writers have no buffered rows to spill.
+  sortingWriters_.clear();
   if (!abort) {
     closed_ = true;
     for (const auto& writer : writers_) {
@@ -536,8 +566,10 @@ HiveDataSink::maybeCreateBucketSortWriter(
       &nonReclaimableSection_,
       &numSpillRuns_,
       spillConfig_);
-  return std::make_unique<dwio::common::SortingWriter>(
+  auto sortingWriter = std::make_unique<dwio::common::SortingWriter>(
       std::move(writer), std::move(sortBuffer));
+  sortingWriters_.push_back(sortingWriter.get());
+  return sortingWriter;
 }
 
 void HiveDataSink::splitInputRowsAndEnsureWriters() {
@@ -26,6 +26,10 @@ namespace facebook::velox::dwrf {
 class Writer;
 }
 
+namespace facebook::velox::dwio::common {
+class SortingWriter;
+}
+
 namespace facebook::velox::connector::hive {
 class HiveColumnHandle;
 
@@ -442,6 +446,11 @@ class HiveDataSink : public DataSink {
   maybeCreateBucketSortWriter(
       std::unique_ptr<facebook::velox::dwio::common::Writer> writer);
 
+  // Spills the sorting writers buffering the most rows if the rows buffered
+  // by all of them exceed 'sortWriterMaxBufferedBytes_'. Spills until half of
+  // the budget is left so that each spill writes a sizable sorted run.
+  void maybeSpillSortingWriters();
+
   HiveWriterParameters getWriterParameters(
       const std::optional<std::string>& partition,
       std::optional<uint32_t> bucketId) const;
@@ -485,6 +494,7 @@ class HiveDataSink : public DataSink {
   const std::unique_ptr<core::PartitionFunction> bucketFunction_;
   const std::shared_ptr<dwio::common::WriterFactory> writerFactory_;
   const common::SpillConfig* const spillConfig_;
+  const uint64_t sortWriterMaxBufferedBytes_;
 
   std::vector<column_index_t> sortColumnIndices_;
   std::vector<CompareFlags> sortCompareFlags_;
@@ -503,6 +513,9 @@ class HiveDataSink : public DataSink {
   // writers_ are both indexed by partitionId.
   std::vector<std::shared_ptr<HiveWriterInfo>> writerInfo_;
   std::vector<std::unique_ptr<dwio::common::Writer>> writers_;
+  // The sorting writers in 'writers_' if the table is sorted. Cleared on close
+  // or abort.
+  std::vector<dwio::common::SortingWriter*> sortingWriters_;
   // IO statistics collected for each writer.
   std::vector<std::shared_ptr<io::IoStatistics>> ioStats_;
 
@@ -390,6 +390,15 @@ const std::string& getColumnName(const common::Subfield& subfield) {
   return field->name();
 }
 
+// Makes the readers of 'spec' and its descendants return string dictionaries
+// as dictionary vectors.
+void setPreserveDictionary(common::ScanSpec& spec) {
+  spec.setPreserveDictionary(true);
+  for (auto& child : spec.children()) {
+    setPreserveDictionary(*child);
+  }
+}
+
 } // namespace
 
 core::TypedExprPtr HiveDataSource::extractFiltersFromRemainingFilter(
@@ -586,6 +595,9 @@ HiveDataSource::HiveDataSource(
       filters,
       hiveTableHandle->dataColumns(),
       pool_);
+  if (readerOpts_.isPreserveStringDictionary()) {
+    setPreserveDictionary(*scanSpec_);
+  }
   if (remainingFilter) {
     metadataFilter_ = std::make_shared<common::MetadataFilter>(
         *scanSpec_, *remainingFilter, expressionEvaluator_);
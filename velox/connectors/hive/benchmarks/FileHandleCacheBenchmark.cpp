@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <random>
+#include <thread>
+
+#include "velox/common/caching/CachedFactory.h"
+#include "velox/connectors/hive/FileHandle.h"
+
+DEFINE_int32(num_threads, 64, "Number of threads adding splits");
+DEFINE_int32(num_files, 10'000, "Number of distinct files in the splits");
+DEFINE_int32(splits_per_thread, 10'000, "Number of splits added per thread");
+
+using namespace facebook::velox;
+
+// Simulates the split churn of table scans: many threads add splits, each
+// getting the FileHandle of the split's file from the cache. The files are
+// not opened, so that the time goes to the caches and the file id map.
+namespace {
+
+// Makes FileHandles without a file. Takes the file ids like
+// FileHandleGenerator.
+struct FakeFileHandleGenerator {
+  std::shared_ptr<FileHandle> operator()(const std::string& filename) {
+    auto fileHandle = std::make_shared<FileHandle>();
+    fileHandle->uuid = StringIdLease(fileIds(), filename);
+    fileHandle->groupId =
+        StringIdLease(fileIds(), filename.substr(0, filename.rfind('/')));
+    return fileHandle;
+  }
+};
+
+// The single lock CachedFactory that FileHandleFactory used before.
+using LockedFactory = CachedFactory<
+    std::string,
+    std::shared_ptr<FileHandle>,
+    FakeFileHandleGenerator>;
+
+using ShardedFactory = ShardedCachedFactory<
+    std::string,
+    std::shared_ptr<FileHandle>,
+    FakeFileHandleGenerator>;
+
+std::vector<std::string> makeFileNames() {
+  std::vector<std::string> names;
+  names.reserve(FLAGS_num_files);
+  for (auto i = 0; i < FLAGS_num_files; ++i) {
+    names.push_back(fmt::format(
+        "hdfs://warehouse/table/ds=2023-01-{:02}/file_{}", i % 30, i));
+  }
+  return names;
+}
+
+// Adds 'FLAGS_splits_per_thread' splits on each of 'FLAGS_num_threads'
+// threads. A split gets the handle of a random file, leases its id as the
+// cache entries of a split do and looks up the id by name as the data cache
+// does. Returns the number of splits.
+template <typename Factory>
+int64_t addSplits(Factory& factory, const std::vector<std::string>& names) {
+  std::vector<std::thread> threads;
+  threads.reserve(FLAGS_num_threads);
+  for (auto i = 0; i < FLAGS_num_threads; ++i) {
+    threads.emplace_back([&, i]() {
+      std::mt19937 rng(i);
+      for (auto j = 0; j < FLAGS_splits_per_thread; ++j) {
+        const auto& name = names[rng() % names.size()];
+        auto fileHandle = factory.generate(name).second;
+        StringIdLease lease(fileIds(), fileHandle->uuid.id());
+        folly::doNotOptimizeAway(fileIds().id(name));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return static_cast<int64_t>(FLAGS_num_threads) * FLAGS_splits_per_thread;
+}
+
+std::unique_ptr<LockedFactory> makeLockedFactory(size_t size) {
+  return std::make_unique<LockedFactory>(
+      std::make_unique<
+          SimpleLRUCache<std::string, std::shared_ptr<FileHandle>>>(size),
+      std::make_unique<FakeFileHandleGenerator>());
+}
+
+std::unique_ptr<ShardedFactory> makeShardedFactory(size_t size) {
+  return std::make_unique<ShardedFactory>(
+      size, std::make_unique<FakeFileHandleGenerator>());
+}
+
+std::vector<std::string> fileNames;
+
+} // namespace
+
+// All files fit in the cache.
+BENCHMARK_MULTI(lockedHits) {
+  auto factory = makeLockedFactory(FLAGS_num_files);
+  return addSplits(*factory, fileNames);
+}
+
+BENCHMARK_RELATIVE_MULTI(shardedHits) {
+  auto factory = makeShardedFactory(FLAGS_num_files);
+  return addSplits(*factory, fileNames);
+}
+
+BENCHMARK_DRAW_LINE();
+
+// The cache holds a tenth of the files, so that most splits evict a handle
+// and make a new one.
+BENCHMARK_MULTI(lockedChurn) {
+  auto factory = makeLockedFactory(FLAGS_num_files / 10);
+  return addSplits(*factory, fileNames);
+}
+
+BENCHMARK_RELATIVE_MULTI(shardedChurn) {
+  auto factory = makeShardedFactory(FLAGS_num_files / 10);
+  return addSplits(*factory, fileNames);
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  fileNames = makeFileNames();
+  folly::runBenchmarks();
+  return 0;
+}
@@ -71,9 +71,7 @@ TEST_F(S3FileSystemRegistrationTest, fileHandle) {
   }
   auto hiveConfig = minioServer_->hiveConfig();
   FileHandleFactory factory(
-      std::make_unique<
-          SimpleLRUCache<std::string, std::shared_ptr<FileHandle>>>(1000),
-      std::make_unique<FileHandleGenerator>(hiveConfig));
+      1000, std::make_unique<FileHandleGenerator>(hiveConfig));
   auto fileHandle = factory.generate(s3File).second;
   readData(fileHandle->file.get());
 }
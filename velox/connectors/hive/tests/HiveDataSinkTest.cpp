@@ -20,8 +20,10 @@
 #include <folly/init/Init.h>
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/core/Config.h"
 #include "velox/dwio/common/Options.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
@@ -484,6 +486,107 @@ TEST_F(HiveDataSinkTest, abort) {
         "Hive data sink hash been aborted");
   }
 }
+
+TEST_F(HiveDataSinkTest, sortedBucketedWriteWithSpill) {
+  const auto outputDirectory = TempDirectoryPath::create();
+  const auto spillDirectory = TempDirectoryPath::create();
+  const common::SpillConfig spillConfig(
+      spillDirectory->path + "/spill",
+      0,
+      0,
+      0,
+      nullptr,
+      5,
+      10,
+      0,
+      0,
+      0,
+      false,
+      0,
+      0,
+      "none");
+  // Spills the sorting writers after every input batch.
+  const auto config = std::make_shared<core::MemConfig>(
+      std::unordered_map<std::string, std::string>{
+          {HiveConfig::kSortWriterMaxBufferedBytes, "1"}});
+  auto connectorQueryCtx = std::make_unique<connector::ConnectorQueryCtx>(
+      opPool_.get(),
+      connectorPool_.get(),
+      nullptr,
+      config.get(),
+      &spillConfig,
+      nullptr,
+      nullptr,
+      "query.HiveDataSinkTest",
+      "task.HiveDataSinkTest",
+      "planNodeId.HiveDataSinkTest",
+      0);
+
+  const int32_t bucketCount = 4;
+  auto bucketProperty = std::make_shared<HiveBucketProperty>(
+      HiveBucketProperty::Kind::kHiveCompatible,
+      bucketCount,
+      std::vector<std::string>{"c0"},
+      std::vector<TypePtr>{BIGINT()},
+      std::vector<std::shared_ptr<const HiveSortingColumn>>{
+          std::make_shared<HiveSortingColumn>(
+              "c1", core::SortOrder{true, false})});
+  auto dataSink = std::make_shared<HiveDataSink>(
+      rowType_,
+      makeHiveInsertTableHandle(
+          rowType_->names(),
+          rowType_->children(),
+          {"c2"},
+          bucketProperty,
+          makeLocationHandle(outputDirectory->path)),
+      connectorQueryCtx.get(),
+      CommitStrategy::kNoCommit,
+      connectorConfig_);
+
+  const int numBatches = 10;
+  const vector_size_t batchSize = 500;
+  std::vector<RowVectorPtr> vectors;
+  for (int i = 0; i < numBatches; ++i) {
+    vectors.push_back(makeRowVector(
+        rowType_->names(),
+        {makeFlatVector<int64_t>(
+             batchSize, [&](auto row) { return i * batchSize + row; }),
+         makeFlatVector<int32_t>(
+             batchSize, [&](auto row) { return (row * 7919 + i) % 1000; }),
+         makeFlatVector<int16_t>(batchSize, [](auto row) { return row % 2; }),
+         makeFlatVector<float>(batchSize, [](auto row) { return row; }),
+         makeFlatVector<double>(batchSize, [](auto row) { return row; }),
+         makeFlatVector<std::string>(batchSize, [](auto row) {
+           return fmt::format("string {}", row);
+         })}));
+    dataSink->appendData(vectors.back());
+  }
+  // The sorted runs are on disk until the writers merge them on close.
+  ASSERT_FALSE(listFiles(spillDirectory->path).empty());
+  const auto results = dataSink->close(true);
+  ASSERT_EQ(results.size(), 2 * bucketCount);
+
+  createDuckDbTable(vectors);
+  const auto filePaths = listFiles(outputDirectory->path);
+  ASSERT_EQ(filePaths.size(), 2 * bucketCount);
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  for (const auto& filePath : filePaths) {
+    auto result =
+        AssertQueryBuilder(PlanBuilder().tableScan(rowType_).planNode())
+            .split(makeHiveConnectorSplit(filePath))
+            .copyResults(pool());
+    auto sortColumn = result->childAt(1)->asFlatVector<int32_t>();
+    for (auto row = 1; row < result->size(); ++row) {
+      ASSERT_LE(sortColumn->valueAt(row - 1), sortColumn->valueAt(row));
+    }
+    splits.push_back(makeHiveConnectorSplit(filePath));
+  }
+  AssertQueryBuilder(
+      PlanBuilder().tableScan(rowType_).planNode(), duckDbQueryRunner_)
+      .splits(splits)
+      .assertResults("SELECT * FROM tmp");
+}
+
 } // namespace
 } // namespace facebook::velox::connector::hive
 
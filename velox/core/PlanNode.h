@@ -1564,6 +1564,10 @@ class MergeJoinNode : public AbstractJoinNode {
     return "MergeJoin";
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.joinSpillEnabled();
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -1607,6 +1611,10 @@ class NestedLoopJoinNode : public PlanNode {
     return "NestedLoopJoin";
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.joinSpillEnabled();
+  }
+
   const TypedExprPtr& joinCondition() const {
     return joinCondition_;
   }
@@ -92,6 +92,13 @@ class QueryConfig {
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// Whether to sample the threads running the Drivers of the query and
+  /// attribute the samples to operator methods and expressions. The samples
+  /// are returned by Task::foldedProfile() and summarized per operator in the
+  /// 'profileSamples' runtime stats. False by default.
+  static constexpr const char* kOperatorProfilingEnabled =
+      "operator_profiling_enabled";
+
   /// Flags used to configure the CAST operator:
 
   /// This flag makes the Row conversion to by applied in a way that the casting
@@ -140,6 +147,29 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// If true, a partial aggregation that is abandoned keeps aggregating the
+  /// few grouping keys that account for a large share of its input and only
+  /// passes the other rows through.
+  static constexpr const char* kAbandonPartialAggregationKeepHeavyHitters =
+      "abandon_partial_aggregation_keep_heavy_hitters";
+
+  /// If true, a final aggregation running with more than one driver per task
+  /// splits its groups into hash ranges shared by all the drivers. Each
+  /// driver adds its input to the ranges the groups fall in and produces the
+  /// output of a subset of the ranges. This removes the need for a local
+  /// repartition before the aggregation.
+  static constexpr const char* kPartitionedAggregationEnabled =
+      "partitioned_aggregation_enabled";
+
+  /// If true, the aggregations over distinct inputs keep the distinct
+  /// (grouping keys, inputs) pairs in one hash table per list of inputs
+  /// instead of one set per group and feed the new pairs to the aggregate
+  /// functions as the input arrives. Always used if spilling is enabled, since
+  /// the per group sets cannot be spilled. The hash table is not spilled
+  /// either and stays in memory until the aggregation finishes.
+  static constexpr const char* kHashDistinctAggregationEnabled =
+      "hash_distinct_aggregation_enabled";
+
   static constexpr const char* kMaxPartitionedOutputBufferSize =
       "max_page_partitioning_buffer_size";
 
@@ -195,6 +225,17 @@ class QueryConfig {
   static constexpr const char* kJoinSpillMemoryThreshold =
       "join_spill_memory_threshold";
 
+  /// The max memory that a merge join can use to buffer the right side rows
+  /// with the same join keys before spilling them. If it 0, then there is no
+  /// limit.
+  static constexpr const char* kMergeJoinSpillMemoryThreshold =
+      "merge_join_spill_memory_threshold";
+
+  /// The max memory that a nested loop join can use to buffer the build side
+  /// before spilling it. If it 0, then there is no limit.
+  static constexpr const char* kNestedLoopJoinSpillMemoryThreshold =
+      "nested_loop_join_spill_memory_threshold";
+
   /// The max memory that an order by can use before spilling. If it 0, then
   /// there is no limit.
   static constexpr const char* kOrderBySpillMemoryThreshold =
@@ -211,6 +252,16 @@ class QueryConfig {
   /// io and cpu resources.
   static constexpr const char* kMaxSpillLevel = "max_spill_level";
 
+  /// The min percentage of the rows of a hash join spill partition that share
+  /// the most frequent join key hash for the partition to be considered
+  /// skewed. Recursive spilling can't split the rows of a join key, so a
+  /// skewed partition that doesn't fit in memory is built in chunks instead:
+  /// the probe side probes each chunk with all its rows of the partition.
+  /// This only applies for inner, right and right semi filter joins. If it is
+  /// zero, then skewed partitions are not detected.
+  static constexpr const char* kJoinSpillSkewedKeyPct =
+      "join_spill_skewed_key_pct";
+
   /// The max allowed spill file size. If it is zero, then there is no limit.
   static constexpr const char* kMaxSpillFileSize = "max_spill_file_size";
 
@@ -292,6 +343,11 @@ class QueryConfig {
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// Priority of the query's Drivers when run by an exec::DriverScheduler.
+  /// Queued Drivers of a higher priority query run before the queued Drivers
+  /// of lower priority queries that have used about the same CPU time.
+  static constexpr const char* kQueryPriority = "query_priority";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -331,6 +387,18 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  bool abandonPartialAggregationKeepHeavyHitters() const {
+    return get<bool>(kAbandonPartialAggregationKeepHeavyHitters, false);
+  }
+
+  bool partitionedAggregationEnabled() const {
+    return get<bool>(kPartitionedAggregationEnabled, false);
+  }
+
+  bool hashDistinctAggregationEnabled() const {
+    return get<bool>(kHashDistinctAggregationEnabled, false);
+  }
+
   uint64_t aggregationSpillMemoryThreshold() const {
     static constexpr uint64_t kDefault = 0;
     return get<uint64_t>(kAggregationSpillMemoryThreshold, kDefault);
@@ -341,6 +409,16 @@ class QueryConfig {
     return get<uint64_t>(kJoinSpillMemoryThreshold, kDefault);
   }
 
+  uint64_t mergeJoinSpillMemoryThreshold() const {
+    static constexpr uint64_t kDefault = 0;
+    return get<uint64_t>(kMergeJoinSpillMemoryThreshold, kDefault);
+  }
+
+  uint64_t nestedLoopJoinSpillMemoryThreshold() const {
+    static constexpr uint64_t kDefault = 0;
+    return get<uint64_t>(kNestedLoopJoinSpillMemoryThreshold, kDefault);
+  }
+
   uint64_t orderBySpillMemoryThreshold() const {
     static constexpr uint64_t kDefault = 0;
     return get<uint64_t>(kOrderBySpillMemoryThreshold, kDefault);
@@ -465,6 +543,10 @@ class QueryConfig {
     return get<int32_t>(kMaxSpillLevel, 4);
   }
 
+  int32_t joinSpillSkewedKeyPct() const {
+    return get<int32_t>(kJoinSpillSkewedKeyPct, 0);
+  }
+
   /// Returns the start partition bit which is used with
   /// 'kJoinSpillPartitionBits' or 'kAggregationSpillPartitionBits' together to
   /// calculate the spilling partition number for join spill or aggregation
@@ -582,6 +664,10 @@ class QueryConfig {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  bool operatorProfilingEnabled() const {
+    return get<bool>(kOperatorProfilingEnabled, false);
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -599,6 +685,10 @@ class QueryConfig {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  int32_t queryPriority() const {
+    return get<int32_t>(kQueryPriority, 0);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
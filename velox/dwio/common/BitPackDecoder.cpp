@@ -295,6 +295,150 @@ void unpack(
   }
 }
 
+namespace {
+
+// Returns the 'kWidth' bit field that starts 'shift' bits below the most
+// significant bit of the big endian word at 'word'. Reads 8 bytes and for
+// widths over 56 bits one more byte if the field extends past the word.
+template <uint8_t kWidth>
+FOLLY_ALWAYS_INLINE uint64_t
+loadBigEndianField(const uint8_t* word, int32_t shift) {
+  uint64_t value =
+      __builtin_bswap64(*reinterpret_cast<const uint64_t*>(word)) << shift;
+  if constexpr (kWidth > 56) {
+    if (shift + kWidth > 64) {
+      value |= word[8] >> (8 - shift);
+    }
+  }
+  return value >> (64 - kWidth);
+}
+
+template <uint8_t kWidth>
+void unpackBigEndian(
+    const uint8_t* inputBits,
+    uint64_t inputBufferLen,
+    uint64_t numValues,
+    uint64_t* result) {
+  uint64_t i = 0;
+  // Number of leading fields whose loads stay inside the buffer.
+  uint64_t numSafe = inputBufferLen < 16
+      ? 0
+      : std::min<uint64_t>(numValues, (inputBufferLen - 16) * 8 / kWidth);
+  // Process 8 fields a time. The positions repeat every kWidth bytes, so the
+  // shifts are constants after unrolling.
+  for (; i + 8 <= numSafe; i += 8) {
+    for (int32_t j = 0; j < 8; ++j) {
+      const int32_t bit = j * kWidth;
+      result[i + j] =
+          loadBigEndianField<kWidth>(inputBits + (bit >> 3), bit & 7);
+    }
+    inputBits += kWidth;
+  }
+  if (i == numValues) {
+    return;
+  }
+  // Decode the tail from a zero padded copy. The tail is under 10 + 128 /
+  // kWidth fields, so it fits with the slack for the last loads.
+  uint8_t padded[2 * kWidth + 32] = {};
+  std::memcpy(
+      padded,
+      inputBits,
+      std::min<uint64_t>(
+          inputBufferLen - (i / 8) * kWidth,
+          bits::roundUp((numValues - i) * kWidth, 8) / 8));
+  for (uint64_t j = 0; i < numValues; ++i, ++j) {
+    const uint64_t bit = j * kWidth;
+    result[i] = loadBigEndianField<kWidth>(padded + (bit >> 3), bit & 7);
+  }
+}
+
+#define BIG_ENDIAN_CASE(width)                                            \
+  case width:                                                             \
+    unpackBigEndian<width>(inputBits, inputBufferLen, numValues, result); \
+    break;
+
+} // namespace
+
+void unpackBigEndian(
+    const uint8_t* inputBits,
+    uint64_t inputBufferLen,
+    uint64_t numValues,
+    uint8_t bitWidth,
+    uint64_t* result) {
+  VELOX_DCHECK(bitWidth >= 1 && bitWidth <= 64);
+  VELOX_DCHECK_GE(inputBufferLen * 8, bitWidth * numValues);
+  switch (bitWidth) {
+    BIG_ENDIAN_CASE(1);
+    BIG_ENDIAN_CASE(2);
+    BIG_ENDIAN_CASE(3);
+    BIG_ENDIAN_CASE(4);
+    BIG_ENDIAN_CASE(5);
+    BIG_ENDIAN_CASE(6);
+    BIG_ENDIAN_CASE(7);
+    BIG_ENDIAN_CASE(8);
+    BIG_ENDIAN_CASE(9);
+    BIG_ENDIAN_CASE(10);
+    BIG_ENDIAN_CASE(11);
+    BIG_ENDIAN_CASE(12);
+    BIG_ENDIAN_CASE(13);
+    BIG_ENDIAN_CASE(14);
+    BIG_ENDIAN_CASE(15);
+    BIG_ENDIAN_CASE(16);
+    BIG_ENDIAN_CASE(17);
+    BIG_ENDIAN_CASE(18);
+    BIG_ENDIAN_CASE(19);
+    BIG_ENDIAN_CASE(20);
+    BIG_ENDIAN_CASE(21);
+    BIG_ENDIAN_CASE(22);
+    BIG_ENDIAN_CASE(23);
+    BIG_ENDIAN_CASE(24);
+    BIG_ENDIAN_CASE(25);
+    BIG_ENDIAN_CASE(26);
+    BIG_ENDIAN_CASE(27);
+    BIG_ENDIAN_CASE(28);
+    BIG_ENDIAN_CASE(29);
+    BIG_ENDIAN_CASE(30);
+    BIG_ENDIAN_CASE(31);
+    BIG_ENDIAN_CASE(32);
+    BIG_ENDIAN_CASE(33);
+    BIG_ENDIAN_CASE(34);
+    BIG_ENDIAN_CASE(35);
+    BIG_ENDIAN_CASE(36);
+    BIG_ENDIAN_CASE(37);
+    BIG_ENDIAN_CASE(38);
+    BIG_ENDIAN_CASE(39);
+    BIG_ENDIAN_CASE(40);
+    BIG_ENDIAN_CASE(41);
+    BIG_ENDIAN_CASE(42);
+    BIG_ENDIAN_CASE(43);
+    BIG_ENDIAN_CASE(44);
+    BIG_ENDIAN_CASE(45);
+    BIG_ENDIAN_CASE(46);
+    BIG_ENDIAN_CASE(47);
+    BIG_ENDIAN_CASE(48);
+    BIG_ENDIAN_CASE(49);
+    BIG_ENDIAN_CASE(50);
+    BIG_ENDIAN_CASE(51);
+    BIG_ENDIAN_CASE(52);
+    BIG_ENDIAN_CASE(53);
+    BIG_ENDIAN_CASE(54);
+    BIG_ENDIAN_CASE(55);
+    BIG_ENDIAN_CASE(56);
+    BIG_ENDIAN_CASE(57);
+    BIG_ENDIAN_CASE(58);
+    BIG_ENDIAN_CASE(59);
+    BIG_ENDIAN_CASE(60);
+    BIG_ENDIAN_CASE(61);
+    BIG_ENDIAN_CASE(62);
+    BIG_ENDIAN_CASE(63);
+    BIG_ENDIAN_CASE(64);
+    default:
+      VELOX_UNREACHABLE("invalid bitWidth");
+  }
+}
+
+#undef BIG_ENDIAN_CASE
+
 template void unpack(
     const uint64_t* bits,
     int32_t bitOffset,
@@ -150,6 +150,26 @@ inline void unpack<uint32_t>(
     uint8_t bitWidth,
     uint32_t* FOLLY_NONNULL& result);
 
+template <>
+inline void unpack<uint64_t>(
+    const uint8_t* FOLLY_NONNULL& inputBits,
+    uint64_t inputBufferLen,
+    uint64_t numValues,
+    uint8_t bitWidth,
+    uint64_t* FOLLY_NONNULL& result);
+
+/// Unpacks 'numValues' bit fields of 'bitWidth' bits each into 'result'. The
+/// fields are packed most significant bit first, starting at the most
+/// significant bit of the first byte of 'inputBits', as in the ORC/DWRF RLEv2
+/// encodings. 'inputBufferLen' is the number of addressable bytes starting at
+/// 'inputBits'. 'bitWidth' is in [1, 64].
+void unpackBigEndian(
+    const uint8_t* FOLLY_NONNULL inputBits,
+    uint64_t inputBufferLen,
+    uint64_t numValues,
+    uint8_t bitWidth,
+    uint64_t* FOLLY_NONNULL result);
+
 // The function definitions are put here to make sure they are inlined. Moving
 // them to the .cpp file may result in 10x regression.
 
@@ -789,6 +809,181 @@ inline void unpack<uint32_t>(
 #endif
 }
 
+// Unpacks 8 values of 'kWidth' bits from 'inputBuffer' into 'outputBuffer'.
+// Reads at most kWidth + 8 bytes from 'inputBuffer'.
+template <uint8_t kWidth>
+FOLLY_ALWAYS_INLINE void unpack8Values64(
+    const uint8_t* FOLLY_NONNULL inputBuffer,
+    uint64_t* FOLLY_NONNULL outputBuffer) {
+#if XSIMD_WITH_AVX2
+  if constexpr (kWidth <= 8) {
+    // Deposit the 8 fields into 8 bytes and widen these to 8 x 64 bits.
+    uint64_t bytes = _pdep_u64(
+        *reinterpret_cast<const uint64_t*>(inputBuffer), kPdepMask8[kWidth]);
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(outputBuffer),
+        _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(static_cast<int32_t>(bytes))));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(outputBuffer + 4),
+        _mm256_cvtepu8_epi64(
+            _mm_cvtsi32_si128(static_cast<int32_t>(bytes >> 32))));
+    return;
+  } else if constexpr (kWidth <= 16) {
+    // Deposit 2 x 4 fields into 2 x 4 uint16_t's and widen to 8 x 64 bits.
+    // With kWidth <= 16 four fields plus the bit offset of the second half
+    // always fit in one 64 bit load.
+    constexpr int32_t kSecondBit = 4 * kWidth;
+    uint64_t first = _pdep_u64(
+        *reinterpret_cast<const uint64_t*>(inputBuffer), kPdepMask16[kWidth]);
+    uint64_t second = _pdep_u64(
+        *reinterpret_cast<const uint64_t*>(inputBuffer + kSecondBit / 8) >>
+            (kSecondBit & 7),
+        kPdepMask16[kWidth]);
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(outputBuffer),
+        _mm256_cvtepu16_epi64(_mm_cvtsi64_si128(first)));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(outputBuffer + 4),
+        _mm256_cvtepu16_epi64(_mm_cvtsi64_si128(second)));
+    return;
+  }
+#endif
+  constexpr uint64_t kMask = kWidth == 64 ? ~0UL : bits::lowMask(kWidth);
+  for (int32_t i = 0; i < 8; ++i) {
+    // 'bit' and 'shift' are constants after unrolling.
+    const int32_t bit = i * kWidth;
+    const int32_t shift = bit & 7;
+    const uint8_t* word = inputBuffer + (bit >> 3);
+    uint64_t value = *reinterpret_cast<const uint64_t*>(word) >> shift;
+    if constexpr (kWidth > 56) {
+      if (shift + kWidth > 64) {
+        value |= static_cast<uint64_t>(word[8]) << (64 - shift);
+      }
+    }
+    outputBuffer[i] = value & kMask;
+  }
+}
+
+// Unpacks numValues number of uint64_t values of 'kWidth' bits, 8 at a time.
+// The last values that are closer than kWidth + 8 bytes to the end of the
+// input are unpacked from a zero padded copy so as not to read past the end.
+template <uint8_t kWidth>
+inline void unpack64(
+    const uint8_t* FOLLY_NONNULL& inputBuffer,
+    uint64_t inputBufferLen,
+    uint64_t numValues,
+    uint64_t* FOLLY_NONNULL& outputBuffer) {
+  auto writeEndOffset = outputBuffer + numValues;
+  auto readEndOffset = inputBuffer + inputBufferLen;
+  while (outputBuffer + 8 <= writeEndOffset &&
+         inputBuffer + kWidth + 8 <= readEndOffset) {
+    unpack8Values64<kWidth>(inputBuffer, outputBuffer);
+    inputBuffer += kWidth;
+    outputBuffer += 8;
+  }
+
+  while (outputBuffer < writeEndOffset) {
+    uint8_t padded[kWidth + 8] = {};
+    uint64_t values[8];
+    std::memcpy(
+        padded,
+        inputBuffer,
+        std::min<uint64_t>(kWidth, readEndOffset - inputBuffer));
+    unpack8Values64<kWidth>(padded, values);
+    auto numLeft = std::min<uint64_t>(8, writeEndOffset - outputBuffer);
+    std::memcpy(outputBuffer, values, numLeft * sizeof(uint64_t));
+    inputBuffer += bits::roundUp(numLeft * kWidth, 8) / 8;
+    outputBuffer += numLeft;
+  }
+}
+
+#define VELOX_UNPACK64_CASE(width)                                 \
+  case width:                                                      \
+    unpack64<width>(inputBits, inputBufferLen, numValues, result); \
+    break;
+
+template <>
+inline void unpack<uint64_t>(
+    const uint8_t* FOLLY_NONNULL& inputBits,
+    uint64_t inputBufferLen,
+    uint64_t numValues,
+    uint8_t bitWidth,
+    uint64_t* FOLLY_NONNULL& result) {
+  VELOX_CHECK(bitWidth >= 1 && bitWidth <= 64);
+  VELOX_CHECK(inputBufferLen * 8 >= bitWidth * numValues);
+
+  switch (bitWidth) {
+    VELOX_UNPACK64_CASE(1)
+    VELOX_UNPACK64_CASE(2)
+    VELOX_UNPACK64_CASE(3)
+    VELOX_UNPACK64_CASE(4)
+    VELOX_UNPACK64_CASE(5)
+    VELOX_UNPACK64_CASE(6)
+    VELOX_UNPACK64_CASE(7)
+    VELOX_UNPACK64_CASE(8)
+    VELOX_UNPACK64_CASE(9)
+    VELOX_UNPACK64_CASE(10)
+    VELOX_UNPACK64_CASE(11)
+    VELOX_UNPACK64_CASE(12)
+    VELOX_UNPACK64_CASE(13)
+    VELOX_UNPACK64_CASE(14)
+    VELOX_UNPACK64_CASE(15)
+    VELOX_UNPACK64_CASE(16)
+    VELOX_UNPACK64_CASE(17)
+    VELOX_UNPACK64_CASE(18)
+    VELOX_UNPACK64_CASE(19)
+    VELOX_UNPACK64_CASE(20)
+    VELOX_UNPACK64_CASE(21)
+    VELOX_UNPACK64_CASE(22)
+    VELOX_UNPACK64_CASE(23)
+    VELOX_UNPACK64_CASE(24)
+    VELOX_UNPACK64_CASE(25)
+    VELOX_UNPACK64_CASE(26)
+    VELOX_UNPACK64_CASE(27)
+    VELOX_UNPACK64_CASE(28)
+    VELOX_UNPACK64_CASE(29)
+    VELOX_UNPACK64_CASE(30)
+    VELOX_UNPACK64_CASE(31)
+    VELOX_UNPACK64_CASE(32)
+    VELOX_UNPACK64_CASE(33)
+    VELOX_UNPACK64_CASE(34)
+    VELOX_UNPACK64_CASE(35)
+    VELOX_UNPACK64_CASE(36)
+    VELOX_UNPACK64_CASE(37)
+    VELOX_UNPACK64_CASE(38)
+    VELOX_UNPACK64_CASE(39)
+    VELOX_UNPACK64_CASE(40)
+    VELOX_UNPACK64_CASE(41)
+    VELOX_UNPACK64_CASE(42)
+    VELOX_UNPACK64_CASE(43)
+    VELOX_UNPACK64_CASE(44)
+    VELOX_UNPACK64_CASE(45)
+    VELOX_UNPACK64_CASE(46)
+    VELOX_UNPACK64_CASE(47)
+    VELOX_UNPACK64_CASE(48)
+    VELOX_UNPACK64_CASE(49)
+    VELOX_UNPACK64_CASE(50)
+    VELOX_UNPACK64_CASE(51)
+    VELOX_UNPACK64_CASE(52)
+    VELOX_UNPACK64_CASE(53)
+    VELOX_UNPACK64_CASE(54)
+    VELOX_UNPACK64_CASE(55)
+    VELOX_UNPACK64_CASE(56)
+    VELOX_UNPACK64_CASE(57)
+    VELOX_UNPACK64_CASE(58)
+    VELOX_UNPACK64_CASE(59)
+    VELOX_UNPACK64_CASE(60)
+    VELOX_UNPACK64_CASE(61)
+    VELOX_UNPACK64_CASE(62)
+    VELOX_UNPACK64_CASE(63)
+    VELOX_UNPACK64_CASE(64)
+    default:
+      VELOX_UNREACHABLE("invalid bitWidth");
+  }
+}
+
+#undef VELOX_UNPACK64_CASE
+
 // Loads a bit field from 'ptr' + bitOffset for up to 'bitWidth' bits. makes
 // sure not to access bytes past lastSafeWord + 7. The definition is put here
 // because it's inlined.
@@ -126,6 +126,25 @@ void CacheInputStream::seekToPosition(PositionProvider& seekPosition) {
   position_ = seekPosition.next();
 }
 
+namespace {
+// Keeps a cache entry pinned for the lifetime of a BufferView over its data.
+struct CachePinReleaser {
+  explicit CachePinReleaser(const cache::CachePin& pin) : pin(pin) {}
+  void addRef() const {}
+  void release() const {}
+
+  cache::CachePin pin;
+};
+} // namespace
+
+BufferPtr CacheInputStream::currentBufferOwner() {
+  if (pin_.empty() || !run_) {
+    return nullptr;
+  }
+  return BufferView<CachePinReleaser>::create(
+      run_, runSize_, CachePinReleaser(pin_));
+}
+
 std::string CacheInputStream::getName() const {
   return fmt::format("CacheInputStream {} of {}", position_, region_.length);
 }
@@ -358,6 +358,7 @@ class ReaderOptions : public io::ReaderOptions {
   uint64_t filePreloadThreshold{kDefaultFilePreloadThreshold};
   bool fileColumnNamesReadAsLowerCase{false};
   bool useColumnNamesForColumnMapping_{false};
+  bool preserveStringDictionary_{false};
   std::shared_ptr<folly::Executor> ioExecutor_;
 
  public:
@@ -386,6 +387,7 @@ class ReaderOptions : public io::ReaderOptions {
     filePreloadThreshold = other.filePreloadThreshold;
     fileColumnNamesReadAsLowerCase = other.fileColumnNamesReadAsLowerCase;
     useColumnNamesForColumnMapping_ = other.useColumnNamesForColumnMapping_;
+    preserveStringDictionary_ = other.preserveStringDictionary_;
     return *this;
   }
 
@@ -399,7 +401,8 @@ class ReaderOptions : public io::ReaderOptions {
         directorySizeGuess(other.directorySizeGuess),
         filePreloadThreshold(other.filePreloadThreshold),
         fileColumnNamesReadAsLowerCase(other.fileColumnNamesReadAsLowerCase),
-        useColumnNamesForColumnMapping_(other.useColumnNamesForColumnMapping_) {
+        useColumnNamesForColumnMapping_(other.useColumnNamesForColumnMapping_),
+        preserveStringDictionary_(other.preserveStringDictionary_) {
   }
 
   /**
@@ -464,6 +467,13 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Set whether string dictionaries in the file are returned as dictionary
+  /// vectors regardless of selectivity. See ScanSpec::setPreserveDictionary().
+  ReaderOptions& setPreserveStringDictionary(bool flag) {
+    preserveStringDictionary_ = flag;
+    return *this;
+  }
+
   ReaderOptions& setIOExecutor(std::shared_ptr<folly::Executor> executor) {
     ioExecutor_ = std::move(executor);
     return *this;
@@ -523,6 +533,10 @@ class ReaderOptions : public io::ReaderOptions {
   bool isUseColumnNamesForColumnMapping() const {
     return useColumnNamesForColumnMapping_;
   }
+
+  bool isPreserveStringDictionary() const {
+    return preserveStringDictionary_;
+  }
 };
 
 struct WriterOptions {
@@ -29,6 +29,7 @@ ScanSpec& ScanSpec::operator=(const ScanSpec& other) {
     projectOut_ = other.projectOut_;
     extractValues_ = other.extractValues_;
     makeFlat_ = other.makeFlat_;
+    preserveDictionary_ = other.preserveDictionary_;
     filter_ = other.filter_;
     metadataFilters_ = other.metadataFilters_;
     selectivity_ = other.selectivity_;
@@ -256,6 +256,19 @@ class ScanSpec {
     makeFlat_ = makeFlat;
   }
 
+  bool preserveDictionary() const {
+    return preserveDictionary_;
+  }
+
+  // Requests that a string dictionary in this field always be returned as a
+  // DictionaryVector, even when few rows pass the filters. The dictionary
+  // base stays the same vector for all batches that use the same file
+  // dictionary, so that consumers can cache results per distinct value.
+  // 'makeFlat' takes precedence.
+  void setPreserveDictionary(bool preserveDictionary) {
+    preserveDictionary_ = preserveDictionary;
+  }
+
   // True if this or a descendant has a filter that will affect the number of
   // output rows.  Note that filter on map keys and array indices is not
   // counted, as they do not change the number of container output rows.
@@ -354,6 +367,9 @@ class ScanSpec {
   // True if a string dictionary or flat map in this field should be
   // returned as flat.
   bool makeFlat_ = false;
+  // True if a string dictionary in this field should be returned as a
+  // dictionary regardless of selectivity.
+  bool preserveDictionary_ = false;
   std::shared_ptr<common::Filter> filter_;
 
   // Filters that will be only used for row group filtering based on metadata.
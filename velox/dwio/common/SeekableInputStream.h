@@ -57,6 +57,13 @@ class SeekableInputStream : public google::protobuf::io::ZeroCopyInputStream {
   // ORC/DWRF stream address.
   virtual size_t positionSize() = 0;
 
+  // Returns a Buffer that keeps the bytes returned by the last Next() valid
+  // after 'this' moves on, or nullptr if the bytes may be overwritten or
+  // freed. Readers can hold this to refer to the bytes without copying.
+  virtual BufferPtr currentBufferOwner() {
+    return nullptr;
+  }
+
   void readFully(char* buffer, size_t bufferSize);
 };
 
@@ -283,6 +283,26 @@ class SelectiveColumnReader {
     anyNulls_ = true;
   }
 
+  // Lets string values in ['start', 'end') be returned without copying if
+  // 'mayUseStreamBuffer_' is set. 'buffer' keeps the range valid and is added
+  // to the string buffers of the result when a value in the range is
+  // returned. A nullptr 'buffer' makes all values be copied.
+  void setStreamBuffer(BufferPtr buffer, const char* start, const char* end) {
+    if (!mayUseStreamBuffer_ || !buffer) {
+      start = nullptr;
+      end = nullptr;
+      buffer = nullptr;
+    }
+    if (buffer == streamBuffer_ && start == streamBufferStart_ &&
+        end == streamBufferEnd_) {
+      return;
+    }
+    streamBuffer_ = std::move(buffer);
+    streamBufferStart_ = start;
+    streamBufferEnd_ = end;
+    streamBufferInUse_ = false;
+  }
+
   void setAllNull() {
     allNull_ = true;
   }
@@ -503,6 +523,29 @@ class SelectiveColumnReader {
 
   void addStringValue(folly::StringPiece value);
 
+  // Returns true if 'value' is in the range given to setStreamBuffer(), so that
+  // the result can refer to it without a copy. Adds the stream buffer to
+  // 'stringBuffers_' on first use after the last getValues().
+  bool useStreamBuffer(folly::StringPiece value) {
+    if (value.begin() < streamBufferStart_ || value.end() > streamBufferEnd_) {
+      return false;
+    }
+    if (!streamBufferInUse_) {
+      stringBuffers_.push_back(streamBuffer_);
+      streamBufferInUse_ = true;
+    }
+    return true;
+  }
+
+  // Clears the state for appending to 'stringBuffers_' after these have been
+  // moved to a result vector.
+  void resetStringBuffers() {
+    rawStringBuffer_ = nullptr;
+    rawStringSize_ = 0;
+    rawStringUsed_ = 0;
+    streamBufferInUse_ = false;
+  }
+
   // Copies 'value' to buffers owned by 'this' and returns the start of the
   // copy.
   char* FOLLY_NONNULL copyStringValue(folly::StringPiece value);
@@ -625,6 +668,13 @@ class SelectiveColumnReader {
   int32_t rawStringSize_ = 0;
   // Number of written bytes in 'rawStringBuffer_'.
   uint32_t rawStringUsed_ = 0;
+  // Stream data that string values may refer to without copying. See
+  // setStreamBuffer().
+  BufferPtr streamBuffer_;
+  const char* FOLLY_NULLABLE streamBufferStart_ = nullptr;
+  const char* FOLLY_NULLABLE streamBufferEnd_ = nullptr;
+  // True if 'streamBuffer_' is in 'stringBuffers_'.
+  bool streamBufferInUse_ = false;
 
   // True if last read() added any nulls.
   bool anyNulls_ = false;
@@ -646,6 +696,11 @@ inline void SelectiveColumnReader::addValue(const folly::StringPiece value) {
         StringView(value.data(), size);
     return;
   }
+  if (useStreamBuffer(value)) {
+    reinterpret_cast<StringView*>(rawValues_)[numValues_++] =
+        StringView(value.data(), size);
+    return;
+  }
   if (rawStringBuffer_ && rawStringUsed_ + size <= rawStringSize_) {
     memcpy(rawStringBuffer_ + rawStringUsed_, value.data(), size);
     reinterpret_cast<StringView*>(rawValues_)[numValues_++] =
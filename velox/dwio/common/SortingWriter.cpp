@@ -36,9 +36,21 @@ void SortingWriter::close() {
     outputWriter_->write(output);
     output = sortBuffer_->getOutput();
   }
+  sortBuffer_.reset();
   outputWriter_->close();
 }
 
+uint64_t SortingWriter::bufferedBytes() const {
+  return sortBuffer_ == nullptr ? 0 : sortBuffer_->bufferedBytes();
+}
+
+void SortingWriter::spill() {
+  if (sortBuffer_ == nullptr) {
+    return;
+  }
+  sortBuffer_->spill(0, 0);
+}
+
 void SortingWriter::abort() {
   sortBuffer_.reset();
   outputWriter_->abort();
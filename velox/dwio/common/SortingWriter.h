@@ -38,6 +38,15 @@ class SortingWriter : public Writer {
 
   virtual void abort() override;
 
+  /// Returns the bytes of memory held by the rows buffered for sorting. 0
+  /// after close() or abort().
+  uint64_t bufferedBytes() const;
+
+  /// Writes all the buffered rows to disk as a sorted run. The runs are
+  /// merged with the rows buffered afterwards on close(). Requires spilling to
+  /// be enabled in 'sortBuffer_'. No-op after close() or abort().
+  void spill();
+
   const std::unique_ptr<Writer> outputWriter_;
   std::unique_ptr<exec::SortBuffer> sortBuffer_;
 };
@@ -225,6 +225,14 @@ std::vector<std::vector<uint64_t>> bitPackedData;
 std::vector<uint8_t> result8;
 std::vector<uint16_t> result16;
 std::vector<uint32_t> result32;
+std::vector<uint64_t> result64;
+
+// Array of bit packed representations of randomInts_u64. The array at index
+// i is packed i bits wide, little endian as in Parquet.
+std::vector<std::vector<uint64_t>> bitPackedData64;
+
+// Same as bitPackedData64 but packed most significant bit first as in ORC.
+std::vector<std::vector<uint8_t>> bitPackedDataBigEndian;
 
 std::vector<int32_t> allRowNumbers;
 std::vector<int32_t> oddRowNumbers;
@@ -283,6 +291,47 @@ void veloxBitUnpack(uint8_t bitWidth, T* result) {
       inputIter, BYTES(kNumValues, bitWidth), kNumValues, bitWidth, result);
 }
 
+void veloxBitUnpack64(uint8_t bitWidth, uint64_t* result) {
+  const uint8_t* inputIter =
+      reinterpret_cast<const uint8_t*>(bitPackedData64[bitWidth].data());
+  facebook::velox::dwio::common::unpack<uint64_t>(
+      inputIter, BYTES(kNumValues, bitWidth), kNumValues, bitWidth, result);
+}
+
+void veloxBitUnpackBigEndian(uint8_t bitWidth, uint64_t* result) {
+  facebook::velox::dwio::common::unpackBigEndian(
+      bitPackedDataBigEndian[bitWidth].data(),
+      BYTES(kNumValues, bitWidth),
+      kNumValues,
+      bitWidth,
+      result);
+}
+
+// Bit at a time reading of big endian bit fields as in the original
+// RleDecoderV2::readLongs.
+void naiveBitUnpackBigEndian(uint8_t bitWidth, uint64_t* result) {
+  auto input = bitPackedDataBigEndian[bitWidth].data();
+  uint32_t bitsLeft = 0;
+  uint32_t curByte = 0;
+  for (auto i = 0; i < kNumValues; ++i) {
+    uint64_t value = 0;
+    uint64_t bitsLeftToRead = bitWidth;
+    while (bitsLeftToRead > bitsLeft) {
+      value <<= bitsLeft;
+      value |= curByte & ((1 << bitsLeft) - 1);
+      bitsLeftToRead -= bitsLeft;
+      curByte = *input++;
+      bitsLeft = 8;
+    }
+    if (bitsLeftToRead > 0) {
+      value <<= bitsLeftToRead;
+      bitsLeft -= bitsLeftToRead;
+      value |= (curByte >> bitsLeft) & ((1 << bitsLeftToRead) - 1);
+    }
+    result[i] = value;
+  }
+}
+
 template <typename T>
 void fastpforlib(uint8_t bitWidth, T* result) {
   uint64_t numBatches = kNumValues / 32;
@@ -313,6 +362,13 @@ void arrowBitUnpack(uint8_t bitWidth, T* result) {
   bitReader.GetBatch<T>(bitWidth, result, kNumValues);
 }
 
+void arrowBitUnpack64(uint8_t bitWidth, uint64_t* result) {
+  arrow::bit_util::BitReader bitReader(
+      reinterpret_cast<const uint8_t*>(bitPackedData64[bitWidth].data()),
+      BYTES(kNumValues, bitWidth));
+  bitReader.GetBatch<uint64_t>(bitWidth, result, kNumValues);
+}
+
 template <typename T>
 void duckdbBitUnpack(uint8_t bitWidth, T* result) {
   duckdb::ByteBuffer duckInputBuffer(
@@ -389,6 +445,21 @@ void duckdbBitUnpack(uint8_t bitWidth, T* result) {
   }                                                               \
   BENCHMARK_DRAW_LINE();
 
+#define BENCHMARK_UNPACK_FULLROWS_CASE_64(width)                      \
+  BENCHMARK(velox_unpack_fullrows_##width##_64) {                     \
+    veloxBitUnpack64(width, result64.data());                         \
+  }                                                                   \
+  BENCHMARK_RELATIVE(arrow_unpack_fullrows_##width##_64) {            \
+    arrowBitUnpack64(width, result64.data());                         \
+  }                                                                   \
+  BENCHMARK(velox_unpack_big_endian_fullrows_##width##_64) {          \
+    veloxBitUnpackBigEndian(width, result64.data());                  \
+  }                                                                   \
+  BENCHMARK_RELATIVE(naive_unpack_big_endian_fullrows_##width##_64) { \
+    naiveBitUnpackBigEndian(width, result64.data());                  \
+  }                                                                   \
+  BENCHMARK_DRAW_LINE();
+
 #define BENCHMARK_UNPACK_ODDROWS_CASE_8(width)                  \
   BENCHMARK_RELATIVE(legacy_unpack_naive_oddrows_##width##_8) { \
     legacyUnpackNaive<uint8_t>(oddRows, width, result8.data()); \
@@ -469,6 +540,73 @@ BENCHMARK_UNPACK_FULLROWS_CASE_32(32)
 
 BENCHMARK_DRAW_LINE();
 
+BENCHMARK_UNPACK_FULLROWS_CASE_64(1)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(2)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(3)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(4)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(5)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(6)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(7)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(8)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(9)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(10)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(11)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(12)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(13)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(14)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(15)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(16)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(17)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(18)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(19)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(20)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(21)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(22)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(23)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(24)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(25)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(26)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(27)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(28)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(29)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(30)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(31)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(32)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(33)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(34)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(35)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(36)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(37)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(38)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(39)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(40)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(41)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(42)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(43)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(44)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(45)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(46)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(47)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(48)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(49)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(50)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(51)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(52)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(53)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(54)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(55)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(56)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(57)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(58)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(59)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(60)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(61)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(62)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(63)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(64)
+
+BENCHMARK_DRAW_LINE();
+
 BENCHMARK_UNPACK_ODDROWS_CASE_8(1)
 BENCHMARK_UNPACK_ODDROWS_CASE_8(2)
 BENCHMARK_UNPACK_ODDROWS_CASE_8(4)
@@ -511,6 +649,26 @@ void populateBitPacked() {
     }
   }
 
+  bitPackedData64.resize(65);
+  bitPackedDataBigEndian.resize(65);
+  for (auto bitWidth = 1; bitWidth <= 64; ++bitWidth) {
+    auto numWords = bits::roundUp(randomInts_u64.size() * bitWidth, 64) / 64;
+    bitPackedData64[bitWidth].resize(numWords);
+    bitPackedDataBigEndian[bitWidth].resize(numWords * 8);
+    auto destination = bitPackedData64[bitWidth].data();
+    auto bigEndian = bitPackedDataBigEndian[bitWidth].data();
+    for (auto i = 0; i < randomInts_u64.size(); ++i) {
+      bits::copyBits(
+          randomInts_u64.data(), i * 64, destination, i * bitWidth, bitWidth);
+      for (auto bit = 0; bit < bitWidth; ++bit) {
+        if ((randomInts_u64[i] >> (bitWidth - bit - 1)) & 1) {
+          auto position = i * bitWidth + bit;
+          bigEndian[position / 8] |= 1 << (7 - position % 8);
+        }
+      }
+    }
+  }
+
   allRowNumbers.resize(randomInts_u32.size());
   std::iota(allRowNumbers.begin(), allRowNumbers.end(), 0);
 
@@ -599,6 +757,7 @@ int32_t main(int32_t argc, char* argv[]) {
   for (int32_t i = 0; i < kNumValues; i++) {
     auto randomInt = folly::Random::rand32();
     randomInts_u32.push_back(randomInt);
+    randomInts_u64.push_back(folly::Random::rand64());
   }
   randomInts_u32_result.resize(randomInts_u32.size());
 
@@ -607,6 +766,7 @@ int32_t main(int32_t argc, char* argv[]) {
   result8.resize(randomInts_u32.size());
   result16.resize(randomInts_u32.size());
   result32.resize(randomInts_u32.size());
+  result64.resize(randomInts_u64.size());
 
   randomInts_u64_result.resize(randomInts_u64.size());
 
@@ -172,3 +172,54 @@ TEST_F(BitPackDecoderTest, uint32AllRows) {
     testUnpack<uint32_t>(width);
   }
 }
+
+TEST_F(BitPackDecoderTest, uint64AllRows) {
+  auto numValues = randomInts_.size();
+  for (auto bitWidth = 1; bitWidth <= 64; ++bitWidth) {
+    std::vector<uint64_t> packed(
+        bits::roundUp(numValues * bitWidth, 64) / 64 + 1);
+    for (auto i = 0; i < numValues; ++i) {
+      bits::copyBits(
+          randomInts_.data(), i * 64, packed.data(), i * bitWidth, bitWidth);
+    }
+    std::vector<uint64_t> result(numValues);
+    const uint8_t* inputIter = reinterpret_cast<const uint8_t*>(packed.data());
+    uint64_t* outputIter = result.data();
+    unpack<uint64_t>(
+        inputIter, bytes(numValues, bitWidth), numValues, bitWidth, outputIter);
+    EXPECT_EQ(outputIter, result.data() + numValues);
+
+    uint64_t mask = bitWidth == 64 ? ~0UL : bits::lowMask(bitWidth);
+    for (auto i = 0; i < numValues; ++i) {
+      ASSERT_EQ(randomInts_[i] & mask, result[i])
+          << " at " << i << " with bitWidth " << bitWidth;
+    }
+  }
+}
+
+TEST_F(BitPackDecoderTest, bigEndian) {
+  for (auto bitWidth = 1; bitWidth <= 64; ++bitWidth) {
+    for (auto numValues : {1, 7, 8, 9, 100, 1001}) {
+      // Pack most significant bit first into a buffer of exactly the needed
+      // size.
+      std::vector<uint8_t> packed(bytes(numValues, bitWidth));
+      uint64_t mask = bitWidth == 64 ? ~0UL : bits::lowMask(bitWidth);
+      for (auto i = 0; i < numValues; ++i) {
+        auto value = randomInts_[i] & mask;
+        for (auto bit = 0; bit < bitWidth; ++bit) {
+          if ((value >> (bitWidth - bit - 1)) & 1) {
+            auto position = i * bitWidth + bit;
+            packed[position / 8] |= 1 << (7 - position % 8);
+          }
+        }
+      }
+      std::vector<uint64_t> result(numValues);
+      unpackBigEndian(
+          packed.data(), packed.size(), numValues, bitWidth, result.data());
+      for (auto i = 0; i < numValues; ++i) {
+        ASSERT_EQ(randomInts_[i] & mask, result[i])
+            << " at " << i << " with bitWidth " << bitWidth;
+      }
+    }
+  }
+}
@@ -19,6 +19,7 @@
 #include "velox/common/base/Nulls.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/Adaptor.h"
+#include "velox/dwio/common/BitPackDecoder.h"
 #include "velox/dwio/common/DataBuffer.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/exception/Exception.h"
@@ -168,9 +169,31 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
       uint64_t len,
       uint64_t fb,
       const uint64_t* nulls = nullptr) {
+    if (!nulls && bitsLeft == 0 && len > 0) {
+      // Byte aligned run without nulls that is entirely in the current buffer.
+      // Unpack it in bulk.
+      auto& bufferStart = dwio::common::IntDecoder<isSigned>::bufferStart;
+      const uint64_t numBits = len * fb;
+      const uint64_t available =
+          dwio::common::IntDecoder<isSigned>::bufferEnd - bufferStart;
+      if (available * 8 >= numBits) {
+        dwio::common::unpackBigEndian(
+            reinterpret_cast<const uint8_t*>(bufferStart),
+            available,
+            len,
+            fb,
+            reinterpret_cast<uint64_t*>(data + offset));
+        bufferStart += numBits / 8;
+        if (numBits % 8 != 0) {
+          curByte = readByte();
+          bitsLeft = 8 - numBits % 8;
+        }
+        return len;
+      }
+    }
+
     uint64_t ret = 0;
 
-    // TODO: unroll to improve performance
     for (uint64_t i = offset; i < (offset + len); i++) {
       // skip null positions
       if (nulls && bits::isBitNull(nulls, i)) {
@@ -139,6 +139,7 @@ void SelectiveStringDictionaryColumnReader::loadStrideDictionary() {
   // get stride dictionary size and load it if needed
   auto& positions =
       formatData_->as<DwrfData>().index().entry(nextStride).positions();
+  auto previousStrideDictSize = scanState_.dictionary2.numValues;
   scanState_.dictionary2.numValues = positions.Get(strideDictSizeOffset_);
   if (scanState_.dictionary2.numValues > 0) {
     // seek stride dictionary related streams
@@ -152,7 +153,12 @@ void SelectiveStringDictionaryColumnReader::loadStrideDictionary() {
         *strideDictStream_, *strideDictLengthDecoder_, scanState_.dictionary2);
   }
   lastStrideIndex_ = nextStride;
-  dictionaryValues_ = nullptr;
+  // The base vector only changes if either stride has a stride dictionary.
+  // Keeping it otherwise lets consumers see the same dictionary base across
+  // row groups.
+  if (previousStrideDictSize > 0 || scanState_.dictionary2.numValues > 0) {
+    dictionaryValues_ = nullptr;
+  }
 
   if (scanSpec_->hasFilter()) {
     scanState_.filterCache.resize(
@@ -315,7 +321,9 @@ void SelectiveStringDictionaryColumnReader::getValues(
   flatSize = std::max<double>(flatSize, rows.size());
   auto dictSize =
       scanState_.dictionary.numValues + scanState_.dictionary2.numValues;
-  if (scanSpec_->makeFlat() || (!dictionaryValues_ && flatSize < dictSize)) {
+  if (scanSpec_->makeFlat() ||
+      (!scanSpec_->preserveDictionary() && !dictionaryValues_ &&
+       flatSize < dictSize)) {
     makeFlat(result);
     return;
   }
@@ -41,6 +41,9 @@ SelectiveStringDirectColumnReader::SelectiveStringDirectColumnReader(
       encodingKey.forKind(proto::Stream_Kind_DATA),
       params.streamLabels().label(),
       true);
+  // Long strings may point to uncompressed data in the cache instead of being
+  // copied.
+  mayUseStreamBuffer_ = true;
 }
 
 uint64_t SelectiveStringDirectColumnReader::skip(uint64_t numValues) {
@@ -73,7 +76,7 @@ void SelectiveStringDirectColumnReader::extractCrossBuffers(
       addValue(value);
     } else {
       auto index = outerNonNullRows_[rowIndex + i];
-      if (size <= StringView::kInlineSize) {
+      if (size <= StringView::kInlineSize || useStreamBuffer(value)) {
         reinterpret_cast<StringView*>(rawValues_)[index] =
             StringView(value.data(), size);
       } else {
@@ -147,6 +150,7 @@ inline bool SelectiveStringDirectColumnReader::try8Consecutive(
   if (!data || bufferEnd_ - data < start + 8 * 12) {
     return false;
   }
+  updateStreamBuffer();
   int32_t* result = reinterpret_cast<int32_t*>(rawValues_);
   int32_t resultIndex = numValues_ * 4 - 4;
   auto rawUsed = rawStringUsed_;
@@ -179,6 +183,11 @@ inline bool SelectiveStringDirectColumnReader::try8Consecutive(
           reinterpret_cast<char*>(result + resultIndex + 1) + length) = 0;
       continue;
     }
+    if (useStreamBuffer(folly::StringPiece(data, length))) {
+      *reinterpret_cast<const char**>(result + resultIndex + 2) = data;
+      data += length;
+      continue;
+    }
     if (!rawStringBuffer_ || rawUsed + length > rawStringSize_) {
       // Slow path if no space in raw strings
       return false;
@@ -258,6 +267,9 @@ folly::StringPiece SelectiveStringDirectColumnReader::readValue(
   // we're reading.
   if (bufferEnd_ - bufferStart_ >= length) {
     bytesToSkip_ = length;
+    if (length > StringView::kInlineSize) {
+      updateStreamBuffer();
+    }
     return folly::StringPiece(bufferStart_, length);
   }
   tempString_.resize(length);
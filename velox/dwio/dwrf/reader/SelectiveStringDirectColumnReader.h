@@ -48,9 +48,7 @@ class SelectiveStringDirectColumnReader
       override;
 
   void getValues(RowSet rows, VectorPtr* result) override {
-    rawStringBuffer_ = nullptr;
-    rawStringSize_ = 0;
-    rawStringUsed_ = 0;
+    resetStringBuffers();
     getFlatValues<StringView, StringView>(rows, result, requestedType());
   }
 
@@ -60,6 +58,16 @@ class SelectiveStringDirectColumnReader
 
   folly::StringPiece readValue(int32_t length);
 
+  // Sets the stream buffer of the reader to the buffer of 'blobStream_' that
+  // 'bufferStart_' is in, if this has changed since the last call.
+  void updateStreamBuffer() {
+    if (bufferEnd_ != streamBufferCheckedEnd_) {
+      streamBufferCheckedEnd_ = bufferEnd_;
+      setStreamBuffer(
+          blobStream_->currentBufferOwner(), bufferStart_, bufferEnd_);
+    }
+  }
+
   template <bool hasNulls, typename Visitor>
   void decode(const uint64_t* nulls, Visitor visitor);
 
@@ -102,6 +110,8 @@ class SelectiveStringDirectColumnReader
   int32_t lengthIndex_ = 0;
   const uint32_t* rawLengths_ = nullptr;
   int64_t bytesToSkip_ = 0;
+  // Value of 'bufferEnd_' at the last updateStreamBuffer().
+  const char* streamBufferCheckedEnd_ = nullptr;
   // Storage for a string straddling a buffer boundary. Needed for calling
   // the filter.
   std::string tempString_;
@@ -506,6 +506,45 @@ TEST_F(CacheTest, window) {
   EXPECT_EQ(kMB, ioStats_->rawBytesRead() - previousRead);
 }
 
+TEST_F(CacheTest, currentBufferOwner) {
+  constexpr int32_t kMB = 1 << 20;
+  initializeCache(64 * kMB);
+  auto tracker = std::make_shared<ScanTracker>(
+      "testTracker",
+      nullptr,
+      io::ReaderOptions::kDefaultLoadQuantum,
+      groupStats_);
+  uint64_t fileId;
+  uint64_t groupId;
+  auto file = inputByPath("test_for_buffer_owner", fileId, groupId);
+  auto input = std::make_unique<CachedBufferedInput>(
+      file,
+      MetricsLog::voidLog(),
+      fileId,
+      cache_.get(),
+      tracker,
+      groupId,
+      ioStats_,
+      executor_.get(),
+      io::ReaderOptions(pool_.get()));
+  auto stream = input->read(kMB, 2 * kMB, LogType::TEST);
+  EXPECT_EQ(nullptr, stream->currentBufferOwner());
+  const void* buffer;
+  int32_t size;
+  ASSERT_TRUE(stream->Next(&buffer, &size));
+  auto owner = stream->currentBufferOwner();
+  ASSERT_TRUE(owner != nullptr);
+  auto data = reinterpret_cast<const char*>(buffer);
+  EXPECT_LE(owner->as<char>(), data);
+  EXPECT_GE(owner->as<char>() + owner->size(), data + size);
+  std::string expected(data, size);
+
+  // The owner keeps the bytes valid after the stream and input are gone.
+  stream.reset();
+  input.reset();
+  EXPECT_EQ(expected, std::string(data, size));
+}
+
 TEST_F(CacheTest, bufferedInput) {
   // Size 160 MB. Frequent evictions and not everything fits in prefetch window.
   initializeCache(160 << 20);
@@ -2716,3 +2716,66 @@ TEST(TestReader, readStringDictionaryAsFlat) {
   rowReader->updateRuntimeStats(stats);
   ASSERT_EQ(stats.columnReaderStatistics.flattenStringDictionaryValues, 1);
 }
+
+TEST(TestReader, readStringDictionaryPreserved) {
+  std::vector<std::string> dictionary;
+  for (int i = 0; i < 26; ++i) {
+    dictionary.emplace_back(20 + i, 'a' + i);
+  }
+  auto* pool = getDefaultPool().get();
+  VectorMaker maker(pool);
+  auto indices = allocateIndices(200, pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  for (int i = 0; i < 200; ++i) {
+    rawIndices[i] = i % dictionary.size();
+  }
+  auto batch = maker.rowVector({
+      BaseVector::wrapInDictionary(
+          nullptr, indices, 200, maker.flatVector(dictionary)),
+  });
+  auto [writer, reader] = createWriterReader(
+      {batch},
+      *pool,
+      std::make_shared<dwrf::Config>(),
+      E2EWriterTestUtil::simpleFlushPolicyFactory(false));
+  auto rowType = reader->rowType();
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType);
+  auto* c0Spec = spec->childByName("c0");
+  // A selective filter makes the reader flatten unless asked to preserve the
+  // dictionary.
+  c0Spec->setFilter(std::make_unique<common::BytesValues>(
+      std::vector<std::string>{"aaaaaaaaaaaaaaaaaaaa"}, false));
+  c0Spec->setPreserveDictionary(true);
+  spec->resetCachedValues(true);
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto actual = BaseVector::create(rowType, 0, pool);
+  VectorPtr firstBase;
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_EQ(rowReader->next(26, actual), 26);
+    ASSERT_EQ(actual->size(), 1);
+    auto* c0 = actual->as<RowVector>()->childAt(0)->loadedVector();
+    ASSERT_EQ(c0->encoding(), VectorEncoding::Simple::DICTIONARY);
+    ASSERT_EQ(c0->valueVector()->size(), dictionary.size());
+    ASSERT_EQ(
+        c0->as<SimpleVector<StringView>>()->valueAt(0),
+        StringView(dictionary[0]));
+    if (i == 0) {
+      firstBase = c0->valueVector();
+    } else {
+      // Consecutive batches share the same dictionary base.
+      ASSERT_EQ(c0->valueVector().get(), firstBase.get());
+    }
+  }
+  dwio::common::RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  ASSERT_EQ(stats.columnReaderStatistics.flattenStringDictionaryValues, 0);
+
+  // 'makeFlat' takes precedence.
+  c0Spec->setMakeFlat(true);
+  rowReader = reader->createRowReader(rowReaderOpts);
+  ASSERT_EQ(rowReader->next(26, actual), 26);
+  ASSERT_TRUE(actual->as<RowVector>()->childAt(0)->isFlatEncoding());
+}
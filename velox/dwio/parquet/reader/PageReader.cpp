@@ -225,6 +225,10 @@ const char* FOLLY_NONNULL PageReader::decompressData(
     const char* pageData,
     uint32_t compressedSize,
     uint32_t uncompressedSize) {
+  if (codec_ == thrift::CompressionCodec::UNCOMPRESSED) {
+    VELOX_CHECK_EQ(compressedSize, uncompressedSize);
+    return pageData;
+  }
   if (codec_ == thrift::CompressionCodec::LZ4 ||
       codec_ == thrift::CompressionCodec::LZO) {
     return decompressLz4AndLzo(
@@ -261,6 +265,19 @@ const char* FOLLY_NONNULL PageReader::decompressData(
   return decompressedData_->as<char>();
 }
 
+void PageReader::updatePageDataOwner() {
+  pageDataOwner_ = inputStream_->currentBufferOwner();
+  if (!pageDataOwner_) {
+    return;
+  }
+  auto ownerStart = pageDataOwner_->as<char>();
+  if (pageData_ < ownerStart ||
+      pageData_ + encodedDataSize_ > ownerStart + pageDataOwner_->size()) {
+    // The encoded data was copied or decompressed into a reader owned buffer.
+    pageDataOwner_ = nullptr;
+  }
+}
+
 void PageReader::setPageRowInfo(bool forRepDef) {
   if (isTopLevel_ || forRepDef || maxRepeat_ == 0) {
     numRowsInPage_ = numRepDefsInPage_;
@@ -350,6 +367,7 @@ void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
     pageData_ += defineLength;
   }
   encodedDataSize_ = pageEnd - pageData_;
+  updatePageDataOwner();
 
   encoding_ = pageHeader.data_page_header.encoding;
   if (!hasChunkRepDefs_ && (numRowsInPage_ == kRowsUnknown || maxDefine_ > 1)) {
@@ -412,6 +430,7 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
   }
 
   encodedDataSize_ = pageHeader.uncompressed_page_size - levelsSize;
+  updatePageDataOwner();
   encoding_ = pageHeader.data_page_header_v2.encoding;
   if (numRowsInPage_ == kRowsUnknown) {
     readPageDefLevels();
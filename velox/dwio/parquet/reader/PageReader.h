@@ -222,6 +222,10 @@ class PageReader {
   // next page.
   void updateRowInfoAfterPageSkipped();
 
+  // Sets 'pageDataOwner_' to the stream buffer holding the encoded data of
+  // the current page, or nullptr if the data was copied or decompressed.
+  void updatePageDataOwner();
+
   void prepareDataPageV1(const thrift::PageHeader& pageHeader, int64_t row);
   void prepareDataPageV2(const thrift::PageHeader& pageHeader, int64_t row);
   void prepareDictionary(const thrift::PageHeader& pageHeader);
@@ -332,6 +336,8 @@ class PageReader {
         dictionaryIdDecoder_->readWithVisitor<true>(nulls, dictVisitor);
       } else {
         nullsFromFastPath = false;
+        visitor.reader().setStreamBuffer(
+            pageDataOwner_, pageData_, pageData_ + encodedDataSize_);
         stringDecoder_->readWithVisitor<true>(nulls, visitor);
       }
     } else {
@@ -339,6 +345,8 @@ class PageReader {
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
       } else {
+        visitor.reader().setStreamBuffer(
+            pageDataOwner_, pageData_, pageData_ + encodedDataSize_);
         stringDecoder_->readWithVisitor<false>(nulls, visitor);
       }
     }
@@ -453,6 +461,10 @@ class PageReader {
   // contiguous run of bytes.
   const char* FOLLY_NULLABLE pageData_{nullptr};
 
+  // Keeps 'pageData_' alive when it points into the input stream's buffer.
+  // Lets string readers refer to values in the page without copying.
+  BufferPtr pageDataOwner_;
+
   // Dictionary contents.
   dwio::common::DictionaryValues dictionary_;
   thrift::Encoding::type dictionaryEncoding_;
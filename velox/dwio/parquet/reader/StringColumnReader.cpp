@@ -23,7 +23,9 @@ StringColumnReader::StringColumnReader(
     const std::shared_ptr<const dwio::common::TypeWithId>& nodeType,
     ParquetParams& params,
     common::ScanSpec& scanSpec)
-    : SelectiveColumnReader(nodeType->type(), params, scanSpec, nodeType) {}
+    : SelectiveColumnReader(nodeType->type(), params, scanSpec, nodeType) {
+  mayUseStreamBuffer_ = true;
+}
 
 uint64_t StringColumnReader::skip(uint64_t numValues) {
   formatData_->skip(numValues);
@@ -135,9 +137,7 @@ void StringColumnReader::getValues(RowSet rows, VectorPtr* result) {
         &memoryPool_, resultNulls(), numValues_, dictionaryValues, values_);
     return;
   }
-  rawStringBuffer_ = nullptr;
-  rawStringSize_ = 0;
-  rawStringUsed_ = 0;
+  resetStringBuffers();
   getFlatValues<StringView, StringView>(rows, result, fileType_->type());
 }
 
@@ -152,9 +152,7 @@ void StringColumnReader::dedictionarize() {
     // 32 bit indices by dictionary scan.
     VELOX_CHECK_GE(valuesCapacity, numValues_ * sizeof(StringView));
     stringBuffers_.clear();
-    rawStringBuffer_ = nullptr;
-    rawStringSize_ = 0;
-    rawStringUsed_ = 0;
+    resetStringBuffers();
     auto numValues = numValues_;
     // Convert indices to values in place. Loop from end to beginning
     // so as not to overwrite integer indices with longer StringViews.
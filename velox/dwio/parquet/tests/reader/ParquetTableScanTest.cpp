@@ -17,9 +17,13 @@
 #include <folly/init/Init.h>
 
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/file/File.h"
+#include "velox/common/memory/MallocAllocator.h"
 #include "velox/dwio/common/tests/utils/DataFiles.h"
 #include "velox/dwio/parquet/RegisterParquetReader.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
+#include "velox/dwio/parquet/writer/Writer.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/type/tests/SubfieldFiltersBuilder.h"
@@ -442,6 +446,84 @@ TEST_F(ParquetTableScanTest, readAsLowerCase) {
       result.second, {makeRowVector({"a"}, {makeFlatVector<int64_t>({0, 1})})});
 }
 
+TEST_F(ParquetTableScanTest, stringsFromCache) {
+  constexpr int32_t kSize = 10'000;
+  auto makeString = [](auto row) {
+    return fmt::format("string too long to be inlined {:06}", row);
+  };
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kSize, folly::identity),
+      makeFlatVector<std::string>(kSize, makeString),
+  });
+  // Plain encoded strings in uncompressed pages are returned as views into the
+  // cache.
+  auto filePath = TempFilePath::create();
+  WriterOptions options;
+  options.enableDictionary = false;
+  options.memoryPool = rootPool_.get();
+  auto writer = std::make_unique<Writer>(
+      std::make_unique<dwio::common::WriteFileSink>(
+          std::make_unique<LocalWriteFile>(filePath->path, true, false),
+          filePath->path),
+      options);
+  writer->write(data);
+  writer->close();
+
+  auto allocator = std::make_shared<memory::MallocAllocator>(1L << 30);
+  auto cache = cache::AsyncDataCache::create(allocator.get());
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(2);
+  CursorParameters params;
+  params.queryCtx = std::make_shared<core::QueryCtx>(
+      executor.get(),
+      core::QueryConfig({}),
+      std::unordered_map<std::string, std::shared_ptr<Config>>{},
+      cache.get());
+  params.planNode =
+      PlanBuilder().tableScan(asRowType(data->type())).planNode();
+  bool noMoreSplits = false;
+  auto [cursor, results] = readCursor(params, [&](exec::Task* task) {
+    if (!noMoreSplits) {
+      task->addSplit("0", exec::Split(makeSplit(filePath->path)));
+      task->noMoreSplits("0");
+      noMoreSplits = true;
+    }
+  });
+  ASSERT_LT(1, results.size());
+
+  // The scan is done and has released its pins. Dropping the unpinned entries
+  // must leave the entries the results refer to in place.
+  cache->clear();
+  EXPECT_LT(0, cache->refreshStats().numShared);
+
+  int64_t row = 0;
+  int32_t numViews = 0;
+  for (const auto& result : results) {
+    auto strings = result->childAt(1)->asFlatVector<StringView>();
+    ASSERT_TRUE(strings != nullptr);
+    for (auto i = 0; i < result->size(); ++i, ++row) {
+      auto value = strings->valueAt(i);
+      ASSERT_EQ(makeString(row), value.str());
+      for (const auto& buffer : strings->stringBuffers()) {
+        auto start = buffer->as<char>();
+        if (buffer->isView() && value.data() >= start &&
+            value.data() + value.size() <= start + buffer->size()) {
+          ++numViews;
+          break;
+        }
+      }
+    }
+  }
+  ASSERT_EQ(kSize, row);
+  EXPECT_LT(0, numViews);
+
+  // The pins go away with the results.
+  results.clear();
+  cursor.reset();
+  EXPECT_EQ(0, cache->refreshStats().numShared);
+  params.queryCtx.reset();
+  cache->shutdown();
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   folly::init(&argc, &argv, false);
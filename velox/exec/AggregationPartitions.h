@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <mutex>
+
+#include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashBitRange.h"
+
+namespace facebook::velox::exec {
+
+/// Groups of an aggregation split into hash ranges that are shared by all the
+/// drivers of the aggregation in a split group. Each range is owned by one
+/// driver, which is the only one to add rows to the range's GroupingSet.
+/// The other drivers queue their rows of the range for the owner under the
+/// range's mutex, which is never held while allocating, so that the memory
+/// of a GroupingSet is allocated and arbitrated on its owner's thread. Once
+/// all the drivers have finished adding input, each driver produces the
+/// output of the ranges it owns.
+///
+/// The ranges are selected by the high bits of the grouping key hash. The hash
+/// tables of the ranges use the low bits, which stay well distributed within
+/// a range.
+class AggregationPartitions {
+ public:
+  struct Partition {
+    // Guards 'pendingInputs' and the reset of 'groupingSet' on close.
+    std::mutex mutex;
+    std::unique_ptr<GroupingSet> groupingSet;
+
+    // Rows of the range added by the drivers other than the owner, which
+    // adds them to 'groupingSet' on its next input or before producing
+    // output.
+    std::vector<RowVectorPtr> pendingInputs;
+
+    // State referenced by 'groupingSet'. Kept here since the GroupingSet is
+    // used by drivers other than the one that created it.
+    tsan_atomic<bool> nonReclaimableSection{false};
+    uint32_t numSpillRuns{0};
+  };
+
+  explicit AggregationPartitions(uint32_t numDrivers)
+      : numDrivers_(numDrivers),
+        hashBits_(hashBits(numDrivers)),
+        partitions_(hashBits_.numPartitions()) {
+    VELOX_CHECK_GT(numDrivers_, 0);
+  }
+
+  uint32_t numDrivers() const {
+    return numDrivers_;
+  }
+
+  uint32_t numPartitions() const {
+    return partitions_.size();
+  }
+
+  const HashBitRange& hashBits() const {
+    return hashBits_;
+  }
+
+  Partition& partition(uint32_t partition) {
+    VELOX_DCHECK_LT(partition, partitions_.size());
+    return partitions_[partition];
+  }
+
+  /// Returns the driver that creates the GroupingSet of 'partition' and
+  /// produces its output.
+  uint32_t owner(uint32_t partition) const {
+    return partition % numDrivers_;
+  }
+
+ private:
+  // Number of hash ranges per driver. More ranges than drivers make two
+  // drivers adding to the same range at the same time less likely and even
+  // out the output work across drivers.
+  static constexpr uint32_t kPartitionsPerDriver = 4;
+
+  static HashBitRange hashBits(uint32_t numDrivers) {
+    const auto numPartitions =
+        bits::nextPowerOfTwo(numDrivers * kPartitionsPerDriver);
+    const uint8_t numBits = __builtin_ctzll(numPartitions);
+    return HashBitRange(64 - numBits, 64);
+  }
+
+  const uint32_t numDrivers_;
+  const HashBitRange hashBits_;
+  std::vector<Partition> partitions_;
+};
+
+} // namespace facebook::velox::exec
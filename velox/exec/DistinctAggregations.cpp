@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/DistinctAggregations.h"
+#include "velox/exec/HashTable.h"
 #include "velox/exec/SetAccumulator.h"
 
 namespace facebook::velox::exec {
@@ -190,16 +191,149 @@ class TypedDistinctAggregations : public DistinctAggregations {
   VectorPtr inputForAccumulator_;
 };
 
+class HashDistinctAggregations : public DistinctAggregations {
+ public:
+  HashDistinctAggregations(
+      std::vector<AggregateInfo*> aggregates,
+      const std::vector<column_index_t>& groupingKeys,
+      const RowTypePtr& inputType,
+      memory::MemoryPool* pool)
+      : aggregates_{std::move(aggregates)} {
+    // The pairs of grouping keys and non-constant inputs. Nulls are kept, as
+    // in the sets of TypedDistinctAggregations.
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    for (auto channel : groupingKeys) {
+      hashers.push_back(
+          VectorHasher::create(inputType->childAt(channel), channel));
+    }
+    for (auto channel : aggregates_[0]->inputs) {
+      if (channel != kConstantChannel) {
+        hashers.push_back(
+            VectorHasher::create(inputType->childAt(channel), channel));
+      }
+    }
+    table_ = HashTable<false>::createForAggregation(
+        std::move(hashers), std::vector<Accumulator>{}, pool);
+    lookup_ = std::make_unique<HashLookup>(table_->hashers());
+  }
+
+  bool hasAccumulator() const override {
+    return false;
+  }
+
+  Accumulator accumulator() const override {
+    VELOX_UNREACHABLE("Hash mode distinct aggregations have no accumulator");
+  }
+
+  uint64_t allocatedBytes() const override {
+    return table_->allocatedBytes();
+  }
+
+  // Assumes that all rows are new pairs.
+  uint64_t sizeIncrement(vector_size_t numRows) const override {
+    return table_->hashTableSizeIncrease(numRows) +
+        table_->rows()->sizeIncrement(numRows, 0);
+  }
+
+  void initializeNewGroups(
+      char** groups,
+      folly::Range<const vector_size_t*> indices) override {
+    for (auto* aggregate : aggregates_) {
+      aggregate->function->initializeNewGroups(groups, indices);
+    }
+  }
+
+  void addInput(
+      char** groups,
+      const RowVectorPtr& input,
+      const SelectivityVector& rows) override {
+    if (!findNewRows(input, rows)) {
+      return;
+    }
+    for (auto* aggregate : aggregates_) {
+      aggregate->function->addRawInput(
+          groups, newRows_, makeInputForAggregation(*aggregate, input), false);
+    }
+  }
+
+  void addSingleGroupInput(
+      char* group,
+      const RowVectorPtr& input,
+      const SelectivityVector& rows) override {
+    if (!findNewRows(input, rows)) {
+      return;
+    }
+    for (auto* aggregate : aggregates_) {
+      aggregate->function->addSingleGroupRawInput(
+          group, newRows_, makeInputForAggregation(*aggregate, input), false);
+    }
+  }
+
+  void extractValues(
+      folly::Range<char**> /*groups*/,
+      const RowVectorPtr& /*result*/) override {}
+
+ private:
+  // Adds the pairs of grouping keys and inputs in 'rows' of 'input' to
+  // 'table_'. Sets 'newRows_' to the first row of each pair that was not in
+  // 'table_' before. Returns false if there is no such row.
+  bool findNewRows(const RowVectorPtr& input, const SelectivityVector& rows) {
+    probeRows_ = rows;
+    table_->prepareForProbe(*lookup_, input, probeRows_, false);
+    table_->groupProbe(*lookup_);
+    if (lookup_->newGroups.empty()) {
+      return false;
+    }
+    newRows_.resizeFill(input->size(), false);
+    for (auto row : lookup_->newGroups) {
+      newRows_.setValid(row, true);
+    }
+    newRows_.updateBounds();
+    return true;
+  }
+
+  const std::vector<VectorPtr>& makeInputForAggregation(
+      const AggregateInfo& aggregate,
+      const RowVectorPtr& input) {
+    const auto& channels = aggregate.inputs;
+    inputForAggregation_.resize(channels.size());
+    for (auto i = 0; i < channels.size(); ++i) {
+      if (channels[i] == kConstantChannel) {
+        inputForAggregation_[i] = BaseVector::wrapInConstant(
+            input->size(), 0, aggregate.constantInputs[i]);
+      } else {
+        inputForAggregation_[i] = input->childAt(channels[i]);
+      }
+    }
+    return inputForAggregation_;
+  }
+
+  const std::vector<AggregateInfo*> aggregates_;
+  std::unique_ptr<BaseHashTable> table_;
+  std::unique_ptr<HashLookup> lookup_;
+
+  SelectivityVector probeRows_;
+  SelectivityVector newRows_;
+  std::vector<VectorPtr> inputForAggregation_;
+};
+
 } // namespace
 
 // static
 std::unique_ptr<DistinctAggregations> DistinctAggregations::create(
     std::vector<AggregateInfo*> aggregates,
+    const std::vector<column_index_t>& groupingKeys,
+    bool hashMode,
     const RowTypePtr& inputType,
     memory::MemoryPool* pool) {
-  VELOX_CHECK_EQ(aggregates.size(), 1);
+  VELOX_CHECK(!aggregates.empty());
   VELOX_CHECK(!aggregates[0]->inputs.empty());
 
+  if (hashMode) {
+    return std::make_unique<HashDistinctAggregations>(
+        std::move(aggregates), groupingKeys, inputType, pool);
+  }
+
   const bool isSingleInput = aggregates[0]->inputs.size() == 1;
   if (!isSingleInput) {
     return std::make_unique<TypedDistinctAggregations<ComplexType>>(
@@ -24,23 +24,55 @@ namespace facebook::velox::exec {
 
 /// Computes aggregations over de-duplicated inputs. Supports aggregations with
 /// single (e.g. sum, count) or multiple (e.g. covar_pop) input columns.
+///
+/// By default, the unique inputs of each group are collected in a set in the
+/// group's accumulator and fed to the aggregate functions in extractValues().
+/// In hash mode, the distinct pairs of grouping keys and inputs of all groups
+/// are kept in a single hash table and the rows with new pairs are fed to the
+/// aggregate functions as the input arrives. The groups then only hold the
+/// accumulators of the aggregate functions, which can be spilled. The hash
+/// table itself is not spilled and stays in memory until the aggregation
+/// finishes, since a spilled group may get new inputs later.
 class DistinctAggregations {
  public:
   /// @param aggregates Non-empty list of
   /// aggregates that require inputs to be de-duplicated. All
-  /// aggregates should have the same inputs.
-  /// Aggregates with multiple inputs are not supported.
+  /// aggregates should have the same inputs and the same mask.
+  /// @param groupingKeys Channels of the grouping keys in the input. Used only
+  /// in hash mode.
+  /// @param hashMode True if the inputs are de-duplicated in a hash table
+  /// shared by all groups.
   /// @param inputType Input row type for the aggregation operator.
   /// @param pool Memory pool.
   static std::unique_ptr<DistinctAggregations> create(
       std::vector<AggregateInfo*> aggregates,
+      const std::vector<column_index_t>& groupingKeys,
+      bool hashMode,
       const RowTypePtr& inputType,
       memory::MemoryPool* pool);
 
   virtual ~DistinctAggregations() = default;
 
+  /// Returns false if the unique inputs are not stored in the groups. Then
+  /// accumulator(), setAllocator() and setOffsets() must not be used.
+  virtual bool hasAccumulator() const {
+    return true;
+  }
+
   virtual Accumulator accumulator() const = 0;
 
+  /// Returns the memory allocated outside of the groups, i.e. the hash table
+  /// in hash mode.
+  virtual uint64_t allocatedBytes() const {
+    return 0;
+  }
+
+  /// Returns an estimate of the growth of allocatedBytes() from adding
+  /// 'numRows' rows of input.
+  virtual uint64_t sizeIncrement(vector_size_t /*numRows*/) const {
+    return 0;
+  }
+
   /// Aggregate-like APIs to aggregate input rows per group.
   void setAllocator(HashStringAllocator* allocator) {
     allocator_ = allocator;
@@ -72,6 +104,8 @@ class DistinctAggregations {
       const SelectivityVector& rows) = 0;
 
   /// Computes aggregations and stores results in the specified 'result' vector.
+  /// A no-op in hash mode, where the aggregate functions have all their input
+  /// already and are extracted like the aggregations over all inputs.
   virtual void extractValues(
       folly::Range<char**> groups,
       const RowVectorPtr& result) = 0;
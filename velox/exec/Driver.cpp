@@ -19,9 +19,11 @@
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <folly/executors/thread_factory/InitThreadFactory.h>
 #include <gflags/gflags.h>
+#include "velox/common/process/Profiler.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
+#include "velox/exec/DriverScheduler.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
@@ -145,6 +147,7 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.aggregationSpillPartitionBits(),
       queryConfig.aggregationSpillAll(),
       queryConfig.maxSpillLevel(),
+      queryConfig.joinSpillSkewedKeyPct(),
       queryConfig.testingSpillPct(),
       queryConfig.spillCompressionKind());
 }
@@ -240,8 +243,12 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  auto* executor = driver->task()->queryCtx()->executor();
+  if (auto* scheduler = dynamic_cast<DriverScheduler*>(executor)) {
+    scheduler->enqueue(std::move(driver));
+    return;
+  }
+  executor->add([driver]() { Driver::run(driver); });
 }
 
 void Driver::init(
@@ -342,6 +349,8 @@ void Driver::enqueueInternal() {
 // terminating throw. Annotate exceptions with Operator info.
 #define CALL_OPERATOR(call, operator, methodName)                       \
   try {                                                                 \
+    process::ProfileFrame operatorFrame(operator->profileLabel());      \
+    process::ProfileFrame methodFrame(methodName);                      \
     threadNumVeloxThrow() = 0;                                          \
     call;                                                               \
     recordSilentThrows(*operator);                                      \
@@ -437,6 +446,9 @@ StopReason Driver::runInternal(
         RuntimeCounter(queuedTime, RuntimeCounter::Unit::kNanos));
   }
 
+  // Samples the thread while on thread for a Task with profiling enabled.
+  process::ScopedProfile scopedProfile(task()->profile());
+
   CancelGuard guard(task().get(), &state_, [&](StopReason reason) {
     // This is run on error or cancel exit.
     if (reason == StopReason::kTerminate) {
@@ -467,6 +479,12 @@ StopReason Driver::runInternal(
           guard.notThrown();
           return stop;
         }
+        if (sliceEndMicros_ != 0 && getCurrentTimeMicro() >= sliceEndMicros_) {
+          // The time slice given by the DriverScheduler is used up. Go to the
+          // end of the queue.
+          guard.notThrown();
+          return StopReason::kYield;
+        }
 
         auto op = operators_[i].get();
         VELOX_CHECK(op->isInitialized());
@@ -650,7 +668,7 @@ StopReason Driver::runInternal(
 #undef CALL_OPERATOR
 
 // static
-void Driver::run(std::shared_ptr<Driver> self) {
+StopReason Driver::run(std::shared_ptr<Driver> self) {
   process::TraceContext trace("Driver::run");
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
@@ -672,7 +690,7 @@ void Driver::run(std::shared_ptr<Driver> self) {
   // going into the resume mode waiting on a promise.
   if (reason == StopReason::kBlock &&
       self->task()->shouldStop() == StopReason::kTerminate) {
-    return;
+    return reason;
   }
 
   switch (reason) {
@@ -681,20 +699,23 @@ void Driver::run(std::shared_ptr<Driver> self) {
       // future is already realized we do not have a second thread
       // entering the same Driver.
       BlockingState::setResume(blockingState);
-      return;
+      return reason;
 
     case StopReason::kYield:
-      // Go to the end of the queue.
-      enqueue(self);
-      return;
+      // Go to the end of the queue. A DriverScheduler queues the Driver again
+      // itself after recording the time slice.
+      if (self->sliceEndMicros_ == 0) {
+        enqueue(self);
+      }
+      return reason;
 
     case StopReason::kPause:
     case StopReason::kTerminate:
     case StopReason::kAlreadyTerminated:
     case StopReason::kAtEnd:
-      return;
+      return reason;
     default:
-      VELOX_CHECK(false, "Unhandled stop reason");
+      VELOX_FAIL("Unhandled stop reason: {}", reason);
   }
 }
 
@@ -762,6 +783,18 @@ bool Driver::mayPushdownAggregation(Operator* aggregation) const {
       aggregation->toString());
 }
 
+bool Driver::onlyFiltersUpstream(const Operator* op) const {
+  for (auto i = 1; i < operators_.size(); ++i) {
+    if (operators_[i].get() == op) {
+      return true;
+    }
+    if (!operators_[i]->isFilter()) {
+      return false;
+    }
+  }
+  VELOX_FAIL("Operator not found in its Driver: {}", op->toString());
+}
+
 std::unordered_set<column_index_t> Driver::canPushdownFilters(
     const Operator* filterSource,
     const std::vector<column_index_t>& channels) const {
@@ -905,6 +938,8 @@ std::string blockingReasonToString(BlockingReason reason) {
       return "kWaitForConnector";
     case BlockingReason::kWaitForSpill:
       return "kWaitForSpill";
+    case BlockingReason::kWaitForPeers:
+      return "kWaitForPeers";
   }
   VELOX_UNREACHABLE();
   return "";
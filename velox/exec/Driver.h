@@ -162,6 +162,9 @@ enum class BlockingReason {
   /// Build operator is blocked waiting for all its peers to stop to run group
   /// spill on all of them.
   kWaitForSpill,
+  /// Aggregation operator in partitioned mode is blocked waiting for all its
+  /// peers to finish adding input before producing output.
+  kWaitForPeers,
 };
 
 std::string blockingReasonToString(BlockingReason reason);
@@ -287,6 +290,11 @@ class Driver : public std::enable_shared_from_this<Driver> {
   /// order-preserving and do not increase cardinality.
   bool mayPushdownAggregation(Operator* aggregation) const;
 
+  /// Returns true if no operator between the source and 'op' has more output
+  /// rows than input rows. Then a dynamic filter from 'op' only drops rows
+  /// that would not reach 'op' otherwise, e.g. the rows after a TopN cutoff.
+  bool onlyFiltersUpstream(const Operator* op) const;
+
   /// Returns a subset of channels for which there are operators upstream from
   /// filterSource that accept dynamically generated filters.
   std::unordered_set<column_index_t> canPushdownFilters(
@@ -342,7 +350,9 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   void enqueueInternal();
 
-  static void run(std::shared_ptr<Driver> self);
+  // Runs 'self' on the current thread until it blocks, finishes or is told
+  // to stop. Returns the reason for stopping.
+  static StopReason run(std::shared_ptr<Driver> self);
 
   StopReason runInternal(
       std::shared_ptr<Driver>& self,
@@ -385,6 +395,11 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   // Timer used to track down the time we are sitting in the driver queue.
   size_t queueTimeStartMicros_{0};
+  // Microsecond real time at which the current run of 'this' yields its
+  // thread. Set by a DriverScheduler before each time slice. 0 if the run is
+  // not time sliced. A time sliced Driver that yields is queued again by the
+  // DriverScheduler, not by Driver::run().
+  uint64_t sliceEndMicros_{0};
   // Index of the current operator to run (or the 1st one if we haven't
   // started yet). Used to determine which operator's queueTime we should
   // update.
@@ -401,6 +416,7 @@ class Driver : public std::enable_shared_from_this<Driver> {
   bool isAdaptable_{true};
 
   friend struct DriverFactory;
+  friend class DriverScheduler;
 };
 
 using OperatorSupplier = std::function<
@@ -526,6 +542,11 @@ struct DriverFactory {
   /// based on this pipeline.
   std::vector<core::PlanNodeId> needsNestedLoopJoinBridges() const;
 
+  /// Returns plan node IDs of the aggregations in this pipeline that run in
+  /// partitioned mode and need AggregationPartitions shared by the drivers.
+  std::vector<core::PlanNodeId> needsAggregationPartitions(
+      const core::QueryConfig& queryConfig) const;
+
   static std::vector<DriverAdapter> adapters;
 };
 
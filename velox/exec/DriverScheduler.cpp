@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+#include "velox/common/process/ProcessBase.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+
+DriverScheduler::DriverScheduler(folly::Executor* executor, Options options)
+    : executor_(executor), options_(std::move(options)) {
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK_GT(options_.timeSliceMicros, 0);
+  VELOX_CHECK_GE(options_.levelTimeMultiplier, 1);
+  VELOX_CHECK(std::is_sorted(
+      options_.levelThresholdNanos.begin(),
+      options_.levelThresholdNanos.end()));
+  levels_.resize(options_.levelThresholdNanos.size() + 1);
+  for (auto i = 0; i < levels_.size(); ++i) {
+    levels_[i].weight =
+        std::pow(options_.levelTimeMultiplier, levels_.size() - 1 - i);
+  }
+}
+
+void DriverScheduler::add(folly::Func func) {
+  executor_->add(std::move(func));
+}
+
+int32_t DriverScheduler::level(uint64_t cpuNanos) const {
+  const auto& thresholds = options_.levelThresholdNanos;
+  return std::upper_bound(thresholds.begin(), thresholds.end(), cpuNanos) -
+      thresholds.begin();
+}
+
+void DriverScheduler::enqueue(std::shared_ptr<Driver> driver) {
+  // Called under the Task's mutex, so only reads Task state that does not
+  // need it.
+  const auto& task = driver->task();
+  const auto priority = task->queryCtx()->queryConfig().queryPriority();
+  const auto levelIndex = level(task->schedulerCpuNanos());
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto& queueLevel = levels_[levelIndex];
+    if (queueLevel.queue.empty()) {
+      // A level that had nothing to run did not use its share. Catch it up
+      // with the busy levels so that it does not starve them to make up for
+      // the idle time.
+      std::optional<double> minBusyNanos;
+      for (const auto& other : levels_) {
+        if (!other.queue.empty()) {
+          const auto nanos = other.cpuNanos / other.weight;
+          minBusyNanos = std::min(minBusyNanos.value_or(nanos), nanos);
+        }
+      }
+      if (minBusyNanos.has_value()) {
+        queueLevel.cpuNanos = std::max(
+            queueLevel.cpuNanos,
+            static_cast<uint64_t>(minBusyNanos.value() * queueLevel.weight));
+      }
+    }
+    queueLevel.queue.push_back(
+        {std::move(driver), priority, nextSequence_++, getCurrentTimeMicro()});
+    std::push_heap(queueLevel.queue.begin(), queueLevel.queue.end());
+    ++numQueued_;
+  }
+  executor_->add([this]() { runNext(); });
+}
+
+int32_t DriverScheduler::nextLevelLocked() const {
+  int32_t next = -1;
+  double nextNanos = 0;
+  for (auto i = 0; i < levels_.size(); ++i) {
+    if (levels_[i].queue.empty()) {
+      continue;
+    }
+    const auto nanos = levels_[i].cpuNanos / levels_[i].weight;
+    if (next == -1 || nanos < nextNanos) {
+      next = i;
+      nextNanos = nanos;
+    }
+  }
+  VELOX_CHECK_GE(next, 0, "No Driver queued in DriverScheduler");
+  return next;
+}
+
+void DriverScheduler::runNext() {
+  Entry entry;
+  int32_t levelIndex;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    levelIndex = nextLevelLocked();
+    auto& queue = levels_[levelIndex].queue;
+    std::pop_heap(queue.begin(), queue.end());
+    entry = std::move(queue.back());
+    queue.pop_back();
+    --numQueued_;
+  }
+
+  const auto startMicros = getCurrentTimeMicro();
+  const auto startCpuNanos = process::threadCpuNanos();
+  auto task = entry.driver->task();
+  entry.driver->sliceEndMicros_ = startMicros + options_.timeSliceMicros;
+  const auto reason = Driver::run(entry.driver);
+  const auto cpuNanos = process::threadCpuNanos() - startCpuNanos;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    levels_[levelIndex].cpuNanos += cpuNanos;
+  }
+  task->addSchedulerSlice(
+      (startMicros - std::min(startMicros, entry.enqueueTimeMicros)) * 1'000,
+      cpuNanos,
+      reason == StopReason::kYield);
+  if (reason == StopReason::kYield) {
+    // Queued after the time slice is recorded, so that the level reflects
+    // the CPU time of this slice.
+    Driver::enqueue(std::move(entry.driver));
+  }
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Executor.h>
+#include <mutex>
+
+#include "velox/exec/Driver.h"
+
+namespace facebook::velox::exec {
+
+/// Executor that runs the Drivers of the queries using it in time slices, in
+/// the order of a multi-level feedback queue. Pass it as the executor of a
+/// QueryCtx. Driver::enqueue() then queues the Drivers of the query here
+/// instead of adding them to the underlying executor in arrival order.
+///
+/// A Driver is queued at the level given by the CPU time its Task has used
+/// in earlier time slices, so that long running Tasks sink to the higher
+/// levels. Each level gets a share of the CPU time that is
+/// 'levelTimeMultiplier' times the share of the next level. Within a level,
+/// Drivers of higher priority queries run first, see
+/// QueryConfig::queryPriority(). A Driver gives up its thread at the end of
+/// its time slice and is queued again, so that short queries do not wait for
+/// long running ones to finish.
+///
+/// Must outlive the queries that use it.
+class DriverScheduler : public folly::Executor {
+ public:
+  struct Options {
+    /// Time a Driver runs before it yields its thread to queued Drivers.
+    uint64_t timeSliceMicros{100'000};
+
+    /// Upper bounds of the Task CPU time of each level except the last, in
+    /// increasing order.
+    std::vector<uint64_t> levelThresholdNanos{
+        1'000'000'000UL,
+        10'000'000'000UL,
+        60'000'000'000UL,
+        300'000'000'000UL};
+
+    /// Ratio between the CPU time shares of consecutive levels.
+    double levelTimeMultiplier{2};
+  };
+
+  DriverScheduler(folly::Executor* executor, Options options);
+
+  explicit DriverScheduler(folly::Executor* executor)
+      : DriverScheduler(executor, Options{}) {}
+
+  /// Runs 'func' on the underlying executor. Used for the work of the queries
+  /// that does not run in a Driver.
+  void add(folly::Func func) override;
+
+  /// Queues 'driver' and adds a run of the next queued Driver to the
+  /// underlying executor. Called by Driver::enqueue().
+  void enqueue(std::shared_ptr<Driver> driver);
+
+  /// Returns the level for a Task that has used 'cpuNanos' of CPU time.
+  int32_t level(uint64_t cpuNanos) const;
+
+  int32_t numLevels() const {
+    return levels_.size();
+  }
+
+  /// Returns the number of queued Drivers.
+  int32_t numQueued() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numQueued_;
+  }
+
+  /// Returns the number of Drivers queued at 'level'.
+  int32_t numQueued(int32_t level) const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return levels_.at(level).queue.size();
+  }
+
+  const Options& options() const {
+    return options_;
+  }
+
+ private:
+  struct Entry {
+    std::shared_ptr<Driver> driver;
+    int32_t priority;
+    // Orders Drivers of the same priority by the time of enqueue.
+    uint64_t sequence;
+    uint64_t enqueueTimeMicros;
+
+    // Heap order. The top of the heap is the Entry with the highest priority
+    // and the lowest sequence.
+    bool operator<(const Entry& other) const {
+      if (priority != other.priority) {
+        return priority < other.priority;
+      }
+      return sequence > other.sequence;
+    }
+  };
+
+  struct Level {
+    // Heap of queued Drivers.
+    std::vector<Entry> queue;
+    // CPU time of the time slices run for Drivers taken from this level.
+    uint64_t cpuNanos{0};
+    // Share of the CPU time relative to the other levels.
+    double weight{1};
+  };
+
+  // Runs a time slice of the next queued Driver. Each enqueue() adds one
+  // call of this to the underlying executor.
+  void runNext();
+
+  // Returns the non-empty level with the least CPU time for its weight.
+  int32_t nextLevelLocked() const;
+
+  folly::Executor* const executor_;
+  const Options options_;
+
+  mutable std::mutex mutex_;
+  std::vector<Level> levels_;
+  uint64_t nextSequence_{0};
+  int32_t numQueued_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -119,16 +119,33 @@ GroupingSet::GroupingSet(
         std::make_unique<SortedAggregations>(sortedAggs, inputType, &pool_);
   }
 
-  for (auto& aggregate : aggregates_) {
-    if (aggregate.distinct) {
-      VELOX_USER_CHECK(
-          !isPartial_,
-          "Partial aggregations over distinct inputs are not supported");
-      distinctAggregations_.emplace_back(
-          DistinctAggregations::create({&aggregate}, inputType, &pool_));
-    } else {
-      distinctAggregations_.push_back(nullptr);
+  // The sets of unique inputs per group cannot be spilled.
+  const bool hashDistinct = spillConfig_ != nullptr ||
+      queryConfig_->hashDistinctAggregationEnabled();
+  // Aggregates over the same distinct inputs with the same mask share the
+  // de-duplication of their inputs. The DistinctAggregations is at the index
+  // of the first of them.
+  distinctAggregations_.resize(aggregates_.size());
+  std::vector<bool> hasDistinctAggregations(aggregates_.size(), false);
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    const auto& aggregate = aggregates_[i];
+    if (!aggregate.distinct || hasDistinctAggregations[i]) {
+      continue;
+    }
+    VELOX_USER_CHECK(
+        !isPartial_,
+        "Partial aggregations over distinct inputs are not supported");
+    std::vector<AggregateInfo*> sameInputs;
+    for (auto j = i; j < aggregates_.size(); ++j) {
+      if (aggregates_[j].distinct &&
+          aggregates_[j].inputs == aggregate.inputs &&
+          aggregates_[j].mask == aggregate.mask) {
+        sameInputs.push_back(&aggregates_[j]);
+        hasDistinctAggregations[j] = true;
+      }
     }
+    distinctAggregations_[i] = DistinctAggregations::create(
+        std::move(sameInputs), keyChannels_, hashDistinct, inputType, &pool_);
   }
 }
 
@@ -272,6 +289,10 @@ void GroupingSet::addInputForActiveRows(
     const auto& rows = getSelectivityVector(i);
 
     if (aggregates_[i].distinct) {
+      if (distinctAggregations_[i] == nullptr) {
+        // Shares the DistinctAggregations of an earlier aggregate.
+        continue;
+      }
       if (!newGroups.empty()) {
         distinctAggregations_[i]->initializeNewGroups(groups, newGroups);
       }
@@ -365,7 +386,7 @@ std::vector<Accumulator> GroupingSet::accumulators(bool excludeToIntermediate) {
   }
 
   for (const auto& aggregation : distinctAggregations_) {
-    if (aggregation != nullptr) {
+    if (aggregation != nullptr && aggregation->hasAccumulator()) {
       accumulators.push_back(aggregation->accumulator());
     }
   }
@@ -400,7 +421,7 @@ void GroupingSet::createHashTable() {
   }
 
   for (const auto& aggregation : distinctAggregations_) {
-    if (aggregation != nullptr) {
+    if (aggregation != nullptr && aggregation->hasAccumulator()) {
       aggregation->setAllocator(&rows.stringAllocator());
 
       const auto rowColumn = rows.columnAt(numColumns);
@@ -480,7 +501,7 @@ void GroupingSet::initializeGlobalAggregation() {
   }
 
   for (const auto& aggregation : distinctAggregations_) {
-    if (aggregation != nullptr) {
+    if (aggregation != nullptr && aggregation->hasAccumulator()) {
       auto accumulator = aggregation->accumulator();
 
       offset = bits::roundUp(offset, accumulator.alignment());
@@ -543,7 +564,9 @@ void GroupingSet::addGlobalAggregationInput(
     }
 
     if (aggregates_[i].distinct) {
-      distinctAggregations_[i]->addSingleGroupInput(group, input, rows);
+      if (distinctAggregations_[i] != nullptr) {
+        distinctAggregations_[i]->addSingleGroupInput(group, input, rows);
+      }
       continue;
     }
 
@@ -750,11 +773,17 @@ bool GroupingSet::isPartialFull(int64_t maxBytes) {
 }
 
 uint64_t GroupingSet::allocatedBytes() const {
+  uint64_t bytes = 0;
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      bytes += aggregation->allocatedBytes();
+    }
+  }
   if (table_) {
-    return table_->allocatedBytes();
+    return bytes + table_->allocatedBytes();
   }
 
-  return stringAllocator_.retainedSize() + rows_.allocatedBytes();
+  return bytes + stringAllocator_.retainedSize() + rows_.allocatedBytes();
 }
 
 const HashLookup& GroupingSet::hashLookup() const {
@@ -807,7 +836,14 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
   const auto minReservationBytes =
       currentUsage * spillConfig_->minSpillableReservationPct / 100;
   const auto availableReservationBytes = pool_.availableReservation();
-  const auto tableIncrementBytes = table_->hashTableSizeIncrease(input->size());
+  auto tableIncrementBytes = table_->hashTableSizeIncrease(input->size());
+  // The de-duplication tables of distinct aggregations in hash mode grow with
+  // the input but are not spilled.
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      tableIncrementBytes += aggregation->sizeIncrement(input->size());
+    }
+  }
   const auto incrementBytes =
       rows->sizeIncrement(input->size(), outOfLineBytes ? flatBytes * 2 : 0) +
       tableIncrementBytes;
@@ -893,6 +929,9 @@ void GroupingSet::spill(int64_t targetRows, int64_t targetBytes) {
     for (const auto& aggregate : aggregates_) {
       types.push_back(aggregate.intermediateType);
     }
+    if (sortedAggregations_) {
+      types.push_back(sortedAggregations_->spillType());
+    }
     std::vector<std::string> names;
     for (auto i = 0; i < types.size(); ++i) {
       names.push_back(fmt::format("s{}", i));
@@ -936,6 +975,9 @@ void GroupingSet::spill(const RowContainerIterator& rowIterator) {
   for (const auto& aggregate : aggregates_) {
     types.push_back(aggregate.intermediateType);
   }
+  if (sortedAggregations_) {
+    types.push_back(sortedAggregations_->spillType());
+  }
   std::vector<std::string> names;
   for (auto i = 0; i < types.size(); ++i) {
     names.push_back(fmt::format("s{}", i));
@@ -981,6 +1023,15 @@ bool GroupingSet::getOutputWithSpill(
         table_->rows()->stringAllocatorShared());
 
     initializeAggregates(aggregates_, *mergeRows_, false);
+    if (sortedAggregations_) {
+      const auto rowColumn =
+          mergeRows_->columnAt(keyTypes.size() + aggregates_.size());
+      sortedAggregations_->setOffsets(
+          rowColumn.offset(),
+          rowColumn.nullByte(),
+          rowColumn.nullMask(),
+          mergeRows_->rowSizeOffset());
+    }
 
     // Take ownership of the rows and free the hash table. The table will not be
     // needed for producing spill output.
@@ -1074,9 +1125,16 @@ void GroupingSet::initializeRow(SpillMergeStream& keys, char* row) {
   }
   vector_size_t zero = 0;
   for (auto& aggregate : aggregates_) {
+    if (!aggregate.sortingKeys.empty()) {
+      continue;
+    }
     aggregate.function->initializeNewGroups(
         &row, folly::Range<const vector_size_t*>(&zero, 1));
   }
+  if (sortedAggregations_) {
+    sortedAggregations_->initializeNewGroups(
+        &row, folly::Range<const vector_size_t*>(&zero, 1));
+  }
 }
 
 void GroupingSet::extractSpillResult(const RowVectorPtr& result) {
@@ -1098,11 +1156,22 @@ void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
   mergeSelection_.setValid(input.currentIndex(), true);
   mergeSelection_.updateBounds();
   for (auto i = 0; i < aggregates_.size(); ++i) {
+    // The spilled input rows of the sorted aggregations are added below.
+    if (!aggregates_[i].sortingKeys.empty()) {
+      continue;
+    }
     mergeArgs_[0] = input.current().childAt(i + keyChannels_.size());
     aggregates_[i].function->addSingleGroupIntermediateResults(
         row, mergeSelection_, mergeArgs_, false);
   }
   mergeSelection_.setValid(input.currentIndex(), false);
+
+  if (sortedAggregations_) {
+    sortedAggregations_->addSingleGroupSpillInput(
+        row,
+        input.current().childAt(keyChannels_.size() + aggregates_.size()),
+        input.currentIndex());
+  }
 }
 
 void GroupingSet::abandonPartialAggregation() {
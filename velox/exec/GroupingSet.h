@@ -221,9 +221,9 @@ class GroupingSet {
   void extractSpillResult(const RowVectorPtr& result);
 
   // Return a list of accumulators for 'aggregates_', plus one more accumulator
-  // for 'sortedAggregations_', and one for each 'distinctAggregations_'.  When
-  // 'excludeToIntermediate' is true, skip the functions that support
-  // 'toIntermediate'.
+  // for 'sortedAggregations_', and one for each 'distinctAggregations_' that
+  // stores the unique inputs in the groups. When 'excludeToIntermediate' is
+  // true, skip the functions that support 'toIntermediate'.
   std::vector<Accumulator> accumulators(bool excludeToIntermediate);
 
   // Calculates the number of groups to extract from 'rowsWhileReadingSpill_'
@@ -20,6 +20,7 @@
 #include "velox/exec/SortedAggregations.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
+#include "velox/functions/lib/ApproxMostFrequentStreamSummary.h"
 
 namespace facebook::velox::exec {
 
@@ -74,6 +75,31 @@ std::vector<TypePtr> populateAggregateInputs(
   return argTypes;
 }
 
+// Capacity of the summary of the most frequent grouping keys of a partial
+// aggregation.
+constexpr int32_t kHeavyHitterSummaryCapacity = 1'024;
+
+// One in this many input batches is sampled, starting with the first. The
+// grouping keys of the other batches are not decoded.
+constexpr int32_t kHeavyHitterSampleBatchStride = 4;
+
+// One in this many rows of a sampled batch is added to the summary. Odd so
+// that keys alternating between rows are sampled evenly.
+constexpr int32_t kHeavyHitterSampleStride = 17;
+
+// Min number of times a key must be sampled to be a heavy hitter. Keys seen
+// fewer times are noise when few rows have been sampled.
+constexpr int64_t kHeavyHitterMinSampleCount = 8;
+
+// Min percentage of the sampled rows for a key to be a heavy hitter. This is
+// well above the count error of the summary, which is at most 1 /
+// kHeavyHitterSummaryCapacity of the sampled rows.
+constexpr int64_t kHeavyHitterMinPct = 1;
+
+// Min percentage of the sampled rows the heavy hitters must cover together
+// to be worth aggregating.
+constexpr int64_t kHeavyHittersMinCoveragePct = 10;
+
 void verifyIntermediateInputs(
     const std::string& name,
     const std::vector<TypePtr>& types) {
@@ -97,6 +123,10 @@ void verifyIntermediateInputs(
 }
 } // namespace
 
+struct HashAggregation::HeavyHitterSummary {
+  functions::ApproxMostFrequentStreamSummary<uint64_t> summary;
+};
+
 HashAggregation::HashAggregation(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -109,9 +139,14 @@ HashAggregation::HashAggregation(
           aggregationNode->step() == core::AggregationNode::Step::kPartial
               ? "PartialAggregation"
               : "Aggregation",
-          aggregationNode->canSpill(driverCtx->queryConfig())
+          aggregationNode->canSpill(driverCtx->queryConfig()) &&
+                  !usePartitions(
+                      *aggregationNode,
+                      driverCtx->queryConfig(),
+                      driverCtx->task->numDrivers(driverCtx->pipelineId))
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
+      aggregationNode_(aggregationNode),
       isPartialOutput_(isPartialOutput(aggregationNode->step())),
       isGlobal_(aggregationNode->groupingKeys().empty()),
       isDistinct_(!isGlobal_ && aggregationNode->aggregates().empty()),
@@ -122,37 +157,104 @@ HashAggregation::HashAggregation(
       abandonPartialAggregationMinRows_(
           driverCtx->queryConfig().abandonPartialAggregationMinRows()),
       abandonPartialAggregationMinPct_(
-          driverCtx->queryConfig().abandonPartialAggregationMinPct()) {
+          driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      keepHeavyHitters_(
+          isPartialOutput_ && !isGlobal_ && !isDistinct_ &&
+          driverCtx->queryConfig()
+              .abandonPartialAggregationKeepHeavyHitters()) {
   VELOX_CHECK(pool()->trackUsage());
 
-  auto inputType = aggregationNode->sources()[0]->outputType();
+  const auto& inputType = aggregationNode->sources()[0]->outputType();
+  std::vector<column_index_t> keyChannels;
+  keyChannels.reserve(aggregationNode->groupingKeys().size());
+  for (const auto& key : aggregationNode->groupingKeys()) {
+    keyChannels.push_back(exprToChannel(key.get(), inputType));
+  }
+
+  if (isDistinct_) {
+    for (auto i = 0; i < keyChannels.size(); ++i) {
+      identityProjections_.emplace_back(keyChannels[i], i);
+    }
+  }
+
+  if (keepHeavyHitters_) {
+    keyHashers_ =
+        createVectorHashers(inputType, aggregationNode->groupingKeys());
+    heavyHitterSummary_ = std::make_unique<HeavyHitterSummary>();
+    heavyHitterSummary_->summary.setCapacity(kHeavyHitterSummaryCapacity);
+  }
+
+  if (!usePartitions(
+          *aggregationNode,
+          driverCtx->queryConfig(),
+          driverCtx->task->numDrivers(driverCtx->pipelineId))) {
+    groupingSet_ = createGroupingSet(
+        *aggregationNode, &nonReclaimableSection_, &numSpillRuns_);
+    return;
+  }
+
+  // The drivers are all created before any of them runs, so the GroupingSets
+  // of all the ranges exist before the first input is added.
+  partitions_ = operatorCtx_->task()->getAggregationPartitions(
+      driverCtx->splitGroupId, planNodeId());
+  for (auto partition = driverCtx->partitionId;
+       partition < partitions_->numPartitions();
+       partition += partitions_->numDrivers()) {
+    VELOX_CHECK_EQ(partitions_->owner(partition), driverCtx->partitionId);
+    auto& state = partitions_->partition(partition);
+    state.groupingSet = createGroupingSet(
+        *aggregationNode, &state.nonReclaimableSection, &state.numSpillRuns);
+  }
+  partitionFunction_ = std::make_unique<HashPartitionFunction>(
+      partitions_->hashBits(), inputType, keyChannels);
+  outputPartition_ = driverCtx->partitionId;
+}
+
+HashAggregation::~HashAggregation() = default;
+
+// static
+bool HashAggregation::usePartitions(
+    const core::AggregationNode& aggregationNode,
+    const core::QueryConfig& queryConfig,
+    uint32_t numDrivers) {
+  return queryConfig.partitionedAggregationEnabled() && numDrivers > 1 &&
+      !isPartialOutput(aggregationNode.step()) &&
+      !aggregationNode.groupingKeys().empty() &&
+      !aggregationNode.aggregates().empty() &&
+      aggregationNode.preGroupedKeys().empty();
+}
+
+std::unique_ptr<GroupingSet> HashAggregation::createGroupingSet(
+    const core::AggregationNode& aggregationNode,
+    tsan_atomic<bool>* nonReclaimableSection,
+    uint32_t* numSpillRuns) {
+  auto inputType = aggregationNode.sources()[0]->outputType();
 
-  auto hashers =
-      createVectorHashers(inputType, aggregationNode->groupingKeys());
+  auto hashers = createVectorHashers(inputType, aggregationNode.groupingKeys());
   auto numHashers = hashers.size();
 
   std::vector<column_index_t> preGroupedChannels;
-  preGroupedChannels.reserve(aggregationNode->preGroupedKeys().size());
-  for (const auto& key : aggregationNode->preGroupedKeys()) {
+  preGroupedChannels.reserve(aggregationNode.preGroupedKeys().size());
+  for (const auto& key : aggregationNode.preGroupedKeys()) {
     auto channel = exprToChannel(key.get(), inputType);
     preGroupedChannels.push_back(channel);
   }
 
-  auto numAggregates = aggregationNode->aggregates().size();
+  auto numAggregates = aggregationNode.aggregates().size();
   std::vector<AggregateInfo> aggregateInfos;
   aggregateInfos.reserve(numAggregates);
 
   std::shared_ptr<core::ExpressionEvaluator> expressionEvaluator;
 
   for (auto i = 0; i < numAggregates; i++) {
-    const auto& aggregate = aggregationNode->aggregates()[i];
+    const auto& aggregate = aggregationNode.aggregates()[i];
 
     AggregateInfo info;
     info.distinct = aggregate.distinct;
     auto argTypes =
         populateAggregateInputs(aggregate, inputType->asRow(), info, pool());
 
-    if (isRawInput(aggregationNode->step())) {
+    if (isRawInput(aggregationNode.step())) {
       info.intermediateType =
           Aggregate::intermediateType(aggregate.call->name(), argTypes);
     } else {
@@ -170,10 +272,10 @@ HashAggregation::HashAggregation(
     const auto& resultType = outputType_->childAt(numHashers + i);
     info.function = Aggregate::create(
         aggregate.call->name(),
-        aggregationNode->step(),
+        aggregationNode.step(),
         argTypes,
         resultType,
-        driverCtx->queryConfig());
+        operatorCtx_->driverCtx()->queryConfig());
 
     auto lambdas = extractLambdaInputs(aggregate);
     if (!lambdas.empty()) {
@@ -209,26 +311,20 @@ HashAggregation::HashAggregation(
         "Unexpected result type for an aggregation: {}, expected {}, step {}",
         aggResultType->toString(),
         expectedType->toString(),
-        core::AggregationNode::stepName(aggregationNode->step()));
+        core::AggregationNode::stepName(aggregationNode.step()));
   }
 
-  if (isDistinct_) {
-    for (auto i = 0; i < hashers.size(); ++i) {
-      identityProjections_.emplace_back(hashers[i]->channel(), i);
-    }
-  }
-
-  groupingSet_ = std::make_unique<GroupingSet>(
+  return std::make_unique<GroupingSet>(
       inputType,
       std::move(hashers),
       std::move(preGroupedChannels),
       std::move(aggregateInfos),
-      aggregationNode->ignoreNullKeys(),
+      aggregationNode.ignoreNullKeys(),
       isPartialOutput_,
-      isRawInput(aggregationNode->step()),
+      isRawInput(aggregationNode.step()),
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr,
-      &numSpillRuns_,
-      &nonReclaimableSection_,
+      numSpillRuns,
+      nonReclaimableSection,
       operatorCtx_.get());
 }
 
@@ -244,10 +340,22 @@ void HashAggregation::addInput(RowVectorPtr input) {
     pushdownChecked_ = true;
   }
   if (abandonedPartialAggregation_) {
-    input_ = input;
+    numInputRows_ += input->size();
+    if (heavyHitterGroupingSet_ != nullptr) {
+      addHeavyHitterInput(input);
+    } else {
+      input_ = input;
+    }
+    return;
+  }
+  if (partitions_ != nullptr) {
+    addPartitionedInput(input);
     numInputRows_ += input->size();
     return;
   }
+  if (keepHeavyHitters_) {
+    sampleHeavyHitters(input);
+  }
   groupingSet_->addInput(input, mayPushdown_);
   numInputRows_ += input->size();
 
@@ -279,6 +387,215 @@ void HashAggregation::addInput(RowVectorPtr input) {
   }
 }
 
+void HashAggregation::addPartitionedInput(const RowVectorPtr& input) {
+  const auto numInput = input->size();
+  partitionFunction_->partition(*input, inputPartitions_);
+
+  // Loads all the columns since the rows queued for a peer are decoded on
+  // the peer's thread.
+  std::vector<VectorPtr> loadedChildren;
+  loadedChildren.reserve(input->childrenSize());
+  for (const auto& child : input->children()) {
+    loadedChildren.push_back(BaseVector::loadedVectorShared(child));
+  }
+  auto loadedInput = std::make_shared<RowVector>(
+      input->pool(),
+      input->type(),
+      input->nulls(),
+      numInput,
+      std::move(loadedChildren));
+
+  const auto numPartitions = partitions_->numPartitions();
+  partitionSizes_.assign(numPartitions, 0);
+  for (auto row = 0; row < numInput; ++row) {
+    ++partitionSizes_[inputPartitions_[row]];
+  }
+
+  std::vector<BufferPtr> indices(numPartitions);
+  std::vector<vector_size_t*> rawIndices(numPartitions);
+  for (auto partition = 0; partition < numPartitions; ++partition) {
+    const auto size = partitionSizes_[partition];
+    if (size > 0 && size < numInput) {
+      indices[partition] = allocateIndices(size, pool());
+      rawIndices[partition] = indices[partition]->asMutable<vector_size_t>();
+    }
+    partitionSizes_[partition] = 0;
+  }
+  for (auto row = 0; row < numInput; ++row) {
+    const auto partition = inputPartitions_[row];
+    if (rawIndices[partition] != nullptr) {
+      rawIndices[partition][partitionSizes_[partition]] = row;
+    }
+    ++partitionSizes_[partition];
+  }
+
+  // Rows of 'input' that fall in a range are added or queued as a dictionary
+  // over 'input'. The range locks are only held to queue.
+  const auto driverId = operatorCtx_->driverCtx()->partitionId;
+  vector_size_t numPeerRows = 0;
+  for (auto partition = 0; partition < numPartitions; ++partition) {
+    const auto size = partitionSizes_[partition];
+    if (size == 0) {
+      continue;
+    }
+    auto partitionInput = wrap(size, indices[partition], loadedInput);
+    auto& state = partitions_->partition(partition);
+    if (partitions_->owner(partition) == driverId) {
+      state.groupingSet->addInput(partitionInput, false);
+      continue;
+    }
+    numPeerRows += size;
+    std::lock_guard<std::mutex> l(state.mutex);
+    // The owner frees the GroupingSet on close, which precedes the barrier
+    // only if the task has failed.
+    if (state.groupingSet != nullptr) {
+      state.pendingInputs.push_back(std::move(partitionInput));
+    }
+  }
+  if (numPeerRows > 0) {
+    addRuntimeStat("numPeerPartitionRows", RuntimeCounter(numPeerRows));
+  }
+  addPendingInputs();
+}
+
+void HashAggregation::addPendingInputs() {
+  std::vector<RowVectorPtr> inputs;
+  for (auto partition = outputPartition_;
+       partition < partitions_->numPartitions();
+       partition += partitions_->numDrivers()) {
+    auto& state = partitions_->partition(partition);
+    {
+      std::lock_guard<std::mutex> l(state.mutex);
+      inputs.swap(state.pendingInputs);
+    }
+    for (const auto& input : inputs) {
+      state.groupingSet->addInput(input, false);
+    }
+    inputs.clear();
+  }
+}
+
+void HashAggregation::hashKeys(
+    const RowVectorPtr& input,
+    const SelectivityVector* rows) {
+  // Decodes all rows so that lazy keys are loaded the same way as by the
+  // GroupingSet.
+  allRows_.resize(input->size());
+  allRows_.setAll();
+  keyHashes_.resize(input->size());
+  for (auto i = 0; i < keyHashers_.size(); ++i) {
+    auto& hasher = keyHashers_[i];
+    hasher->decode(*input->childAt(hasher->channel()), allRows_);
+    hasher->hash(rows != nullptr ? *rows : allRows_, i > 0, keyHashes_);
+  }
+}
+
+void HashAggregation::sampleHeavyHitters(const RowVectorPtr& input) {
+  if (batchesToNextSample_ > 0) {
+    --batchesToNextSample_;
+    return;
+  }
+  batchesToNextSample_ = kHeavyHitterSampleBatchStride - 1;
+  const auto numInput = input->size();
+  sampleRows_.resize(numInput);
+  sampleRows_.clearAll();
+  // The stride continues across sampled batches.
+  auto sampleRow = nextSampleRow_;
+  for (; sampleRow < numInput; sampleRow += kHeavyHitterSampleStride) {
+    sampleRows_.setValid(sampleRow, true);
+  }
+  nextSampleRow_ = sampleRow - numInput;
+  sampleRows_.updateBounds();
+  hashKeys(input, &sampleRows_);
+  sampleRows_.applyToSelected([&](auto row) {
+    heavyHitterSummary_->summary.insert(keyHashes_[row]);
+    ++numSampledRows_;
+  });
+}
+
+void HashAggregation::selectHeavyHitters() {
+  VELOX_CHECK(heavyHitters_.empty());
+  int64_t numCoveredRows = 0;
+  // topK() returns the keys from the most to the least frequent.
+  for (const auto& [hash, count] :
+       heavyHitterSummary_->summary.topK(heavyHitterSummary_->summary.size())) {
+    if (count < kHeavyHitterMinSampleCount ||
+        count * 100 < numSampledRows_ * kHeavyHitterMinPct) {
+      break;
+    }
+    heavyHitters_.insert(hash);
+    numCoveredRows += count;
+  }
+  if (numCoveredRows * 100 < numSampledRows_ * kHeavyHittersMinCoveragePct) {
+    heavyHitters_.clear();
+    return;
+  }
+  heavyHitterGroupingSet_ = createGroupingSet(
+      *aggregationNode_, &nonReclaimableSection_, &numSpillRuns_);
+  addRuntimeStat("heavyHitterKeys", RuntimeCounter(heavyHitters_.size()));
+}
+
+void HashAggregation::addHeavyHitterInput(const RowVectorPtr& input) {
+  const auto numInput = input->size();
+  hashKeys(input, nullptr);
+
+  BufferPtr heavyIndices = allocateIndices(numInput, pool());
+  BufferPtr otherIndices = allocateIndices(numInput, pool());
+  auto* rawHeavyIndices = heavyIndices->asMutable<vector_size_t>();
+  auto* rawOtherIndices = otherIndices->asMutable<vector_size_t>();
+  vector_size_t numHeavy = 0;
+  vector_size_t numOther = 0;
+  for (auto row = 0; row < numInput; ++row) {
+    if (heavyHitters_.contains(keyHashes_[row])) {
+      rawHeavyIndices[numHeavy++] = row;
+    } else {
+      rawOtherIndices[numOther++] = row;
+    }
+  }
+
+  const auto numGroups = heavyHitterGroupingSet_->numDistinct();
+  if (numHeavy > 0) {
+    heavyHitterGroupingSet_->addInput(
+        numHeavy == numInput ? input : wrap(numHeavy, heavyIndices, input),
+        false);
+  }
+  // The other rows are passed through by getOutput().
+  if (numOther == 0) {
+    input_ = nullptr;
+  } else {
+    input_ = numOther == numInput ? input : wrap(numOther, otherIndices, input);
+  }
+
+  // The heavy hitter rows that did not start a new group are the reduction of
+  // this batch.
+  const auto numNewGroups = heavyHitterGroupingSet_->numDistinct() - numGroups;
+  addRuntimeStat(
+      "heavyHitterReductionPct",
+      RuntimeCounter(100 * (numHeavy - numNewGroups) / numInput));
+
+  if (heavyHitterGroupingSet_->isPartialFull(
+          maxPartialAggregationMemoryUsage_)) {
+    partialFull_ = true;
+  }
+}
+
+RowVectorPtr HashAggregation::getHeavyHitterOutput() {
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  prepareOutput(queryConfig.preferredOutputBatchRows());
+  if (heavyHitterGroupingSet_->getOutput(
+          queryConfig.preferredOutputBatchRows(),
+          queryConfig.preferredOutputBatchBytes(),
+          heavyHitterIterator_,
+          output_)) {
+    numOutputRows_ += output_->size();
+    return output_;
+  }
+  heavyHitterIterator_.reset();
+  heavyHitterGroupingSet_->resetPartial();
+  partialFull_ = false;
+  return nullptr;
+}
+
 void HashAggregation::updateRuntimeStats() {
   // Report range sizes and number of distinct values for the group-by keys.
   const auto& hashers = groupingSet_->hashLookup().hashers;
@@ -368,6 +685,9 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
     pool()->release();
     addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
     abandonedPartialAggregation_ = true;
+    if (keepHeavyHitters_) {
+      selectHeavyHitters();
+    }
     return;
   }
   const int64_t extendedPartialAggregationMemoryUsage = std::min(
@@ -396,18 +716,28 @@ RowVectorPtr HashAggregation::getOutput() {
     input_ = nullptr;
     return nullptr;
   }
+  if (partitions_ != nullptr) {
+    return getPartitionedOutput();
+  }
   if (abandonedPartialAggregation_) {
+    if (input_ != nullptr) {
+      prepareOutput(input_->size());
+      groupingSet_->toIntermediate(input_, output_);
+      numOutputRows_ += input_->size();
+      input_ = nullptr;
+      return output_;
+    }
+    // Flushes the heavy hitter groups at the end of input or when they are
+    // over the partial aggregation memory limit.
+    if (heavyHitterGroupingSet_ != nullptr && (noMoreInput_ || partialFull_)) {
+      if (auto output = getHeavyHitterOutput()) {
+        return output;
+      }
+    }
     if (noMoreInput_) {
       finished_ = true;
     }
-    if (!input_) {
-      return nullptr;
-    }
-    prepareOutput(input_->size());
-    groupingSet_->toIntermediate(input_, output_);
-    numOutputRows_ += input_->size();
-    input_ = nullptr;
-    return output_;
+    return nullptr;
   }
 
   // Produce results if one of the following is true:
@@ -469,7 +799,57 @@ RowVectorPtr HashAggregation::getOutput() {
   return output_;
 }
 
+RowVectorPtr HashAggregation::getPartitionedOutput() {
+  if (!noMoreInput_ || future_.valid()) {
+    return nullptr;
+  }
+
+  // The peers have all finished adding input, so no more rows are queued
+  // after this.
+  addPendingInputs();
+
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  while (outputPartition_ < partitions_->numPartitions()) {
+    auto& groupingSet = partitions_->partition(outputPartition_).groupingSet;
+    // Without pre-grouped keys a GroupingSet has output only after
+    // noMoreInput().
+    if (!groupingSet->hasOutput()) {
+      groupingSet->noMoreInput();
+    }
+    prepareOutput(queryConfig.preferredOutputBatchRows());
+    if (groupingSet->getOutput(
+            queryConfig.preferredOutputBatchRows(),
+            queryConfig.preferredOutputBatchBytes(),
+            resultIterator_,
+            output_)) {
+      numOutputRows_ += output_->size();
+      return output_;
+    }
+    // Frees the range as soon as its output is done.
+    groupingSet.reset();
+    resultIterator_.reset();
+    outputPartition_ += partitions_->numDrivers();
+  }
+  finished_ = true;
+  return nullptr;
+}
+
 void HashAggregation::noMoreInput() {
+  if (partitions_ != nullptr) {
+    Operator::noMoreInput();
+    std::vector<ContinuePromise> promises;
+    std::vector<std::shared_ptr<Driver>> peers;
+    // The last driver to finish adding input continues the others, which then
+    // produce the output of their ranges.
+    if (operatorCtx_->task()->allPeersFinished(
+            planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+      peers.clear();
+      for (auto& promise : promises) {
+        promise.setValue();
+      }
+    }
+    return;
+  }
   groupingSet_->noMoreInput();
   Operator::noMoreInput();
   recordSpillStats();
@@ -477,6 +857,14 @@ void HashAggregation::noMoreInput() {
   pool()->release();
 }
 
+BlockingReason HashAggregation::isBlocked(ContinueFuture* future) {
+  if (!future_.valid()) {
+    return BlockingReason::kNotBlocked;
+  }
+  *future = std::move(future_);
+  return BlockingReason::kWaitForPeers;
+}
+
 bool HashAggregation::isFinished() {
   return finished_;
 }
@@ -526,6 +914,18 @@ void HashAggregation::close() {
 
   output_ = nullptr;
   groupingSet_.reset();
+  heavyHitterGroupingSet_.reset();
+  if (partitions_ != nullptr) {
+    for (auto partition = outputPartition_;
+         partition < partitions_->numPartitions();
+         partition += partitions_->numDrivers()) {
+      auto& state = partitions_->partition(partition);
+      std::lock_guard<std::mutex> l(state.mutex);
+      state.groupingSet.reset();
+      state.pendingInputs.clear();
+    }
+    partitions_.reset();
+  }
 }
 
 void HashAggregation::abort() {
@@ -15,7 +15,11 @@
  */
 #pragma once
 
+#include <folly/container/F14Set.h>
+
+#include "velox/exec/AggregationPartitions.h"
 #include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
@@ -27,6 +31,18 @@ class HashAggregation : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::AggregationNode>& aggregationNode);
 
+  ~HashAggregation() override;
+
+  /// Returns true if 'aggregationNode' run by 'numDrivers' drivers per split
+  /// group splits its groups into hash ranges shared by the drivers instead
+  /// of each driver aggregating its own input. This applies to final
+  /// aggregations with grouping keys when enabled in 'queryConfig'. See
+  /// AggregationPartitions.
+  static bool usePartitions(
+      const core::AggregationNode& aggregationNode,
+      const core::QueryConfig& queryConfig,
+      uint32_t numDrivers);
+
   void addInput(RowVectorPtr input) override;
 
   RowVectorPtr getOutput() override;
@@ -37,9 +53,7 @@ class HashAggregation : public Operator {
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
@@ -51,6 +65,25 @@ class HashAggregation : public Operator {
   void abort() override;
 
  private:
+  // Creates a GroupingSet for 'aggregationNode'. 'nonReclaimableSection' and
+  // 'numSpillRuns' must outlive the GroupingSet.
+  std::unique_ptr<GroupingSet> createGroupingSet(
+      const core::AggregationNode& aggregationNode,
+      tsan_atomic<bool>* nonReclaimableSection,
+      uint32_t* numSpillRuns);
+
+  // Adds the rows of 'input' to the shared hash ranges the rows fall in.
+  // Rows of the ranges owned by this driver are added to their GroupingSets.
+  // The others are queued for the owners.
+  void addPartitionedInput(const RowVectorPtr& input);
+
+  // Adds the rows the peers have queued for the ranges owned by this driver.
+  void addPendingInputs();
+
+  // Produces the output of the hash ranges owned by this driver once all the
+  // peers have finished adding input.
+  RowVectorPtr getPartitionedOutput();
+
   void updateRuntimeStats();
 
   void prepareOutput(vector_size_t size);
@@ -74,6 +107,28 @@ class HashAggregation : public Operator {
   // the inputs.
   void recordSpillStats();
 
+  // Computes the hash of the grouping keys of 'rows' of 'input' into
+  // 'keyHashes_'. Hashes all rows if 'rows' is null.
+  void hashKeys(const RowVectorPtr& input, const SelectivityVector* rows);
+
+  // Adds a sample of the rows of 'input' to 'heavyHitterSummary_'.
+  void sampleHeavyHitters(const RowVectorPtr& input);
+
+  // Invoked when abandoning partial aggregation. Sets 'heavyHitters_' to the
+  // keys that account for a large share of the sampled rows and creates
+  // 'heavyHitterGroupingSet_' for them. Leaves 'heavyHitters_' empty if these
+  // keys don't cover enough rows to be worth aggregating.
+  void selectHeavyHitters();
+
+  // Adds the rows of 'input' with heavy hitter keys to
+  // 'heavyHitterGroupingSet_' and sets 'input_' to the other rows.
+  void addHeavyHitterInput(const RowVectorPtr& input);
+
+  // Returns the next batch of 'heavyHitterGroupingSet_' groups or nullptr and
+  // resets 'heavyHitterGroupingSet_' once all are returned.
+  RowVectorPtr getHeavyHitterOutput();
+
+  const std::shared_ptr<const core::AggregationNode> aggregationNode_;
   const bool isPartialOutput_;
   const bool isGlobal_;
   const bool isDistinct_;
@@ -109,6 +164,54 @@ class HashAggregation : public Operator {
 
   // Possibly reusable output vector.
   RowVectorPtr output_;
+
+  // True if an abandoned partial aggregation keeps aggregating heavy hitter
+  // keys.
+  const bool keepHeavyHitters_;
+
+  // Hashers for the grouping keys used to identify heavy hitters. Separate
+  // from the GroupingSet hashers, which may not be in hash mode.
+  std::vector<std::unique_ptr<VectorHasher>> keyHashers_;
+  raw_vector<uint64_t> keyHashes_;
+  SelectivityVector allRows_;
+  SelectivityVector sampleRows_;
+
+  // Most frequent key hashes over a sample of the input before abandoning
+  // partial aggregation. Defined in the .cpp file, which includes the
+  // space-saving summary from velox/functions/lib.
+  struct HeavyHitterSummary;
+  std::unique_ptr<HeavyHitterSummary> heavyHitterSummary_;
+  int64_t numSampledRows_{0};
+  vector_size_t nextSampleRow_{0};
+  // Number of input batches to skip before sampling the next one.
+  int32_t batchesToNextSample_{0};
+
+  // Key hashes kept aggregating after abandoning partial aggregation.
+  folly::F14FastSet<uint64_t> heavyHitters_;
+
+  // Groups of the heavy hitter keys.
+  std::unique_ptr<GroupingSet> heavyHitterGroupingSet_;
+  RowContainerIterator heavyHitterIterator_;
+
+  // Hash ranges shared with the peer drivers in partitioned mode. Null
+  // otherwise, in which case 'groupingSet_' holds all the groups.
+  std::shared_ptr<AggregationPartitions> partitions_;
+
+  // Maps the grouping keys of each input row to a range of 'partitions_'.
+  std::unique_ptr<HashPartitionFunction> partitionFunction_;
+
+  // Range of each input row. Reused across inputs.
+  std::vector<uint32_t> inputPartitions_;
+
+  // Number of input rows in each range. Reused across inputs.
+  std::vector<vector_size_t> partitionSizes_;
+
+  // Next range to produce output from in partitioned mode.
+  uint32_t outputPartition_{0};
+
+  // Set in partitioned mode while waiting for the peers to finish adding
+  // input.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
 };
 
 } // namespace facebook::velox::exec
@@ -206,14 +206,25 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
   } else {
     spillInputReader_ = spillPartition->createReader();
 
-    const auto startBit = spillPartition->id().partitionBitOffset() +
-        spillConfig.joinPartitionBits;
-    // Disable spilling if exceeding the max spill level and the query might run
-    // out of memory if the restored partition still can't fit in memory.
-    if (spillConfig.exceedJoinSpillLevelLimit(startBit)) {
-      return;
+    const auto& id = spillPartition->id();
+    if (isSkewedSpillPartition(*spillPartition)) {
+      // Recursive spilling can't split the rows of the skewed join keys, so we
+      // spill the rows which don't fit in memory back to the same partition.
+      skewedSpillPartition_ = id.partitionNumber();
+      hashBits = HashBitRange(
+          id.partitionBitOffset(),
+          id.partitionBitOffset() + spillConfig.joinPartitionBits);
+    } else {
+      const auto startBit =
+          id.partitionBitOffset() + spillConfig.joinPartitionBits;
+      // Disable spilling if exceeding the max spill level and the query might
+      // run out of memory if the restored partition still can't fit in memory.
+      if (spillConfig.exceedJoinSpillLevelLimit(startBit)) {
+        return;
+      }
+      hashBits =
+          HashBitRange(startBit, startBit + spillConfig.joinPartitionBits);
     }
-    hashBits = HashBitRange(startBit, startBit + spillConfig.joinPartitionBits);
   }
 
   spiller_ = std::make_unique<Spiller>(
@@ -231,6 +242,9 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
       spillConfig.compressionKind,
       Spiller::pool(),
       spillConfig.executor);
+  if (canBuildSkewedSpillPartitionInChunks()) {
+    spiller_->enableHashSketches();
+  }
 
   const int32_t numPartitions = spiller_->hashBits().numPartitions();
   spillInputIndicesBuffers_.resize(numPartitions);
@@ -239,6 +253,22 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
   spillChildVectors_.resize(tableType_->size());
 }
 
+bool HashBuild::canBuildSkewedSpillPartitionInChunks() const {
+  // NOTE: the hash probe operators probe each table built from a chunk with all
+  // the probe rows of the partition, so a probe row can match the build rows
+  // of several tables but can't tell if it didn't match any.
+  return spillConfig()->joinSpillSkewedKeyPct > 0 &&
+      (isInnerJoin(joinType_) || isRightJoin(joinType_) ||
+       isRightSemiFilterJoin(joinType_));
+}
+
+bool HashBuild::isSkewedSpillPartition(
+    const SpillPartition& spillPartition) const {
+  return canBuildSkewedSpillPartitionInChunks() &&
+      spillPartition.hashSketch().isSkewed(
+          spillConfig()->joinSpillSkewedKeyPct);
+}
+
 bool HashBuild::isInputFromSpill() const {
   return spillInputReader_ != nullptr;
 }
@@ -410,6 +440,28 @@ bool HashBuild::ensureInputFits(RowVectorPtr& input) {
     return true;
   }
 
+  if (skewedSpillPartition_.has_value()) {
+    // The rows in memory are the chunk of the skewed partition to build the
+    // table from. Once out of memory, we spill the rest of the partition
+    // including 'input'.
+    if (spiller_->isAnySpilled()) {
+      return true;
+    }
+    bool reserved = reserveMemory(input);
+    TestValue::adjust(
+        "facebook::velox::exec::HashBuild::ensureInputFits::skewedSpillPartition",
+        &reserved);
+    // NOTE: we always keep the first rows of the partition in memory, even if
+    // the reservation fails. Otherwise the whole partition would be spilled
+    // back and restored again without making progress.
+    if (!reserved && table_->rows()->numRows() > 0) {
+      spiller_->setSkewedPartitionSpilled(skewedSpillPartition_.value());
+    }
+    numSpillRows_ = 0;
+    numSpillBytes_ = 0;
+    return true;
+  }
+
   // NOTE: we simply reserve memory all inputs even though some of them are
   // spilling directly. It is okay as we will accumulate the extra reservation
   // in the operator's memory pool, and won't make any new reservation if there
@@ -525,6 +577,7 @@ void HashBuild::spillInput(const RowVectorPtr& input) {
     activeRows_.setValid(row, false);
     ++numSpillInputs;
     rawSpillInputIndicesBuffers_[partition][numSpillInputs_[partition]++] = row;
+    spiller_->addSpilledRowHash(partition, hashes_[row]);
   }
   if (numSpillInputs == 0) {
     return;
@@ -895,6 +948,7 @@ void HashBuild::setupSpillInput(HashJoinBridge::SpillInput spillInput) {
   table_.reset();
   spiller_.reset();
   spillInputReader_.reset();
+  skewedSpillPartition_.reset();
 
   // Reset the key and dependent channels as the spilled data columns have
   // already been ordered.
@@ -1079,9 +1133,11 @@ void HashBuild::reclaim(
   TestValue::adjust("facebook::velox::exec::HashBuild::reclaim", this);
 
   // NOTE: a hash build operator is reclaimable if it is in the middle of table
-  // build processing and is not under non-reclaimable execution section.
+  // build processing and is not under non-reclaimable execution section. It is
+  // not reclaimable either if restoring a skewed spill partition as the rows in
+  // memory are the next chunk of the partition to build the table from.
   if ((state_ != State::kRunning && state_ != State::kWaitForBuild) ||
-      nonReclaimableSection_) {
+      nonReclaimableSection_ || skewedSpillPartition_.has_value()) {
     // TODO: reduce the log frequency if it is too verbose.
     ++stats.numNonReclaimableAttempts;
     LOG(WARNING) << "Can't reclaim from hash build operator, state_["
@@ -131,9 +131,21 @@ class HashBuild final : public Operator {
   // is not null, then the input is from the spilled data instead of from build
   // source. The function will need to setup a spill input reader to read input
   // from the spilled data for restoring. If the spilled data can't still fit
-  // in memory, then we will recursively spill part(s) of its data on disk.
+  // in memory, then we will recursively spill part(s) of its data on disk,
+  // or spill the rows that don't fit back to 'spillPartition' if it is skewed.
   void setupSpiller(SpillPartition* spillPartition = nullptr);
 
+  // Indicates if skewed spill partitions are detected and built in chunks. It
+  // requires a join type whose output doesn't change if the build rows of a
+  // partition are split between several tables, each probed with all the
+  // probe rows of the partition.
+  bool canBuildSkewedSpillPartitionInChunks() const;
+
+  // Indicates if most of the rows of 'spillPartition' have the same join key,
+  // which recursive spilling can't split. The rows of a skewed partition which
+  // don't fit in memory are spilled back to it to build the next table from.
+  bool isSkewedSpillPartition(const SpillPartition& spillPartition) const;
+
   // Invoked when either there is no more input from the build source or from
   // the spill input reader during the restoring.
   void noMoreInputInternal();
@@ -149,7 +161,9 @@ class HashBuild final : public Operator {
   // also requested group spill and this driver is the last one to reach the
   // group spill barrier. Otherwise, the function returns false to wait for the
   // group spill to run. The operator will transition to 'kWaitForSpill' state
-  // accordingly.
+  // accordingly. If restoring a skewed spill partition, the function spills
+  // 'input' and the rest of the partition's rows back to the partition if the
+  // memory reservation fails, without spilling the rows in memory.
   bool ensureInputFits(RowVectorPtr& input);
 
   // Invoked to ensure there is sufficient memory to build the join table with
@@ -299,6 +313,12 @@ class HashBuild final : public Operator {
   // Used to read input from previously spilled data for restoring.
   std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
 
+  // Set to the partition number of the restoring spill partition if it is
+  // skewed. The table is then built from the rows that fit in memory and the
+  // rest are spilled back to the same partition, which the hash probe
+  // operators see as a spill partition of the table.
+  std::optional<uint32_t> skewedSpillPartition_;
+
   // Reusable memory for spill partition calculation for input data.
   std::vector<uint32_t> spillPartitions_;
 
@@ -56,9 +56,15 @@ bool HashJoinBridge::setHashTable(
 
     if (restoringSpillPartitionId_.has_value()) {
       for (const auto& id : spillPartitionIdSet) {
-        VELOX_DCHECK_LT(
-            restoringSpillPartitionId_->partitionBitOffset(),
-            id.partitionBitOffset());
+        // NOTE: the restoring partition is spilled again if it is skewed and
+        // 'table' is built from a chunk of it.
+        VELOX_DCHECK(
+            id == restoringSpillPartitionId_.value() ||
+                restoringSpillPartitionId_->partitionBitOffset() <
+                    id.partitionBitOffset(),
+            "{} {}",
+            id.toString(),
+            restoringSpillPartitionId_->toString());
       }
     }
 
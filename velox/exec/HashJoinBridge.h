@@ -36,9 +36,11 @@ class HashJoinBridge : public JoinBridge {
   void addBuilder();
 
   /// 'spillPartitionSet' contains the spilled partitions while building
-  /// 'table'. The function returns true if there is spill data to restore
-  /// after HashProbe operators process 'table', otherwise false. This only
-  /// applies if the disk spilling is enabled.
+  /// 'table'. If it contains the restored spill partition, then 'table' is
+  /// built from a chunk of the skewed restored partition and the rest of its
+  /// build rows have been spilled back to it. The function returns true if
+  /// there is spill data to restore after HashProbe operators process 'table',
+  /// otherwise false. This only applies if the disk spilling is enabled.
   bool setHashTable(
       std::unique_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
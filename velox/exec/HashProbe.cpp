@@ -242,6 +242,9 @@ void HashProbe::maybeSetupSpillInput(
   if (spillInputPartitionIds_.empty()) {
     return;
   }
+  probeSkewedChunk_ = restoredPartitionId.has_value() &&
+      spillInputPartitionIds_.contains(restoredPartitionId.value());
+  VELOX_CHECK(!probeSkewedChunk_ || spillInputPartitionIds_.size() == 1);
 
   // If 'spillInputPartitionIds_' is not empty, then we set up a spiller to
   // spill the incoming probe inputs.
@@ -356,6 +359,7 @@ void HashProbe::prepareForSpillRestore() {
   spiller_.reset();
   spillInputReader_.reset();
   spillInputPartitionIds_.clear();
+  probeSkewedChunk_ = false;
   lastProbeIterator_.reset();
 
   VELOX_CHECK(promises_.empty() || lastProber_);
@@ -426,6 +430,12 @@ void HashProbe::spillInput(RowVectorPtr& input) {
         wrap(numSpillInputs, spillInputIndicesBuffers_[partition], input));
   }
 
+  // The spilled rows are also probed against the chunk of their partition in
+  // 'table_'.
+  if (probeSkewedChunk_) {
+    return;
+  }
+
   if (numNonSpillingInput == 0) {
     input = nullptr;
   } else {
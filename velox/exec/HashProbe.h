@@ -593,6 +593,12 @@ class HashProbe : public Operator {
   // 'table_'.
   SpillPartitionIdSet spillInputPartitionIds_;
 
+  // True if 'table_' is built from a chunk of a skewed spill partition and the
+  // build side has spilled the rest of the partition back to it. The probe
+  // inputs are then probed against 'table_' and also spilled to probe the
+  // tables built from the next chunks.
+  bool probeSkewedChunk_{false};
+
   // Used to calculate the spill partition numbers of the probe inputs.
   std::unique_ptr<HashPartitionFunction> spillHashFunction_;
 
@@ -41,6 +41,45 @@ std::string BaseHashTable::modeString(HashMode mode) {
   }
 }
 
+namespace {
+// Returns the byte width of a key of 'kind' that can be compared with memcmp,
+// 0 if not comparable this way.
+int32_t packedKeyWidth(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return 1;
+    case TypeKind::SMALLINT:
+      return 2;
+    case TypeKind::INTEGER:
+      return 4;
+    case TypeKind::BIGINT:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+template <typename T>
+void packKeyColumn(
+    const DecodedVector& decoded,
+    const raw_vector<vector_size_t>& rows,
+    int32_t offset,
+    int32_t rowSize,
+    char* packed) {
+  if (decoded.isIdentityMapping()) {
+    const T* values = decoded.data<T>();
+    for (auto row : rows) {
+      *reinterpret_cast<T*>(packed + row * rowSize + offset) = values[row];
+    }
+    return;
+  }
+  for (auto row : rows) {
+    *reinterpret_cast<T*>(packed + row * rowSize + offset) =
+        decoded.valueAt<T>(row);
+  }
+}
+} // namespace
+
 template <bool ignoreNullKeys>
 HashTable<ignoreNullKeys>::HashTable(
     std::vector<std::unique_ptr<VectorHasher>>&& hashers,
@@ -73,6 +112,14 @@ HashTable<ignoreNullKeys>::HashTable(
       hashMode_ != HashMode::kHash,
       pool);
   nextOffset_ = rows_->nextOffset();
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    const auto size = packedKeyWidth(hashers_[i]->typeKind());
+    if (size == 0 || rows_->columnAt(i).offset() != packedKeySize_) {
+      packedKeySize_ = 0;
+      break;
+    }
+    packedKeySize_ += size;
+  }
 }
 
 class ProbeState {
@@ -322,12 +369,74 @@ char* HashTable<ignoreNullKeys>::insertEntry(
   return group;
 }
 
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::packKeys(HashLookup& lookup) {
+  lookup.packedKeySize = 0;
+  if (packedKeySize_ == 0 || lookup.rows.empty()) {
+    return;
+  }
+  if constexpr (!ignoreNullKeys) {
+    for (const auto& hasher : lookup.hashers) {
+      if (hasher->decodedVector().mayHaveNulls()) {
+        return;
+      }
+    }
+  }
+  // 'lookup.rows' is in ascending order.
+  lookup.packedKeys.resize((lookup.rows.back() + 1) * packedKeySize_);
+  char* packed = lookup.packedKeys.data();
+  for (auto i = 0; i < lookup.hashers.size(); ++i) {
+    const auto& decoded = lookup.hashers[i]->decodedVector();
+    const auto offset = rows_->columnAt(i).offset();
+    switch (packedKeyWidth(lookup.hashers[i]->typeKind())) {
+      case 1:
+        packKeyColumn<int8_t>(
+            decoded, lookup.rows, offset, packedKeySize_, packed);
+        break;
+      case 2:
+        packKeyColumn<int16_t>(
+            decoded, lookup.rows, offset, packedKeySize_, packed);
+        break;
+      case 4:
+        packKeyColumn<int32_t>(
+            decoded, lookup.rows, offset, packedKeySize_, packed);
+        break;
+      case 8:
+        packKeyColumn<int64_t>(
+            decoded, lookup.rows, offset, packedKeySize_, packed);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+  lookup.packedKeySize = packedKeySize_;
+}
+
 template <bool ignoreNullKeys>
 bool HashTable<ignoreNullKeys>::compareKeys(
     const char* group,
     HashLookup& lookup,
     vector_size_t row) {
   int32_t numKeys = lookup.hashers.size();
+  if (lookup.packedKeySize != 0) {
+    if (memcmp(
+            group,
+            lookup.packedKeys.data() + row * lookup.packedKeySize,
+            lookup.packedKeySize) != 0) {
+      return false;
+    }
+    if constexpr (!ignoreNullKeys) {
+      // The probe keys are not null. A null key in 'group' has a 0 value.
+      for (auto i = 0; i < numKeys; ++i) {
+        const auto& column = rows_->columnAt(i);
+        if (RowContainer::isNullAt(
+                group, column.nullByte(), column.nullMask())) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
   // The loop runs at least once. Allow for first comparison to fail
   // before loop end check.
   int32_t i = 0;
@@ -345,6 +454,11 @@ template <bool ignoreNullKeys>
 bool HashTable<ignoreNullKeys>::compareKeys(
     const char* group,
     const char* inserted) {
+  if constexpr (ignoreNullKeys) {
+    if (packedKeySize_ != 0) {
+      return memcmp(group, inserted, packedKeySize_) == 0;
+    }
+  }
   auto numKeys = hashers_.size();
   int32_t i = 0;
   do {
@@ -438,6 +552,7 @@ void HashTable<ignoreNullKeys>::groupProbe(HashLookup& lookup) {
     groupNormalizedKeyProbe(lookup);
     return;
   }
+  packKeys(lookup);
   ProbeState state1;
   ProbeState state2;
   ProbeState state3;
@@ -573,6 +688,7 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
     joinNormalizedKeyProbe(lookup);
     return;
   }
+  packKeys(lookup);
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
   const vector_size_t* rows = lookup.rows.data();
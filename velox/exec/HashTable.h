@@ -47,6 +47,10 @@ struct HashLookup {
   raw_vector<char*> hits;
   // Indices of newly inserted rows (not found during probe).
   std::vector<vector_size_t> newGroups;
+  // If not 0, the keys of each row of input packed back to back,
+  // 'packedKeySize' bytes per row, in the same layout as in the table's rows.
+  int32_t packedKeySize{0};
+  raw_vector<char> packedKeys;
 };
 
 struct HashTableStats {
@@ -702,6 +706,11 @@ class HashTable : public BaseHashTable {
 
   char* insertEntry(HashLookup& lookup, int32_t index, vector_size_t row);
 
+  // Packs the keys of 'lookup.rows' into 'lookup.packedKeys' if
+  // 'packedKeySize_' is not 0 and the keys have no nulls, so that
+  // compareKeys() compares all keys of a row with a single memcmp.
+  void packKeys(HashLookup& lookup);
+
   bool compareKeys(const char* group, HashLookup& lookup, vector_size_t row);
 
   bool compareKeys(const char* group, const char* inserted);
@@ -808,6 +817,11 @@ class HashTable : public BaseHashTable {
   int8_t sizeBits_;
   bool isJoinBuild_ = false;
 
+  // Total size of the keys if these are all fixed width integers. These are
+  // at the start of a row, back to back, so that equal keys have equal bytes.
+  // 0 if the keys are compared one at a time.
+  int32_t packedKeySize_{0};
+
   // Set at join build time if the table has duplicates, meaning that
   // the join can be cardinality increasing. Atomic for tsan because
   // many threads can set this.
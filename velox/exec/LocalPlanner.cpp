@@ -669,6 +669,21 @@ std::vector<core::PlanNodeId> DriverFactory::needsNestedLoopJoinBridges()
   return planNodeIds;
 }
 
+std::vector<core::PlanNodeId> DriverFactory::needsAggregationPartitions(
+    const core::QueryConfig& queryConfig) const {
+  std::vector<core::PlanNodeId> planNodeIds;
+  for (const auto& planNode : planNodes) {
+    if (auto aggregationNode =
+            std::dynamic_pointer_cast<const core::AggregationNode>(planNode)) {
+      if (HashAggregation::usePartitions(
+              *aggregationNode, queryConfig, numDrivers)) {
+        planNodeIds.emplace_back(aggregationNode->id());
+      }
+    }
+  }
+  return planNodeIds;
+}
+
 // static
 void DriverFactory::registerAdapter(DriverAdapter adapter) {
   adapters.push_back(std::move(adapter));
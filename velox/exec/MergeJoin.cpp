@@ -29,11 +29,16 @@ MergeJoin::MergeJoin(
           joinNode->outputType(),
           operatorId,
           joinNode->id(),
-          "MergeJoin"),
+          "MergeJoin",
+          joinNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       outputBatchSize_{outputBatchRows()},
       joinType_{joinNode->joinType()},
       numKeys_{joinNode->leftKeys().size()},
-      joinNode_(joinNode) {
+      joinNode_(joinNode),
+      spillMemoryThreshold_(
+          driverCtx->queryConfig().mergeJoinSpillMemoryThreshold()) {
   VELOX_USER_CHECK(
       joinNode_->isInnerJoin() || joinNode_->isLeftJoin(),
       "Merge join supports only inner and left joins. Other join types are not supported yet.");
@@ -229,6 +234,16 @@ bool MergeJoin::findEndOfMatch(
 }
 
 namespace {
+RowVectorPtr sliceRows(
+    const RowVectorPtr& rows,
+    vector_size_t start,
+    vector_size_t end) {
+  if (start == 0 && end == rows->size()) {
+    return rows;
+  }
+  return std::static_pointer_cast<RowVector>(rows->slice(start, end - start));
+}
+
 void copyRow(
     const RowVectorPtr& source,
     vector_size_t sourceIndex,
@@ -347,6 +362,10 @@ void MergeJoin::prepareOutput() {
 }
 
 bool MergeJoin::addToOutput() {
+  if (rightMatchSpill_ != nullptr) {
+    return addSpilledMatchToOutput();
+  }
+
   prepareOutput();
 
   size_t firstLeftBatch;
@@ -401,6 +420,168 @@ bool MergeJoin::addToOutput() {
   return outputSize_ == outputBatchSize_;
 }
 
+bool MergeJoin::addSpilledMatchToOutput() {
+  prepareOutput();
+
+  if (!rightMatch_->inputs.empty()) {
+    // Spill the rest of the right side rows so that they are all read back in
+    // order.
+    const auto& inputs = rightMatch_->inputs;
+    const auto numRights = inputs.size();
+    for (size_t r = 0; r < numRights; ++r) {
+      const auto start = r == 0 ? rightMatch_->startIndex : 0;
+      const auto end =
+          r == numRights - 1 ? rightMatch_->endIndex : inputs[r]->size();
+      rightMatchSpill_->add(sliceRows(inputs[r], start, end));
+    }
+    rightMatch_->inputs.clear();
+    rightMatchFiles_ = rightMatchSpill_->finishSpill();
+    VELOX_CHECK(!rightMatchFiles_.empty());
+    spillStats_ += rightMatchSpill_->stats();
+  }
+
+  size_t firstLeftBatch;
+  vector_size_t leftStartIndex;
+  if (leftMatch_->cursor) {
+    firstLeftBatch = leftMatch_->cursor->batchIndex;
+    leftStartIndex = leftMatch_->cursor->index;
+  } else {
+    firstLeftBatch = 0;
+    leftStartIndex = leftMatch_->startIndex;
+  }
+
+  size_t numLefts = leftMatch_->inputs.size();
+  for (size_t l = firstLeftBatch; l < numLefts; ++l) {
+    auto left = leftMatch_->inputs[l];
+    auto leftStart = l == firstLeftBatch ? leftStartIndex : 0;
+    auto leftEnd = l == numLefts - 1 ? leftMatch_->endIndex : left->size();
+
+    for (auto i = leftStart; i < leftEnd; ++i) {
+      // Continue reading the spilled right side rows from the cursor
+      // position, otherwise start over.
+      if (rightMatchReader_ == nullptr) {
+        rightMatchReader_ =
+            std::make_unique<SpillFilesReader>(rightMatchFiles_, pool());
+        rightMatchBatchIndex_ = 0;
+      }
+      for (;;) {
+        if (rightMatchBatch_ == nullptr ||
+            rightMatchBatchIndex_ == rightMatchBatch_->size()) {
+          rightMatchBatchIndex_ = 0;
+          if (!rightMatchReader_->nextBatch(rightMatchBatch_)) {
+            break;
+          }
+          continue;
+        }
+        if (outputSize_ == outputBatchSize_) {
+          leftMatch_->setCursor(l, i);
+          return true;
+        }
+        addOutputRow(left, i, rightMatchBatch_, rightMatchBatchIndex_++);
+      }
+      rightMatchReader_.reset();
+      rightMatchBatch_ = nullptr;
+    }
+  }
+
+  leftMatch_.reset();
+  rightMatch_.reset();
+  rightMatchSpill_.reset();
+  rightMatchFiles_.clear();
+
+  return outputSize_ == outputBatchSize_;
+}
+
+bool MergeJoin::testingTriggerSpill() {
+  // Test-only spill path.
+  if (spillConfig_->testSpillPct == 0) {
+    return false;
+  }
+  return folly::hasher<uint64_t>()(++spillTestCounter_) % 100 <=
+      spillConfig_->testSpillPct;
+}
+
+void MergeJoin::maybeSpillRightMatch() {
+  if (!canSpill()) {
+    return;
+  }
+  if (testingTriggerSpill() ||
+      (spillMemoryThreshold_ != 0 &&
+       spillableRightMatchBytes() > spillMemoryThreshold_)) {
+    spillRightMatch();
+  }
+}
+
+void MergeJoin::spillRightMatch() {
+  VELOX_CHECK(rightMatch_.has_value());
+  VELOX_CHECK(!rightMatch_->complete);
+  auto& inputs = rightMatch_->inputs;
+  if (inputs.size() <= 1) {
+    return;
+  }
+  if (rightMatchSpill_ == nullptr) {
+    rightMatchSpill_ = std::make_unique<SpillableVectorBuffer>(
+        &spillConfig_.value(), Spiller::pool(), &numSpillRuns_);
+  }
+  for (size_t r = 0; r + 1 < inputs.size(); ++r) {
+    const auto start = r == 0 ? rightMatch_->startIndex : 0;
+    rightMatchSpill_->add(sliceRows(inputs[r], start, inputs[r]->size()));
+  }
+  rightMatchSpill_->spill();
+  inputs.erase(inputs.begin(), inputs.end() - 1);
+  rightMatch_->startIndex = 0;
+  spillableRightMatchBytes_ = 0;
+}
+
+bool MergeJoin::reclaimableBytes(uint64_t& reclaimableBytes) const {
+  reclaimableBytes = 0;
+  if (!canReclaim()) {
+    return false;
+  }
+  // The buffered right side batches are allocated from the pools of the right
+  // side operators, so they are not in the reserved bytes of this operator.
+  reclaimableBytes = pool()->reservedBytes() + spillableRightMatchBytes();
+  return true;
+}
+
+void MergeJoin::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  VELOX_CHECK(canReclaim());
+
+  // NOTE: a merge join operator is only reclaimable if it is collecting a right
+  // side match which spans multiple batches and is not under non-reclaimable
+  // execution section.
+  const auto spillableBytes = spillableRightMatchBytes();
+  if (nonReclaimableSection_ || spillableBytes == 0) {
+    // TODO: reduce the log frequency if it is too verbose.
+    ++stats.numNonReclaimableAttempts;
+    LOG(WARNING) << "Can't reclaim from merge join operator, "
+                 << "nonReclaimableSection_[" << nonReclaimableSection_
+                 << "], spillableBytes[" << spillableBytes << "], "
+                 << pool()->name();
+    return;
+  }
+
+  spillRightMatch();
+  // Release the minimum reserved memory.
+  pool()->release();
+}
+
+void MergeJoin::close() {
+  if (noMoreInput_ && numSpillRuns_ != 0) {
+    recordSpillStats(spillStats_);
+  }
+  rightMatchReader_.reset();
+  rightMatchBatch_.reset();
+  rightMatchFiles_.clear();
+  rightMatchSpill_.reset();
+  if (rightSource_) {
+    rightSource_->close();
+  }
+  Operator::close();
+}
+
 namespace {
 vector_size_t firstNonNull(
     const RowVectorPtr& rowVector,
@@ -432,6 +613,9 @@ RowVectorPtr MergeJoin::getOutput() {
 
   // TODO Finish early if ran out of data on either side of the join.
 
+  // NOTE: the right side match is only spilled by memory arbitration while
+  // this operator is off thread, e.g. waiting for the right side input.
+  NonReclaimableSection guard(this);
   for (;;) {
     auto output = doGetOutput();
     if (output != nullptr && output->size() > 0) {
@@ -486,7 +670,8 @@ RowVectorPtr MergeJoin::doGetOutput() {
   // Check if we ran out of space in the output vector in the middle of the
   // match.
   if (leftMatch_ && leftMatch_->cursor) {
-    VELOX_CHECK(rightMatch_ && rightMatch_->cursor);
+    VELOX_CHECK(
+        rightMatch_ && (rightMatch_->cursor || rightMatchReader_ != nullptr));
 
     // Not all rows from the last match fit in the output. Continue producing
     // results from the current match.
@@ -520,6 +705,11 @@ RowVectorPtr MergeJoin::doGetOutput() {
 
     if (rightInput_) {
       if (!findEndOfMatch(rightMatch_.value(), rightInput_, rightKeys_)) {
+        // The batch before the one just added can now be spilled.
+        const auto& inputs = rightMatch_->inputs;
+        spillableRightMatchBytes_ +=
+            inputs[inputs.size() - 2]->estimateFlatSize();
+        maybeSpillRightMatch();
         // Continue looking for the end of the match.
         rightInput_ = nullptr;
         return nullptr;
@@ -537,6 +727,8 @@ RowVectorPtr MergeJoin::doGetOutput() {
       // Need more input.
       return nullptr;
     }
+    // The right side match is complete and is all needed for output.
+    spillableRightMatchBytes_ = 0;
   }
 
   // There is no output-in-progress match, but there can be a complete match
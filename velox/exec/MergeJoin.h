@@ -18,6 +18,7 @@
 
 #include "velox/exec/MergeSource.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/SpillableVectorBuffer.h"
 
 namespace facebook::velox::exec {
 class MergeJoin : public Operator {
@@ -39,12 +40,12 @@ class MergeJoin : public Operator {
 
   bool isFinished() override;
 
-  void close() override {
-    if (rightSource_) {
-      rightSource_->close();
-    }
-    Operator::close();
-  }
+  bool reclaimableBytes(uint64_t& reclaimableBytes) const override;
+
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
+  void close() override;
 
  private:
   // Sets up 'filter_' and related member variables.
@@ -164,6 +165,30 @@ class MergeJoin : public Operator {
   // rightMatchCursor_ if output_ filled up before all rows were added.
   bool addToOutput();
 
+  // Same as addToOutput() but for a right side match that has spilled. Reads
+  // the spilled right side rows back once for each left side row.
+  // 'leftMatch_->cursor' and 'rightMatchReader_' hold the position to continue
+  // from if output_ filled up before all the rows were added.
+  bool addSpilledMatchToOutput();
+
+  // Invoked to check if it needs to trigger spilling for test purpose only.
+  bool testingTriggerSpill();
+
+  // Returns the estimated bytes of the rows of an incomplete 'rightMatch_' that
+  // can be spilled. These are all but the last batch, which is needed to find
+  // the end of the match. Can be called concurrently, e.g. by memory
+  // arbitration.
+  uint64_t spillableRightMatchBytes() const {
+    return spillableRightMatchBytes_;
+  }
+
+  // Spills the rows of an incomplete 'rightMatch_' if they exceed
+  // 'spillMemoryThreshold_'.
+  void maybeSpillRightMatch();
+
+  // Spills the rows of an incomplete 'rightMatch_' except for the last batch.
+  void spillRightMatch();
+
   // Adds one row of output by copying values from left and right batches at the
   // specified rows. Advances outputSize_. Assumes that output_ has room.
   //
@@ -398,6 +423,38 @@ class MergeJoin : public Operator {
   // A set of rows with matching keys on the right side.
   std::optional<Match> rightMatch_;
 
+  // The estimated bytes of all but the last batch of an incomplete
+  // 'rightMatch_'. Updated by the driver thread as batches are added to and
+  // spilled from the match, and read by memory arbitration.
+  tsan_atomic<uint64_t> spillableRightMatchBytes_{0};
+
+  // The maximum size of the right side rows with matching keys that can be
+  // held in memory before spilling. Zero indicates no limit.
+  const uint64_t spillMemoryThreshold_;
+
+  // Holds the spilled rows of 'rightMatch_'. Set on the first spill of the
+  // match and reset after the match has been added to the output.
+  std::unique_ptr<SpillableVectorBuffer> rightMatchSpill_;
+
+  // The spilled rows of a complete 'rightMatch_', including the rows that
+  // were in memory when the match completed.
+  SpillFiles rightMatchFiles_;
+
+  // Reads 'rightMatchFiles_' for the left side row being joined.
+  std::unique_ptr<SpillFilesReader> rightMatchReader_;
+
+  // The batch read by 'rightMatchReader_' and the row number in it to join
+  // next.
+  RowVectorPtr rightMatchBatch_;
+  vector_size_t rightMatchBatchIndex_{0};
+
+  // The stats of the spilled right side matches.
+  SpillStats spillStats_;
+
+  // Counts right side match batches and triggers spilling if folly hash of
+  // this % 100 <= 'testSpillPct'.
+  uint64_t spillTestCounter_{0};
+
   RowVectorPtr output_;
 
   // Number of rows accumulated in the output_.
@@ -14,15 +14,19 @@
  * limitations under the License.
  */
 #include "velox/exec/NestedLoopJoinBuild.h"
+#include "velox/exec/Spiller.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
 
-void NestedLoopJoinBridge::setData(std::vector<RowVectorPtr> buildVectors) {
+void NestedLoopJoinBridge::setData(
+    std::vector<RowVectorPtr> buildVectors,
+    SpillFiles spillFiles) {
   std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(!buildVectors_.has_value(), "setData must be called only once");
+    spillFiles_ = std::move(spillFiles);
     buildVectors_ = std::move(buildVectors);
     promises = std::move(promises_);
   }
@@ -50,16 +54,73 @@ NestedLoopJoinBuild::NestedLoopJoinBuild(
           nullptr,
           operatorId,
           joinNode->id(),
-          "NestedLoopJoinBuild") {}
+          "NestedLoopJoinBuild",
+          joinNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
+      spillMemoryThreshold_(
+          driverCtx->queryConfig().nestedLoopJoinSpillMemoryThreshold()),
+      dataVectors_(std::make_unique<SpillableVectorBuffer>(
+          spillConfig_.has_value() ? &spillConfig_.value() : nullptr,
+          Spiller::pool(),
+          &numSpillRuns_)) {}
 
 void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
-  if (input->size() > 0) {
-    // Load lazy vectors before storing.
-    for (auto& child : input->children()) {
-      child->loadedVector();
-    }
-    dataVectors_.emplace_back(std::move(input));
+  NonReclaimableSection guard(this);
+  dataVectors_->add(std::move(input));
+  if (!canSpill()) {
+    return;
+  }
+  if (testingTriggerSpill() ||
+      (spillMemoryThreshold_ != 0 &&
+       dataVectors_->inMemoryBytes() > spillMemoryThreshold_)) {
+    dataVectors_->spill();
+  }
+}
+
+bool NestedLoopJoinBuild::testingTriggerSpill() {
+  // Test-only spill path.
+  if (spillConfig_->testSpillPct == 0) {
+    return false;
+  }
+  return folly::hasher<uint64_t>()(++spillTestCounter_) % 100 <=
+      spillConfig_->testSpillPct;
+}
+
+bool NestedLoopJoinBuild::reclaimableBytes(uint64_t& reclaimableBytes) const {
+  reclaimableBytes = 0;
+  if (!canReclaim()) {
+    return false;
+  }
+  reclaimableBytes = pool()->reservedBytes();
+  if (!noMoreInput_ && dataVectors_ != nullptr) {
+    reclaimableBytes += dataVectors_->inMemoryBytes();
   }
+  return true;
+}
+
+void NestedLoopJoinBuild::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  VELOX_CHECK(canReclaim());
+
+  // NOTE: a nested loop join build operator is reclaimable if it hasn't
+  // finished the input processing and is not under non-reclaimable execution
+  // section. The build side vectors are handed over to the probe side after
+  // that.
+  if (noMoreInput_ || nonReclaimableSection_ || dataVectors_ == nullptr) {
+    // TODO: reduce the log frequency if it is too verbose.
+    ++stats.numNonReclaimableAttempts;
+    LOG(WARNING) << "Can't reclaim from nested loop join build operator, "
+                 << "noMoreInput_[" << noMoreInput_
+                 << "], nonReclaimableSection_[" << nonReclaimableSection_
+                 << "], " << pool()->name();
+    return;
+  }
+
+  dataVectors_->spill();
+  // Release the minimum reserved memory.
+  pool()->release();
 }
 
 BlockingReason NestedLoopJoinBuild::isBlocked(ContinueFuture* future) {
@@ -72,6 +133,11 @@ BlockingReason NestedLoopJoinBuild::isBlocked(ContinueFuture* future) {
 
 void NestedLoopJoinBuild::noMoreInput() {
   Operator::noMoreInput();
+  spillFiles_ = dataVectors_->finishSpill();
+  if (dataVectors_->spilled()) {
+    recordSpillStats(dataVectors_->stats());
+  }
+
   std::vector<ContinuePromise> promises;
   std::vector<std::shared_ptr<Driver>> peers;
   // The last Driver to hit NestedLoopJoinBuild::finish gathers the data from
@@ -84,6 +150,7 @@ void NestedLoopJoinBuild::noMoreInput() {
     return;
   }
 
+  auto& dataVectors = dataVectors_->vectors();
   {
     auto promisesGuard = folly::makeGuard([&]() {
       // Realize the promises so that the other Drivers (which were not
@@ -98,17 +165,20 @@ void NestedLoopJoinBuild::noMoreInput() {
       auto op = peer->findOperator(planNodeId());
       auto* build = dynamic_cast<NestedLoopJoinBuild*>(op);
       VELOX_CHECK_NOT_NULL(build);
-      dataVectors_.insert(
-          dataVectors_.begin(),
-          build->dataVectors_.begin(),
-          build->dataVectors_.end());
+      auto& peerDataVectors = build->dataVectors_->vectors();
+      dataVectors.insert(
+          dataVectors.begin(), peerDataVectors.begin(), peerDataVectors.end());
+      for (auto& file : build->spillFiles_) {
+        spillFiles_.push_back(std::move(file));
+      }
+      build->spillFiles_.clear();
     }
   }
 
   operatorCtx_->task()
       ->getNestedLoopJoinBridge(
           operatorCtx_->driverCtx()->splitGroupId, planNodeId())
-      ->setData(std::move(dataVectors_));
+      ->setData(std::move(dataVectors), std::move(spillFiles_));
 }
 
 bool NestedLoopJoinBuild::isFinished() {
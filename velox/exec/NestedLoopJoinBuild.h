@@ -17,17 +17,31 @@
 
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/SpillableVectorBuffer.h"
 
 namespace facebook::velox::exec {
 
 class NestedLoopJoinBridge : public JoinBridge {
  public:
-  void setData(std::vector<RowVectorPtr> buildVectors);
+  /// Sets the build side data. 'buildVectors' are in memory and
+  /// 'spillFiles' hold the spilled build side vectors if any.
+  void setData(
+      std::vector<RowVectorPtr> buildVectors,
+      SpillFiles spillFiles = {});
 
   std::optional<std::vector<RowVectorPtr>> dataOrFuture(ContinueFuture* future);
 
+  /// Returns the spilled build side data. Can only be called after
+  /// dataOrFuture() returns the data. The probe operators read the files with
+  /// a SpillFilesReader each.
+  const SpillFiles& spilledData() const {
+    VELOX_CHECK(buildVectors_.has_value());
+    return spillFiles_;
+  }
+
  private:
   std::optional<std::vector<RowVectorPtr>> buildVectors_;
+  SpillFiles spillFiles_;
 };
 
 class NestedLoopJoinBuild : public Operator {
@@ -53,13 +67,40 @@ class NestedLoopJoinBuild : public Operator {
 
   bool isFinished() override;
 
+  /// Returns the estimated bytes of the build side vectors held in memory.
+  /// They are allocated from the upstream operators' pools, so that the
+  /// reserved bytes of the pool of this operator don't account for them.
+  bool reclaimableBytes(uint64_t& reclaimableBytes) const override;
+
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
   void close() override {
-    dataVectors_.clear();
+    dataVectors_.reset();
+    spillFiles_.clear();
     Operator::close();
   }
 
  private:
-  std::vector<RowVectorPtr> dataVectors_;
+  // Invoked to check if it needs to trigger spilling for test purpose only.
+  bool testingTriggerSpill();
+
+  // The maximum size of the build side vectors that can be held in memory
+  // before spilling. Zero indicates no limit.
+  const uint64_t spillMemoryThreshold_;
+
+  // The build side vectors added to this operator. Spills them to disk if
+  // spilling is enabled and they exceed 'spillMemoryThreshold_' or memory
+  // arbitration reclaims memory from this operator.
+  std::unique_ptr<SpillableVectorBuffer> dataVectors_;
+
+  // The spilled build side vectors, set when no more input. The last build
+  // operator gathers the files of all the build operators.
+  SpillFiles spillFiles_;
+
+  // Counts input batches and triggers spilling if folly hash of this % 100 <=
+  // 'testSpillPct'.
+  uint64_t spillTestCounter_{0};
 
   // Future for synchronizing with other Drivers of the same pipeline. All build
   // Drivers must be completed before making data available for the probe side.
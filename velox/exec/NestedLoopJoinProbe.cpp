@@ -108,6 +108,8 @@ void NestedLoopJoinProbe::close() {
   if (joinCondition_ != nullptr) {
     joinCondition_->clear();
   }
+  spilledBuildReader_.reset();
+  spilledBuildVector_.reset();
   buildVectors_.reset();
   Operator::close();
 }
@@ -120,7 +122,7 @@ void NestedLoopJoinProbe::addInput(RowVectorPtr input) {
     child->loadedVector();
   }
   input_ = std::move(input);
-  VELOX_CHECK_EQ(buildIndex_, 0);
+  startBuildScan();
   if (needsProbeMismatch(joinType_)) {
     probeMatched_.resizeFill(input_->size(), false);
   }
@@ -138,12 +140,12 @@ RowVectorPtr NestedLoopJoinProbe::getOutput() {
 
       while (output == nullptr && !hasProbedAllBuildData()) {
         output = getMismatchedOutput(
-            buildVectors_.value()[buildIndex_],
+            currentBuildVector(),
             buildMatched_[buildIndex_],
             buildOutMapping_,
             buildProjections_,
             identityProjections_);
-        ++buildIndex_;
+        advanceBuildIndex();
       }
       if (hasProbedAllBuildData()) {
         setState(ProbeOperatorState::kFinish);
@@ -258,6 +260,8 @@ void NestedLoopJoinProbe::finishProbeInput() {
   VELOX_CHECK_NOT_NULL(input_);
   input_.reset();
   buildIndex_ = 0;
+  spilledBuildReader_.reset();
+  spilledBuildVector_.reset();
   if (!noMoreInput_) {
     return;
   }
@@ -299,8 +303,15 @@ void NestedLoopJoinProbe::beginBuildMismatch() {
     auto* op = peer->findOperator(planNodeId());
     auto* probe = dynamic_cast<NestedLoopJoinProbe*>(op);
     VELOX_CHECK_NOT_NULL(probe);
-    for (auto i = 0; i < buildMatched_.size(); ++i) {
-      buildMatched_[i].select(probe->buildMatched_[i]);
+    // A probe operator only knows the batches of the spilled build side that
+    // it has read, so that the peers might have different sizes.
+    const auto& peerMatched = probe->buildMatched_;
+    for (auto i = 0; i < peerMatched.size(); ++i) {
+      if (i < buildMatched_.size()) {
+        buildMatched_[i].select(peerMatched[i]);
+      } else {
+        buildMatched_.push_back(peerMatched[i]);
+      }
     }
   }
   peers.clear();
@@ -310,6 +321,7 @@ void NestedLoopJoinProbe::beginBuildMismatch() {
   for (auto& promise : promises) {
     promise.setValue();
   }
+  startBuildScan();
 }
 
 bool NestedLoopJoinProbe::getBuildData(ContinueFuture* future) {
@@ -325,18 +337,60 @@ bool NestedLoopJoinProbe::getBuildData(ContinueFuture* future) {
   }
 
   buildVectors_ = std::move(buildData);
-  if (buildVectors_->empty()) {
+  spilledBuildFiles_ =
+      &operatorCtx_->task()
+           ->getNestedLoopJoinBridge(
+               operatorCtx_->driverCtx()->splitGroupId, planNodeId())
+           ->spilledData();
+  if (buildVectors_->empty() && spilledBuildFiles_->empty()) {
     buildSideEmpty_ = true;
   }
   return true;
 }
 
+void NestedLoopJoinProbe::startBuildScan() {
+  VELOX_CHECK_EQ(buildIndex_, 0);
+  VELOX_CHECK_NULL(spilledBuildReader_);
+  if (buildVectors_->empty()) {
+    readSpilledBuildVector();
+  }
+}
+
+void NestedLoopJoinProbe::advanceBuildIndex() {
+  ++buildIndex_;
+  if (buildIndex_ >= buildVectors_->size()) {
+    readSpilledBuildVector();
+  }
+}
+
+void NestedLoopJoinProbe::readSpilledBuildVector() {
+  // Don't reuse the previous batch which might still be referenced by the
+  // output.
+  spilledBuildVector_ = nullptr;
+  if (spilledBuildFiles_->empty()) {
+    return;
+  }
+  if (spilledBuildReader_ == nullptr) {
+    spilledBuildReader_ =
+        std::make_unique<SpillFilesReader>(*spilledBuildFiles_, pool());
+  }
+  if (!spilledBuildReader_->nextBatch(spilledBuildVector_)) {
+    spilledBuildVector_ = nullptr;
+    spilledBuildReader_.reset();
+    return;
+  }
+  if (needsBuildMismatch(joinType_) && buildIndex_ >= buildMatched_.size()) {
+    VELOX_CHECK_EQ(buildIndex_, buildMatched_.size());
+    buildMatched_.emplace_back(spilledBuildVector_->size(), false);
+  }
+}
+
 vector_size_t NestedLoopJoinProbe::getNumProbeRows() const {
   VELOX_CHECK_NOT_NULL(input_);
   VELOX_CHECK(!hasProbedAllBuildData());
 
   const auto inputSize = input_->size();
-  auto numBuildRows = buildVectors_.value()[buildIndex_]->size();
+  auto numBuildRows = currentBuildVector()->size();
   vector_size_t numProbeRows;
   if (numBuildRows > outputBatchSize_) {
     numProbeRows = 1;
@@ -355,7 +409,7 @@ RowVectorPtr NestedLoopJoinProbe::getCrossProduct(
   VELOX_CHECK_GT(probeCnt, 0);
   VELOX_CHECK(!hasProbedAllBuildData());
 
-  const auto buildSize = buildVectors_.value()[buildIndex_]->size();
+  const auto buildSize = currentBuildVector()->size();
   const auto numOutputRows = probeCnt * buildSize;
   const bool probeCntChanged = (probeCnt != numPrevProbedRows_);
   numPrevProbedRows_ = probeCnt;
@@ -386,7 +440,7 @@ RowVectorPtr NestedLoopJoinProbe::getCrossProduct(
       output, input_, probeProjections, numOutputRows, probeIndices_);
   projectChildren(
       output,
-      buildVectors_.value()[buildIndex_],
+      currentBuildVector(),
       buildProjections,
       numOutputRows,
       buildIndices_);
@@ -401,9 +455,8 @@ bool NestedLoopJoinProbe::advanceProbeRows(vector_size_t probeCnt) {
   probeRow_ = 0;
   numPrevProbedRows_ = 0;
   do {
-    ++buildIndex_;
-  } while (!hasProbedAllBuildData() &&
-           !buildVectors_.value()[buildIndex_]->size());
+    advanceBuildIndex();
+  } while (!hasProbedAllBuildData() && !currentBuildVector()->size());
   return hasProbedAllBuildData();
 }
 
@@ -471,7 +524,7 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
       output, input_, identityProjections_, numOutputRows, probeOutMapping_);
   projectChildren(
       output,
-      buildVectors_.value()[buildIndex_],
+      currentBuildVector(),
       buildProjections_,
       numOutputRows,
       buildOutMapping_);
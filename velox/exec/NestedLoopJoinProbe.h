@@ -60,8 +60,29 @@ class NestedLoopJoinProbe : public Operator {
   // given the output batch size limit.
   vector_size_t getNumProbeRows() const;
 
+  // Returns the build side vector at 'buildIndex_'. The in-memory build side
+  // vectors come first, followed by the batches read from the spilled build
+  // side.
+  const RowVectorPtr& currentBuildVector() const {
+    return buildIndex_ < buildVectors_->size()
+        ? buildVectors_.value()[buildIndex_]
+        : spilledBuildVector_;
+  }
+
+  // Sets 'buildIndex_' to the first build side vector. Reads the first batch
+  // of the spilled build side if there are no in-memory build side vectors.
+  void startBuildScan();
+
+  // Advances 'buildIndex_' to the next build side vector. Reads the next batch
+  // of the spilled build side after the in-memory build side vectors.
+  void advanceBuildIndex();
+
+  // Reads the next batch of the spilled build side into
+  // 'spilledBuildVector_'. Sets it to null if all have been read.
+  void readSpilledBuildVector();
+
   // Generates cross product of next 'probeCnt' rows of input_, and all rows of
-  // build side vector at 'buildIndex_' in 'buildData_'.
+  // build side vector at 'buildIndex_'.
   // 'outputType' specifies the type of output.
   // Projections from input_ and buildData_ to the output are specified by
   // 'probeProjections' and 'buildProjections' respectively. Caller is
@@ -85,7 +106,8 @@ class NestedLoopJoinProbe : public Operator {
   bool advanceProbeRows(vector_size_t probeCnt);
 
   bool hasProbedAllBuildData() const {
-    return (buildIndex_ == buildVectors_.value().size());
+    return buildIndex_ >= buildVectors_.value().size() &&
+        spilledBuildVector_ == nullptr;
   }
 
   // Wraps rows of 'data' that are not selected in 'matched' and projects
@@ -146,9 +168,18 @@ class NestedLoopJoinProbe : public Operator {
 
   // Build side state
   std::optional<std::vector<RowVectorPtr>> buildVectors_;
+  // The spilled build side vectors owned by the join bridge. Empty if the
+  // build side didn't spill.
+  const SpillFiles* spilledBuildFiles_{nullptr};
+  // Reads 'spilledBuildFiles_' once for each probe input and once more for the
+  // build side mismatch output. Holds one batch of spilled rows at a time.
+  std::unique_ptr<SpillFilesReader> spilledBuildReader_;
+  // The batch of the spilled build side at 'buildIndex_'.
+  RowVectorPtr spilledBuildVector_;
   bool buildSideEmpty_{false};
-  // Index into buildData_ for the build side vector to process on next call to
-  // getOutput().
+  // Index of the build side vector to process on next call to getOutput(). It
+  // counts the in-memory build side vectors first, then the batches read from
+  // the spilled build side.
   size_t buildIndex_{0};
   std::vector<IdentityProjection> buildProjections_;
   BufferPtr buildIndices_;
@@ -15,6 +15,7 @@
  */
 #include "velox/exec/Operator.h"
 #include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/process/Profiler.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Driver.h"
 #include "velox/exec/HashJoinBridge.h"
@@ -86,9 +87,20 @@ Operator::Operator(
           driverCtx->pipelineId,
           std::move(planNodeId),
           std::move(operatorType)}) {
+  if (driverCtx->queryConfig().operatorProfilingEnabled()) {
+    profileLabel_ = process::internProfileLabel(makeProfileLabel(
+        operatorCtx_->planNodeId(), operatorCtx_->operatorType()));
+  }
   maybeSetReclaimer();
 }
 
+// static
+std::string Operator::makeProfileLabel(
+    const core::PlanNodeId& planNodeId,
+    const std::string& operatorType) {
+  return fmt::format("{}:{}", planNodeId, operatorType);
+}
+
 void Operator::maybeSetReclaimer() {
   VELOX_CHECK_NULL(pool()->reclaimer());
 
@@ -338,6 +350,17 @@ void Operator::recordSpillStats(const SpillStats& spillStats) {
                 Timestamp::kNanosecondsInMicrosecond),
             RuntimeCounter::Unit::kNanos});
   }
+  if (spillStats.spilledSkewedPartitions != 0) {
+    lockedStats->addRuntimeStat(
+        "spilledSkewedPartitions",
+        RuntimeCounter{
+            static_cast<int64_t>(spillStats.spilledSkewedPartitions)});
+  }
+  if (spillStats.spilledSkewedRows != 0) {
+    lockedStats->addRuntimeStat(
+        "spilledSkewedRows",
+        RuntimeCounter{static_cast<int64_t>(spillStats.spilledSkewedRows)});
+  }
   if (numSpillRuns_ != 0) {
     lockedStats->addRuntimeStat(
         "spillRuns", RuntimeCounter{static_cast<int64_t>(numSpillRuns_)});
@@ -653,6 +653,9 @@ class Operator : public BaseRuntimeStatWriter {
 
   folly::Synchronized<OperatorStats> stats_;
 
+  /// See profileLabel().
+  const char* profileLabel_{nullptr};
+
   /// Indicates if an operator is under a non-reclaimable execution section.
   /// This prevents the memory arbitrator from reclaiming memory from this
   /// operator if it happens to be suspended for memory arbitration processing.
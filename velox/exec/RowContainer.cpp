@@ -21,6 +21,12 @@
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/exec/Operator.h"
 
+DEFINE_int32(
+    velox_row_container_prefetch_distance,
+    16,
+    "Number of rows ahead of the current row to prefetch in RowContainer "
+    "column extraction, comparison and hashing. 0 disables prefetching");
+
 namespace facebook::velox::exec {
 namespace {
 template <TypeKind Kind>
@@ -65,12 +71,14 @@ Accumulator::Accumulator(
     int32_t fixedSize,
     bool usesExternalMemory,
     int32_t alignment,
-    std::function<void(folly::Range<char**> groups)> destroyFunction)
+    std::function<void(folly::Range<char**> groups)> destroyFunction,
+    SpillExtractFunction spillExtractFunction)
     : isFixedSize_{isFixedSize},
       fixedSize_{fixedSize},
       usesExternalMemory_{usesExternalMemory},
       alignment_{alignment},
-      destroyFunction_{destroyFunction} {}
+      destroyFunction_{destroyFunction},
+      spillExtractFunction_{std::move(spillExtractFunction)} {}
 
 bool Accumulator::isFixedSize() const {
   return isFixedSize_;
@@ -92,6 +100,17 @@ void Accumulator::destroy(folly::Range<char**> groups) {
   destroyFunction_(groups);
 }
 
+void Accumulator::extractForSpill(
+    folly::Range<char**> groups,
+    VectorPtr& result) const {
+  if (spillExtractFunction_ != nullptr) {
+    spillExtractFunction_(groups, result);
+    return;
+  }
+  VELOX_CHECK_NOT_NULL(aggregate_);
+  aggregate_->extractAccumulators(groups.data(), groups.size(), &result);
+}
+
 // static
 int32_t RowContainer::combineAlignments(int32_t a, int32_t b) {
   VELOX_CHECK_EQ(__builtin_popcount(a), 1, "Alignment can only be power of 2");
@@ -557,7 +576,11 @@ void RowContainer::hashTyped(
   auto offset = column.offset();
   std::string storage;
   auto numRows = rows.size();
+  const auto distance = prefetchDistance();
   for (int32_t i = 0; i < numRows; ++i) {
+    if (distance > 0 && i + distance < numRows) {
+      __builtin_prefetch(rows[i + distance] + offset);
+    }
     char* row = rows[i];
     if (nullable && isNullAt(row, nullByte, nullMask)) {
       result[i] = mix ? bits::hashMix(result[i], BaseVector::kNullHash)
@@ -607,6 +630,46 @@ void RowContainer::hash(
       result);
 }
 
+template <TypeKind Kind>
+void RowContainer::compareTyped(
+    const char* const* left,
+    const char* const* right,
+    int32_t numRows,
+    const Type* type,
+    RowColumn column,
+    CompareFlags flags,
+    int32_t* result) {
+  const auto offset = column.offset();
+  const auto distance = prefetchDistance();
+  for (int32_t i = 0; i < numRows; ++i) {
+    if (distance > 0 && i + distance < numRows) {
+      __builtin_prefetch(left[i + distance] + offset);
+      __builtin_prefetch(right[i + distance] + offset);
+    }
+    result[i] = compare<Kind>(left[i], right[i], type, column, flags);
+  }
+}
+
+void RowContainer::compare(
+    const char* const* left,
+    const char* const* right,
+    int32_t numRows,
+    int32_t columnIndex,
+    CompareFlags flags,
+    int32_t* result) {
+  auto type = types_[columnIndex].get();
+  VELOX_DYNAMIC_TYPE_DISPATCH_ALL(
+      compareTyped,
+      type->kind(),
+      left,
+      right,
+      numRows,
+      type,
+      columnAt(columnIndex),
+      flags,
+      result);
+}
+
 void RowContainer::clear() {
   const bool sharedStringAllocator = !stringAllocator_.unique();
   if (checkFree_ || sharedStringAllocator || usesExternalMemory_) {
@@ -15,6 +15,9 @@
  */
 #pragma once
 
+#include <gflags/gflags.h>
+
+#include "velox/common/base/SimdUtil.h"
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/core/PlanNode.h"
@@ -23,18 +26,26 @@
 #include "velox/vector/FlatVector.h"
 #include "velox/vector/VectorTypeUtils.h"
 
+DECLARE_int32(velox_row_container_prefetch_distance);
+
 namespace facebook::velox::exec {
 
 class Aggregate;
 
 class Accumulator {
  public:
+  using SpillExtractFunction =
+      std::function<void(folly::Range<char**> groups, VectorPtr& result)>;
+
+  /// 'spillExtractFunction' extracts the accumulators of 'groups' into
+  /// 'result' for spilling. The accumulator can be spilled only if it is set.
   Accumulator(
       bool isFixedSize,
       int32_t fixedSize,
       bool usesExternalMemory,
       int32_t alignment,
-      std::function<void(folly::Range<char**> groups)> destroyFunction);
+      std::function<void(folly::Range<char**> groups)> destroyFunction,
+      SpillExtractFunction spillExtractFunction = nullptr);
 
   explicit Accumulator(Aggregate* aggregate);
 
@@ -48,11 +59,9 @@ class Accumulator {
 
   void destroy(folly::Range<char**> groups);
 
-  /// Used only for spilling. Do not introduce other usages.
-  Aggregate* aggregateForSpill() const {
-    VELOX_CHECK_NOT_NULL(aggregate_);
-    return aggregate_;
-  }
+  /// Extracts the accumulators of 'groups' into 'result'. Used only for
+  /// spilling. Do not introduce other usages.
+  void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const;
 
  private:
   const bool isFixedSize_;
@@ -60,6 +69,7 @@ class Accumulator {
   const bool usesExternalMemory_;
   const int32_t alignment_;
   std::function<void(folly::Range<char**> groups)> destroyFunction_;
+  SpillExtractFunction spillExtractFunction_;
   Aggregate* aggregate_{nullptr};
 };
 
@@ -550,6 +560,18 @@ class RowContainer {
       int rightColumnIndex,
       CompareFlags flags = CompareFlags());
 
+  /// Compares the value at 'columnIndex' between 'left[i]' and 'right[i]' for
+  /// each 'i' below 'numRows' and stores the results in 'result'. Same as
+  /// calling compare() for each pair but dispatches on the column type once
+  /// and prefetches the rows ahead of the comparison.
+  void compare(
+      const char* FOLLY_NONNULL const* FOLLY_NONNULL left,
+      const char* FOLLY_NONNULL const* FOLLY_NONNULL right,
+      int32_t numRows,
+      int32_t columnIndex,
+      CompareFlags flags,
+      int32_t* FOLLY_NONNULL result);
+
   // Allows get/set of the normalized key. If normalized keys are
   // used, they are stored in the word immediately below the hash
   // table row.
@@ -705,6 +727,83 @@ class RowContainer {
     return *reinterpret_cast<T*>(group + offset);
   }
 
+  // Returns the number of rows ahead of the current row that column at a time
+  // loops prefetch.
+  static int32_t prefetchDistance() {
+    return std::max(0, FLAGS_velox_row_container_prefetch_distance);
+  }
+
+  // Returns the row at position 'index' of an extraction. The row is null if
+  // 'rows' has a null at 'index' or if the row number at 'index' is negative.
+  template <bool useRowNumbers>
+  static inline const char* FOLLY_NULLABLE rowAt(
+      const char* FOLLY_NONNULL const* FOLLY_NONNULL rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t index) {
+    if constexpr (useRowNumbers) {
+      auto rowNumber = rowNumbers[index];
+      return rowNumber >= 0 ? rows[rowNumber] : nullptr;
+    } else {
+      return rows[index];
+    }
+  }
+
+  // Prefetches the value at 'offset' of the row at position 'index' of an
+  // extraction if there is such a row.
+  template <bool useRowNumbers>
+  static inline void prefetchRow(
+      const char* FOLLY_NONNULL const* FOLLY_NONNULL rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t numRows,
+      int32_t index,
+      int32_t offset) {
+    if (index < numRows) {
+      if (auto row = rowAt<useRowNumbers>(rows, rowNumbers, index)) {
+        __builtin_prefetch(row + offset);
+      }
+    }
+  }
+
+  // True if values of type 'T' are copied out of rows with gather
+  // instructions. The gather loads 8 byte lanes addressed by the row
+  // pointers.
+  template <typename T>
+  static constexpr bool kGatherValues =
+      std::is_arithmetic_v<T> && sizeof(T) == sizeof(int64_t);
+
+  // Copies the values at 'offset' of the first rows of 'rows' to 'values'
+  // with gather instructions, a batch of rows at a time. Stops at the first
+  // batch that has a null row, which the caller handles. Returns the number
+  // of values copied.
+  template <typename T>
+  static int32_t gatherValues(
+      const char* FOLLY_NONNULL const* FOLLY_NONNULL rows,
+      int32_t numRows,
+      int32_t offset,
+      int32_t distance,
+      T* FOLLY_NONNULL values) {
+    static_assert(kGatherValues<T>);
+    using Batch = xsimd::batch<int64_t>;
+    // The gather adds the row pointers to 'offset'.
+    auto base =
+        reinterpret_cast<const int64_t*>(static_cast<uintptr_t>(offset));
+    int32_t i = 0;
+    for (; i + Batch::size <= numRows; i += Batch::size) {
+      auto indices = reinterpret_cast<const int64_t*>(rows + i);
+      if (xsimd::any(Batch::load_unaligned(indices) == Batch(0))) {
+        break;
+      }
+      if (distance > 0) {
+        for (auto j = 0; j < Batch::size; ++j) {
+          prefetchRow<false>(rows, {}, numRows, i + distance + j, offset);
+        }
+      }
+      simd::gather<int64_t, int64_t, 1>(base, indices)
+          .store_unaligned(reinterpret_cast<int64_t*>(values + i));
+    }
+    return i;
+  }
+
   template <TypeKind Kind>
   static void extractColumnTyped(
       const char* FOLLY_NONNULL const* FOLLY_NONNULL rows,
@@ -822,14 +921,13 @@ class RowContainer {
     auto nulls = nullBuffer->asMutable<uint64_t>();
     BufferPtr valuesBuffer = result->mutableValues(maxRows);
     auto values = valuesBuffer->asMutableRange<T>();
+    const auto distance = prefetchDistance();
     for (int32_t i = 0; i < numRows; ++i) {
-      const char* row;
-      if constexpr (useRowNumbers) {
-        auto rowNumber = rowNumbers[i];
-        row = rowNumber >= 0 ? rows[rowNumber] : nullptr;
-      } else {
-        row = rows[i];
+      if (distance > 0) {
+        prefetchRow<useRowNumbers>(
+            rows, rowNumbers, numRows, i + distance, offset);
       }
+      auto row = rowAt<useRowNumbers>(rows, rowNumbers, i);
       auto resultIndex = resultOffset + i;
       if (row == nullptr || isNullAt(row, nullByte, nullMask)) {
         bits::setNull(nulls, resultIndex, true);
@@ -856,19 +954,28 @@ class RowContainer {
     VELOX_DCHECK_LE(maxRows, result->size());
     BufferPtr valuesBuffer = result->mutableValues(maxRows);
     auto values = valuesBuffer->asMutableRange<T>();
-    for (int32_t i = 0; i < numRows; ++i) {
-      const char* row;
-      if constexpr (useRowNumbers) {
-        auto rowNumber = rowNumbers[i];
-        row = rowNumber >= 0 ? rows[rowNumber] : nullptr;
-      } else {
-        row = rows[i];
+    // Clears the nulls left from a previous use of 'result' in bulk. Null
+    // rows set their null bits below.
+    if (result->rawNulls()) {
+      bits::fillBits(
+          result->mutableRawNulls(), resultOffset, maxRows, bits::kNotNull);
+    }
+    const auto distance = prefetchDistance();
+    int32_t i = 0;
+    if constexpr (!useRowNumbers && kGatherValues<T>) {
+      i = gatherValues(
+          rows, numRows, offset, distance, values.data() + resultOffset);
+    }
+    for (; i < numRows; ++i) {
+      if (distance > 0) {
+        prefetchRow<useRowNumbers>(
+            rows, rowNumbers, numRows, i + distance, offset);
       }
+      auto row = rowAt<useRowNumbers>(rows, rowNumbers, i);
       auto resultIndex = resultOffset + i;
       if (row == nullptr) {
         result->setNull(resultIndex, true);
       } else {
-        result->setNull(resultIndex, false);
         if constexpr (std::is_same_v<T, StringView>) {
           extractString(valueAt<StringView>(row, offset), result, resultIndex);
         } else {
@@ -892,6 +999,16 @@ class RowContainer {
       bool mix,
       uint64_t* FOLLY_NONNULL result);
 
+  template <TypeKind Kind>
+  void compareTyped(
+      const char* FOLLY_NONNULL const* FOLLY_NONNULL left,
+      const char* FOLLY_NONNULL const* FOLLY_NONNULL right,
+      int32_t numRows,
+      const Type* FOLLY_NONNULL type,
+      RowColumn column,
+      CompareFlags flags,
+      int32_t* FOLLY_NONNULL result);
+
   template <TypeKind Kind>
   inline bool equalsWithNulls(
       const char* FOLLY_NONNULL row,
@@ -1056,13 +1173,7 @@ class RowContainer {
 
     VELOX_DCHECK_LE(numRows + resultOffset, result->size());
     for (int i = 0; i < numRows; ++i) {
-      const char* row;
-      if constexpr (useRowNumbers) {
-        auto rowNumber = rowNumbers[i];
-        row = rowNumber >= 0 ? rows[rowNumber] : nullptr;
-      } else {
-        row = rows[i];
-      }
+      auto row = rowAt<useRowNumbers>(rows, rowNumbers, i);
       auto resultIndex = resultOffset + i;
       if (!row || isNullAt(row, nullByte, nullMask)) {
         result->setNull(resultIndex, true);
@@ -58,6 +58,11 @@ class SortBuffer {
   /// the rows from 'data_'.
   void spill(int64_t targetRows, int64_t targetBytes);
 
+  /// Returns the bytes of memory held by the buffered input rows.
+  uint64_t bufferedBytes() const {
+    return data_->allocatedBytes();
+  }
+
   /// Returns the spiller stats including total bytes and rows spilled so far.
   std::optional<SpillStats> spilledStats() const {
     if (spiller_ == nullptr) {
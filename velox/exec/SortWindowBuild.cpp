@@ -48,9 +48,6 @@ void SortWindowBuild::addInput(RowVectorPtr input) {
 
 void SortWindowBuild::computePartitionStartRows() {
   partitionStartRows_.reserve(numRows_);
-  auto partitionCompare = [&](const char* lhs, const char* rhs) -> bool {
-    return compareRowsWithKeys(lhs, rhs, partitionKeyInfo_);
-  };
 
   // Using a sequential traversal to find changing partitions.
   // This algorithm is inefficient and can be changed
@@ -60,9 +57,32 @@ void SortWindowBuild::computePartitionStartRows() {
   partitionStartRows_.push_back(0);
 
   VELOX_CHECK_GT(sortedRows_.size(), 0);
-  for (auto i = 1; i < sortedRows_.size(); i++) {
-    if (partitionCompare(sortedRows_[i - 1], sortedRows_[i])) {
-      partitionStartRows_.push_back(i);
+  // The rows are sorted on the partition keys, so a row starts a partition
+  // if any partition key differs from the previous row. Each key is compared
+  // for a batch of adjacent row pairs at a time.
+  constexpr int32_t kBatchSize = 1024;
+  std::array<int32_t, kBatchSize> keyResults;
+  std::array<int32_t, kBatchSize> differs;
+  const int32_t numPairs = sortedRows_.size() - 1;
+  for (int32_t start = 0; start < numPairs; start += kBatchSize) {
+    const auto batchSize = std::min(kBatchSize, numPairs - start);
+    std::fill(differs.begin(), differs.begin() + batchSize, 0);
+    for (const auto& key : partitionKeyInfo_) {
+      data_->compare(
+          sortedRows_.data() + start,
+          sortedRows_.data() + start + 1,
+          batchSize,
+          key.first,
+          {key.second.isNullsFirst(), key.second.isAscending(), false},
+          keyResults.data());
+      for (auto i = 0; i < batchSize; ++i) {
+        differs[i] |= keyResults[i];
+      }
+    }
+    for (auto i = 0; i < batchSize; ++i) {
+      if (differs[i]) {
+        partitionStartRows_.push_back(start + i + 1);
+      }
     }
   }
 
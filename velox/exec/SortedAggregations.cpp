@@ -93,8 +93,10 @@ SortedAggregations::SortedAggregations(
   inputMapping_.resize(inputType->size());
 
   std::vector<TypePtr> types;
+  std::vector<std::string> names;
   for (auto input : allInputs) {
     types.push_back(inputType->childAt(input));
+    names.push_back(inputType->nameOf(input));
 
     inputMapping_[input] = inputs_.size();
     inputs_.push_back(input);
@@ -102,22 +104,69 @@ SortedAggregations::SortedAggregations(
 
   inputData_ = std::make_unique<RowContainer>(types, pool);
   decodedInputs_.resize(inputs_.size());
+  spillType_ = ARRAY(ROW(std::move(names), std::move(types)));
 }
 
 Accumulator SortedAggregations::accumulator() const {
   return {
-      false,
+      false, // isFixedSize
       sizeof(RowPointers),
-      false,
-      1,
+      // The input rows of a group live in 'inputData_', so RowContainer::clear()
+      // must call the destroy function, e.g. when output is spilled.
+      true, // usesExternalMemory
+      1, // alignment
       [this](folly::Range<char**> groups) {
         for (auto* group : groups) {
           auto* accumulator = reinterpret_cast<RowPointers*>(group + offset_);
+          // Frees the input rows, e.g. after the group is spilled.
+          if (accumulator->size > 0) {
+            auto groupRows = accumulator->read(*allocator_);
+            inputData_->eraseRows(
+                folly::Range<char**>(groupRows.data(), groupRows.size()));
+          }
           accumulator->free(*allocator_);
         }
+      },
+      [this](folly::Range<char**> groups, VectorPtr& result) {
+        extractForSpill(groups, result);
       }};
 }
 
+void SortedAggregations::extractForSpill(
+    folly::Range<char**> groups,
+    VectorPtr& result) const {
+  auto* pool = inputData_->pool();
+  auto offsets = allocateOffsets(groups.size(), pool);
+  auto sizes = allocateSizes(groups.size(), pool);
+  auto* rawOffsets = offsets->asMutable<vector_size_t>();
+  auto* rawSizes = sizes->asMutable<vector_size_t>();
+  std::vector<char*> allRows;
+  for (auto i = 0; i < groups.size(); ++i) {
+    auto* accumulator = reinterpret_cast<RowPointers*>(groups[i] + offset_);
+    rawOffsets[i] = allRows.size();
+    rawSizes[i] = accumulator->size;
+    if (accumulator->size > 0) {
+      auto groupRows = accumulator->read(*allocator_);
+      allRows.insert(allRows.end(), groupRows.begin(), groupRows.end());
+    }
+  }
+
+  auto elements = BaseVector::create<RowVector>(
+      spillType_->childAt(0), allRows.size(), pool);
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    inputData_->extractColumn(
+        allRows.data(), allRows.size(), i, elements->childAt(i));
+  }
+  result = std::make_shared<ArrayVector>(
+      pool,
+      spillType_,
+      nullptr,
+      groups.size(),
+      std::move(offsets),
+      std::move(sizes),
+      std::move(elements));
+}
+
 void SortedAggregations::initializeNewGroups(
     char** groups,
     folly::Range<const vector_size_t*> indices) {
@@ -136,6 +185,7 @@ void SortedAggregations::addInput(char** groups, const RowVectorPtr& input) {
   for (auto i = 0; i < inputs_.size(); ++i) {
     decodedInputs_[i].decode(*input->childAt(inputs_[i]));
   }
+  decodedSpillElements_ = nullptr;
 
   // Add all the rows into the RowContainer.
   for (auto row = 0; row < input->size(); ++row) {
@@ -161,6 +211,7 @@ void SortedAggregations::addSingleGroupInput(
   for (auto i = 0; i < inputs_.size(); ++i) {
     decodedInputs_[i].decode(*input->childAt(inputs_[i]));
   }
+  decodedSpillElements_ = nullptr;
 
   // Add all the rows into the RowContainer.
   for (auto row = 0; row < input->size(); ++row) {
@@ -174,6 +225,34 @@ void SortedAggregations::addSingleGroupInput(
   }
 }
 
+void SortedAggregations::addSingleGroupSpillInput(
+    char* group,
+    const VectorPtr& input,
+    vector_size_t index) {
+  const auto* arrayVector = input->wrappedVector()->asUnchecked<ArrayVector>();
+  const auto arrayIndex = input->wrappedIndex(index);
+  const auto& elements = arrayVector->elements();
+  if (elements != decodedSpillElements_) {
+    const auto* rowVector = elements->asUnchecked<RowVector>();
+    for (auto i = 0; i < inputs_.size(); ++i) {
+      decodedInputs_[i].decode(*rowVector->childAt(i));
+    }
+    decodedSpillElements_ = elements;
+  }
+
+  const auto offset = arrayVector->offsetAt(arrayIndex);
+  const auto size = arrayVector->sizeAt(arrayIndex);
+  for (auto row = offset; row < offset + size; ++row) {
+    char* newRow = inputData_->newRow();
+
+    for (auto i = 0; i < inputs_.size(); ++i) {
+      inputData_->store(decodedInputs_[i], row, newRow, i);
+    }
+
+    addNewRow(group, newRow);
+  }
+}
+
 bool SortedAggregations::compareRowsWithKeys(
     const char* lhs,
     const char* rhs,
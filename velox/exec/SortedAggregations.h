@@ -23,7 +23,8 @@
 namespace facebook::velox::exec {
 
 /// Accumulates inputs for aggregations over sorted input, sorts these inputs
-/// and computes aggregates.
+/// and computes aggregates. The accumulated inputs can be spilled together
+/// with the groups, see spillType().
 class SortedAggregations {
  public:
   /// @param aggregates Non-empty list of aggregates that require inputs to be
@@ -38,6 +39,13 @@ class SortedAggregations {
   /// Returns metadata about the accumulator used to store lists of input rows.
   Accumulator accumulator() const;
 
+  /// Returns the type of the accumulator when spilled. An array of the input
+  /// rows of the group with the inputs, sorting keys and masks of all
+  /// aggregates.
+  const TypePtr& spillType() const {
+    return spillType_;
+  }
+
   /// Aggregate-like APIs to aggregate input rows per group.
   void setAllocator(HashStringAllocator* allocator) {
     allocator_ = allocator;
@@ -62,6 +70,13 @@ class SortedAggregations {
 
   void addSingleGroupInput(char* group, const RowVectorPtr& input);
 
+  /// Adds the input rows of 'group' read back from spill, i.e. the array at
+  /// 'index' of 'input' of spillType().
+  void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index);
+
   void noMoreInput();
 
   /// Sorts input row for the specified groups, computes aggregations and stores
@@ -71,6 +86,8 @@ class SortedAggregations {
  private:
   void addNewRow(char* group, char* newRow);
 
+  void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const;
+
   bool compareRowsWithKeys(
       const char* lhs,
       const char* rhs,
@@ -95,6 +112,11 @@ class SortedAggregations {
 
   std::vector<DecodedVector> decodedInputs_;
 
+  TypePtr spillType_;
+  // The elements of the spilled arrays 'decodedInputs_' were decoded from.
+  // Null if 'decodedInputs_' were decoded from input.
+  VectorPtr decodedSpillElements_;
+
   HashStringAllocator* allocator_;
   int32_t offset_;
   int32_t nullByte_;
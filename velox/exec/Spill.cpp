@@ -121,24 +121,52 @@ WriteFile& SpillFile::output() {
 }
 
 void SpillFile::startRead() {
-  constexpr uint64_t kMaxReadBufferSize =
-      (1 << 20) - AlignedBuffer::kPaddedSize; // 1MB - padding.
   VELOX_CHECK(!output_);
   VELOX_CHECK(!input_);
-  auto fs = filesystems::getFileSystem(path_, nullptr);
-  auto file = fs->openFileForRead(path_);
-  auto buffer = AlignedBuffer::allocate<char>(
-      std::min<uint64_t>(fileSize_, kMaxReadBufferSize), pool_);
-  input_ = std::make_unique<SpillInput>(std::move(file), std::move(buffer));
+  input_ = openInput(pool_);
 }
 
 bool SpillFile::nextBatch(RowVectorPtr& rowVector) {
   if (input_->atEnd()) {
     return false;
   }
+  readBatch(input_.get(), pool_, rowVector);
+  return true;
+}
+
+std::unique_ptr<SpillInput> SpillFile::openInput(
+    memory::MemoryPool* pool) const {
+  constexpr uint64_t kMaxReadBufferSize =
+      (1 << 20) - AlignedBuffer::kPaddedSize; // 1MB - padding.
+  auto fs = filesystems::getFileSystem(path_, nullptr);
+  auto file = fs->openFileForRead(path_);
+  auto buffer = AlignedBuffer::allocate<char>(
+      std::min<uint64_t>(fileSize_, kMaxReadBufferSize), pool);
+  return std::make_unique<SpillInput>(std::move(file), std::move(buffer));
+}
+
+void SpillFile::readBatch(
+    SpillInput* input,
+    memory::MemoryPool* pool,
+    RowVectorPtr& rowVector) const {
   serializer::presto::PrestoVectorSerde::PrestoOptions options = {
       kDefaultUseLosslessTimestamp, compressionKind_};
-  VectorStreamGroup::read(input_.get(), pool_, type_, &rowVector, &options);
+  VectorStreamGroup::read(input, pool, type_, &rowVector, &options);
+}
+
+bool SpillFilesReader::nextBatch(RowVectorPtr& rowVector) {
+  while (input_ == nullptr || input_->atEnd()) {
+    if (input_ != nullptr) {
+      ++fileIndex_;
+    }
+    if (fileIndex_ >= files_.size()) {
+      input_.reset();
+      return false;
+    }
+    VELOX_CHECK(!files_[fileIndex_]->isWritable());
+    input_ = files_[fileIndex_]->openInput(pool_);
+  }
+  files_[fileIndex_]->readBatch(input_.get(), pool_, rowVector);
   return true;
 }
 
@@ -419,8 +447,8 @@ std::vector<std::unique_ptr<SpillPartition>> SpillPartition::split(
     while (shardFiles.size() < numFilesPerShard && fileIdx < files_.size()) {
       shardFiles.push_back(std::move(files_[fileIdx++]));
     }
-    shards[shard] =
-        std::make_unique<SpillPartition>(id_, std::move(shardFiles));
+    shards[shard] = std::make_unique<SpillPartition>(
+        id_, std::move(shardFiles), hashSketch_);
   }
   files_.clear();
   return shards;
@@ -438,6 +466,51 @@ SpillPartition::createReader() {
       std::move(streams));
 }
 
+void SpillHashSketch::add(uint64_t hash, uint64_t count) {
+  numRows_ += count;
+  int32_t minIndex = 0;
+  for (auto i = 0; i < numCounters_; ++i) {
+    if (counters_[i].hash == hash) {
+      counters_[i].count += count;
+      return;
+    }
+    if (counters_[i].count < counters_[minIndex].count) {
+      minIndex = i;
+    }
+  }
+  if (numCounters_ < kNumCounters) {
+    counters_[numCounters_++] = {hash, count, 0};
+    return;
+  }
+  // Replaces the least frequent hash, which might have been counted as many
+  // times as its count.
+  auto& counter = counters_[minIndex];
+  counter.hash = hash;
+  counter.error = counter.count;
+  counter.count += count;
+}
+
+void SpillHashSketch::merge(const SpillHashSketch& other) {
+  // Adds the lower bounds of the counts of 'other' so that the counts minus
+  // the errors of this stay lower bounds.
+  const auto numRows = numRows_ + other.numRows_;
+  for (auto i = 0; i < other.numCounters_; ++i) {
+    const auto& counter = other.counters_[i];
+    if (counter.count > counter.error) {
+      add(counter.hash, counter.count - counter.error);
+    }
+  }
+  numRows_ = numRows;
+}
+
+uint64_t SpillHashSketch::maxHashRows() const {
+  uint64_t maxRows = 0;
+  for (auto i = 0; i < numCounters_; ++i) {
+    maxRows = std::max(maxRows, counters_[i].count - counters_[i].error);
+  }
+  return maxRows;
+}
+
 SpillStats::SpillStats(
     uint64_t _spillRuns,
     uint64_t _spilledInputBytes,
@@ -450,7 +523,9 @@ SpillStats::SpillStats(
     uint64_t _spillSerializationTimeUs,
     uint64_t _spillDiskWrites,
     uint64_t _spillFlushTimeUs,
-    uint64_t _spillWriteTimeUs)
+    uint64_t _spillWriteTimeUs,
+    uint32_t _spilledSkewedPartitions,
+    uint64_t _spilledSkewedRows)
     : spillRuns(_spillRuns),
       spilledInputBytes(_spilledInputBytes),
       spilledBytes(_spilledBytes),
@@ -462,7 +537,9 @@ SpillStats::SpillStats(
       spillSerializationTimeUs(_spillSerializationTimeUs),
       spillDiskWrites(_spillDiskWrites),
       spillFlushTimeUs(_spillFlushTimeUs),
-      spillWriteTimeUs(_spillWriteTimeUs) {}
+      spillWriteTimeUs(_spillWriteTimeUs),
+      spilledSkewedPartitions(_spilledSkewedPartitions),
+      spilledSkewedRows(_spilledSkewedRows) {}
 
 bool SpillStats::empty() const {
   return spilledBytes == 0;
@@ -481,6 +558,8 @@ SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillDiskWrites += other.spillDiskWrites;
   spillFlushTimeUs += other.spillFlushTimeUs;
   spillWriteTimeUs += other.spillWriteTimeUs;
+  spilledSkewedPartitions += other.spilledSkewedPartitions;
+  spilledSkewedRows += other.spilledSkewedRows;
   return *this;
 }
 
@@ -499,6 +578,9 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
   result.spillDiskWrites = spillDiskWrites - other.spillDiskWrites;
   result.spillFlushTimeUs = spillFlushTimeUs - other.spillFlushTimeUs;
   result.spillWriteTimeUs = spillWriteTimeUs - other.spillWriteTimeUs;
+  result.spilledSkewedPartitions =
+      spilledSkewedPartitions - other.spilledSkewedPartitions;
+  result.spilledSkewedRows = spilledSkewedRows - other.spilledSkewedRows;
   return result;
 }
 
@@ -529,6 +611,8 @@ bool SpillStats::operator<(const SpillStats& other) const {
   UPDATE_COUNTER(spillDiskWrites);
   UPDATE_COUNTER(spillFlushTimeUs);
   UPDATE_COUNTER(spillWriteTimeUs);
+  UPDATE_COUNTER(spilledSkewedPartitions);
+  UPDATE_COUNTER(spilledSkewedRows);
 #undef UPDATE_COUNTER
   VELOX_CHECK(
       !((gtCount > 0) && (ltCount > 0)),
@@ -563,7 +647,9 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillSerializationTimeUs,
              spillDiskWrites,
              spillFlushTimeUs,
-             spillWriteTimeUs) ==
+             spillWriteTimeUs,
+             spilledSkewedPartitions,
+             spilledSkewedRows) ==
       std::tie(
              other.spillRuns,
              other.spilledInputBytes,
@@ -576,7 +662,9 @@ bool SpillStats::operator==(const SpillStats& other) const {
              other.spillSerializationTimeUs,
              other.spillDiskWrites,
              other.spillFlushTimeUs,
-             other.spillWriteTimeUs);
+             other.spillWriteTimeUs,
+             other.spilledSkewedPartitions,
+             other.spilledSkewedRows);
 }
 
 void SpillStats::reset() {
@@ -592,11 +680,13 @@ void SpillStats::reset() {
   spillDiskWrites = 0;
   spillFlushTimeUs = 0;
   spillWriteTimeUs = 0;
+  spilledSkewedPartitions = 0;
+  spilledSkewedRows = 0;
 }
 
 std::string SpillStats::toString() const {
   return fmt::format(
-      "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] spilledPartitions[{}] spilledFiles[{}] spillFillTimeUs[{}] spillSortTime[{}] spillSerializationTime[{}] spillDiskWrites[{}] spillFlushTime[{}] spillWriteTime[{}]",
+      "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] spilledPartitions[{}] spilledFiles[{}] spillFillTimeUs[{}] spillSortTime[{}] spillSerializationTime[{}] spillDiskWrites[{}] spillFlushTime[{}] spillWriteTime[{}] spilledSkewedPartitions[{}] spilledSkewedRows[{}]",
       spillRuns,
       succinctBytes(spilledInputBytes),
       succinctBytes(spilledBytes),
@@ -608,7 +698,9 @@ std::string SpillStats::toString() const {
       succinctMicros(spillSerializationTimeUs),
       spillDiskWrites,
       succinctMicros(spillFlushTimeUs),
-      succinctMicros(spillWriteTimeUs));
+      succinctMicros(spillWriteTimeUs),
+      spilledSkewedPartitions,
+      spilledSkewedRows);
 }
 
 SpillPartitionIdSet toSpillPartitionIdSet(
@@ -658,6 +750,14 @@ void updateGlobalSpillWriteStats(
   statsLocked->spillWriteTimeUs += writeTimeUs;
 }
 
+void updateGlobalSpillSkewStats(
+    uint32_t numSkewedPartitions,
+    uint64_t numSkewedRows) {
+  auto statsLocked = localSpillStats().wlock();
+  statsLocked->spilledSkewedPartitions += numSkewedPartitions;
+  statsLocked->spilledSkewedRows += numSkewedRows;
+}
+
 void updateGlobalSpillMemoryBytes(uint64_t spilledInputBytes) {
   auto statsLocked = localSpillStats().wlock();
   statsLocked->spilledInputBytes += spilledInputBytes;
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <array>
+
 #include <folly/container/F14Set.h>
 
 #include "velox/common/compression/Compression.h"
@@ -123,6 +125,17 @@ class SpillFile {
   }
 
  private:
+  friend class SpillFilesReader;
+
+  // Opens the file for reading with a read buffer allocated from 'pool'.
+  std::unique_ptr<SpillInput> openInput(memory::MemoryPool* pool) const;
+
+  // Reads the next batch of rows from 'input' into 'rowVector'.
+  void readBatch(
+      SpillInput* input,
+      memory::MemoryPool* pool,
+      RowVectorPtr& rowVector) const;
+
   static std::atomic<int32_t> ordinalCounter_;
 
   // Type of 'rowVector_'. Needed for setting up writing.
@@ -141,6 +154,33 @@ class SpillFile {
   std::unique_ptr<SpillInput> input_;
 };
 
+using SpillFiles = std::vector<std::unique_ptr<SpillFile>>;
+
+/// Reads the RowVectors from a list of spill files in order. Unlike
+/// SpillFile::startRead() and nextBatch(), this doesn't change the files, so
+/// that any number of readers can read the same files, concurrently and
+/// repeatedly. A reader holds one batch of spilled rows at a time, which is
+/// about the spill write buffer size.
+class SpillFilesReader {
+ public:
+  /// 'files' must be finished writing and must outlive 'this'. The read
+  /// buffers and the RowVectors are allocated from 'pool'.
+  SpillFilesReader(const SpillFiles& files, memory::MemoryPool* pool)
+      : files_(files), pool_(pool) {}
+
+  /// Sets 'rowVector' to the next batch of rows. Returns false if all the
+  /// rows have been read.
+  bool nextBatch(RowVectorPtr& rowVector);
+
+ private:
+  const SpillFiles& files_;
+  memory::MemoryPool* const pool_;
+
+  // Index in 'files_' of the file being read.
+  size_t fileIndex_{0};
+  std::unique_ptr<SpillInput> input_;
+};
+
 /// Provides the fine-grained spill execution stats.
 struct SpillStats {
   /// The number of times that spilling runs on an operator.
@@ -171,6 +211,12 @@ struct SpillStats {
   uint64_t spillFlushTimeUs{0};
   /// The time spent on writing spilled rows to disk.
   uint64_t spillWriteTimeUs{0};
+  /// The number of skewed hash join spill partitions which didn't fit in
+  /// memory and were built in chunks instead of being spilled recursively.
+  uint32_t spilledSkewedPartitions{0};
+  /// The number of rows spilled back to the skewed partitions to build the
+  /// next chunks from.
+  uint64_t spilledSkewedRows{0};
 
   SpillStats(
       uint64_t _spillRuns,
@@ -184,7 +230,9 @@ struct SpillStats {
       uint64_t _spillSerializationTimeUs,
       uint64_t _spillDiskWrites,
       uint64_t _spillFlushTimeUs,
-      uint64_t _spillWriteTimeUs);
+      uint64_t _spillWriteTimeUs,
+      uint32_t _spilledSkewedPartitions,
+      uint64_t _spilledSkewedRows);
 
   SpillStats() = default;
 
@@ -212,8 +260,6 @@ FOLLY_ALWAYS_INLINE std::ostream& operator<<(
   return o << stats.toString();
 }
 
-using SpillFiles = std::vector<std::unique_ptr<SpillFile>>;
-
 /// Sequence of files for one partition of the spilled data. If data is
 /// sorted, each file is sorted. The globally sorted order is produced
 /// by merging the constituent files.
@@ -520,6 +566,50 @@ inline std::ostream& operator<<(std::ostream& os, SpillPartitionId id) {
 using SpillPartitionIdSet = folly::F14FastSet<SpillPartitionId>;
 using SpillPartitionNumSet = folly::F14FastSet<uint32_t>;
 
+/// Tracks the most frequent join key hashes of the rows spilled to a hash join
+/// spill partition with the Space-Saving algorithm, which uses a fixed number
+/// of counters. Any hash with more than 1/kNumCounters of the rows has a
+/// counter. It is used to detect a skewed partition whose rows are dominated
+/// by a few join keys, which recursive spilling can't split.
+class SpillHashSketch {
+ public:
+  static constexpr int32_t kNumCounters = 16;
+
+  /// Adds 'count' rows with 'hash'.
+  void add(uint64_t hash, uint64_t count = 1);
+
+  /// Adds the rows counted by 'other'.
+  void merge(const SpillHashSketch& other);
+
+  /// Returns the number of rows added.
+  uint64_t numRows() const {
+    return numRows_;
+  }
+
+  /// Returns a lower bound of the number of rows with the most frequent hash.
+  uint64_t maxHashRows() const;
+
+  /// Returns true if the most frequent hash has at least 'pct' percent of the
+  /// rows.
+  bool isSkewed(int32_t pct) const {
+    return numRows_ > 0 && maxHashRows() * 100 >= numRows_ * pct;
+  }
+
+ private:
+  struct Counter {
+    uint64_t hash;
+    // The number of rows counted for 'hash'.
+    uint64_t count;
+    // The count of the hash replaced by 'hash', by which 'count' may
+    // overestimate the number of rows with 'hash'.
+    uint64_t error;
+  };
+
+  std::array<Counter, kNumCounters> counters_;
+  int32_t numCounters_{0};
+  uint64_t numRows_{0};
+};
+
 /// Contains a spill partition data which includes the partition id and
 /// corresponding spill files.
 class SpillPartition {
@@ -527,8 +617,11 @@ class SpillPartition {
   explicit SpillPartition(const SpillPartitionId& id)
       : SpillPartition(id, {}) {}
 
-  SpillPartition(const SpillPartitionId& id, SpillFiles files)
-      : id_(id), files_(std::move(files)) {}
+  SpillPartition(
+      const SpillPartitionId& id,
+      SpillFiles files,
+      SpillHashSketch hashSketch = {})
+      : id_(id), files_(std::move(files)), hashSketch_(hashSketch) {}
 
   void addFiles(SpillFiles files) {
     files_.reserve(files_.size() + files.size());
@@ -545,10 +638,22 @@ class SpillPartition {
     return files_.size();
   }
 
+  /// Adds the join key hashes of the rows spilled to this partition. This
+  /// only applies for the hash join build spill partitions.
+  void addHashSketch(const SpillHashSketch& hashSketch) {
+    hashSketch_.merge(hashSketch);
+  }
+
+  /// Returns the most frequent join key hashes of the rows in this partition.
+  const SpillHashSketch& hashSketch() const {
+    return hashSketch_;
+  }
+
   /// Invoked to split this spill partition into 'numShards' to process in
   /// parallel.
   ///
-  /// NOTE: the split spill partition shards will have the same id as this.
+  /// NOTE: the split spill partition shards will have the same id and hash
+  /// sketch as this.
   std::vector<std::unique_ptr<SpillPartition>> split(int numShards);
 
   /// Invoked to create an unordered stream reader from this spill partition.
@@ -558,6 +663,7 @@ class SpillPartition {
  private:
   SpillPartitionId id_;
   SpillFiles files_;
+  SpillHashSketch hashSketch_;
 };
 
 using SpillPartitionSet =
@@ -706,6 +812,11 @@ void updateGlobalSpillWriteStats(
     uint64_t spilledBytes,
     uint64_t flushTimeUs,
     uint64_t writeTimeUs);
+/// Updates the number of skewed hash join spill partitions built in chunks and
+/// the rows spilled back to them.
+void updateGlobalSpillSkewStats(
+    uint32_t numSkewedPartitions,
+    uint64_t numSkewedRows);
 // Increment the spill memory bytes.
 void updateGlobalSpillMemoryBytes(uint64_t spilledInputBytes);
 
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SpillableVectorBuffer.h"
+
+namespace facebook::velox::exec {
+
+SpillableVectorBuffer::SpillableVectorBuffer(
+    const common::SpillConfig* spillConfig,
+    memory::MemoryPool* pool,
+    uint32_t* numSpillRuns)
+    : spillConfig_(spillConfig), pool_(pool), numSpillRuns_(numSpillRuns) {
+  VELOX_CHECK_NOT_NULL(numSpillRuns_);
+}
+
+void SpillableVectorBuffer::add(RowVectorPtr vector) {
+  VELOX_CHECK(!finished_);
+  if (vector->size() == 0) {
+    return;
+  }
+  numRows_ += vector->size();
+  // Load lazy vectors before storing.
+  for (auto& child : vector->children()) {
+    child->loadedVector();
+  }
+  if (spilled()) {
+    spillState_->appendToPartition(0, vector);
+    return;
+  }
+  inMemoryBytes_ += vector->estimateFlatSize();
+  vectors_.push_back(std::move(vector));
+}
+
+void SpillableVectorBuffer::spill() {
+  VELOX_CHECK_NOT_NULL(spillConfig_);
+  VELOX_CHECK(!finished_);
+  ++(*numSpillRuns_);
+  if (!spilled()) {
+    spillState_ = std::make_unique<SpillState>(
+        spillConfig_->filePath,
+        1,
+        0,
+        std::vector<CompareFlags>{},
+        spillConfig_->maxFileSize,
+        spillConfig_->writeBufferSize,
+        spillConfig_->compressionKind,
+        pool_,
+        &stats_);
+    spillState_->setPartitionSpilled(0);
+  }
+  for (const auto& vector : vectors_) {
+    spillState_->appendToPartition(0, vector);
+  }
+  vectors_.clear();
+  inMemoryBytes_ = 0;
+}
+
+SpillFiles SpillableVectorBuffer::finishSpill() {
+  VELOX_CHECK(!finished_);
+  finished_ = true;
+  if (!spilled() || !spillState_->hasFiles(0)) {
+    return {};
+  }
+  spillState_->finishWrite(0);
+  return spillState_->files(0);
+}
+} // namespace facebook::velox::exec
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/Portability.h"
+#include "velox/common/config/SpillConfig.h"
+#include "velox/exec/Spill.h"
+
+namespace facebook::velox::exec {
+
+/// Buffers a sequence of RowVectors which is read back in order, possibly
+/// many times, e.g. the build side of a nested loop join or the right side
+/// rows with the same keys in a merge join. The vectors stay in memory until
+/// spill() writes them to spill files. The vectors added after that are
+/// written to the spill files directly, so that the order is kept. The spilled
+/// vectors are read back with a SpillFilesReader over finishSpill().
+class SpillableVectorBuffer {
+ public:
+  /// 'spillConfig' must outlive 'this' and is null if spilling is disabled.
+  /// 'pool' is used for serializing the spilled vectors. 'numSpillRuns' is
+  /// the spill run counter of the owning operator.
+  SpillableVectorBuffer(
+      const common::SpillConfig* spillConfig,
+      memory::MemoryPool* pool,
+      uint32_t* numSpillRuns);
+
+  /// Appends 'vector' after loading its lazy vectors.
+  void add(RowVectorPtr vector);
+
+  /// Writes the vectors in memory to the spill files and frees them. Spilling
+  /// must be enabled.
+  void spill();
+
+  bool spilled() const {
+    return spillState_ != nullptr;
+  }
+
+  /// Returns the number of rows added.
+  uint64_t numRows() const {
+    return numRows_;
+  }
+
+  /// Returns the estimated byte size of the vectors kept in memory. Can be
+  /// called concurrently, e.g. by memory arbitration.
+  uint64_t inMemoryBytes() const {
+    return inMemoryBytes_;
+  }
+
+  /// Returns the vectors kept in memory. They precede the spilled vectors if
+  /// not spilled yet, otherwise there are none.
+  std::vector<RowVectorPtr>& vectors() {
+    return vectors_;
+  }
+
+  /// Finishes writing and returns the spill files. Returns an empty list if
+  /// not spilled. No more vectors can be added after this.
+  SpillFiles finishSpill();
+
+  SpillStats stats() const {
+    return stats_.copy();
+  }
+
+ private:
+  const common::SpillConfig* const spillConfig_;
+  memory::MemoryPool* const pool_;
+  uint32_t* const numSpillRuns_;
+
+  folly::Synchronized<SpillStats> stats_;
+  // Set on the first spill. Writes to a single partition.
+  std::unique_ptr<SpillState> spillState_;
+  bool finished_{false};
+
+  std::vector<RowVectorPtr> vectors_;
+  uint64_t numRows_{0};
+  tsan_atomic<uint64_t> inMemoryBytes_{0};
+};
+} // namespace facebook::velox::exec
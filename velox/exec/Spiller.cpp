@@ -188,8 +188,7 @@ void Spiller::extractSpill(folly::Range<char**> rows, RowVectorPtr& resultPtr) {
 
   auto numKeys = types.size();
   for (auto i = 0; i < accumulators.size(); ++i) {
-    accumulators[i].aggregateForSpill()->extractAccumulators(
-        rows.data(), rows.size(), &result->childAt(i + numKeys));
+    accumulators[i].extractForSpill(rows, result->childAt(i + numKeys));
   }
 }
 
@@ -384,6 +383,9 @@ void Spiller::advanceSpill() {
     auto partition = result->partition;
     auto& run = spillRuns_[partition];
     auto spilled = folly::Range<char**>(run.rows.data(), numWritten);
+    if (!hashSketches_.empty()) {
+      addSpilledRowHashes(partition, spilled);
+    }
     eraser_(spilled);
     if (!container_->numRows()) {
       // If the container became empty, free its memory.
@@ -549,6 +551,35 @@ void Spiller::spill(uint32_t partition, const RowVectorPtr& spillVector) {
   }
 
   state_.appendToPartition(partition, spillVector);
+  if (FOLLY_UNLIKELY(skewedPartitions_.contains(partition))) {
+    stats_.wlock()->spilledSkewedRows += spillVector->size();
+    updateGlobalSpillSkewStats(0, spillVector->size());
+  }
+}
+
+void Spiller::setSkewedPartitionSpilled(uint32_t partition) {
+  VELOX_CHECK_EQ(type_, Type::kHashJoinBuild);
+  state_.setPartitionSpilled(partition);
+  skewedPartitions_.insert(partition);
+  ++stats_.wlock()->spilledSkewedPartitions;
+  updateGlobalSpillSkewStats(1, 0);
+}
+
+void Spiller::enableHashSketches() {
+  VELOX_CHECK_EQ(type_, Type::kHashJoinBuild);
+  hashSketches_.resize(state_.maxPartitions());
+}
+
+void Spiller::addSpilledRowHashes(
+    int32_t partition,
+    folly::Range<char**> rows) {
+  std::vector<uint64_t> hashes(rows.size());
+  for (auto i = 0; i < container_->keyTypes().size(); ++i) {
+    container_->hash(i, rows, i > 0, hashes.data());
+  }
+  for (auto hash : hashes) {
+    hashSketches_[partition].add(hash);
+  }
 }
 
 int32_t Spiller::pickNextPartitionToSpill() {
@@ -611,6 +642,9 @@ void Spiller::finishSpill(SpillPartitionSet& partitionSet) {
     } else {
       partitionSet[partitionId]->addFiles(state_.files(partition));
     }
+    if (!hashSketches_.empty()) {
+      partitionSet[partitionId]->addHashSketch(hashSketches_[partition]);
+    }
   }
 }
 
@@ -210,6 +210,26 @@ class Spiller {
     }
   }
 
+  /// Sets 'partition' of a skewed spill partition as spilling without spilling
+  /// the rows buffered in the row container, which stay in memory as a chunk
+  /// of the partition. The rows spilled to 'partition' afterwards are counted
+  /// as skewed rows in the spill stats. It is only used by kHashJoinBuild
+  /// spiller type.
+  void setSkewedPartitionSpilled(uint32_t partition);
+
+  /// Enables tracking the most frequent join key hashes of the rows spilled to
+  /// each partition, which finishSpill() adds to the spill partitions. It is
+  /// only used by kHashJoinBuild spiller type to detect skewed partitions.
+  void enableHashSketches();
+
+  /// Adds the join key 'hash' of a row spilled by spill(partition, spillVector)
+  /// to the hash sketch of 'partition' if enabled.
+  void addSpilledRowHash(uint32_t partition, uint64_t hash) {
+    if (!hashSketches_.empty()) {
+      hashSketches_[partition].add(hash);
+    }
+  }
+
   SpillStats stats() const;
 
   /// Global memory pool for spill intermediates. ~1MB per spill executor thread
@@ -332,6 +352,10 @@ class Spiller {
 
   void updateSpillSortTime(uint64_t timeUs);
 
+  // Adds the join key hashes of 'rows' from the row container spilled to
+  // 'partition' to its hash sketch.
+  void addSpilledRowHashes(int32_t partition, folly::Range<char**> rows);
+
   const Type type_;
   // NOTE: for hash join probe type, there is no associated row container for
   // the spiller.
@@ -357,5 +381,12 @@ class Spiller {
 
   // One spill run for each partition of spillable data.
   std::vector<SpillRun> spillRuns_;
+
+  // The join key hash sketch of the rows spilled to each partition. Empty if
+  // not enabled.
+  std::vector<SpillHashSketch> hashSketches_;
+
+  // The partitions set by setSkewedPartitionSpilled().
+  SpillPartitionNumSet skewedPartitions_;
 };
 } // namespace facebook::velox::exec
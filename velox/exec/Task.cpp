@@ -21,6 +21,7 @@
 #include "velox/codegen/Codegen.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/time/Timer.h"
+#include "velox/exec/AggregationPartitions.h"
 #include "velox/exec/Exchange.h"
 #include "velox/exec/HashBuild.h"
 #include "velox/exec/LocalPlanner.h"
@@ -116,6 +117,45 @@ void addRunningTimeOperatorMetrics(exec::OperatorStats& op) {
       RuntimeMetric(op.finishTiming.wallNanos, RuntimeCounter::Unit::kNanos);
 }
 
+// Adds the samples of 'profile' to the runtime stats of the operators they
+// were taken in. 'profileSamples' counts the samples of an operator,
+// 'profileSamples.<method>' the samples of an operator method and
+// 'profileSamples.<method>.<expression>' the samples of a method while
+// evaluating the expression as the innermost one.
+void addProfileRuntimeStats(const process::Profile& profile, TaskStats& stats) {
+  std::unordered_map<std::string, std::unordered_map<std::string, int64_t>>
+      operatorSamples;
+  for (const auto& [frames, count] : profile.samples()) {
+    if (frames.empty()) {
+      continue;
+    }
+    auto& samples = operatorSamples[frames[0]];
+    samples["profileSamples"] += count;
+    if (frames.size() > 1) {
+      samples[fmt::format("profileSamples.{}", frames[1])] += count;
+    }
+    if (frames.size() > 2) {
+      samples[fmt::format("profileSamples.{}.{}", frames[1], frames.back())] +=
+          count;
+    }
+  }
+  if (operatorSamples.empty()) {
+    return;
+  }
+  for (auto& pipelineStats : stats.pipelineStats) {
+    for (auto& op : pipelineStats.operatorStats) {
+      auto it = operatorSamples.find(
+          Operator::makeProfileLabel(op.planNodeId, op.operatorType));
+      if (it == operatorSamples.end()) {
+        continue;
+      }
+      for (const auto& [name, count] : it->second) {
+        op.runtimeStats[name] = RuntimeMetric(count);
+      }
+    }
+  }
+}
+
 void buildSplitStates(
     const core::PlanNode* planNode,
     std::unordered_set<core::PlanNodeId>& allIds,
@@ -261,7 +301,11 @@ Task::Task(
       consumerSupplier_(std::move(consumerSupplier)),
       onError_(onError),
       splitsStates_(buildSplitStates(planFragment_.planNode)),
-      bufferManager_(PartitionedOutputBufferManager::getInstance()) {}
+      bufferManager_(PartitionedOutputBufferManager::getInstance()),
+      profile_(
+          queryCtx_->queryConfig().operatorProfilingEnabled()
+              ? std::make_unique<process::Profile>()
+              : nullptr) {}
 
 Task::~Task() {
   TestValue::adjust("facebook::velox::exec::Task::~Task", this);
@@ -869,6 +913,10 @@ void Task::createSplitGroupStateLocked(uint32_t splitGroupId) {
     addNestedLoopJoinBridgesLocked(
         splitGroupId, factory->needsNestedLoopJoinBridges());
     addCustomJoinBridgesLocked(splitGroupId, factory->planNodes);
+    addAggregationPartitionsLocked(
+        splitGroupId,
+        factory->needsAggregationPartitions(queryCtx()->queryConfig()),
+        factory->numDrivers);
   }
 }
 
@@ -1553,6 +1601,32 @@ void Task::addCustomJoinBridgesLocked(
   }
 }
 
+void Task::addAggregationPartitionsLocked(
+    uint32_t splitGroupId,
+    const std::vector<core::PlanNodeId>& planNodeIds,
+    uint32_t numDrivers) {
+  auto& splitGroupState = splitGroupStates_[splitGroupId];
+  for (const auto& planNodeId : planNodeIds) {
+    splitGroupState.aggregationPartitions.emplace(
+        planNodeId, std::make_shared<AggregationPartitions>(numDrivers));
+  }
+}
+
+std::shared_ptr<AggregationPartitions> Task::getAggregationPartitions(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId) {
+  auto& splitGroupState = splitGroupStates_[splitGroupId];
+
+  auto it = splitGroupState.aggregationPartitions.find(planNodeId);
+  VELOX_CHECK(
+      it != splitGroupState.aggregationPartitions.end(),
+      "Aggregation partitions for plan node ID {} not found for group {}, task {}",
+      planNodeId,
+      splitGroupId,
+      taskId());
+  return it->second;
+}
+
 std::shared_ptr<JoinBridge> Task::getCustomJoinBridge(
     uint32_t splitGroupId,
     const core::PlanNodeId& planNodeId) {
@@ -1866,6 +1940,10 @@ TaskStats Task::taskStats() const {
     }
   }
 
+  if (profile_ != nullptr) {
+    addProfileRuntimeStats(*profile_, taskStats);
+  }
+
   auto bufferManager = bufferManager_.lock();
   taskStats.outputBufferUtilization = bufferManager->getUtilization(taskId_);
   taskStats.outputBufferOverutilized = bufferManager->isOverutilized(taskId_);
@@ -1873,6 +1951,13 @@ TaskStats Task::taskStats() const {
   return taskStats;
 }
 
+std::string Task::foldedProfile() const {
+  if (profile_ == nullptr) {
+    return "";
+  }
+  return profile_->toFolded(taskId_);
+}
+
 uint64_t Task::timeSinceStartMs() const {
   std::lock_guard<std::mutex> l(mutex_);
   return timeSinceStartMsLocked();
@@ -2350,6 +2435,22 @@ int32_t Task::yieldIfDue(uint64_t startTimeMicros) {
   return 0;
 }
 
+void Task::addSchedulerSlice(
+    uint64_t queuedNanos,
+    uint64_t cpuNanos,
+    bool yielded) {
+  schedulerCpuNanos_ += cpuNanos;
+  std::lock_guard<std::mutex> l(mutex_);
+  taskStats_.schedulerQueuedWallNanos += queuedNanos;
+  taskStats_.schedulerMaxQueuedWallNanos =
+      std::max(taskStats_.schedulerMaxQueuedWallNanos, queuedNanos);
+  taskStats_.schedulerCpuNanos += cpuNanos;
+  ++taskStats_.numSchedulerSlices;
+  if (yielded) {
+    ++taskStats_.numSchedulerYields;
+  }
+}
+
 std::vector<ContinuePromise> Task::allThreadsFinishedLocked() {
   std::vector<ContinuePromise> threadFinishPromises;
   threadFinishPromises.swap(threadFinishPromises_);
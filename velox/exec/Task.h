@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #pragma once
+#include "velox/common/process/Profiler.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/exec/Driver.h"
@@ -429,6 +430,19 @@ class Task : public std::enable_shared_from_this<Task> {
       uint32_t splitGroupId,
       const std::vector<core::PlanNodePtr>& planNodes);
 
+  /// Adds AggregationPartitions shared by 'numDrivers' drivers for all the
+  /// specified plan node IDs.
+  void addAggregationPartitionsLocked(
+      uint32_t splitGroupId,
+      const std::vector<core::PlanNodeId>& planNodeIds,
+      uint32_t numDrivers);
+
+  /// Returns the AggregationPartitions for 'planNodeId'. Called from the
+  /// aggregation operator constructor while the drivers are being created.
+  std::shared_ptr<AggregationPartitions> getAggregationPartitions(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId);
+
   /// Returns a HashJoinBridge for 'planNodeId'. This is used for synchronizing
   /// start of probe with completion of build for a join that has a
   /// separate probe and build. 'id' is the PlanNodeId shared between
@@ -544,6 +558,31 @@ class Task : public std::enable_shared_from_this<Task> {
   /// 'this' at the time of requesting yield. Returns 0 if yield not requested.
   int32_t yieldIfDue(uint64_t startTimeMicros);
 
+  /// Records a time slice run by a DriverScheduler for a Driver of 'this'.
+  /// 'queuedNanos' is the time the Driver waited in the scheduler's queue
+  /// and 'cpuNanos' the CPU time of the slice. 'yielded' is true if the
+  /// Driver gave up its thread to other queued Drivers at the end of the
+  /// slice.
+  void addSchedulerSlice(uint64_t queuedNanos, uint64_t cpuNanos, bool yielded);
+
+  /// Returns the CPU time of the time slices run by a DriverScheduler for
+  /// 'this'. Can be called without holding the mutex.
+  uint64_t schedulerCpuNanos() const {
+    return schedulerCpuNanos_;
+  }
+
+  /// Returns the samples of the threads running the Drivers of 'this' if
+  /// QueryConfig::operatorProfilingEnabled() is set, nullptr otherwise.
+  process::Profile* profile() const {
+    return profile_.get();
+  }
+
+  /// Returns the samples of profile() in folded stack format, with the task id
+  /// as the outermost frame, then the plan node id and operator type, the
+  /// operator method and the expressions being evaluated. Returns an empty
+  /// string if 'this' is not profiled.
+  std::string foldedProfile() const;
+
   /// Once 'pauseRequested_' is set, it will not be cleared until
   /// task::resume(). It is therefore OK to read it without a mutex
   /// from a thread that this flag concerns.
@@ -560,6 +599,11 @@ class Task : public std::enable_shared_from_this<Task> {
     return driverFactories_[driver->driverCtx()->pipelineId]->numDrivers;
   }
 
+  /// Returns the number of concurrent drivers in pipeline 'pipelineId'.
+  uint32_t numDrivers(int pipelineId) const {
+    return driverFactories_[pipelineId]->numDrivers;
+  }
+
   /// Returns the number of created and deleted tasks since the velox engine
   /// starts running so far.
   static uint64_t numCreatedTasks() {
@@ -808,10 +852,6 @@ class Task : public std::enable_shared_from_this<Task> {
     return driverFactories_[pipelineId]->outputDriver;
   }
 
-  uint32_t numDrivers(int pipelineId) const {
-    return driverFactories_[pipelineId]->numDrivers;
-  }
-
   int getOutputPipelineId() const;
 
   // Create an exchange client for the specified exchange plan node at a given
@@ -1011,6 +1051,12 @@ class Task : public std::enable_shared_from_this<Task> {
   // one thread running. Used to decide if continuous run should be
   // interrupted by yieldIfDue().
   tsan_atomic<uint64_t> onThreadSince_{0};
+  // Same as 'taskStats_.schedulerCpuNanos'. Read by a DriverScheduler
+  // without holding 'mutex_' to select the queue of a Driver.
+  std::atomic<uint64_t> schedulerCpuNanos_{0};
+
+  // See profile().
+  const std::unique_ptr<process::Profile> profile_;
   // Promises for the futures returned to callers of requestPause() or
   // terminate(). They are fulfilled when the last thread stops
   // running for 'this'.
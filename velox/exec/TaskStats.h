@@ -86,6 +86,19 @@ struct TaskStats {
   /// Drivers blocked for various reasons. Based on enum BlockingReason.
   std::unordered_map<BlockingReason, uint64_t> numBlockedDrivers;
 
+  /// Total time the Drivers waited in the queues of a DriverScheduler before
+  /// running a time slice.
+  uint64_t schedulerQueuedWallNanos{0};
+  /// Longest wait of a Driver in the queues of a DriverScheduler.
+  uint64_t schedulerMaxQueuedWallNanos{0};
+  /// CPU time of the time slices run by a DriverScheduler.
+  uint64_t schedulerCpuNanos{0};
+  /// Number of time slices run by a DriverScheduler.
+  uint64_t numSchedulerSlices{0};
+  /// Number of time slices that ended with the Driver yielding its thread to
+  /// other queued Drivers.
+  uint64_t numSchedulerYields{0};
+
   /// Output buffer's memory utilization ratio measured as
   /// current buffer usage / max buffer size
   double outputBufferUtilization{0};
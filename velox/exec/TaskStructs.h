@@ -22,6 +22,7 @@
 
 namespace facebook::velox::exec {
 
+class AggregationPartitions;
 class Driver;
 class JoinBridge;
 class LocalExchangeMemoryManager;
@@ -103,6 +104,11 @@ struct SplitGroupState {
   /// Map of local exchanges keyed on LocalPartition plan node ID.
   std::unordered_map<core::PlanNodeId, LocalExchangeState> localExchanges;
 
+  /// Map of hash ranges shared by the drivers of a partitioned aggregation
+  /// keyed on AggregationNode plan node ID.
+  std::unordered_map<core::PlanNodeId, std::shared_ptr<AggregationPartitions>>
+      aggregationPartitions;
+
   /// Drivers created and still running for this split group.
   /// The split group is finished when this numbers reaches zero.
   uint32_t numRunningDrivers{0};
@@ -129,6 +135,7 @@ struct SplitGroupState {
     localMergeSources.clear();
     mergeJoinSources.clear();
     localExchanges.clear();
+    aggregationPartitions.clear();
   }
 };
 
@@ -14,10 +14,107 @@
  * limitations under the License.
  */
 #include "velox/exec/TopN.h"
+
+#include <numeric>
+
+#include "velox/common/base/SimdUtil.h"
 #include "velox/exec/ContainerRowSerde.h"
+#include "velox/exec/Driver.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
+namespace {
+std::vector<column_index_t> keyChannels(
+    const std::vector<core::FieldAccessTypedExprPtr>& sortingKeys,
+    const RowTypePtr& type) {
+  std::vector<column_index_t> channels;
+  channels.reserve(sortingKeys.size());
+  for (const auto& key : sortingKeys) {
+    channels.push_back(exprToChannel(key.get(), type));
+  }
+  return channels;
+}
+
+bool isCandidateFilterKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename T>
+inline T valueAt(const char* row, const RowColumn& column) {
+  return *reinterpret_cast<const T*>(row + column.offset());
+}
+
+// Returns true if 'value' sorts before 'cutoff' or, if not 'strict', is equal
+// to it. NaN sorts after all other values. 'cutoff' is not NaN.
+template <typename T, bool descending, bool strict>
+inline bool beatsCutoff(T value, T cutoff) {
+  if constexpr (std::is_floating_point_v<T>) {
+    if (std::isnan(value)) {
+      return descending;
+    }
+  }
+  if constexpr (descending) {
+    return strict ? value > cutoff : value >= cutoff;
+  } else {
+    return strict ? value < cutoff : value <= cutoff;
+  }
+}
+
+template <typename T, bool descending, bool strict>
+inline xsimd::batch_bool<T> beatsCutoff(
+    xsimd::batch<T> values,
+    xsimd::batch<T> cutoff) {
+  if constexpr (descending) {
+    auto result = strict ? values > cutoff : values >= cutoff;
+    if constexpr (std::is_floating_point_v<T>) {
+      // NaN is not equal to itself.
+      result = result | (values != values);
+    }
+    return result;
+  } else {
+    // Comparisons with NaN are false.
+    return strict ? values < cutoff : values <= cutoff;
+  }
+}
+
+// Writes the indices of the 'values' that beat 'cutoff' to 'candidates' and
+// returns their number.
+template <typename T, bool descending, bool strict>
+vector_size_t findCandidatesFlat(
+    const T* values,
+    vector_size_t numRows,
+    T cutoff,
+    vector_size_t* candidates) {
+  constexpr int32_t kBatchSize = xsimd::batch<T>::size;
+  const auto cutoffs = xsimd::broadcast<T>(cutoff);
+  vector_size_t numCandidates = 0;
+  vector_size_t row = 0;
+  for (; row + kBatchSize <= numRows; row += kBatchSize) {
+    uint64_t bits = simd::toBitMask(beatsCutoff<T, descending, strict>(
+        xsimd::load_unaligned(values + row), cutoffs));
+    while (bits) {
+      candidates[numCandidates++] = row + __builtin_ctzll(bits);
+      bits &= bits - 1;
+    }
+  }
+  for (; row < numRows; ++row) {
+    candidates[numCandidates] = row;
+    numCandidates += beatsCutoff<T, descending, strict>(values[row], cutoff);
+  }
+  return numCandidates;
+}
+} // namespace
+
 TopN::TopN(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -29,6 +126,10 @@ TopN::TopN(
           topNNode->id(),
           "TopN"),
       count_(topNNode->count()),
+      keyChannels_(keyChannels(topNNode->sortingKeys(), outputType_)),
+      firstKeyOrder_(topNNode->sortingOrders()[0]),
+      canFilterCandidates_(isCandidateFilterKind(
+          outputType_->childAt(keyChannels_[0])->kind())),
       data_(std::make_unique<RowContainer>(outputType_->children(), pool())),
       comparator_(
           outputType_,
@@ -38,13 +139,51 @@ TopN::TopN(
       topRows_(comparator_),
       decodedVectors_(outputType_->children().size()) {}
 
+void TopN::initialize() {
+  Operator::initialize();
+  const auto& keyType = outputType_->childAt(keyChannels_[0]);
+  const bool isFloatingPoint = keyType->kind() == TypeKind::REAL ||
+      keyType->kind() == TypeKind::DOUBLE;
+  // Filters drop NaN, which sorts last.
+  if (!canFilterCandidates_ || keyType->isDecimal() ||
+      (isFloatingPoint && !firstKeyOrder_.isAscending())) {
+    return;
+  }
+  auto* driver = operatorCtx_->driverCtx()->driver;
+  pushdownCutoff_ = driver->onlyFiltersUpstream(this) &&
+      !driver->canPushdownFilters(this, {keyChannels_[0]}).empty();
+}
+
 void TopN::addInput(RowVectorPtr input) {
-  // TODO Decode keys first, then decode the rest only for passing positions
+  const auto numRows = input->size();
+  for (auto channel : keyChannels_) {
+    decodedVectors_[channel].decode(*input->childAt(channel));
+  }
+  const auto numCandidates = findCandidates(numRows);
+  if (numCandidates == 0) {
+    return;
+  }
+
+  // Decode the other columns only for the candidate rows.
+  if (numCandidates < numRows) {
+    candidateRows_.resize(numRows);
+    candidateRows_.clearAll();
+    for (auto i = 0; i < numCandidates; ++i) {
+      candidateRows_.setValid(candidates_[i], true);
+    }
+    candidateRows_.updateBounds();
+  } else {
+    candidateRows_.resizeFill(numRows, true);
+  }
   for (auto col = 0; col < input->childrenSize(); ++col) {
-    decodedVectors_[col].decode(*input->childAt(col));
+    if (std::find(keyChannels_.begin(), keyChannels_.end(), col) ==
+        keyChannels_.end()) {
+      decodedVectors_[col].decode(*input->childAt(col), candidateRows_);
+    }
   }
 
-  for (auto row = 0; row < input->size(); ++row) {
+  for (auto i = 0; i < numCandidates; ++i) {
+    const auto row = candidates_[i];
     char* newRow = nullptr;
     if (topRows_.size() < count_) {
       newRow = data_->newRow();
@@ -65,6 +204,143 @@ void TopN::addInput(RowVectorPtr input) {
 
     topRows_.push(newRow);
   }
+  maybePushdownCutoff();
+}
+
+vector_size_t TopN::findCandidates(vector_size_t numRows) {
+  candidates_.resize(numRows);
+  if (canFilterCandidates_ && topRows_.size() == count_ && count_ > 0) {
+    const char* cutoffRow = topRows_.top();
+    vector_size_t numCandidates;
+    switch (firstKeyKind()) {
+      case TypeKind::TINYINT:
+        numCandidates = findCandidates<int8_t>(cutoffRow, numRows);
+        break;
+      case TypeKind::SMALLINT:
+        numCandidates = findCandidates<int16_t>(cutoffRow, numRows);
+        break;
+      case TypeKind::INTEGER:
+        numCandidates = findCandidates<int32_t>(cutoffRow, numRows);
+        break;
+      case TypeKind::BIGINT:
+        numCandidates = findCandidates<int64_t>(cutoffRow, numRows);
+        break;
+      case TypeKind::REAL:
+        numCandidates = findCandidates<float>(cutoffRow, numRows);
+        break;
+      case TypeKind::DOUBLE:
+        numCandidates = findCandidates<double>(cutoffRow, numRows);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    if (numCandidates >= 0) {
+      return numCandidates;
+    }
+  }
+  std::iota(candidates_.begin(), candidates_.end(), 0);
+  return numRows;
+}
+
+// Returns -1 if the rows are not compared with the cutoff.
+template <typename T>
+vector_size_t TopN::findCandidates(
+    const char* cutoffRow,
+    vector_size_t numRows) {
+  const auto& decoded = decodedVectors_[keyChannels_[0]];
+  const auto& column = data_->columnAt(keyChannels_[0]);
+  if (!decoded.isIdentityMapping() || decoded.mayHaveNulls() ||
+      RowContainer::isNullAt(cutoffRow, column.nullByte(), column.nullMask())) {
+    return -1;
+  }
+  const auto cutoff = valueAt<T>(cutoffRow, column);
+  if constexpr (std::is_floating_point_v<T>) {
+    if (std::isnan(cutoff)) {
+      return -1;
+    }
+  }
+  // With more than one key, the rows with the same first key are compared on
+  // the other keys.
+  const bool strict = keyChannels_.size() == 1;
+  const T* values = decoded.data<T>();
+  auto* candidates = candidates_.data();
+  if (firstKeyOrder_.isAscending()) {
+    if (strict) {
+      return findCandidatesFlat<T, false, true>(
+          values, numRows, cutoff, candidates);
+    }
+    return findCandidatesFlat<T, false, false>(
+        values, numRows, cutoff, candidates);
+  }
+  if (strict) {
+    return findCandidatesFlat<T, true, true>(
+        values, numRows, cutoff, candidates);
+  }
+  return findCandidatesFlat<T, true, false>(
+      values, numRows, cutoff, candidates);
+}
+
+void TopN::maybePushdownCutoff() {
+  if (!pushdownCutoff_ || topRows_.size() < count_ || count_ == 0) {
+    return;
+  }
+  const char* cutoffRow = topRows_.top();
+  const auto& column = data_->columnAt(keyChannels_[0]);
+  if (RowContainer::isNullAt(cutoffRow, column.nullByte(), column.nullMask())) {
+    return;
+  }
+  // Nulls sort before the cutoff if nulls come first.
+  const bool nullAllowed = firstKeyOrder_.isNullsFirst();
+  std::unique_ptr<common::Filter> filter;
+  const auto kind = firstKeyKind();
+  if (kind == TypeKind::REAL || kind == TypeKind::DOUBLE) {
+    // The order is ascending, see initialize().
+    const double cutoff = kind == TypeKind::REAL
+        ? valueAt<float>(cutoffRow, column)
+        : valueAt<double>(cutoffRow, column);
+    if (std::isnan(cutoff) ||
+        (pushedDoubleCutoff_.has_value() &&
+         cutoff >= pushedDoubleCutoff_.value())) {
+      return;
+    }
+    pushedDoubleCutoff_ = cutoff;
+    if (kind == TypeKind::REAL) {
+      filter = std::make_unique<common::FloatRange>(
+          0, true, false, cutoff, false, false, nullAllowed);
+    } else {
+      filter = std::make_unique<common::DoubleRange>(
+          0, true, false, cutoff, false, false, nullAllowed);
+    }
+  } else {
+    int64_t cutoff;
+    switch (kind) {
+      case TypeKind::TINYINT:
+        cutoff = valueAt<int8_t>(cutoffRow, column);
+        break;
+      case TypeKind::SMALLINT:
+        cutoff = valueAt<int16_t>(cutoffRow, column);
+        break;
+      case TypeKind::INTEGER:
+        cutoff = valueAt<int32_t>(cutoffRow, column);
+        break;
+      default:
+        cutoff = valueAt<int64_t>(cutoffRow, column);
+        break;
+    }
+    const bool ascending = firstKeyOrder_.isAscending();
+    if (pushedBigintCutoff_.has_value() &&
+        (ascending ? cutoff >= pushedBigintCutoff_.value()
+                   : cutoff <= pushedBigintCutoff_.value())) {
+      return;
+    }
+    pushedBigintCutoff_ = cutoff;
+    filter = ascending
+        ? std::make_unique<common::BigintRange>(
+              std::numeric_limits<int64_t>::min(), cutoff, nullAllowed)
+        : std::make_unique<common::BigintRange>(
+              cutoff, std::numeric_limits<int64_t>::max(), nullAllowed);
+  }
+  dynamicFilters_[keyChannels_[0]] = std::move(filter);
 }
 
 RowVectorPtr TopN::getOutput() {
@@ -27,6 +27,8 @@ class TopN : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::TopNNode>& topNNode);
 
+  void initialize() override;
+
   bool needsInput() const override {
     return !noMoreInput_;
   }
@@ -44,7 +46,44 @@ class TopN : public Operator {
   bool isFinished() override;
 
  private:
+  // Sets 'candidates_' to the rows of the input that may sort before the top
+  // of 'topRows_', i.e. the current cutoff, and returns their number. Once
+  // 'topRows_' is full, compares the first sorting key of flat input without
+  // nulls with the cutoff a SIMD batch at a time. Otherwise, returns all rows.
+  // Expects the sorting keys in 'decodedVectors_'.
+  vector_size_t findCandidates(vector_size_t numRows);
+
+  template <typename T>
+  vector_size_t findCandidates(const char* cutoffRow, vector_size_t numRows);
+
+  // Adds a filter on the first sorting key that drops the rows after the
+  // cutoff to 'dynamicFilters_' if the cutoff is tighter than the one pushed
+  // down last.
+  void maybePushdownCutoff();
+
+  TypeKind firstKeyKind() const {
+    return outputType_->childAt(keyChannels_[0])->kind();
+  }
+
   const int32_t count_;
+  const std::vector<column_index_t> keyChannels_;
+  const core::SortOrder firstKeyOrder_;
+
+  // True if the first sorting key is of a type for which findCandidates()
+  // compares the input with the cutoff.
+  const bool canFilterCandidates_;
+
+  // True if the cutoff is pushed down as a dynamic filter. Set in initialize()
+  // if the first sorting key has a numeric type, an upstream operator accepts
+  // the filter and the operators in between do not add rows.
+  bool pushdownCutoff_{false};
+  std::optional<int64_t> pushedBigintCutoff_;
+  std::optional<double> pushedDoubleCutoff_;
+
+  // Rows of the input that findCandidates() selected.
+  raw_vector<vector_size_t> candidates_;
+  // Rows to decode in the columns that are not sorting keys.
+  SelectivityVector candidateRows_;
 
   bool finished_ = false;
   uint32_t numRowsReturned_ = 0;
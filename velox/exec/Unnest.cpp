@@ -30,7 +30,8 @@ Unnest::Unnest(
           operatorId,
           unnestNode->id(),
           "Unnest"),
-      withOrdinality_(unnestNode->withOrdinality()) {
+      withOrdinality_(unnestNode->withOrdinality()),
+      maxOutputSize_(outputBatchRows()) {
   const auto& inputType = unnestNode->sources()[0]->outputType();
   const auto& unnestVariables = unnestNode->unnestVariables();
   for (const auto& variable : unnestVariables) {
@@ -41,6 +42,9 @@ Unnest::Unnest(
   }
 
   unnestDecoded_.resize(unnestVariables.size());
+  rawSizes_.resize(unnestVariables.size());
+  rawOffsets_.resize(unnestVariables.size());
+  rawIndices_.resize(unnestVariables.size());
 
   if (withOrdinality_) {
     VELOX_CHECK_EQ(
@@ -58,83 +62,104 @@ Unnest::Unnest(
 
 void Unnest::addInput(RowVectorPtr input) {
   input_ = std::move(input);
-}
-
-RowVectorPtr Unnest::getOutput() {
-  if (!input_) {
-    return nullptr;
-  }
 
-  auto size = input_->size();
+  const auto size = input_->size();
   inputRows_.resize(size);
 
-  // The max number of elements at each row across all unnested columns.
-  auto maxSizes = AlignedBuffer::allocate<int64_t>(size, pool(), 0);
-  auto rawMaxSizes = maxSizes->asMutable<int64_t>();
-
-  std::vector<const vector_size_t*> rawSizes;
-  std::vector<const vector_size_t*> rawOffsets;
-  std::vector<const vector_size_t*> rawIndices;
-
-  rawSizes.resize(unnestChannels_.size());
-  rawOffsets.resize(unnestChannels_.size());
-  rawIndices.resize(unnestChannels_.size());
+  if (!maxSizes_ || maxSizes_->capacity() < size * sizeof(vector_size_t)) {
+    maxSizes_ = allocateSizes(size, pool());
+    rawMaxSizes_ = maxSizes_->asMutable<vector_size_t>();
+  }
+  std::fill(rawMaxSizes_, rawMaxSizes_ + size, 0);
 
   for (auto channel = 0; channel < unnestChannels_.size(); ++channel) {
     const auto& unnestVector = input_->childAt(unnestChannels_[channel]);
     unnestDecoded_[channel].decode(*unnestVector, inputRows_);
 
     auto& currentDecoded = unnestDecoded_[channel];
-    rawIndices[channel] = currentDecoded.indices();
+    rawIndices_[channel] = currentDecoded.indices();
 
-    const ArrayVector* unnestBaseArray;
-    const MapVector* unnestBaseMap;
     if (unnestVector->typeKind() == TypeKind::ARRAY) {
-      unnestBaseArray = currentDecoded.base()->as<ArrayVector>();
-      rawSizes[channel] = unnestBaseArray->rawSizes();
-      rawOffsets[channel] = unnestBaseArray->rawOffsets();
+      const auto* unnestBaseArray = currentDecoded.base()->as<ArrayVector>();
+      rawSizes_[channel] = unnestBaseArray->rawSizes();
+      rawOffsets_[channel] = unnestBaseArray->rawOffsets();
     } else {
       VELOX_CHECK(unnestVector->typeKind() == TypeKind::MAP);
-      unnestBaseMap = currentDecoded.base()->as<MapVector>();
-      rawSizes[channel] = unnestBaseMap->rawSizes();
-      rawOffsets[channel] = unnestBaseMap->rawOffsets();
+      const auto* unnestBaseMap = currentDecoded.base()->as<MapVector>();
+      rawSizes_[channel] = unnestBaseMap->rawSizes();
+      rawOffsets_[channel] = unnestBaseMap->rawOffsets();
     }
 
     // Count max number of elements per row.
-    auto currentSizes = rawSizes[channel];
-    auto currentIndices = rawIndices[channel];
+    auto currentSizes = rawSizes_[channel];
+    auto currentIndices = rawIndices_[channel];
     for (auto row = 0; row < size; ++row) {
       if (!currentDecoded.isNullAt(row)) {
         auto unnestSize = currentSizes[currentIndices[row]];
-        if (rawMaxSizes[row] < unnestSize) {
-          rawMaxSizes[row] = unnestSize;
+        if (rawMaxSizes_[row] < unnestSize) {
+          rawMaxSizes_[row] = unnestSize;
         }
       }
     }
   }
 
-  // Calculate the number of rows in the unnest result.
-  int numElements = 0;
-  for (auto row = 0; row < size; ++row) {
-    numElements += rawMaxSizes[row];
+  nextInputRow_ = 0;
+  nextElement_ = 0;
+}
+
+template <typename Func>
+void Unnest::forEachRow(Func func) const {
+  for (auto row = firstRow_; row <= lastRow_; ++row) {
+    func(
+        row,
+        row == firstRow_ ? firstRowStart_ : 0,
+        row == lastRow_ ? lastRowEnd_ : rawMaxSizes_[row]);
+  }
+}
+
+RowVectorPtr Unnest::getOutput() {
+  if (!input_) {
+    return nullptr;
+  }
+
+  const auto size = input_->size();
+
+  // Find the rows for the output batch. The first and the last row may have
+  // only part of their elements in the batch.
+  firstRow_ = nextInputRow_;
+  firstRowStart_ = nextElement_;
+  vector_size_t numElements = 0;
+  while (nextInputRow_ < size && numElements < maxOutputSize_) {
+    const auto numRowElements = std::min(
+        rawMaxSizes_[nextInputRow_] - nextElement_,
+        maxOutputSize_ - numElements);
+    numElements += numRowElements;
+    lastRow_ = nextInputRow_;
+    lastRowEnd_ = nextElement_ + numRowElements;
+    if (lastRowEnd_ < rawMaxSizes_[nextInputRow_]) {
+      nextElement_ = lastRowEnd_;
+      break;
+    }
+    ++nextInputRow_;
+    nextElement_ = 0;
   }
 
   if (numElements == 0) {
-    // All arrays/maps are null or empty.
+    // All remaining arrays/maps are null or empty.
     input_ = nullptr;
     return nullptr;
   }
 
   // Create "indices" buffer to repeat rows as many times as there are elements
-  // in the array (or map) in unnestDecoded.
+  // in the array (or map) in unnestDecoded. It is shared by all the
+  // replicated columns.
   auto repeatedIndices = allocateIndices(numElements, pool());
   auto* rawRepeatedIndices = repeatedIndices->asMutable<vector_size_t>();
   vector_size_t index = 0;
-  for (auto row = 0; row < size; ++row) {
-    for (auto i = 0; i < rawMaxSizes[row]; i++) {
-      rawRepeatedIndices[index++] = row;
-    }
-  }
+  forEachRow([&](auto row, auto start, auto end) {
+    std::fill_n(rawRepeatedIndices + index, end - start, row);
+    index += end - start;
+  });
 
   // Wrap "replicated" columns in a dictionary using 'repeatedIndices'.
   std::vector<VectorPtr> outputs(outputType_->size());
@@ -147,70 +172,81 @@ RowVectorPtr Unnest::getOutput() {
   vector_size_t outputsIndex = identityProjections_.size();
   for (auto channel = 0; channel < unnestChannels_.size(); ++channel) {
     auto& currentDecoded = unnestDecoded_[channel];
-    auto currentSizes = rawSizes[channel];
-    auto currentOffsets = rawOffsets[channel];
-    auto currentIndices = rawIndices[channel];
+    auto currentSizes = rawSizes_[channel];
+    auto currentOffsets = rawOffsets_[channel];
+    auto currentIndices = rawIndices_[channel];
 
     BufferPtr elementIndices = allocateIndices(numElements, pool());
     auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
 
-    auto nulls =
-        AlignedBuffer::allocate<bool>(numElements, pool(), bits::kNotNull);
-    auto rawNulls = nulls->asMutable<uint64_t>();
+    // Allocated on the first null.
+    BufferPtr nulls;
+    uint64_t* rawNulls = nullptr;
+    auto setNulls = [&](vector_size_t count) {
+      if (!nulls) {
+        nulls =
+            AlignedBuffer::allocate<bool>(numElements, pool(), bits::kNotNull);
+        rawNulls = nulls->asMutable<uint64_t>();
+      }
+      bits::fillBits(rawNulls, index, index + count, bits::kNull);
+      index += count;
+    };
 
-    // Make dictionary index for elements column since they may be out of order.
+    // Make dictionary index for elements column since they may be out of
+    // order. If they are contiguous, the elements are passed through as a
+    // slice instead.
     index = 0;
-    bool identityMapping = true;
-    for (auto row = 0; row < size; ++row) {
-      auto maxSize = rawMaxSizes[row];
-
-      if (!currentDecoded.isNullAt(row)) {
-        auto offset = currentOffsets[currentIndices[row]];
-        auto unnestSize = currentSizes[currentIndices[row]];
-
-        if (index != offset || unnestSize < maxSize) {
-          identityMapping = false;
-        }
-
-        for (auto i = 0; i < unnestSize; i++) {
-          rawElementIndices[index++] = offset + i;
-        }
-
-        for (auto i = unnestSize; i < maxSize; ++i) {
-          bits::setNull(rawNulls, index++, true);
-        }
-      } else if (maxSize > 0) {
-        identityMapping = false;
+    bool contiguous = true;
+    vector_size_t firstOffset = 0;
+    vector_size_t nextOffset = 0;
+    forEachRow([&](auto row, auto start, auto end) {
+      if (start == end) {
+        return;
+      }
+      if (currentDecoded.isNullAt(row)) {
+        setNulls(end - start);
+        return;
+      }
 
-        for (auto i = 0; i < maxSize; ++i) {
-          bits::setNull(rawNulls, index++, true);
-        }
+      auto offset = currentOffsets[currentIndices[row]];
+      auto unnestSize = currentSizes[currentIndices[row]];
+      if (index == 0) {
+        firstOffset = offset + start;
+      } else if (nextOffset != offset + start) {
+        contiguous = false;
       }
-    }
+      for (auto i = start; i < std::min(end, unnestSize); ++i) {
+        rawElementIndices[index++] = offset + i;
+      }
+      nextOffset = offset + std::min(end, unnestSize);
+      if (unnestSize < end) {
+        setNulls(end - std::max(start, unnestSize));
+      }
+    });
+    contiguous = contiguous && !nulls;
+
+    auto wrapElements = [&](const VectorPtr& elements) -> VectorPtr {
+      // Biased and sequence vectors do not support slicing.
+      const auto encoding = elements->encoding();
+      if (!contiguous || encoding == VectorEncoding::Simple::BIASED ||
+          encoding == VectorEncoding::Simple::SEQUENCE) {
+        return wrapChild(numElements, elementIndices, elements, nulls);
+      }
+      if (firstOffset == 0 && numElements == elements->size()) {
+        return elements;
+      }
+      return elements->slice(firstOffset, numElements);
+    };
 
     if (currentDecoded.base()->typeKind() == TypeKind::ARRAY) {
-      // Construct unnest column using Array elements wrapped using above
-      // created dictionary.
+      // Construct unnest column using Array elements.
       auto unnestBaseArray = currentDecoded.base()->as<ArrayVector>();
-      outputs[outputsIndex++] = identityMapping
-          ? unnestBaseArray->elements()
-          : wrapChild(
-                numElements,
-                elementIndices,
-                unnestBaseArray->elements(),
-                nulls);
+      outputs[outputsIndex++] = wrapElements(unnestBaseArray->elements());
     } else {
-      // Construct two unnest columns for Map keys and values vectors wrapped
-      // using above created dictionary.
+      // Construct two unnest columns for Map keys and values vectors.
       auto unnestBaseMap = currentDecoded.base()->as<MapVector>();
-      outputs[outputsIndex++] = identityMapping
-          ? unnestBaseMap->mapKeys()
-          : wrapChild(
-                numElements, elementIndices, unnestBaseMap->mapKeys(), nulls);
-      outputs[outputsIndex++] = identityMapping
-          ? unnestBaseMap->mapValues()
-          : wrapChild(
-                numElements, elementIndices, unnestBaseMap->mapValues(), nulls);
+      outputs[outputsIndex++] = wrapElements(unnestBaseMap->mapKeys());
+      outputs[outputsIndex++] = wrapElements(unnestBaseMap->mapValues());
     }
   }
 
@@ -221,17 +257,18 @@ RowVectorPtr Unnest::getOutput() {
     // Set the ordinality at each result row to be the index of the element in
     // the original array (or map) plus one.
     auto rawOrdinality = ordinalityVector->mutableRawValues();
-    for (auto row = 0; row < size; ++row) {
-      auto maxSize = rawMaxSizes[row];
-      std::iota(rawOrdinality, rawOrdinality + maxSize, 1);
-      rawOrdinality += maxSize;
-    }
+    forEachRow([&](auto /*row*/, auto start, auto end) {
+      std::iota(rawOrdinality, rawOrdinality + end - start, start + 1);
+      rawOrdinality += end - start;
+    });
 
     // Ordinality column is always at the end.
     outputs.back() = std::move(ordinalityVector);
   }
 
-  input_ = nullptr;
+  if (nextInputRow_ == size) {
+    input_ = nullptr;
+  }
   return std::make_shared<RowVector>(
       pool(), outputType_, BufferPtr(nullptr), numElements, std::move(outputs));
 }
@@ -29,21 +29,49 @@ class Unnest : public Operator {
   }
 
   bool needsInput() const override {
-    return true;
+    return !input_;
   }
 
   void addInput(RowVectorPtr input) override;
 
+  /// Returns up to outputBatchRows() rows. An input row with more elements
+  /// than that is split across several output batches.
   RowVectorPtr getOutput() override;
 
   bool isFinished() override;
 
  private:
+  // Calls 'func' with (row, start, end) for each input row in the current
+  // output batch. 'start' and 'end' are the range of the row's elements in
+  // the batch, up to the max size of the row across the unnested columns.
+  template <typename Func>
+  void forEachRow(Func func) const;
+
   std::vector<column_index_t> unnestChannels_;
 
   SelectivityVector inputRows_;
   std::vector<DecodedVector> unnestDecoded_;
+  std::vector<const vector_size_t*> rawSizes_;
+  std::vector<const vector_size_t*> rawOffsets_;
+  std::vector<const vector_size_t*> rawIndices_;
+
+  // The max number of elements at each row of 'input_' across all unnested
+  // columns.
+  BufferPtr maxSizes_;
+  vector_size_t* rawMaxSizes_{nullptr};
+
+  // The input row and its element that the next output batch starts at.
+  vector_size_t nextInputRow_{0};
+  vector_size_t nextElement_{0};
+
+  // The first and the last input row of the current output batch, the
+  // first element of the first row and the end of the elements of the last.
+  vector_size_t firstRow_{0};
+  vector_size_t firstRowStart_{0};
+  vector_size_t lastRow_{0};
+  vector_size_t lastRowEnd_{0};
 
   const bool withOrdinality_;
+  const vector_size_t maxOutputSize_;
 };
 } // namespace facebook::velox::exec
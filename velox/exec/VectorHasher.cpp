@@ -62,6 +62,55 @@ uint64_t hashOne(DecodedVector& decoded, vector_size_t index) {
   using T = typename KindToFlatVector<Kind>::HashRowType;
   return folly::hasher<T>()(decoded.valueAt<T>(index));
 }
+
+// Same as bits::hashMix() for a batch of hashes.
+#if defined(FOLLY_DISABLE_UNDEFINED_BEHAVIOR_SANITIZER)
+FOLLY_DISABLE_UNDEFINED_BEHAVIOR_SANITIZER("unsigned-integer-overflow")
+#endif
+xsimd::batch<uint64_t> hashMix(
+    xsimd::batch<uint64_t> upper,
+    xsimd::batch<uint64_t> lower) {
+  const auto kMul = xsimd::broadcast<uint64_t>(0x9ddfea08eb382d69ULL);
+  auto a = (lower ^ upper) * kMul;
+  a ^= (a >> 47);
+  auto b = (upper ^ a) * kMul;
+  b ^= (b >> 47);
+  return b * kMul;
+}
+
+// Hashes the flat, non-null 'values' in [begin, end) into 'result'. The hashes
+// of a batch of rows are mixed into 'result' at a time, so that the hashes of
+// multiple key columns are combined a column at a time instead of a row at a
+// time. The result is the same as with bits::hashMix() per row.
+template <typename T>
+void hashFlatNoNulls(
+    const T* values,
+    vector_size_t begin,
+    vector_size_t end,
+    bool mix,
+    uint64_t* result) {
+  if (!mix) {
+    for (auto row = begin; row < end; ++row) {
+      result[row] = folly::hasher<T>()(values[row]);
+    }
+    return;
+  }
+  constexpr int32_t kBatchSize = xsimd::batch<uint64_t>::size;
+  alignas(xsimd::default_arch::alignment()) uint64_t hashes[kBatchSize];
+  auto row = begin;
+  for (; row + kBatchSize <= end; row += kBatchSize) {
+    for (auto i = 0; i < kBatchSize; ++i) {
+      hashes[i] = folly::hasher<T>()(values[row + i]);
+    }
+    hashMix(
+        xsimd::load_unaligned(result + row), xsimd::load_aligned(hashes))
+        .store_unaligned(result + row);
+  }
+  for (; row < end; ++row) {
+    result[row] =
+        bits::hashMix(result[row], folly::hasher<T>()(values[row]));
+  }
+}
 } // namespace
 
 template <TypeKind Kind>
@@ -78,6 +127,16 @@ void VectorHasher::hashValues(
       result[row] = mix ? bits::hashMix(result[row], hash) : hash;
     });
   } else if (decoded_.isIdentityMapping()) {
+    // Booleans are bits, not an array of values.
+    if constexpr (
+        std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+        std::is_same_v<T, typename KindToFlatVector<Kind>::HashRowType>) {
+      if (!decoded_.mayHaveNulls() && rows.isAllSelected()) {
+        hashFlatNoNulls(
+            decoded_.data<T>(), rows.begin(), rows.end(), mix, result);
+        return;
+      }
+    }
     rows.applyToSelected([&](vector_size_t row) {
       if (decoded_.isNullAt(row)) {
         result[row] = mix ? bits::hashMix(result[row], kNullHash) : kNullHash;
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <random>
+
+#include "velox/exec/RowContainer.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+
+// Number of rows in the container. Large enough for the rows not to fit in
+// the cache, so that the cost of reaching the rows shows.
+constexpr vector_size_t kNumRows = 1'000'000;
+
+// Number of rows extracted, compared or hashed per call, as in operators
+// producing a batch of output.
+constexpr int32_t kBatchSize = 1'024;
+
+// Holds a RowContainer with a single column of 'type' and pointers to its
+// rows in random order, like the rows of a hash table or a sort.
+class RowContainerBenchmark {
+ public:
+  RowContainerBenchmark(const TypePtr& type, bool withNulls) {
+    // Dependent columns are nullable, keys are not.
+    const std::vector<TypePtr> types{type};
+    container_ = std::make_unique<RowContainer>(
+        withNulls ? std::vector<TypePtr>{} : types,
+        false, // nullableKeys
+        std::vector<Accumulator>{},
+        withNulls ? types : std::vector<TypePtr>{},
+        false, // hasNext
+        false, // isJoinBuild
+        false, // hasProbedFlag
+        false, // hasNormalizedKey
+        pool_.get());
+
+    auto nulls = withNulls ? VectorMaker::nullEvery(5) : nullptr;
+    VectorPtr data;
+    switch (type->kind()) {
+      case TypeKind::BIGINT:
+        data = vectorMaker_.flatVector<int64_t>(
+            kNumRows, [](auto row) { return row * 7; }, nulls);
+        break;
+      case TypeKind::DOUBLE:
+        data = vectorMaker_.flatVector<double>(
+            kNumRows, [](auto row) { return row * 0.3; }, nulls);
+        break;
+      case TypeKind::VARCHAR:
+        data = vectorMaker_.flatVector<std::string>(
+            kNumRows,
+            [](auto row) {
+              return fmt::format("string value number {}", row % 1'000);
+            },
+            nulls);
+        break;
+      default:
+        VELOX_UNSUPPORTED("Unsupported type: {}", type->toString());
+    }
+
+    DecodedVector decoded(*data);
+    rows_.resize(kNumRows);
+    for (auto i = 0; i < kNumRows; ++i) {
+      rows_[i] = container_->newRow();
+      container_->store(decoded, i, rows_[i], 0);
+    }
+    std::shuffle(rows_.begin(), rows_.end(), std::mt19937{1});
+
+    result_ = BaseVector::create(type, kBatchSize, pool_.get());
+    compareResults_.resize(kBatchSize);
+    hashes_.resize(kBatchSize);
+  }
+
+  // Returns the number of rows extracted.
+  int64_t extract() {
+    int64_t numRows = 0;
+    for (auto i = 0; i + kBatchSize <= kNumRows; i += kBatchSize) {
+      container_->extractColumn(rows_.data() + i, kBatchSize, 0, result_);
+      numRows += kBatchSize;
+    }
+    return numRows;
+  }
+
+  // Returns the number of pairs of rows compared.
+  int64_t compare() {
+    int64_t numRows = 0;
+    for (auto i = 0; i + kBatchSize < kNumRows; i += kBatchSize) {
+      container_->compare(
+          rows_.data() + i,
+          rows_.data() + i + 1,
+          kBatchSize,
+          0,
+          CompareFlags(),
+          compareResults_.data());
+      numRows += kBatchSize;
+    }
+    return numRows;
+  }
+
+  // Returns the number of rows hashed.
+  int64_t hash() {
+    int64_t numRows = 0;
+    for (auto i = 0; i + kBatchSize <= kNumRows; i += kBatchSize) {
+      container_->hash(
+          0,
+          folly::Range<char**>(rows_.data() + i, kBatchSize),
+          false,
+          hashes_.data());
+      numRows += kBatchSize;
+    }
+    return numRows;
+  }
+
+ private:
+  std::shared_ptr<memory::MemoryPool> pool_{memory::addDefaultLeafMemoryPool()};
+  VectorMaker vectorMaker_{pool_.get()};
+  std::unique_ptr<RowContainer> container_;
+  std::vector<char*> rows_;
+  VectorPtr result_;
+  std::vector<int32_t> compareResults_;
+  std::vector<uint64_t> hashes_;
+};
+
+std::unique_ptr<RowContainerBenchmark> bigint;
+std::unique_ptr<RowContainerBenchmark> bigintWithNulls;
+std::unique_ptr<RowContainerBenchmark> doubles;
+std::unique_ptr<RowContainerBenchmark> varchar;
+std::unique_ptr<RowContainerBenchmark> varcharWithNulls;
+
+} // namespace
+
+BENCHMARK_MULTI(extractBigint) {
+  return bigint->extract();
+}
+
+BENCHMARK_MULTI(extractBigintWithNulls) {
+  return bigintWithNulls->extract();
+}
+
+BENCHMARK_MULTI(extractDouble) {
+  return doubles->extract();
+}
+
+BENCHMARK_MULTI(extractVarchar) {
+  return varchar->extract();
+}
+
+BENCHMARK_MULTI(extractVarcharWithNulls) {
+  return varcharWithNulls->extract();
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_MULTI(compareBigint) {
+  return bigint->compare();
+}
+
+BENCHMARK_MULTI(compareBigintWithNulls) {
+  return bigintWithNulls->compare();
+}
+
+BENCHMARK_MULTI(compareDouble) {
+  return doubles->compare();
+}
+
+BENCHMARK_MULTI(compareVarchar) {
+  return varchar->compare();
+}
+
+BENCHMARK_MULTI(compareVarcharWithNulls) {
+  return varcharWithNulls->compare();
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_MULTI(hashBigint) {
+  return bigint->hash();
+}
+
+BENCHMARK_MULTI(hashBigintWithNulls) {
+  return bigintWithNulls->hash();
+}
+
+BENCHMARK_MULTI(hashDouble) {
+  return doubles->hash();
+}
+
+BENCHMARK_MULTI(hashVarchar) {
+  return varchar->hash();
+}
+
+BENCHMARK_MULTI(hashVarcharWithNulls) {
+  return varcharWithNulls->hash();
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  bigint = std::make_unique<RowContainerBenchmark>(BIGINT(), false);
+  bigintWithNulls = std::make_unique<RowContainerBenchmark>(BIGINT(), true);
+  doubles = std::make_unique<RowContainerBenchmark>(DOUBLE(), false);
+  varchar = std::make_unique<RowContainerBenchmark>(VARCHAR(), false);
+  varcharWithNulls = std::make_unique<RowContainerBenchmark>(VARCHAR(), true);
+  folly::runBenchmarks();
+  bigint.reset();
+  bigintWithNulls.reset();
+  doubles.reset();
+  varchar.reset();
+  varcharWithNulls.reset();
+  return 0;
+}
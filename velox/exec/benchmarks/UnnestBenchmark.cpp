@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+/// Benchmark for Unnest over arrays of 1 to 10K elements. Each case unnests
+/// 10M elements in vectors of 1M elements with a replicated BIGINT column.
+/// Without nulls, the elements of each output batch are contiguous and passed
+/// through as slices. With every 10th array null, they are wrapped in a
+/// dictionary. The output is counted and summed so that all columns are read.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+constexpr int32_t kNumVectors = 10;
+constexpr int32_t kElementsPerVector = 1'000'000;
+
+class UnnestBenchmark : public VectorTestBase {
+ public:
+  void makeBenchmark(int32_t arraySize, bool withNulls) {
+    const vector_size_t numRows = kElementsPerVector / arraySize;
+    std::vector<RowVectorPtr> vectors;
+    for (auto i = 0; i < kNumVectors; ++i) {
+      vectors.push_back(makeRowVector({
+          makeFlatVector<int64_t>(numRows, [](auto row) { return row; }),
+          makeArrayVector<int64_t>(
+              numRows,
+              [arraySize](auto /*row*/) { return arraySize; },
+              [](auto row, auto index) { return row + index; },
+              withNulls ? nullEvery(10) : nullptr),
+      }));
+    }
+
+    auto plan = exec::test::PlanBuilder()
+                    .values(vectors)
+                    .unnest({"c0"}, {"c1"})
+                    .singleAggregation({}, {"count(c0)", "sum(c1_e)"})
+                    .planNode();
+
+    folly::addBenchmark(
+        __FILE__,
+        fmt::format("unnest_{}{}", arraySize, withNulls ? "_nulls" : ""),
+        [plan, this]() {
+          exec::test::AssertQueryBuilder(plan).copyResults(pool_.get());
+          return 1;
+        });
+  }
+};
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  aggregate::prestosql::registerAllAggregateFunctions();
+  parse::registerTypeResolver();
+
+  UnnestBenchmark bm;
+  for (auto arraySize : {1, 10, 100, 1'000, 10'000}) {
+    bm.makeBenchmark(arraySize, false);
+    bm.makeBenchmark(arraySize, true);
+  }
+
+  folly::runBenchmarks();
+  return 0;
+}
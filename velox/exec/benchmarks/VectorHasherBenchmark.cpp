@@ -238,6 +238,67 @@ BENCHMARK(computeValueIdsLowCardinalityNotAllUsed) {
   }
 }
 
+// Hashes 'numKeys' bigint key columns of 10'000 rows and combines the hashes
+// as a group by or join on these keys does. If 'varcharKey' is true, adds a
+// varchar key column. The columns without nulls use the batched hashing of
+// flat, fixed width values.
+void benchmarkHashKeys(int32_t numKeys, bool withNulls, bool varcharKey) {
+  folly::BenchmarkSuspender suspender;
+  constexpr vector_size_t kSize = 10'000;
+  BenchmarkBase base;
+  std::vector<VectorPtr> keys;
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  for (auto i = 0; i < numKeys; ++i) {
+    keys.push_back(base.vectorMaker().flatVector<int64_t>(
+        kSize,
+        [i](vector_size_t row) { return row * (i + 1); },
+        withNulls ? test::VectorMaker::nullEvery(7) : nullptr));
+    hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), i));
+  }
+  if (varcharKey) {
+    keys.push_back(base.vectorMaker().flatVector<StringView>(
+        kSize, [](vector_size_t row) {
+          return StringView::makeInline(fmt::format("key_{}", row % 1'000));
+        }));
+    hashers.push_back(std::make_unique<VectorHasher>(VARCHAR(), numKeys));
+  }
+  raw_vector<uint64_t> hashes(kSize);
+  SelectivityVector rows(kSize);
+  suspender.dismiss();
+
+  for (int i = 0; i < 1'000; i++) {
+    for (auto j = 0; j < hashers.size(); ++j) {
+      hashers[j]->decode(*keys[j], rows);
+      hashers[j]->hash(rows, j > 0, hashes);
+    }
+    folly::doNotOptimizeAway(hashes);
+  }
+}
+
+BENCHMARK(hash3BigintKeysNoNulls) {
+  benchmarkHashKeys(3, false, false);
+}
+
+BENCHMARK_RELATIVE(hash3BigintKeysWithNulls) {
+  benchmarkHashKeys(3, true, false);
+}
+
+BENCHMARK(hash6BigintKeysNoNulls) {
+  benchmarkHashKeys(6, false, false);
+}
+
+BENCHMARK_RELATIVE(hash6BigintKeysWithNulls) {
+  benchmarkHashKeys(6, true, false);
+}
+
+BENCHMARK(hash3BigintAndVarcharKeysNoNulls) {
+  benchmarkHashKeys(3, false, true);
+}
+
+BENCHMARK_RELATIVE(hash3BigintAndVarcharKeysWithNulls) {
+  benchmarkHashKeys(3, true, true);
+}
+
 int main(int argc, char** argv) {
   folly::init(&argc, &argv);
   folly::runBenchmarks();
@@ -842,6 +842,51 @@ TEST_F(AggregationTest, partialDistinctWithAbandon) {
              .assertResults("SELECT distinct c0, sum(c0) FROM tmp group by c0");
 }
 
+TEST_F(AggregationTest, partialAggregationKeepHeavyHitters) {
+  // Half of the rows have key 0. The other keys are unique.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(
+             1'000, [&](auto row) { return row % 2 ? i * 1'000 + row : 0; }),
+         makeFlatVector<int64_t>(1'000, [](auto row) { return row; })}));
+  }
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .partialAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                  .finalAggregation()
+                  .planNode();
+  for (const auto keepHeavyHitters : {false, true}) {
+    SCOPED_TRACE(fmt::format("keepHeavyHitters: {}", keepHeavyHitters));
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(QueryConfig::kAbandonPartialAggregationMinRows, "100")
+            .config(QueryConfig::kAbandonPartialAggregationMinPct, "40")
+            .config(
+                QueryConfig::kAbandonPartialAggregationKeepHeavyHitters,
+                keepHeavyHitters ? "true" : "false")
+            .config("max_drivers_per_task", "1")
+            .assertResults(
+                "SELECT c0, sum(c1), count(1) FROM tmp GROUP BY c0");
+
+    auto partialStats = task->taskStats().pipelineStats[0].operatorStats[1];
+    ASSERT_EQ(
+        1, partialStats.runtimeStats.count("abandonedPartialAggregation"));
+    if (!keepHeavyHitters) {
+      ASSERT_EQ(0, partialStats.runtimeStats.count("heavyHitterKeys"));
+      continue;
+    }
+    ASSERT_EQ(1, partialStats.runtimeStats.at("heavyHitterKeys").sum);
+    ASSERT_LT(0, partialStats.runtimeStats.at("heavyHitterReductionPct").min);
+    // The key 0 rows after abandoning partial aggregation are reduced to one
+    // row per flush.
+    ASSERT_LT(
+        partialStats.outputPositions, partialStats.inputPositions * 6 / 10);
+  }
+}
+
 TEST_F(AggregationTest, largeValueRangeArray) {
   // We have keys that map to integer range. The keys are
   // a little under max array hash table size apart. This wastes 16MB of
@@ -1881,6 +1926,57 @@ TEST_F(AggregationTest, distinctWithSpilling) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(AggregationTest, hashDistinctAggregations) {
+  auto vectors = makeVectors(rowType_, 100, 10);
+  createDuckDbTable(vectors);
+  // count(distinct c2) and sum(distinct c2) share the de-duplication of c2.
+  const std::vector<std::string> aggregates = {
+      "count(distinct c2)",
+      "sum(distinct c2)",
+      "count(distinct c6)",
+      "count(c2)"};
+  const auto duckDbAggregates =
+      "count(distinct c2), sum(distinct c2), count(distinct c6), count(c2)";
+  const auto groupByPlan = PlanBuilder()
+                               .values(vectors)
+                               .singleAggregation({"c1"}, aggregates)
+                               .planNode();
+  const auto globalPlan = PlanBuilder()
+                              .values(vectors)
+                              .singleAggregation({}, aggregates)
+                              .planNode();
+  const auto groupBySql =
+      fmt::format("SELECT c1, {} FROM tmp GROUP BY 1", duckDbAggregates);
+  const auto globalSql = fmt::format("SELECT {} FROM tmp", duckDbAggregates);
+
+  for (const auto* hashMode : {"false", "true"}) {
+    SCOPED_TRACE(hashMode);
+    AssertQueryBuilder(groupByPlan, duckDbQueryRunner_)
+        .config(QueryConfig::kHashDistinctAggregationEnabled, hashMode)
+        .assertResults(groupBySql);
+    AssertQueryBuilder(globalPlan, duckDbQueryRunner_)
+        .config(QueryConfig::kHashDistinctAggregationEnabled, hashMode)
+        .assertResults(globalSql);
+  }
+
+  // Spilling uses the hash mode.
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  core::PlanNodeId aggrNodeId;
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .spillDirectory(spillDirectory->path)
+                  .config(QueryConfig::kSpillEnabled, "true")
+                  .config(QueryConfig::kAggregationSpillEnabled, "true")
+                  .config(QueryConfig::kTestingSpillPct, "100")
+                  .plan(PlanBuilder()
+                            .values(vectors)
+                            .singleAggregation({"c1"}, aggregates)
+                            .capturePlanNodeId(aggrNodeId)
+                            .planNode())
+                  .assertResults(groupBySql);
+  ASSERT_GT(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
+
 TEST_F(AggregationTest, preGroupedAggregationWithSpilling) {
   std::vector<RowVectorPtr> vectors;
   int64_t val = 0;
@@ -2508,6 +2604,88 @@ DEBUG_ONLY_TEST_F(AggregationTest, reclaimDuringOutputProcessing) {
   ASSERT_EQ(reclaimerStats_, memory::MemoryReclaimer::Stats{0});
 }
 
+DEBUG_ONLY_TEST_F(AggregationTest, reclaimSortedAggregationDuringOutput) {
+  constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
+  std::vector<RowVectorPtr> batches;
+  for (int32_t i = 0; i < 10; ++i) {
+    const auto start = i * 1'000;
+    batches.push_back(makeRowVector({
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row % 97; }),
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (start + row) * 7'919 % 1'000; }),
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return start + row; }),
+    }));
+  }
+  auto plan = PlanBuilder()
+                  .values(batches)
+                  .singleAggregation({"c0"}, {"sum(c2 ORDER BY c1)"})
+                  .planNode();
+  auto expectedResult =
+      AssertQueryBuilder(plan).maxDrivers(1).copyResults(pool_.get());
+
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  auto queryCtx = std::make_shared<core::QueryCtx>(executor_.get());
+  queryCtx->testingOverrideMemoryPool(
+      memory::defaultMemoryManager().addRootPool(
+          queryCtx->queryId(), kMaxBytes));
+
+  std::atomic<bool> driverWaitFlag{true};
+  folly::EventCount driverWait;
+  std::atomic<bool> testWaitFlag{true};
+  folly::EventCount testWait;
+
+  std::atomic<bool> injectNoMoreInputOnce{true};
+  Operator* op{nullptr};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Driver::runInternal::noMoreInput",
+      std::function<void(Operator*)>(([&](Operator* testOp) {
+        if (testOp->operatorType() != "Aggregation") {
+          return;
+        }
+        if (!injectNoMoreInputOnce.exchange(false)) {
+          return;
+        }
+        op = testOp;
+        testWaitFlag = false;
+        testWait.notifyAll();
+        driverWait.await([&]() { return !driverWaitFlag.load(); });
+      })));
+
+  std::thread taskThread([&]() {
+    AssertQueryBuilder(plan)
+        .queryCtx(queryCtx)
+        .spillDirectory(tempDirectory->path)
+        .config(QueryConfig::kSpillEnabled, "true")
+        .config(QueryConfig::kAggregationSpillEnabled, "true")
+        .maxDrivers(1)
+        .assertResults(expectedResult);
+  });
+
+  testWait.await([&]() { return !testWaitFlag.load(); });
+  ASSERT_TRUE(op != nullptr);
+
+  auto task = op->testingOperatorCtx()->task();
+  auto taskPauseWait = task->requestPause();
+  driverWaitFlag = false;
+  driverWait.notifyAll();
+  taskPauseWait.wait();
+
+  // Spilling the output frees the input rows of the sorted aggregation.
+  const auto usedMemory = op->pool()->currentBytes();
+  op->reclaim(0, reclaimerStats_);
+  ASSERT_EQ(reclaimerStats_.numNonReclaimableAttempts, 0);
+  ASSERT_GT(usedMemory, op->pool()->currentBytes());
+
+  Task::resume(task);
+  taskThread.join();
+
+  auto stats = task->taskStats().pipelineStats;
+  ASSERT_GT(stats[0].operatorStats[1].spilledBytes, 0);
+  ASSERT_EQ(stats[0].operatorStats[1].spilledPartitions, 1);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  ASSERT_EQ(reclaimerStats_, memory::MemoryReclaimer::Stats{0});
+}
+
 DEBUG_ONLY_TEST_F(AggregationTest, reclaimDuringNonReclaimableSection) {
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
   auto rowType = ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), INTEGER()});
@@ -3002,6 +3180,46 @@ DEBUG_ONLY_TEST_F(AggregationTest, abortDuringInputgProcessing) {
   }
 }
 
+TEST_F(AggregationTest, partitionedFinalAggregation) {
+  constexpr int32_t kNumDrivers = 4;
+  auto vectors = makeVectors(rowType_, 1'000, 10);
+  // Parallelizable values produce 'vectors' once per driver.
+  std::vector<RowVectorPtr> allVectors;
+  for (auto i = 0; i < kNumDrivers; ++i) {
+    allVectors.insert(allVectors.end(), vectors.begin(), vectors.end());
+  }
+  createDuckDbTable(allVectors);
+
+  auto partialFinalPlan =
+      PlanBuilder()
+          .values(vectors, true)
+          .partialAggregation(
+              {"c0", "c6"}, {"sum(c2)", "count(1)", "max(c6)", "min(c1)"})
+          .finalAggregation()
+          .planNode();
+  auto singlePlan =
+      PlanBuilder()
+          .values(vectors, true)
+          .singleAggregation({"c1"}, {"sum(c2)", "count(1)", "max(c6)"})
+          .planNode();
+
+  // Without partitioning each driver would produce its own copy of the
+  // groups.
+  auto task =
+      AssertQueryBuilder(partialFinalPlan, duckDbQueryRunner_)
+          .config(QueryConfig::kPartitionedAggregationEnabled, "true")
+          .maxDrivers(kNumDrivers)
+          .assertResults(
+              "SELECT c0, c6, sum(c2), count(1), max(c6), min(c1) FROM tmp GROUP BY 1, 2");
+  EXPECT_EQ(kNumDrivers, task->numTotalDrivers());
+
+  AssertQueryBuilder(singlePlan, duckDbQueryRunner_)
+      .config(QueryConfig::kPartitionedAggregationEnabled, "true")
+      .maxDrivers(kNumDrivers)
+      .assertResults(
+          "SELECT c1, sum(c2), count(1), max(c6) FROM tmp GROUP BY 1");
+}
+
 TEST_F(AggregationTest, noAggregationsNoGroupingKeys) {
   auto data = makeRowVector({
       makeFlatVector<int32_t>({1, 2, 3}),
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/DriverScheduler.h"
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/ManualExecutor.h>
+#include <gtest/gtest.h>
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+using namespace facebook::velox::exec::test;
+
+class DriverSchedulerTest : public OperatorTestBase {
+ protected:
+  std::vector<RowVectorPtr> makeVectors(int32_t numVectors) {
+    std::vector<RowVectorPtr> vectors;
+    for (auto i = 0; i < numVectors; ++i) {
+      vectors.push_back(makeRowVector({
+          makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+          makeFlatVector<int64_t>(1'000, [&](auto row) { return row * i; }),
+      }));
+    }
+    return vectors;
+  }
+};
+
+TEST_F(DriverSchedulerTest, levels) {
+  folly::ManualExecutor executor;
+  DriverScheduler scheduler(&executor);
+  EXPECT_EQ(5, scheduler.numLevels());
+  EXPECT_EQ(0, scheduler.level(0));
+  EXPECT_EQ(0, scheduler.level(999'999'999));
+  EXPECT_EQ(1, scheduler.level(1'000'000'000));
+  EXPECT_EQ(2, scheduler.level(30'000'000'000));
+  EXPECT_EQ(4, scheduler.level(1'000'000'000'000));
+
+  DriverScheduler::Options options;
+  options.levelThresholdNanos = {10, 5};
+  VELOX_ASSERT_THROW(DriverScheduler(&executor, options), "");
+}
+
+TEST_F(DriverSchedulerTest, priority) {
+  // Nothing runs until the executor is run, so the Drivers of both Tasks are
+  // queued at the same level when the first one is picked.
+  folly::ManualExecutor executor;
+  DriverScheduler scheduler(&executor);
+  auto plan = PlanBuilder().values(makeVectors(2)).planNode();
+
+  std::vector<std::string> runOrder;
+  std::mutex mutex;
+  auto makeTask = [&](const std::string& taskId, int32_t priority) {
+    auto queryCtx = std::make_shared<core::QueryCtx>(
+        &scheduler,
+        std::unordered_map<std::string, std::string>{
+            {core::QueryConfig::kQueryPriority, std::to_string(priority)}});
+    return Task::create(
+        taskId,
+        core::PlanFragment{plan},
+        0,
+        std::move(queryCtx),
+        [&, taskId](RowVectorPtr vector, ContinueFuture* /*future*/) {
+          if (vector) {
+            std::lock_guard<std::mutex> l(mutex);
+            if (std::find(runOrder.begin(), runOrder.end(), taskId) ==
+                runOrder.end()) {
+              runOrder.push_back(taskId);
+            }
+          }
+          return BlockingReason::kNotBlocked;
+        });
+  };
+
+  auto low = makeTask("low", 0);
+  auto high = makeTask("high", 10);
+  Task::start(low, 1);
+  Task::start(high, 1);
+  EXPECT_EQ(2, scheduler.numQueued());
+  executor.drain();
+  EXPECT_EQ(0, scheduler.numQueued());
+
+  ASSERT_EQ((std::vector<std::string>{"high", "low"}), runOrder);
+  for (const auto& task : {low, high}) {
+    ASSERT_TRUE(waitForTaskCompletion(task.get()));
+    const auto stats = task->taskStats();
+    EXPECT_EQ(1, stats.numSchedulerSlices);
+    EXPECT_EQ(0, stats.numSchedulerYields);
+  }
+}
+
+TEST_F(DriverSchedulerTest, yieldRequeuesAtUpdatedLevel) {
+  // Any CPU time moves a Task to level 1. The Driver yields after its first
+  // time slice and must be queued at the level of the CPU time of that slice.
+  folly::ManualExecutor executor;
+  DriverScheduler::Options options;
+  options.timeSliceMicros = 1;
+  options.levelThresholdNanos = {1};
+  DriverScheduler scheduler(&executor, options);
+  auto plan = PlanBuilder()
+                  .values(makeVectors(10), true, 100)
+                  .project({"c0 + c1"})
+                  .planNode();
+
+  auto task = Task::create(
+      "yield",
+      core::PlanFragment{plan},
+      0,
+      std::make_shared<core::QueryCtx>(&scheduler),
+      [](RowVectorPtr /*vector*/, ContinueFuture* /*future*/) {
+        return BlockingReason::kNotBlocked;
+      });
+  Task::start(task, 1);
+  EXPECT_EQ(1, scheduler.numQueued(0));
+
+  ASSERT_EQ(1, executor.run());
+  const auto stats = task->taskStats();
+  ASSERT_EQ(1, stats.numSchedulerYields);
+  EXPECT_GT(task->schedulerCpuNanos(), 0);
+  EXPECT_EQ(0, scheduler.numQueued(0));
+  EXPECT_EQ(1, scheduler.numQueued(1));
+
+  executor.drain();
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  EXPECT_EQ(0, scheduler.numQueued());
+}
+
+TEST_F(DriverSchedulerTest, timeSlices) {
+  // One thread and short time slices, so that the Drivers take turns.
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(1);
+  DriverScheduler::Options options;
+  options.timeSliceMicros = 1'000;
+  DriverScheduler scheduler(executor.get(), options);
+
+  constexpr int32_t kNumDrivers = 4;
+  constexpr int32_t kRepeat = 100;
+  auto vectors = makeVectors(10);
+  auto plan = PlanBuilder()
+                  .values(vectors, true, kRepeat)
+                  .filter("c0 % 7 <> 0")
+                  .project({"c0 * 3 + c1 % 11 AS p0", "c1 % 13 AS p1"})
+                  .planNode();
+  const vector_size_t numRows = kNumDrivers * kRepeat * vectors.size() *
+      (1'000 - (1'000 + 6) / 7);
+
+  auto task = AssertQueryBuilder(plan)
+                  .queryCtx(std::make_shared<core::QueryCtx>(&scheduler))
+                  .maxDrivers(kNumDrivers)
+                  .assertTypeAndNumRows(
+                      ROW({"p0", "p1"}, {BIGINT(), BIGINT()}), numRows);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+
+  const auto stats = task->taskStats();
+  EXPECT_GT(stats.numSchedulerSlices, kNumDrivers);
+  EXPECT_GT(stats.numSchedulerYields, 0);
+  EXPECT_GT(stats.schedulerCpuNanos, 0);
+  EXPECT_GT(stats.schedulerQueuedWallNanos, 0);
+  EXPECT_GE(stats.schedulerQueuedWallNanos, stats.schedulerMaxQueuedWallNanos);
+  EXPECT_EQ(0, scheduler.numQueued());
+  executor->join();
+}
+
+} // namespace
+} // namespace facebook::velox::exec
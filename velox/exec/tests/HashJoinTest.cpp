@@ -983,6 +983,143 @@ TEST_P(MultiThreadedHashJoinTest, emptyProbeWithSpillMemoryThreshold) {
       .run();
 }
 
+TEST_P(MultiThreadedHashJoinTest, skewedSpillPartition) {
+  // Most of the build rows have the same join key, which recursive spilling
+  // can't split.
+  std::vector<RowVectorPtr> buildVectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    buildVectors.push_back(makeRowVector(
+        {"u_k0", "u_data"},
+        {makeFlatVector<int64_t>(
+             20,
+             [&](auto row) { return row % 10 == 0 ? 100 + i * 20 + row : 1; }),
+         makeFlatVector<int64_t>(20, [&](auto row) { return i * 20 + row; })}));
+  }
+  std::vector<RowVectorPtr> probeVectors;
+  for (int32_t i = 0; i < 2; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t_k0", "t_data"},
+        {makeFlatVector<int64_t>(30, [](auto row) { return row % 10; }),
+         makeFlatVector<int64_t>(30, [&](auto row) { return i * 30 + row; })}));
+  }
+
+  for (const auto joinType :
+       {core::JoinType::kInner,
+        core::JoinType::kRight,
+        core::JoinType::kRightSemiFilter}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    const bool rightSemi = joinType == core::JoinType::kRightSemiFilter;
+    std::string referenceQuery;
+    if (joinType == core::JoinType::kInner) {
+      referenceQuery =
+          "SELECT t_k0, t_data, u_k0, u_data FROM t, u WHERE t_k0 = u_k0";
+    } else if (joinType == core::JoinType::kRight) {
+      referenceQuery =
+          "SELECT t_k0, t_data, u_k0, u_data FROM t RIGHT JOIN u "
+          "ON t_k0 = u_k0";
+    } else {
+      referenceQuery =
+          "SELECT u_k0, u_data FROM u WHERE u_k0 IN (SELECT t_k0 FROM t)";
+    }
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(numDrivers_)
+        .probeKeys({"t_k0"})
+        .probeVectors(std::vector<RowVectorPtr>(probeVectors))
+        .buildKeys({"u_k0"})
+        .buildVectors(std::vector<RowVectorPtr>(buildVectors))
+        .joinType(joinType)
+        .joinOutputLayout(
+            rightSemi ? std::vector<std::string>{"u_k0", "u_data"}
+                      : std::vector<std::string>{
+                            "t_k0", "t_data", "u_k0", "u_data"})
+        .config(core::QueryConfig::kJoinSpillSkewedKeyPct, "50")
+        .maxSpillLevel(0)
+        .referenceQuery(referenceQuery)
+        .verifier([&](const std::shared_ptr<Task>& task, bool injectSpill) {
+          int64_t numSkewedPartitions{0};
+          int64_t numSkewedRows{0};
+          for (auto& pipelineStats : task->taskStats().pipelineStats) {
+            for (auto& operatorStats : pipelineStats.operatorStats) {
+              if (operatorStats.operatorType != "HashBuild") {
+                continue;
+              }
+              numSkewedPartitions +=
+                  operatorStats.runtimeStats["spilledSkewedPartitions"].sum;
+              numSkewedRows +=
+                  operatorStats.runtimeStats["spilledSkewedRows"].sum;
+            }
+          }
+          if (injectSpill) {
+            ASSERT_GT(numSkewedPartitions, 0);
+            ASSERT_GT(numSkewedRows, 0);
+          } else {
+            ASSERT_EQ(numSkewedPartitions, 0);
+            ASSERT_EQ(numSkewedRows, 0);
+          }
+        })
+        .run();
+  }
+}
+
+DEBUG_ONLY_TEST_P(
+    MultiThreadedHashJoinTest,
+    skewedSpillPartitionReservationFailure) {
+  std::vector<RowVectorPtr> buildVectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    buildVectors.push_back(makeRowVector(
+        {"u_k0", "u_data"},
+        {makeFlatVector<int64_t>(20, [](auto /*row*/) { return 1; }),
+         makeFlatVector<int64_t>(20, [&](auto row) { return i * 20 + row; })}));
+  }
+  std::vector<RowVectorPtr> probeVectors;
+  for (int32_t i = 0; i < 2; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t_k0", "t_data"},
+        {makeFlatVector<int64_t>(30, [](auto row) { return row % 3; }),
+         makeFlatVector<int64_t>(30, [&](auto row) { return i * 30 + row; })}));
+  }
+
+  // Fails the reservation of every input of a restored skewed partition,
+  // including the first one. Each chunk of the partition must still keep its
+  // first rows in memory for the join to finish.
+  std::atomic_int numReservationFailures{0};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::HashBuild::ensureInputFits::skewedSpillPartition",
+      std::function<void(bool*)>([&](bool* reserved) {
+        *reserved = false;
+        ++numReservationFailures;
+      }));
+
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .numDrivers(numDrivers_)
+      .probeKeys({"t_k0"})
+      .probeVectors(std::move(probeVectors))
+      .buildKeys({"u_k0"})
+      .buildVectors(std::move(buildVectors))
+      .joinOutputLayout({"t_k0", "t_data", "u_k0", "u_data"})
+      .config(core::QueryConfig::kJoinSpillSkewedKeyPct, "50")
+      .maxSpillLevel(0)
+      .referenceQuery(
+          "SELECT t_k0, t_data, u_k0, u_data FROM t, u WHERE t_k0 = u_k0")
+      .verifier([&](const std::shared_ptr<Task>& task, bool injectSpill) {
+        if (!injectSpill) {
+          return;
+        }
+        ASSERT_GT(numReservationFailures, 0);
+        int64_t numSkewedPartitions{0};
+        for (auto& pipelineStats : task->taskStats().pipelineStats) {
+          for (auto& operatorStats : pipelineStats.operatorStats) {
+            if (operatorStats.operatorType == "HashBuild") {
+              numSkewedPartitions +=
+                  operatorStats.runtimeStats["spilledSkewedPartitions"].sum;
+            }
+          }
+        }
+        ASSERT_GT(numSkewedPartitions, 0);
+      })
+      .run();
+}
+
 DEBUG_ONLY_TEST_P(
     MultiThreadedHashJoinTest,
     raceBetweenTaskTerminationAndThesholdTriggeredSpill) {
@@ -564,6 +564,15 @@ TEST_P(HashTableTest, mixed6Sparse) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
 }
 
+// All keys are fixed width, so that these are compared with one memcmp.
+TEST_P(HashTableTest, int6SparseHash) {
+  auto type =
+      ROW({"k1", "k2", "k3", "k4", "k5", "k6"},
+          {BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
+}
+
 // It should be safe to call clear() before we insert any data into HashTable
 TEST_P(HashTableTest, clear) {
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
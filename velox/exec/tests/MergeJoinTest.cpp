@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
@@ -415,6 +417,80 @@ TEST_F(MergeJoinTest, leftJoinFilter) {
   }
 }
 
+TEST_F(MergeJoinTest, spill) {
+  // Each join key has 50 rows on the left side and 120 rows on the right side,
+  // which span 3 or 4 right side batches. The last 3 keys on the left side have
+  // no match.
+  std::vector<RowVectorPtr> left;
+  for (auto i = 0; i < 2; ++i) {
+    left.push_back(makeRowVector(
+        {"t_c0", "t_c1"},
+        {makeFlatVector<int32_t>(
+             300, [i](auto row) { return (i * 300 + row) / 50; }),
+         makeFlatVector<int32_t>(300, [](auto row) { return row; })}));
+  }
+  std::vector<RowVectorPtr> right;
+  for (auto i = 0; i < 20; ++i) {
+    right.push_back(makeRowVector(
+        {"u_c0", "u_c1"},
+        {makeFlatVector<int32_t>(
+             50, [i](auto row) { return (i * 50 + row) / 120; }),
+         makeFlatVector<int32_t>(50, [](auto row) { return row; })}));
+  }
+  createDuckDbTable("t", left);
+  createDuckDbTable("u", right);
+
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    for (const std::string filter : {"", "(t_c1 + u_c1) % 3 = 0"}) {
+      for (const bool triggerByThreshold : {false, true}) {
+        SCOPED_TRACE(fmt::format(
+            "joinType:{} filter:{} triggerByThreshold:{}",
+            joinTypeName(joinType),
+            filter,
+            triggerByThreshold));
+        auto spillDirectory = TempDirectoryPath::create();
+        auto planNodeIdGenerator =
+            std::make_shared<core::PlanNodeIdGenerator>();
+        core::PlanNodeId joinNodeId;
+        auto plan =
+            PlanBuilder(planNodeIdGenerator)
+                .values(left)
+                .mergeJoin(
+                    {"t_c0"},
+                    {"u_c0"},
+                    PlanBuilder(planNodeIdGenerator).values(right).planNode(),
+                    filter,
+                    {"t_c0", "t_c1", "u_c0", "u_c1"},
+                    joinType)
+                .capturePlanNodeId(joinNodeId)
+                .planNode();
+
+        AssertQueryBuilder builder(plan, duckDbQueryRunner_);
+        builder.spillDirectory(spillDirectory->path)
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kJoinSpillEnabled, "true")
+            // Fill up the output in the middle of the right side match.
+            .config(core::QueryConfig::kPreferredOutputBatchRows, "64");
+        if (triggerByThreshold) {
+          builder.config(
+              core::QueryConfig::kMergeJoinSpillMemoryThreshold, "1");
+        } else {
+          builder.config(core::QueryConfig::kTestingSpillPct, "100");
+        }
+        auto task = builder.assertResults(fmt::format(
+            "SELECT t_c0, t_c1, u_c0, u_c1 FROM t {} JOIN u ON t_c0 = u_c0{}",
+            joinTypeName(joinType),
+            filter.empty() ? "" : " AND " + filter));
+
+        const auto& joinStats = toPlanStats(task->taskStats()).at(joinNodeId);
+        ASSERT_GT(joinStats.spilledBytes, 0);
+        ASSERT_GT(joinStats.spilledRows, 0);
+        OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+      }
+    }
+  }
+}
+
 // Verify that both left-side and right-side pipelines feeding the merge join
 // always run single-threaded.
 TEST_F(MergeJoinTest, numDrivers) {
@@ -13,8 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/VectorTestUtil.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
@@ -334,6 +337,78 @@ TEST_F(NestedLoopJoinTest, lazyVectors) {
   assertQuery(op, "SELECT * FROM t FULL JOIN u ON t.c0 + u.c0 < 100");
 }
 
+TEST_F(NestedLoopJoinTest, spill) {
+  std::vector<RowVectorPtr> probeVectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    probeVectors.push_back(
+        makeRowVector({"t0"}, {sequence<int32_t>(100, i * 100)}));
+  }
+  // Some build side rows match no probe side row, so that right and full
+  // joins read the spilled build side once more for the mismatches.
+  std::vector<RowVectorPtr> buildVectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    buildVectors.push_back(
+        makeRowVector({"u0"}, {sequence<int32_t>(50, 25 + i * 50)}));
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  for (const auto joinType :
+       {core::JoinType::kInner,
+        core::JoinType::kLeft,
+        core::JoinType::kRight,
+        core::JoinType::kFull}) {
+    for (const bool triggerByThreshold : {false, true}) {
+      for (const int32_t numDrivers : {1, 4}) {
+        SCOPED_TRACE(fmt::format(
+            "joinType:{} triggerByThreshold:{} numDrivers:{}",
+            joinTypeName(joinType),
+            triggerByThreshold,
+            numDrivers));
+        auto spillDirectory = TempDirectoryPath::create();
+        auto planNodeIdGenerator =
+            std::make_shared<core::PlanNodeIdGenerator>();
+        core::PlanNodeId joinNodeId;
+        auto plan = PlanBuilder(planNodeIdGenerator)
+                        .values(probeVectors)
+                        .localPartition({"t0"})
+                        .nestedLoopJoin(
+                            PlanBuilder(planNodeIdGenerator)
+                                .values(buildVectors)
+                                .localPartition({"u0"})
+                                .planNode(),
+                            "u0 BETWEEN t0 + 100 AND t0 + 105",
+                            {"t0", "u0"},
+                            joinType)
+                        .capturePlanNodeId(joinNodeId)
+                        .planNode();
+
+        AssertQueryBuilder builder(plan, duckDbQueryRunner_);
+        builder.maxDrivers(numDrivers)
+            .spillDirectory(spillDirectory->path)
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kJoinSpillEnabled, "true")
+            // Read the spilled build side back in small batches.
+            .config(core::QueryConfig::kSpillWriteBufferSize, "0");
+        if (triggerByThreshold) {
+          builder.config(
+              core::QueryConfig::kNestedLoopJoinSpillMemoryThreshold, "1");
+        } else {
+          builder.config(core::QueryConfig::kTestingSpillPct, "100");
+        }
+        auto task = builder.assertResults(fmt::format(
+            "SELECT t0, u0 FROM t {} JOIN u ON u0 BETWEEN t0 + 100 AND t0 + 105",
+            joinTypeName(joinType)));
+
+        const auto& joinStats = toPlanStats(task->taskStats()).at(joinNodeId);
+        ASSERT_GT(joinStats.spilledBytes, 0);
+        ASSERT_EQ(joinStats.spilledRows, 500);
+        OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+      }
+    }
+  }
+}
+
 // Test cross join with a build side that has rows, but no columns.
 TEST_F(NestedLoopJoinTest, zeroColumnBuild) {
   auto probeVectors = {
@@ -1306,3 +1306,74 @@ TEST_F(RowContainerTest, unknown) {
         return rowContainer->compareRows(l.second, r.second) < 0;
       }));
 }
+
+TEST_F(RowContainerTest, extractAndCompareBatches) {
+  constexpr vector_size_t kSize = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row % 31; }),
+      makeFlatVector<double>(kSize, [](auto row) { return row * 0.5; }),
+      makeFlatVector<std::string>(
+          kSize,
+          [](auto row) { return fmt::format("a long string {}", row % 11); },
+          nullEvery(7)),
+  });
+  // The keys are not nullable, which extracts them without null checks.
+  auto rowContainer = makeRowContainer({BIGINT(), DOUBLE()}, {VARCHAR()});
+  std::vector<char*> rows(kSize);
+  std::vector<DecodedVector> decoded(data->childrenSize());
+  for (auto column = 0; column < data->childrenSize(); ++column) {
+    decoded[column].decode(*data->childAt(column));
+  }
+  for (auto row = 0; row < kSize; ++row) {
+    rows[row] = rowContainer->newRow();
+    for (auto column = 0; column < data->childrenSize(); ++column) {
+      rowContainer->store(decoded[column], row, rows[row], column);
+    }
+  }
+
+  // Null rows in the middle of the batches stop the gather of the fixed
+  // width keys. The result vectors are reused and start with all nulls.
+  auto withNullRows = rows;
+  for (auto row = 0; row < kSize; row += 13) {
+    withNullRows[row] = nullptr;
+  }
+  for (auto column = 0; column < data->childrenSize(); ++column) {
+    const auto& expected = data->childAt(column);
+    auto result = BaseVector::create(expected->type(), kSize, pool_.get());
+    for (auto row = 0; row < kSize; ++row) {
+      result->setNull(row, true);
+    }
+    rowContainer->extractColumn(rows.data(), kSize, column, result);
+    assertEqualVectors(expected, result);
+
+    rowContainer->extractColumn(withNullRows.data(), kSize, column, result);
+    for (auto row = 0; row < kSize; ++row) {
+      if (row % 13 == 0) {
+        EXPECT_TRUE(result->isNullAt(row));
+      } else {
+        EXPECT_TRUE(result->equalValueAt(expected.get(), row, row));
+      }
+    }
+  }
+
+  // The batched compare gives the same results as comparing one pair at a
+  // time.
+  std::vector<int32_t> results(kSize - 1);
+  for (auto column = 0; column < data->childrenSize(); ++column) {
+    for (auto flags :
+         {CompareFlags{true, true, false}, CompareFlags{false, false, false}}) {
+      rowContainer->compare(
+          rows.data(),
+          rows.data() + 1,
+          kSize - 1,
+          column,
+          flags,
+          results.data());
+      for (auto row = 0; row < kSize - 1; ++row) {
+        EXPECT_EQ(
+            rowContainer->compare(rows[row], rows[row + 1], column, flags),
+            results[row]);
+      }
+    }
+  }
+}
@@ -57,6 +57,7 @@ class SortBufferTest : public OperatorTestBase {
         false,
         0,
         0,
+        0,
         "none");
   }
 
@@ -304,6 +305,7 @@ TEST_F(SortBufferTest, batchOutput) {
         0,
         false,
         0,
+        0,
         100, //  testSpillPct
         "none");
     auto sortBuffer = std::make_unique<SortBuffer>(
@@ -400,6 +402,7 @@ TEST_F(SortBufferTest, spill) {
         false,
         0,
         0,
+        0,
         "none");
     auto sortBuffer = std::make_unique<SortBuffer>(
         inputType_,
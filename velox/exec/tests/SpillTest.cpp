@@ -707,6 +707,8 @@ TEST(SpillTest, spillStats) {
   stats1.spillFillTimeUs = 1023;
   stats1.spilledRows = 1023;
   stats1.spillSerializationTimeUs = 1023;
+  stats1.spilledSkewedPartitions = 1;
+  stats1.spilledSkewedRows = 1023;
   ASSERT_FALSE(stats1.empty());
   SpillStats stats2;
   stats2.spillRuns = 100;
@@ -721,6 +723,8 @@ TEST(SpillTest, spillStats) {
   stats2.spillFillTimeUs = 1030;
   stats2.spilledRows = 1031;
   stats2.spillSerializationTimeUs = 1032;
+  stats2.spilledSkewedPartitions = 2;
+  stats2.spilledSkewedRows = 1033;
   ASSERT_TRUE(stats1 < stats2);
   ASSERT_TRUE(stats1 <= stats2);
   ASSERT_FALSE(stats1 > stats2);
@@ -747,6 +751,8 @@ TEST(SpillTest, spillStats) {
   ASSERT_EQ(delta.spillFillTimeUs, 7);
   ASSERT_EQ(delta.spilledRows, 8);
   ASSERT_EQ(delta.spillSerializationTimeUs, 9);
+  ASSERT_EQ(delta.spilledSkewedPartitions, 1);
+  ASSERT_EQ(delta.spilledSkewedRows, 10);
   delta = stats1 - stats2;
   ASSERT_EQ(delta.spilledInputBytes, 0);
   ASSERT_EQ(delta.spilledBytes, 0);
@@ -759,6 +765,8 @@ TEST(SpillTest, spillStats) {
   ASSERT_EQ(delta.spillFillTimeUs, -7);
   ASSERT_EQ(delta.spilledRows, -8);
   ASSERT_EQ(delta.spillSerializationTimeUs, -9);
+  ASSERT_EQ(delta.spilledSkewedPartitions, -1);
+  ASSERT_EQ(delta.spilledSkewedRows, -10);
   stats1.spilledInputBytes = 2060;
   stats1.spilledBytes = 1030;
   VELOX_ASSERT_THROW(stats1 < stats2, "");
@@ -772,5 +780,45 @@ TEST(SpillTest, spillStats) {
   ASSERT_EQ(zeroStats, stats1);
   ASSERT_EQ(
       stats2.toString(),
-      "spillRuns[100] spilledInputBytes[2.00KB] spilledBytes[1.00KB] spilledRows[1031] spilledPartitions[1025] spilledFiles[1026] spillFillTimeUs[1.03ms] spillSortTime[1.03ms] spillSerializationTime[1.03ms] spillDiskWrites[1028] spillFlushTime[1.03ms] spillWriteTime[1.03ms]");
+      "spillRuns[100] spilledInputBytes[2.00KB] spilledBytes[1.00KB] spilledRows[1031] spilledPartitions[1025] spilledFiles[1026] spillFillTimeUs[1.03ms] spillSortTime[1.03ms] spillSerializationTime[1.03ms] spillDiskWrites[1028] spillFlushTime[1.03ms] spillWriteTime[1.03ms] spilledSkewedPartitions[2] spilledSkewedRows[1033]");
+}
+
+TEST(SpillTest, spillHashSketch) {
+  SpillHashSketch sketch;
+  ASSERT_EQ(sketch.numRows(), 0);
+  ASSERT_EQ(sketch.maxHashRows(), 0);
+  ASSERT_FALSE(sketch.isSkewed(1));
+
+  // One hash has half of the rows and the others are distinct.
+  for (uint64_t i = 0; i < 1'000; ++i) {
+    sketch.add(i % 2 == 0 ? 7 : 1'000 + i);
+  }
+  ASSERT_EQ(sketch.numRows(), 1'000);
+  ASSERT_LE(sketch.maxHashRows(), 500);
+  ASSERT_GE(sketch.maxHashRows(), 500 - 1'000 / SpillHashSketch::kNumCounters);
+  ASSERT_TRUE(sketch.isSkewed(40));
+  ASSERT_FALSE(sketch.isSkewed(60));
+
+  // Uniform hashes are not skewed.
+  SpillHashSketch uniform;
+  for (uint64_t i = 0; i < 1'000; ++i) {
+    uniform.add(i % 100, 1);
+  }
+  ASSERT_EQ(uniform.numRows(), 1'000);
+  ASSERT_LE(uniform.maxHashRows(), 10);
+  ASSERT_FALSE(uniform.isSkewed(10));
+
+  // Merging keeps the heavy hitter of either side.
+  uniform.merge(sketch);
+  ASSERT_EQ(uniform.numRows(), 2'000);
+  ASSERT_GE(uniform.maxHashRows(), sketch.maxHashRows());
+  ASSERT_TRUE(uniform.isSkewed(20));
+
+  SpillHashSketch weighted;
+  weighted.add(1, 10);
+  weighted.add(2, 30);
+  ASSERT_EQ(weighted.numRows(), 40);
+  ASSERT_EQ(weighted.maxHashRows(), 30);
+  ASSERT_TRUE(weighted.isSkewed(75));
+  ASSERT_FALSE(weighted.isSkewed(76));
 }
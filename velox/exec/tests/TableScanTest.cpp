@@ -3498,3 +3498,131 @@ TEST_F(TableScanTest, varbinaryPartitionKey) {
 
   assertQuery(op, split, "SELECT c0, '2021-12-02' FROM tmp");
 }
+
+TEST_F(TableScanTest, stringsFromCache) {
+  constexpr int32_t kSize = 10'000;
+  auto makeString = [](auto row) {
+    return fmt::format("string too long to be inlined {:06}", row);
+  };
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kSize, folly::identity),
+      makeFlatVector<std::string>(kSize, makeString),
+  });
+  // Uncompressed, direct encoded strings are returned as views into the cache.
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::COMPRESSION, common::CompressionKind_NONE);
+  config->set(dwrf::Config::DICTIONARY_STRING_KEY_SIZE_THRESHOLD, 0.0f);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, {data}, config);
+
+  CursorParameters params;
+  params.planNode = tableScanNode(asRowType(data->type()));
+  bool noMoreSplits = false;
+  auto [cursor, results] = readCursor(params, [&](Task* task) {
+    if (!noMoreSplits) {
+      task->addSplit("0", makeHiveSplit(filePath->path));
+      task->noMoreSplits("0");
+      noMoreSplits = true;
+    }
+  });
+  ASSERT_LT(1, results.size());
+
+  // The scan is done and has released its pins. Dropping the unpinned entries
+  // must leave the entries the results refer to in place.
+  asyncDataCache_->clear();
+  EXPECT_LT(0, asyncDataCache_->refreshStats().numShared);
+
+  int64_t row = 0;
+  int32_t numViews = 0;
+  for (const auto& result : results) {
+    auto strings = result->childAt(1)->asFlatVector<StringView>();
+    ASSERT_TRUE(strings != nullptr);
+    for (auto i = 0; i < result->size(); ++i, ++row) {
+      auto value = strings->valueAt(i);
+      ASSERT_EQ(makeString(row), value.str());
+      for (const auto& buffer : strings->stringBuffers()) {
+        auto start = buffer->as<char>();
+        if (buffer->isView() && value.data() >= start &&
+            value.data() + value.size() <= start + buffer->size()) {
+          ++numViews;
+          break;
+        }
+      }
+    }
+  }
+  ASSERT_EQ(kSize, row);
+  EXPECT_LT(0, numViews);
+
+  // The pins go away with the results.
+  results.clear();
+  cursor.reset();
+  EXPECT_EQ(0, asyncDataCache_->refreshStats().numShared);
+}
+
+TEST_F(TableScanTest, preserveStringDictionary) {
+  constexpr int32_t kSize = 20'000;
+  constexpr int32_t kNumDistinct = 1'000;
+  auto makeString = [](auto row) {
+    return fmt::format("dictionary value {:04}", row % kNumDistinct);
+  };
+  auto data = makeRowVector({makeFlatVector<std::string>(kSize, makeString)});
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, {data});
+
+  // Few rows pass the filter, so the reader flattens the dictionary unless
+  // asked to preserve it.
+  auto plan = PlanBuilder(pool_.get())
+                  .tableScan(
+                      asRowType(data->type()), {"c0 = 'dictionary value 0007'"})
+                  .planNode();
+  auto readBatches = [&](bool preserveDictionary) {
+    auto queryCtx = std::make_shared<core::QueryCtx>(driverExecutor_.get());
+    queryCtx->setConnectorConfigOverridesUnsafe(
+        kHiveConnectorId,
+        {{HiveConfig::kPreserveStringDictionary,
+          preserveDictionary ? "true" : "false"}});
+    CursorParameters params;
+    params.planNode = plan;
+    params.queryCtx = queryCtx;
+    bool noMoreSplits = false;
+    // The results borrow memory from the cursor, which is returned with them.
+    auto cursorAndResults = readCursor(params, [&](Task* task) {
+      if (!noMoreSplits) {
+        task->addSplit("0", makeHiveSplit(filePath->path));
+        task->noMoreSplits("0");
+        noMoreSplits = true;
+      }
+    });
+    int32_t numRows = 0;
+    for (const auto& result : cursorAndResults.second) {
+      numRows += result->size();
+    }
+    EXPECT_EQ(kSize / kNumDistinct, numRows);
+    return cursorAndResults;
+  };
+
+  auto [flatCursor, flatResults] = readBatches(false);
+  ASSERT_LT(1, flatResults.size());
+  for (const auto& result : flatResults) {
+    ASSERT_TRUE(result->childAt(0)->isFlatEncoding());
+  }
+
+  auto [cursor, results] = readBatches(true);
+  ASSERT_LT(1, results.size());
+  VectorPtr base;
+  for (const auto& result : results) {
+    auto strings = result->childAt(0);
+    ASSERT_EQ(strings->encoding(), VectorEncoding::Simple::DICTIONARY);
+    if (!base) {
+      base = strings->valueVector();
+      ASSERT_EQ(kNumDistinct, base->size());
+    }
+    // All batches of the stripe share one dictionary base.
+    ASSERT_EQ(base.get(), strings->valueVector().get());
+    for (auto i = 0; i < result->size(); ++i) {
+      ASSERT_EQ(
+          "dictionary value 0007",
+          strings->as<SimpleVector<StringView>>()->valueAt(i).str());
+    }
+  }
+}
@@ -15,6 +15,8 @@
  */
 
 #include "velox/exec/Task.h"
+#include <gflags/gflags.h>
+#include "folly/String.h"
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/future/VeloxPromise.h"
@@ -24,11 +26,14 @@
 #include "velox/exec/PartitionedOutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/Values.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/Cursor.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/QueryAssertions.h"
 
+DECLARE_int32(velox_profiler_sample_interval_micros);
+
 using namespace facebook::velox;
 using namespace facebook::velox::common::testutil;
 
@@ -1314,4 +1319,73 @@ TEST_F(TaskTest, driverCreationMemoryAllocationCheck) {
     }
   }
 }
+
+TEST_F(TaskTest, operatorProfiling) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_profiler_sample_interval_micros = 50;
+
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+        makeFlatVector<double>(10'000, [&](auto row) { return row * 0.1 + i; }),
+    }));
+  }
+  auto plan = PlanBuilder()
+                  .values(vectors, false, 20)
+                  .filter("c0 % 11 <> 3")
+                  .project(
+                      {"sqrt(c1 * c1 + 1.5) + ln(c1 + 1.0) AS p0",
+                       "c0 * 7 % 13 + c0 / 3 AS p1"})
+                  .planNode();
+  // 910 of each 10'000 rows have c0 % 11 = 3.
+  const vector_size_t numRows = 20 * 10 * (10'000 - 910);
+
+  // Not profiled by default.
+  auto task = AssertQueryBuilder(plan).assertTypeAndNumRows(
+      ROW({"p0", "p1"}, {DOUBLE(), BIGINT()}), numRows);
+  EXPECT_EQ(nullptr, task->profile());
+  EXPECT_EQ("", task->foldedProfile());
+
+  task = AssertQueryBuilder(plan)
+             .config(core::QueryConfig::kOperatorProfilingEnabled, "true")
+             .assertTypeAndNumRows(
+                 ROW({"p0", "p1"}, {DOUBLE(), BIGINT()}), numRows);
+  ASSERT_NE(nullptr, task->profile());
+  ASSERT_GT(task->profile()->numSamples(), 0);
+
+  // Each line of the folded profile starts with the task id.
+  const auto folded = task->foldedProfile();
+  const auto lines = [&]() {
+    std::vector<std::string> result;
+    folly::split('\n', folded, result, true);
+    return result;
+  }();
+  ASSERT_FALSE(lines.empty());
+  for (const auto& line : lines) {
+    EXPECT_EQ(0, line.find(task->taskId() + ";")) << line;
+  }
+  EXPECT_NE(std::string::npos, folded.find(":FilterProject;getOutput"));
+
+  // The samples are summarized in the runtime stats of the operators and the
+  // custom stats of the plan nodes.
+  const auto stats = task->taskStats();
+  int64_t numOperatorSamples = 0;
+  for (const auto& pipelineStats : stats.pipelineStats) {
+    for (const auto& op : pipelineStats.operatorStats) {
+      auto it = op.runtimeStats.find("profileSamples");
+      if (it != op.runtimeStats.end()) {
+        numOperatorSamples += it->second.sum;
+      }
+    }
+  }
+  EXPECT_GT(numOperatorSamples, 0);
+  EXPECT_LE(numOperatorSamples, task->profile()->numSamples());
+
+  const auto planStats = toPlanStats(stats);
+  const auto& projectStats = planStats.at(plan->id());
+  ASSERT_EQ(1, projectStats.customStats.count("profileSamples"));
+  EXPECT_GT(projectStats.customStats.at("profileSamples").sum, 0);
+  EXPECT_EQ(1, projectStats.customStats.count("profileSamples.getOutput"));
+}
 } // namespace facebook::velox::exec::test
@@ -13,13 +13,13 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
 
-class TopNTest : public OperatorTestBase {
+class TopNTest : public HiveConnectorTestBase {
  protected:
   static std::vector<std::string> getSortOrderSqls() {
     return {"NULLS LAST", "NULLS FIRST", "DESC NULLS FIRST", "DESC NULLS LAST"};
@@ -261,3 +261,77 @@ TEST_F(TopNTest, lowCardinality) {
 
   testTwoKeys(vectors, "c0", "c1", 200);
 }
+
+TEST_F(TopNTest, noNullsMultipleKeys) {
+  // Once the top rows are found, the rows of later batches are compared with
+  // the cutoff on the first key. Rows with the same first key are compared on
+  // the second key.
+  vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    auto c0 = makeFlatVector<int16_t>(
+        batchSize, [&](vector_size_t row) { return (row + i) % 97; });
+    auto c1 = makeFlatVector<double>(
+        batchSize, [&](vector_size_t row) { return (row * 7 + i) % 1'000; });
+    auto c2 = makeFlatVector<int32_t>(
+        batchSize, [&](vector_size_t row) { return batchSize * i + row; });
+    vectors.push_back(makeRowVector({c0, c1, c2}));
+  }
+  createDuckDbTable(vectors);
+
+  testTwoKeys(vectors, "c0", "c2", 100);
+  testSingleKey(vectors, "c2", 100);
+}
+
+TEST_F(TopNTest, cutoffPushdown) {
+  // The keys grow from file to file, so that the cutoff of an ascending key
+  // excludes all the files after the first one.
+  vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  for (int32_t i = 0; i < 10; ++i) {
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize, [&](vector_size_t row) { return batchSize * i + row; });
+    auto c1 = makeFlatVector<double>(batchSize, [&](vector_size_t row) {
+      return (batchSize * i + row) / 2.0;
+    });
+    vectors.push_back(makeRowVector({c0, c1}));
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->path, vectors.back());
+  }
+  createDuckDbTable(vectors);
+  const auto rowType = asRowType(vectors[0]->type());
+
+  for (const auto& key : {"c0", "c1"}) {
+    core::PlanNodeId scanNodeId;
+    auto plan = PlanBuilder()
+                    .tableScan(rowType)
+                    .capturePlanNodeId(scanNodeId)
+                    .topN({key}, 10, false)
+                    .planNode();
+    auto task = assertQuery(
+        plan,
+        filePaths,
+        fmt::format("SELECT * FROM tmp ORDER BY {} LIMIT 10", key));
+    const auto planStats = toPlanStats(task->taskStats());
+    const auto& scanStats = planStats.at(scanNodeId);
+    EXPECT_LT(0, scanStats.customStats.at("dynamicFiltersAccepted").sum);
+    EXPECT_EQ(batchSize, scanStats.outputRows);
+  }
+
+  // A descending key is pushed down as well. The cutoff grows with each file.
+  core::PlanNodeId scanNodeId;
+  auto plan = PlanBuilder()
+                  .tableScan(rowType)
+                  .capturePlanNodeId(scanNodeId)
+                  .topN({"c0 DESC"}, 10, false)
+                  .planNode();
+  auto task = assertQuery(
+      plan, filePaths, "SELECT * FROM tmp ORDER BY c0 DESC LIMIT 10");
+  EXPECT_LT(
+      0,
+      toPlanStats(task->taskStats())
+          .at(scanNodeId)
+          .customStats.at("dynamicFiltersAccepted")
+          .sum);
+}
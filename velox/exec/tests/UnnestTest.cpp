@@ -403,3 +403,90 @@ TEST_F(UnnestTest, allEmptyOrNullMaps) {
            .planNode();
   assertQueryReturnsEmptyResult(op);
 }
+
+TEST_F(UnnestTest, outputBatchSize) {
+  // Arrays of up to 1'000 elements, many of them larger than the output batch.
+  auto c1Size = [](auto row) { return (row * 37) % 1'000; };
+  auto c2Size = [](auto row) { return row % 7; };
+  auto vector = makeRowVector({
+      makeFlatVector<int64_t>(50, [](auto row) { return row; }),
+      makeArrayVector<int32_t>(
+          50,
+          c1Size,
+          [](auto row, auto index) { return row * 1'000 + index; },
+          nullEvery(11)),
+      makeArrayVector<int32_t>(
+          50, c2Size, [](auto /* row */, auto index) { return index; }),
+  });
+
+  // DuckDB doesn't support WITH ORDINALITY. Hence, adding the ordinals as an
+  // array column of the size of the larger array to validate.
+  auto ordinalitySize = [&](auto row) {
+    return std::max(row % 11 == 0 ? 0 : c1Size(row), c2Size(row));
+  };
+  auto duckDbVector = makeRowVector({
+      vector->childAt(0),
+      vector->childAt(1),
+      vector->childAt(2),
+      makeArrayVector<int64_t>(
+          50,
+          ordinalitySize,
+          [](auto /* row */, auto index) { return index + 1; }),
+  });
+  createDuckDbTable({duckDbVector});
+
+  auto op = PlanBuilder()
+                .values({vector})
+                .unnest({"c0"}, {"c1", "c2"}, "ordinal")
+                .planNode();
+
+  for (auto batchSize : {1, 7, 100, 10'000}) {
+    SCOPED_TRACE(fmt::format("batchSize: {}", batchSize));
+    CursorParameters params;
+    params.planNode = op;
+    params.queryCtx = std::make_shared<core::QueryCtx>(executor_.get());
+    params.queryCtx->testingOverrideConfigUnsafe(
+        {{core::QueryConfig::kPreferredOutputBatchRows,
+          std::to_string(batchSize)}});
+    auto [cursor, results] = readCursor(params, [](Task*) {});
+
+    // All batches but the last are full since there is one input vector.
+    for (auto i = 0; i + 1 < results.size(); ++i) {
+      ASSERT_EQ(results[i]->size(), batchSize);
+    }
+    ASSERT_LE(results.back()->size(), batchSize);
+    assertResults(
+        results,
+        op->outputType(),
+        "SELECT c0, UNNEST(c1), UNNEST(c2), UNNEST(c3) FROM tmp",
+        duckDbQueryRunner_);
+  }
+}
+
+TEST_F(UnnestTest, contiguousElements) {
+  // Non-null arrays, so the elements of each output batch are contiguous and
+  // passed through without a dictionary.
+  auto vector = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+      makeArrayVector<int32_t>(
+          100,
+          [](auto row) { return row % 5 + 1; },
+          [](auto row, auto index) { return row + index; }),
+  });
+  createDuckDbTable({vector});
+
+  auto op = PlanBuilder().values({vector}).unnest({"c0"}, {"c1"}).planNode();
+  CursorParameters params;
+  params.planNode = op;
+  params.queryCtx = std::make_shared<core::QueryCtx>(executor_.get());
+  params.queryCtx->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kPreferredOutputBatchRows, "64"}});
+  params.copyResult = false;
+  auto [cursor, results] = readCursor(params, [](Task*) {});
+  ASSERT_GT(results.size(), 1);
+  for (const auto& result : results) {
+    ASSERT_TRUE(result->childAt(1)->isFlatEncoding());
+  }
+
+  assertQuery(op, "SELECT c0, UNNEST(c1) FROM tmp");
+}
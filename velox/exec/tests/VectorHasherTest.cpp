@@ -224,6 +224,36 @@ TEST_F(VectorHasherTest, flat) {
   }
 }
 
+TEST_F(VectorHasherTest, flatNoNullsMultipleKeys) {
+  // Flat keys without nulls are hashed and mixed a batch of rows at a time.
+  // The result must be the same as mixing one row at a time.
+  vector_size_t size = 1'003;
+  auto bigints = vectorMaker_->flatVector<int64_t>(
+      size, [](vector_size_t row) { return row * 7; });
+  auto integers = vectorMaker_->flatVector<int32_t>(
+      size, [](vector_size_t row) { return row % 11; });
+  auto doubles = vectorMaker_->flatVector<double>(
+      size, [](vector_size_t row) { return row * 0.5; });
+  std::vector<std::unique_ptr<exec::VectorHasher>> hashers;
+  hashers.push_back(exec::VectorHasher::create(BIGINT(), 0));
+  hashers.push_back(exec::VectorHasher::create(INTEGER(), 1));
+  hashers.push_back(exec::VectorHasher::create(DOUBLE(), 2));
+  std::vector<VectorPtr> keys = {bigints, integers, doubles};
+
+  SelectivityVector rows(size);
+  raw_vector<uint64_t> hashes(size);
+  for (auto i = 0; i < hashers.size(); ++i) {
+    hashers[i]->decode(*keys[i], rows);
+    hashers[i]->hash(rows, i > 0, hashes);
+  }
+  for (vector_size_t row = 0; row < size; ++row) {
+    auto expected = folly::hasher<int64_t>()(row * 7);
+    expected = bits::hashMix(expected, folly::hasher<int32_t>()(row % 11));
+    expected = bits::hashMix(expected, folly::hasher<double>()(row * 0.5));
+    EXPECT_EQ(expected, hashes[row]) << "at " << row;
+  }
+}
+
 TEST_F(VectorHasherTest, nonNullConstant) {
   auto hasher = exec::VectorHasher::create(INTEGER(), 1);
   auto vector = BaseVector::createConstant(INTEGER(), 123, 100, pool_.get());
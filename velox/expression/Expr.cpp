@@ -21,6 +21,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/process/Profiler.h"
 #include "velox/common/process/ThreadDebugInfo.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/core/Expressions.h"
@@ -782,6 +783,15 @@ void Expr::eval(
     EvalCtx& context,
     VectorPtr& result,
     const ExprSet* parentExprSet) {
+  // Attributes the samples of a profiled query to this expression.
+  std::optional<process::ProfileFrame> profileFrame;
+  if (UNLIKELY(process::ProfileFrame::isProfiling())) {
+    if (profileLabel_ == nullptr) {
+      profileLabel_ = process::internProfileLabel(name_);
+    }
+    profileFrame.emplace(profileLabel_);
+  }
+
   if (supportsFlatNoNullsFastPath_ && context.throwOnError() &&
       context.inputFlatNoNulls() && rows.countSelected() < 1'000) {
     evalFlatNoNulls(rows, context, result, parentExprSet);
@@ -611,6 +611,10 @@ class Expr {
   // True if distinctFields_ are identical to at least one of the parent
   // expression's distinct fields.
   bool sameAsParentDistinctFields_ = false;
+
+  // Label of the frame of 'this' in the samples of a profiled query. Set on
+  // first evaluation in a profiled thread.
+  const char* profileLabel_{nullptr};
 };
 
 /// Generate a selectivity vector of a single row.
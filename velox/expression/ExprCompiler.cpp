@@ -356,6 +356,19 @@ core::TypedExprPtr rewriteExpression(const core::TypedExprPtr& expr) {
   return expr;
 }
 
+std::vector<TypedExprPtr> rewriteExpressionSet(
+    const std::vector<TypedExprPtr>& exprs) {
+  auto rewrittenExprs = exprs;
+  for (auto& rewrite : expressionSetRewrites()) {
+    auto rewritten = rewrite(rewrittenExprs);
+    if (!rewritten.empty()) {
+      VELOX_CHECK_EQ(rewritten.size(), rewrittenExprs.size());
+      rewrittenExprs = std::move(rewritten);
+    }
+  }
+  return rewrittenExprs;
+}
+
 ExprPtr compileRewrittenExpression(
     const TypedExprPtr& expr,
     Scope* scope,
@@ -582,11 +595,15 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
   std::vector<std::shared_ptr<Expr>> exprs;
   exprs.reserve(sources.size());
 
+  // Keeps the re-written expressions alive while compiling, 'scope.visited'
+  // refers to them by raw pointer.
+  auto rewrittenSources = rewriteExpressionSet(sources);
+
   // Precompute a set of function calls that support flattening. This allows to
   // lock function registry once vs. locking for each function call.
-  auto flatteningCandidates = collectFlatteningCandidates(sources);
+  auto flatteningCandidates = collectFlatteningCandidates(rewrittenSources);
 
-  for (auto& source : sources) {
+  for (auto& source : rewrittenSources) {
     exprs.push_back(compileExpression(
         source,
         &scope,
@@ -295,6 +295,23 @@ std::vector<ExpressionRewrite>& expressionRewrites();
 /// non-null result terminates the re-write for this particular expression.
 void registerExpressionRewrite(ExpressionRewrite rewrite);
 
+/// A re-writer that takes all the expressions of an ExprSet and returns
+/// equivalent expressions or an empty list if re-write is not possible. Unlike
+/// ExpressionRewrite, it sees all the expressions at once, e.g. to share work
+/// between calls that appear in different expressions of the ExprSet.
+using ExpressionSetRewrite = std::function<std::vector<core::TypedExprPtr>(
+    const std::vector<core::TypedExprPtr>&)>;
+
+/// Returns a list of registered expression set re-writes.
+std::vector<ExpressionSetRewrite>& expressionSetRewrites();
+
+/// Appends a 'rewrite' to 'expressionSetRewrites'.
+///
+/// Re-writes are applied in the order they were registered, each to the result
+/// of the previous one, before the expressions of an ExprSet are compiled and
+/// before the re-writes registered with registerExpressionRewrite.
+void registerExpressionSetRewrite(ExpressionSetRewrite rewrite);
+
 } // namespace facebook::velox::exec
 
 // Private. Return the external function name given a UDF tag.
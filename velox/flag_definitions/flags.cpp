@@ -62,6 +62,14 @@ DEFINE_bool(avx2, true, "Enables use of AVX2 when available");
 
 DEFINE_bool(bmi2, true, "Enables use of BMI2 when available");
 
+// Used in common/process/Profiler.cpp
+
+DEFINE_int32(
+    velox_profiler_sample_interval_micros,
+    1'000,
+    "Interval between samples of the threads that run with a ScopedProfile, "
+    "e.g. the Drivers of queries with operator_profiling_enabled");
+
 // Used in exec/Expr.cpp
 
 DEFINE_string(
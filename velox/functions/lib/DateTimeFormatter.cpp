@@ -179,38 +179,34 @@ static std::
         };
 constexpr int monthsFullLength[] = {7, 8, 5, 5, 3, 4, 4, 6, 9, 7, 8, 8};
 
-/// Pads the content with desired padding characters. E.g. if we need to pad 999
-/// with three 0s in front, the result will be '000999'
-/// \param content the content that is going to be padded.
-/// \param padding the padding that is going to be used to pad the content.
-/// \param totalDigits the total number of digits the padded result is desired
-/// to be. If totalDigits is already smaller than content length, the original
-/// content will be returned with no padding
-/// \param padFront if the padding is in front of the content or back of the
-/// content.
-template <typename T>
-std::string padContent(
-    const T& content,
-    char padding,
-    size_t totalDigits,
-    bool padFront = true) {
-  std::string strContent = folly::to<std::string>(content);
-  auto contentLength = strContent.size();
-  if (contentLength == 0) {
-    return std::string(totalDigits, padding);
+/// Writes 'value' padded with zeros to at least 'minDigits' digits after the
+/// sign, e.g. 999 with 6 digits is '000999' and -5 with 2 digits is '-05'.
+/// Returns the number of characters written.
+int32_t writeNumber(int64_t value, size_t minDigits, char* result) {
+  char* cur = result;
+  uint64_t absValue = value;
+  if (value < 0) {
+    *cur++ = '-';
+    absValue = -absValue;
   }
-
-  bool isNegative = strContent[0] == '-';
-  auto digitLength = contentLength - (isNegative ? 1 : 0);
-  if (digitLength >= totalDigits) {
-    return strContent;
+  char digits[20];
+  int32_t numDigits = 0;
+  do {
+    digits[numDigits++] = '0' + absValue % 10;
+    absValue /= 10;
+  } while (absValue != 0);
+  for (auto i = numDigits; i < minDigits; ++i) {
+    *cur++ = '0';
   }
-  std::string paddingStr(totalDigits - digitLength, padding);
-  if (padFront) {
-    return strContent.insert((isNegative ? 1 : 0), paddingStr);
-  } else {
-    return strContent.append(paddingStr);
+  while (numDigits > 0) {
+    *cur++ = digits[--numDigits];
   }
+  return cur - result;
+}
+
+int32_t writeString(std::string_view value, char* result) {
+  std::memcpy(result, value.data(), value.size());
+  return value.size();
 }
 
 size_t countOccurence(const std::string_view& base, const std::string& target) {
@@ -462,31 +458,44 @@ int64_t parseHalfDayOfDay(const char* cur, const char* end, Date& date) {
   }
 }
 
-std::string formatFractionOfSecond(
+/// Writes the milliseconds 'subseconds' as a fraction of a second with
+/// 'minRepresentDigits' digits, e.g. 5 with 2 digits is '00' and with 4 digits
+/// is '0050'.
+int32_t writeFractionOfSecond(
     uint16_t subseconds,
-    size_t minRepresentDigits) {
-  char toAdd[minRepresentDigits > 3 ? minRepresentDigits + 1 : 4];
-
-  if (subseconds < 10) {
-    toAdd[0] = '0';
-    toAdd[1] = '0';
-    toAdd[2] = char(subseconds + '0');
-  } else if (subseconds < 100) {
-    toAdd[2] = char(subseconds % 10 + '0');
-    toAdd[1] = char((subseconds / 10) % 10 + '0');
-    toAdd[0] = '0';
-  } else {
-    toAdd[2] = char(subseconds % 10 + '0');
-    toAdd[1] = char((subseconds / 10) % 10 + '0');
-    toAdd[0] = char((subseconds / 100) % 10 + '0');
-  }
-
+    size_t minRepresentDigits,
+    char* result) {
+  char digits[3] = {
+      char(subseconds / 100 % 10 + '0'),
+      char(subseconds / 10 % 10 + '0'),
+      char(subseconds % 10 + '0')};
+  std::memcpy(result, digits, std::min<size_t>(minRepresentDigits, 3));
   if (minRepresentDigits > 3) {
-    memset(toAdd + 3, '0', minRepresentDigits - 3);
+    std::memset(result + 3, '0', minRepresentDigits - 3);
   }
+  return minRepresentDigits;
+}
 
-  toAdd[minRepresentDigits] = '\0';
-  return toAdd;
+/// Returns the maximum size of a value of 'pattern' formatted, except for
+/// time zone names.
+size_t maxFormattedSize(const FormatPattern& pattern) {
+  switch (pattern.specifier) {
+    case DateTimeFormatSpecifier::ERA:
+    case DateTimeFormatSpecifier::HALFDAY_OF_DAY:
+      return 2;
+    case DateTimeFormatSpecifier::DAY_OF_WEEK_TEXT:
+    case DateTimeFormatSpecifier::MONTH_OF_YEAR_TEXT:
+      // 'Wednesday' and 'September'.
+      return 9;
+    case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+      return pattern.minRepresentDigits;
+    case DateTimeFormatSpecifier::TIMEZONE:
+    case DateTimeFormatSpecifier::TIMEZONE_OFFSET_ID:
+      return 0;
+    default:
+      // A sign and the digits of any int64_t.
+      return 1 + std::max<size_t>(pattern.minRepresentDigits, 19);
+  }
 }
 
 // According to DateTimeFormatSpecifier enum class
@@ -925,11 +934,107 @@ void parseFromPattern(
   }
 }
 
+/// Returns the number of digits of the value of 'pattern' in an input with a
+/// fixed layout, or 0 if the value may have a different number of digits or
+/// if 'pattern' has no fast path for parsing.
+size_t fixedLayoutDigits(const FormatPattern& pattern) {
+  switch (pattern.specifier) {
+    case DateTimeFormatSpecifier::YEAR:
+      return pattern.minRepresentDigits == 4 ? 4 : 0;
+    case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+    case DateTimeFormatSpecifier::DAY_OF_MONTH:
+    case DateTimeFormatSpecifier::HOUR_OF_DAY:
+    case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+    case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+      return pattern.minRepresentDigits <= 2 ? pattern.minRepresentDigits : 0;
+    case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+      // Only the first 3 digits are read.
+      return pattern.minRepresentDigits <= 3 ? pattern.minRepresentDigits : 0;
+    default:
+      return 0;
+  }
+}
+
+/// Returns the size of the inputs 'tokens' parse with a fixed layout, or 0
+/// if they have none. The fields must be at fixed positions, which holds if
+/// each numeric field is followed by a literal that does not start with a
+/// digit, by the end of the input, or by a field after reading as many digits
+/// as parseFromPattern() would.
+size_t fixedLayoutSize(
+    const std::vector<DateTimeToken>& tokens,
+    DateTimeFormatterType type) {
+  size_t size = 0;
+  uint32_t specifiers = 0;
+  for (auto i = 0; i < tokens.size(); ++i) {
+    const auto& token = tokens[i];
+    if (token.type == DateTimeToken::Type::kLiteral) {
+      if (token.literal.empty() || characterIsDigit(token.literal[0])) {
+        return 0;
+      }
+      size += token.literal.size();
+      continue;
+    }
+    const auto digits = fixedLayoutDigits(token.pattern);
+    const auto specifierBit = 1u << static_cast<int>(token.pattern.specifier);
+    if (digits == 0 || (specifiers & specifierBit) != 0) {
+      return 0;
+    }
+    specifiers |= specifierBit;
+    const bool specifierNext = i + 1 < tokens.size() &&
+        tokens[i + 1].type == DateTimeToken::Type::kPattern;
+    if (specifierNext &&
+        getMaxDigitConsume(token.pattern, true, type) != digits) {
+      return 0;
+    }
+    size += digits;
+  }
+  return size;
+}
+
 } // namespace
 
+DateTimeFormatter::DateTimeFormatter(
+    std::unique_ptr<char[]>&& literalBuf,
+    size_t bufSize,
+    std::vector<DateTimeToken>&& tokens,
+    DateTimeFormatterType type)
+    : literalBuf_(std::move(literalBuf)),
+      bufSize_(bufSize),
+      tokens_(std::move(tokens)),
+      type_(type) {
+  for (const auto& token : tokens_) {
+    if (token.type == DateTimeToken::Type::kLiteral) {
+      maxResultSize_ += token.literal.size();
+    } else {
+      maxResultSize_ += maxFormattedSize(token.pattern);
+      if (token.pattern.specifier == DateTimeFormatSpecifier::TIMEZONE) {
+        ++numTimezoneTokens_;
+      }
+    }
+  }
+  fixedLayoutSize_ = fixedLayoutSize(tokens_, type_);
+}
+
 std::string DateTimeFormatter::format(
     const Timestamp& timestamp,
     const date::time_zone* timezone) const {
+  std::string result(maxResultSize(timezone), '\0');
+  result.resize(format(timestamp, timezone, result.data()));
+  return result;
+}
+
+size_t DateTimeFormatter::maxResultSize(
+    const date::time_zone* timezone) const {
+  if (numTimezoneTokens_ == 0 || timezone == nullptr) {
+    return maxResultSize_;
+  }
+  return maxResultSize_ + numTimezoneTokens_ * timezone->name().size();
+}
+
+int32_t DateTimeFormatter::format(
+    const Timestamp& timestamp,
+    const date::time_zone* timezone,
+    char* result) const {
   Timestamp t = timestamp;
   if (timezone != nullptr) {
     t.toTimezone(*timezone);
@@ -941,30 +1046,31 @@ std::string DateTimeFormatter::format(
   const date::year_month_day calDate(daysTimePoint);
   const date::weekday weekday(daysTimePoint);
 
-  std::string result;
+  char* cur = result;
   for (auto& token : tokens_) {
     if (token.type == DateTimeToken::Type::kLiteral) {
-      result += token.literal;
+      cur += writeString(token.literal, cur);
     } else {
       switch (token.pattern.specifier) {
         case DateTimeFormatSpecifier::ERA:
-          result += static_cast<signed>(calDate.year()) > 0 ? "AD" : "BC";
+          cur += writeString(
+              static_cast<signed>(calDate.year()) > 0 ? "AD" : "BC", cur);
           break;
 
         case DateTimeFormatSpecifier::CENTURY_OF_ERA: {
           auto year = static_cast<signed>(calDate.year());
           year = (year < 0 ? -year : year);
           auto century = year / 100;
-          result += padContent(century, '0', token.pattern.minRepresentDigits);
+          cur += writeNumber(century, token.pattern.minRepresentDigits, cur);
         } break;
 
         case DateTimeFormatSpecifier::YEAR_OF_ERA: {
           auto year = static_cast<signed>(calDate.year());
           if (token.pattern.minRepresentDigits == 2) {
-            result += padContent(std::abs(year) % 100, '0', 2);
+            cur += writeNumber(std::abs(year) % 100, 2, cur);
           } else {
             year = year <= 0 ? std::abs(year - 1) : year;
-            result += padContent(year, '0', token.pattern.minRepresentDigits);
+            cur += writeNumber(year, token.pattern.minRepresentDigits, cur);
           }
         } break;
 
@@ -976,16 +1082,16 @@ std::string DateTimeFormatter::format(
                   DateTimeFormatSpecifier::DAY_OF_WEEK_1_BASED) {
             weekdayNum = 7;
           }
-          result +=
-              padContent(weekdayNum, '0', token.pattern.minRepresentDigits);
+          cur +=
+              writeNumber(weekdayNum, token.pattern.minRepresentDigits, cur);
         } break;
 
         case DateTimeFormatSpecifier::DAY_OF_WEEK_TEXT: {
           auto weekdayNum = weekday.c_encoding();
           if (token.pattern.minRepresentDigits <= 3) {
-            result += weekdaysShort[weekdayNum];
+            cur += writeString(weekdaysShort[weekdayNum], cur);
           } else {
-            result += weekdaysFull[weekdayNum];
+            cur += writeString(weekdaysFull[weekdayNum], cur);
           }
         } break;
 
@@ -994,13 +1100,13 @@ std::string DateTimeFormatter::format(
           if (token.pattern.minRepresentDigits == 2) {
             year = std::abs(year);
             auto twoDigitYear = year % 100;
-            result +=
-                padContent(twoDigitYear, '0', token.pattern.minRepresentDigits);
+            cur += writeNumber(
+                twoDigitYear, token.pattern.minRepresentDigits, cur);
           } else {
-            result += padContent(
+            cur += writeNumber(
                 static_cast<signed>(calDate.year()),
-                '0',
-                token.pattern.minRepresentDigits);
+                token.pattern.minRepresentDigits,
+                cur);
           }
         } break;
 
@@ -1011,33 +1117,36 @@ std::string DateTimeFormatter::format(
               (date::sys_days{calDate} - date::sys_days{firstDayOfTheYear})
                   .count();
           delta += 1;
-          result += padContent(delta, '0', token.pattern.minRepresentDigits);
+          cur += writeNumber(delta, token.pattern.minRepresentDigits, cur);
         } break;
 
         case DateTimeFormatSpecifier::MONTH_OF_YEAR:
-          result += padContent(
+          cur += writeNumber(
               static_cast<unsigned>(calDate.month()),
-              '0',
-              token.pattern.minRepresentDigits);
+              token.pattern.minRepresentDigits,
+              cur);
           break;
 
         case DateTimeFormatSpecifier::MONTH_OF_YEAR_TEXT:
           if (token.pattern.minRepresentDigits <= 3) {
-            result += monthsShort[static_cast<unsigned>(calDate.month()) - 1];
+            cur += writeString(
+                monthsShort[static_cast<unsigned>(calDate.month()) - 1], cur);
           } else {
-            result += monthsFull[static_cast<unsigned>(calDate.month()) - 1];
+            cur += writeString(
+                monthsFull[static_cast<unsigned>(calDate.month()) - 1], cur);
           }
           break;
 
         case DateTimeFormatSpecifier::DAY_OF_MONTH:
-          result += padContent(
+          cur += writeNumber(
               static_cast<unsigned>(calDate.day()),
-              '0',
-              token.pattern.minRepresentDigits);
+              token.pattern.minRepresentDigits,
+              cur);
           break;
 
         case DateTimeFormatSpecifier::HALFDAY_OF_DAY:
-          result += durationInTheDay.hours().count() < 12 ? "AM" : "PM";
+          cur += writeString(
+              durationInTheDay.hours().count() < 12 ? "AM" : "PM", cur);
           break;
 
         case DateTimeFormatSpecifier::HOUR_OF_HALFDAY:
@@ -1057,27 +1166,28 @@ std::string DateTimeFormatter::format(
               DateTimeFormatSpecifier::CLOCK_HOUR_OF_DAY) {
             hourNum = (hourNum + 23) % 24 + 1;
           }
-          result += padContent(hourNum, '0', token.pattern.minRepresentDigits);
+          cur += writeNumber(hourNum, token.pattern.minRepresentDigits, cur);
         } break;
 
         case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
-          result += padContent(
+          cur += writeNumber(
               durationInTheDay.minutes().count() % 60,
-              '0',
-              token.pattern.minRepresentDigits);
+              token.pattern.minRepresentDigits,
+              cur);
           break;
 
         case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
-          result += padContent(
+          cur += writeNumber(
               durationInTheDay.seconds().count() % 60,
-              '0',
-              token.pattern.minRepresentDigits);
+              token.pattern.minRepresentDigits,
+              cur);
           break;
 
         case DateTimeFormatSpecifier::FRACTION_OF_SECOND: {
-          result += formatFractionOfSecond(
+          cur += writeFractionOfSecond(
               durationInTheDay.subseconds().count(),
-              token.pattern.minRepresentDigits);
+              token.pattern.minRepresentDigits,
+              cur);
           break;
         }
 
@@ -1090,7 +1200,7 @@ std::string DateTimeFormatter::format(
           if (timezone == nullptr) {
             VELOX_USER_FAIL("Timezone unknown")
           }
-          result += timezone->name();
+          cur += writeString(timezone->name(), cur);
           break;
 
         case DateTimeFormatSpecifier::TIMEZONE_OFFSET_ID:
@@ -1105,10 +1215,99 @@ std::string DateTimeFormatter::format(
       }
     }
   }
-  return result;
+  return cur - result;
+}
+
+std::optional<DateTimeResult> DateTimeFormatter::parseFixedLayout(
+    const std::string_view& input) const {
+  if (input.size() != fixedLayoutSize_) {
+    return std::nullopt;
+  }
+  int32_t year = 1970;
+  int32_t month = 1;
+  int32_t day = 1;
+  int32_t hour = 0;
+  int32_t minute = 0;
+  int32_t second = 0;
+  int32_t millisecond = 0;
+  bool hasYear = false;
+  bool hasMonthOrDay = false;
+
+  const char* cur = input.data();
+  for (const auto& token : tokens_) {
+    if (token.type == DateTimeToken::Type::kLiteral) {
+      if (std::memcmp(cur, token.literal.data(), token.literal.size()) != 0) {
+        return std::nullopt;
+      }
+      cur += token.literal.size();
+      continue;
+    }
+    const auto digits = fixedLayoutDigits(token.pattern);
+    int32_t number = 0;
+    for (auto i = 0; i < digits; ++i) {
+      const uint8_t digit = cur[i] - '0';
+      if (digit > 9) {
+        return std::nullopt;
+      }
+      number = number * 10 + digit;
+    }
+    cur += digits;
+    switch (token.pattern.specifier) {
+      case DateTimeFormatSpecifier::YEAR:
+        year = number;
+        hasYear = true;
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+        month = number;
+        hasMonthOrDay = true;
+        break;
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+        day = number;
+        hasMonthOrDay = true;
+        break;
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+        hour = number;
+        break;
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+        minute = number;
+        break;
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        second = number;
+        break;
+      case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+        for (auto i = digits; i < 3; ++i) {
+          number *= 10;
+        }
+        millisecond = number;
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+
+  // Same as parse(), the year is 2000 if only the month or the day is given.
+  if (!hasYear && hasMonthOrDay) {
+    year = 2000;
+  }
+  if (month < 1 || month > 12 || !util::isValidDate(year, month, day) ||
+      hour > 23 || minute > 59 || second > 59) {
+    return std::nullopt;
+  }
+  return DateTimeResult{
+      util::fromDatetime(
+          util::daysSinceEpochFromDate(year, month, day),
+          util::fromTime(
+              hour, minute, second, millisecond * util::kMicrosPerMsec)),
+      -1};
 }
 
 DateTimeResult DateTimeFormatter::parse(const std::string_view& input) const {
+  if (fixedLayoutSize_ != 0) {
+    if (auto result = parseFixedLayout(input)) {
+      return *result;
+    }
+  }
+
   Date date;
   const char* cur = input.data();
   const char* end = cur + input.size();
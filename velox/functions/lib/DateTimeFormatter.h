@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <optional>
 #include <string>
 #include <vector>
 #include "velox/common/base/Exceptions.h"
@@ -155,11 +156,7 @@ class DateTimeFormatter {
       std::unique_ptr<char[]>&& literalBuf,
       size_t bufSize,
       std::vector<DateTimeToken>&& tokens,
-      DateTimeFormatterType type)
-      : literalBuf_(std::move(literalBuf)),
-        bufSize_(bufSize),
-        tokens_(std::move(tokens)),
-        type_(type) {}
+      DateTimeFormatterType type);
 
   const std::unique_ptr<char[]>& literalBuf() const {
     return literalBuf_;
@@ -179,11 +176,39 @@ class DateTimeFormatter {
       const Timestamp& timestamp,
       const date::time_zone* timezone) const;
 
+  /// Same as above, but writes the formatted 'timestamp' to 'result' and
+  /// returns its size. 'result' must have space for maxResultSize(timezone)
+  /// characters. Used to format into the string buffer of the result vector
+  /// without an intermediate std::string per row.
+  int32_t format(
+      const Timestamp& timestamp,
+      const date::time_zone* timezone,
+      char* result) const;
+
+  /// Returns an upper bound of the size of any timestamp formatted with
+  /// 'timezone'.
+  size_t maxResultSize(const date::time_zone* timezone) const;
+
  private:
+  // Parses 'input' if it has the fixed layout of the tokens, e.g.
+  // '2023-05-01 12:30:00' for 'yyyy-MM-dd HH:mm:ss'. Returns std::nullopt if
+  // it does not or if a field is out of range, so that parse() reports the
+  // error.
+  std::optional<DateTimeResult> parseFixedLayout(
+      const std::string_view& input) const;
+
   std::unique_ptr<char[]> literalBuf_;
   size_t bufSize_;
   std::vector<DateTimeToken> tokens_;
   DateTimeFormatterType type_;
+
+  // The maximum size of the formatted tokens, except for the time zone names.
+  size_t maxResultSize_{0};
+  size_t numTimezoneTokens_{0};
+
+  // The size of the inputs parseFixedLayout() accepts, or 0 if the tokens have
+  // no fixed layout, e.g. have text fields or variable width years.
+  size_t fixedLayoutSize_{0};
 };
 
 std::shared_ptr<DateTimeFormatter> buildMysqlDateTimeFormatter(
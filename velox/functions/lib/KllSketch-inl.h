@@ -293,6 +293,46 @@ void KllSketch<T, A, C>::insert(T value) {
   doInsert(value);
 }
 
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::insert(const T* values, size_t count) {
+  if (count == 0) {
+    return;
+  }
+  const auto [minIt, maxIt] = std::minmax_element(values, values + count, C());
+  if (n_ == 0) {
+    minValue_ = *minIt;
+    maxValue_ = *maxIt;
+  } else {
+    minValue_ = std::min(minValue_, *minIt, C());
+    maxValue_ = std::max(maxValue_, *maxIt, C());
+  }
+  VELOX_DCHECK_GT(k_, 0);
+  VELOX_DCHECK_GE(levels_.size(), 2);
+  // Set before the compactions below, which sort level zero if not sorted.
+  isLevelZeroSorted_ = false;
+  for (size_t i = 0; i < count;) {
+    uint32_t size;
+    if (items_.size() < k_ && numLevels() == 1) {
+      // Same as doInsert(), grow level zero at the end.
+      size = std::min<size_t>(count - i, k_ - items_.size());
+      items_.insert(items_.end(), values + i, values + i + size);
+      levels_[1] += size;
+    } else {
+      if (levels_[0] == 0) {
+        // Compact to free up the space below level zero. insertPosition()
+        // reserves one slot for the next value, give it back.
+        insertPosition();
+        ++levels_[0];
+      }
+      size = std::min<size_t>(count - i, levels_[0]);
+      levels_[0] -= size;
+      std::copy(values + i, values + i + size, items_.data() + levels_[0]);
+    }
+    i += size;
+  }
+  n_ += count;
+}
+
 template <typename T, typename A, typename C>
 void KllSketch<T, A, C>::doInsert(T value) {
   VELOX_DCHECK_GT(k_, 0);
@@ -532,12 +572,48 @@ void KllSketch<T, A, C>::estimateQuantiles(
     const folly::Range<Iter>& fractions,
     T* out) const {
   VELOX_USER_CHECK_GT(n_, 0, "estimateQuantiles called on empty sketch");
-  auto entries = getFrequencies();
+  SortedView view;
+  sortedView(view);
+  estimateQuantiles(view, fractions, out);
+}
+
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::sortedView(SortedView& view) const {
+  VELOX_USER_CHECK(
+      isLevelZeroSorted_, "finish() must be called before estimate quantiles");
+  view.clear();
+  view.reserve(getNumRetained());
+  // The levels are smaller towards the top.  Merging them from the top keeps
+  // the merged part small, so this takes about linear time.
+  for (int level = numLevels() - 1; level >= 0; --level) {
+    const auto oldLen = view.size();
+    for (auto i = levels_[level]; i < levels_[level + 1]; ++i) {
+      view.emplace_back(items_[i], 1ull << level);
+    }
+    std::inplace_merge(
+        view.begin(),
+        view.begin() + oldLen,
+        view.end(),
+        [](auto& x, auto& y) { return C()(x.first, y.first); });
+  }
+  // Equal items do not need to be combined, the quantiles fall on the last
+  // of them either way.
   uint64_t totalWeight = 0;
-  for (auto& [_, w] : entries) {
+  for (auto& [_, w] : view) {
     totalWeight += w;
     w = totalWeight;
   }
+}
+
+template <typename T, typename A, typename C>
+template <typename Iter>
+void KllSketch<T, A, C>::estimateQuantiles(
+    const SortedView& view,
+    const folly::Range<Iter>& fractions,
+    T* out) const {
+  VELOX_USER_CHECK_GT(n_, 0, "estimateQuantiles called on empty sketch");
+  VELOX_CHECK(!view.empty());
+  const uint64_t totalWeight = view.back().second;
   int i = 0;
   for (auto& q : fractions) {
     VELOX_CHECK_GE(q, 0.0);
@@ -552,12 +628,12 @@ void KllSketch<T, A, C>::estimateQuantiles(
     }
     uint64_t maxWeight = q * totalWeight;
     auto it = std::upper_bound(
-        entries.begin(),
-        entries.end(),
+        view.begin(),
+        view.end(),
         std::make_pair(T{}, maxWeight),
         [](auto& x, auto& y) { return x.second < y.second; });
-    if (it == entries.end()) {
-      out[i++] = entries.back().first;
+    if (it == view.end()) {
+      out[i++] = view.back().first;
     } else {
       out[i++] = it->first;
     }
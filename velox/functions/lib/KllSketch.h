@@ -60,6 +60,11 @@ struct KllSketch {
   /// Add one new value to the sketch.
   void insert(T value);
 
+  /// Add `count` new values to the sketch.  Equivalent to calling
+  /// insert(value) for each value, but copies the values into the free
+  /// space of level zero in chunks and only compacts when it is full.
+  void insert(const T* FOLLY_NONNULL values, size_t count);
+
   /// Call this before serialization can optimize the space used.
   void compact();
 
@@ -99,6 +104,27 @@ struct KllSketch {
       const folly::Range<Iter>& quantiles,
       T* FOLLY_NONNULL out) const;
 
+  /// Items of the sketch sorted by value, each with the total weight of the
+  /// items up to and including it.
+  using SortedView = std::vector<std::pair<T, uint64_t>>;
+
+  /// Builds the sorted view once to estimate any number of quantiles from
+  /// it.  Reuses the memory of `view`.  finish() must be called before.
+  void sortedView(SortedView& view) const;
+
+  /// Estimate the values of the given quantiles from `view`, which is built
+  /// by sortedView() of this sketch.
+  /// @tparam Iter Iterator type dereferenceable to double
+  /// @param view Sorted view of this sketch
+  /// @param quantiles Range of quantiles in [0, 1] to be estimated
+  /// @param out Pre-allocated memory to hold the result, must be at least as
+  ///  large as `quantiles`
+  template <typename Iter>
+  void estimateQuantiles(
+      const SortedView& view,
+      const folly::Range<Iter>& quantiles,
+      T* FOLLY_NONNULL out) const;
+
   /// The total number of values being added to the sketch.
   size_t totalCount() const {
     return n_;
@@ -85,6 +85,52 @@ int insertKllSketch(int iters) {
   return iters;
 }
 
+template <typename T>
+int insertKllSketchBatch(int iters) {
+  constexpr int kBatchSize = 1024;
+  std::vector<T> values;
+  BENCHMARK_SUSPEND {
+    populateValues(iters, values);
+  }
+  KllSketch<T> kll;
+  for (int i = 0; i < iters; i += kBatchSize) {
+    kll.insert(values.data() + i, std::min(iters - i, kBatchSize));
+  }
+  return iters;
+}
+
+// Estimates p50, p90 and p99 of `count` sketches.  If `reuseView` is true,
+// the memory of one sorted view is reused across the sketches.
+void estimateQuantilesKllSketch(int iters, int count, bool reuseView) {
+  constexpr int kSize = 1000;
+  std::vector<KllSketch<double>> sketches;
+  BENCHMARK_SUSPEND {
+    std::vector<double> values;
+    for (int i = 0; i < count; ++i) {
+      populateValues(kSize, values);
+      KllSketch<double> kll;
+      kll.insert(values.data(), values.size());
+      kll.finish();
+      sketches.push_back(std::move(kll));
+    }
+  }
+  const std::vector<double> quantiles = {0.5, 0.9, 0.99};
+  const folly::Range range(quantiles.begin(), quantiles.end());
+  std::vector<double> out(quantiles.size());
+  KllSketch<double>::SortedView view;
+  for (int i = 0; i < iters; ++i) {
+    for (auto& kll : sketches) {
+      if (reuseView) {
+        kll.sortedView(view);
+        kll.estimateQuantiles(view, range, out.data());
+      } else {
+        kll.estimateQuantiles(range, out.data());
+      }
+      folly::doNotOptimizeAway(out);
+    }
+  }
+}
+
 void mergeTDigest(int iters, int maxSize, int count) {
   std::vector<folly::TDigest> digests;
   BENCHMARK_SUSPEND {
@@ -130,6 +176,8 @@ DEFINE_WITH_TYPE(insertTDigest, int64_t);
 DEFINE_WITH_TYPE(insertTDigest, double);
 DEFINE_WITH_TYPE(insertKllSketch, int64_t);
 DEFINE_WITH_TYPE(insertKllSketch, double);
+DEFINE_WITH_TYPE(insertKllSketchBatch, int64_t);
+DEFINE_WITH_TYPE(insertKllSketchBatch, double);
 
 #undef DEFINE_WITH_TYPE
 
@@ -137,16 +185,22 @@ BENCHMARK_PARAM_MULTI(insertTDigest_int64_t, 1e5);
 BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch_int64_t, 1e5);
 BENCHMARK_PARAM_MULTI(insertTDigest_double, 1e5);
 BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch_double, 1e5);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketchBatch_int64_t, 1e5);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketchBatch_double, 1e5);
 BENCHMARK_DRAW_LINE();
 BENCHMARK_PARAM_MULTI(insertTDigest_int64_t, 1e6);
 BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch_int64_t, 1e6);
 BENCHMARK_PARAM_MULTI(insertTDigest_double, 1e6);
 BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch_double, 1e6);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketchBatch_int64_t, 1e6);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketchBatch_double, 1e6);
 BENCHMARK_DRAW_LINE();
 BENCHMARK_PARAM_MULTI(insertTDigest_int64_t, 1e7);
 BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch_int64_t, 1e7);
 BENCHMARK_PARAM_MULTI(insertTDigest_double, 1e7);
 BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch_double, 1e7);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketchBatch_int64_t, 1e7);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketchBatch_double, 1e7);
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM(mergeTDigest, 1e6x2, 1e6, 2);
 BENCHMARK_RELATIVE_NAMED_PARAM(mergeKllSketch, 1e6x2, 1e6, 2);
@@ -156,6 +210,9 @@ BENCHMARK_NAMED_PARAM(mergeTDigest, 1e6x40, 1e6, 40);
 BENCHMARK_RELATIVE_NAMED_PARAM(mergeKllSketch, 1e6x40, 1e6, 40);
 BENCHMARK_NAMED_PARAM(mergeTDigest, 1e6x80, 1e6, 80);
 BENCHMARK_RELATIVE_NAMED_PARAM(mergeKllSketch, 1e6x80, 1e6, 80);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(estimateQuantilesKllSketch, 1e4, 1e4, false);
+BENCHMARK_RELATIVE_NAMED_PARAM(estimateQuantilesKllSketch, 1e4_view, 1e4, true);
 
 // ============================================================================
 // [...]chmarks/ApproxPercentileBenchmark.cpp     relative  time/iter   iters/s
@@ -1355,6 +1355,69 @@ TEST_F(JodaDateTimeFormatterTest, parseConsecutiveSpecifiers) {
   EXPECT_THROW(parseJoda("12312", "yyH"), VeloxUserError);
 }
 
+TEST_F(JodaDateTimeFormatterTest, parseFixedLayout) {
+  // Inputs with the layout of the format take a fast path, the others and the
+  // ones with values out of range are parsed token by token.
+  EXPECT_EQ(
+      util::fromTimestampString("2023-05-01 12:30:59.123"),
+      parseJoda("2023-05-01 12:30:59.123", "yyyy-MM-dd HH:mm:ss.SSS")
+          .timestamp);
+  EXPECT_EQ(
+      util::fromTimestampString("2023-05-01 12:30:59.100"),
+      parseJoda("2023-05-01T12:30:59.1", "yyyy-MM-dd'T'HH:mm:ss.S").timestamp);
+  EXPECT_EQ(
+      util::fromTimestampString("2023-05-01 12:30:59"),
+      parseJoda("20230501123059", "yyyyMMddHHmmss").timestamp);
+  EXPECT_EQ(
+      util::fromTimestampString("2023-05-01"),
+      parseJoda("2023-5-1", "yyyy-MM-dd").timestamp);
+  EXPECT_EQ(
+      util::fromTimestampString("12023-05-01"),
+      parseJoda("12023-05-01", "yyyy-MM-dd").timestamp);
+  EXPECT_EQ(
+      util::fromTimestampString("2000-12-31"),
+      parseJoda("12/31", "MM/dd").timestamp);
+  EXPECT_EQ(
+      util::fromTimestampString("1970-01-01 23:59:00"),
+      parseJoda("23:59", "HH:mm").timestamp);
+  EXPECT_EQ(-1, parseJoda("2023-05-01", "yyyy-MM-dd").timezoneId);
+
+  EXPECT_THROW(parseJoda("2023-13-01", "yyyy-MM-dd"), VeloxUserError);
+  EXPECT_THROW(parseJoda("2023-02-29", "yyyy-MM-dd"), VeloxUserError);
+  EXPECT_THROW(parseJoda("2023-02-2a", "yyyy-MM-dd"), VeloxUserError);
+  EXPECT_THROW(parseJoda("2023/02/28", "yyyy-MM-dd"), VeloxUserError);
+  EXPECT_THROW(parseJoda("24:00", "HH:mm"), VeloxUserError);
+  EXPECT_THROW(parseJoda("23:60", "HH:mm"), VeloxUserError);
+}
+
+TEST_F(JodaDateTimeFormatterTest, formatIntoBuffer) {
+  auto* timezone = date::locate_zone("America/Los_Angeles");
+  const auto timestamp = util::fromTimestampString("2023-05-01 12:30:59.123");
+  struct {
+    const char* format;
+    const date::time_zone* timezone;
+    const char* expected;
+  } testCases[] = {
+      {"yyyy-MM-dd HH:mm:ss.SSS", nullptr, "2023-05-01 12:30:59.123"},
+      {"yyyy-MM-dd HH:mm:ss.SSS", timezone, "2023-05-01 05:30:59.123"},
+      {"EEEE, MMMM d, yyyy G", nullptr, "Monday, May 1, 2023 AD"},
+      {"EEE MMM dd hh:mm a", nullptr, "Mon May 01 12:30 PM"},
+      {"hh:mm:ss a zzzz", timezone, "05:30:59 AM America/Los_Angeles"},
+      {"zzzz'/'zzzz", timezone, "America/Los_Angeles/America/Los_Angeles"},
+  };
+  for (const auto& testCase : testCases) {
+    SCOPED_TRACE(testCase.format);
+    auto formatter = buildJodaDateTimeFormatter(testCase.format);
+    const std::string expected = testCase.expected;
+    EXPECT_EQ(expected, formatter->format(timestamp, testCase.timezone));
+    EXPECT_LE(expected.size(), formatter->maxResultSize(testCase.timezone));
+    std::string result(formatter->maxResultSize(testCase.timezone), '\0');
+    result.resize(
+        formatter->format(timestamp, testCase.timezone, result.data()));
+    EXPECT_EQ(expected, result);
+  }
+}
+
 class MysqlDateTimeTest : public DateTimeFormatterTest {};
 
 TEST_F(MysqlDateTimeTest, validBuild) {
@@ -2422,6 +2485,37 @@ TEST_F(MysqlDateTimeTest, parseFractionOfSecond) {
   EXPECT_THROW(parseMysql("9999999", "%f"), VeloxUserError);
 }
 
+TEST_F(MysqlDateTimeTest, formatIntoBuffer) {
+  auto* timezone = date::locate_zone("America/Los_Angeles");
+  const auto timestamp = util::fromTimestampString("2023-05-01 12:30:59.123");
+  struct {
+    const char* format;
+    const char* expected;
+    const char* expectedInTimezone;
+  } testCases[] = {
+      {"%Y-%m-%d %H:%i:%s.%f",
+       "2023-05-01 12:30:59.123000",
+       "2023-05-01 05:30:59.123000"},
+      {"%W, %M %e %Y", "Monday, May 1 2023", "Monday, May 1 2023"},
+      {"%a %b %c %r", "Mon May 5 12:30:59 PM", "Mon May 5 05:30:59 AM"},
+      {"%j", "121", "121"},
+      {"%y%%", "23%", "23%"},
+  };
+  for (const auto& testCase : testCases) {
+    SCOPED_TRACE(testCase.format);
+    auto formatter = buildMysqlDateTimeFormatter(testCase.format);
+    for (const auto* zone : {(const date::time_zone*)nullptr, timezone}) {
+      const std::string expected =
+          zone ? testCase.expectedInTimezone : testCase.expected;
+      EXPECT_EQ(expected, formatter->format(timestamp, zone));
+      EXPECT_LE(expected.size(), formatter->maxResultSize(zone));
+      std::string result(formatter->maxResultSize(zone), '\0');
+      result.resize(formatter->format(timestamp, zone, result.data()));
+      EXPECT_EQ(expected, result);
+    }
+  }
+}
+
 TEST_F(MysqlDateTimeTest, parseConsecutiveSpecifiers) {
   EXPECT_EQ(
       util::fromTimestampString("2012-12-01"), parseMysql("1212", "%y%m"));
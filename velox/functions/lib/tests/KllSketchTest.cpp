@@ -122,6 +122,78 @@ TEST(KllSketchTest, randomInput) {
   }
 }
 
+TEST(KllSketchTest, insertBatch) {
+  constexpr int N = 1e5;
+  constexpr int M = 1001;
+  std::default_random_engine gen(0);
+  std::normal_distribution<> dist;
+  std::vector<double> values(N);
+  for (auto& v : values) {
+    v = dist(gen);
+  }
+  auto q = linspace(M);
+  for (int batchSize : {1, 7, 200, 1000, N}) {
+    SCOPED_TRACE(fmt::format("batchSize={}", batchSize));
+    KllSketch<double> kll(kDefaultK, {}, 0);
+    for (int i = 0; i < N; i += batchSize) {
+      kll.insert(values.data() + i, std::min(batchSize, N - i));
+      // Level zero is no longer sorted after inserting more values.
+      if (i % (10 * batchSize) == 0) {
+        kll.finish();
+      }
+    }
+    kll.insert(values.data(), 0);
+    EXPECT_EQ(kll.totalCount(), N);
+    kll.finish();
+    auto sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_EQ(kll.estimateQuantile(0.0), sorted.front());
+    EXPECT_EQ(kll.estimateQuantile(1.0), sorted.back());
+    auto v = kll.estimateQuantiles(folly::Range(q.begin(), q.end()));
+    ASSERT_TRUE(std::is_sorted(std::begin(v), std::end(v)));
+    for (int i = 0; i < M; ++i) {
+      auto it = std::lower_bound(sorted.begin(), sorted.end(), v[i]);
+      double actualQ = 1.0 * (it - sorted.begin()) / N;
+      EXPECT_NEAR(q[i], actualQ, kEpsilon);
+    }
+  }
+}
+
+TEST(KllSketchTest, sortedView) {
+  constexpr int N = 1e5;
+  constexpr int M = 1001;
+  auto q = linspace(M);
+  KllSketch<double>::SortedView view;
+  for (int seed = 0; seed < 3; ++seed) {
+    KllSketch<double> kll(kDefaultK, {}, seed);
+    insertRandomData(seed, N, kll, nullptr);
+    kll.finish();
+    kll.sortedView(view);
+    ASSERT_EQ(view.back().second, kll.totalCount());
+    // Same estimates as from the frequencies.
+    auto frequencies = kll.getFrequencies();
+    uint64_t totalWeight = 0;
+    for (auto& [_, w] : frequencies) {
+      totalWeight += w;
+      w = totalWeight;
+    }
+    std::vector<double> v(M);
+    kll.estimateQuantiles(view, folly::Range(q.begin(), q.end()), v.data());
+    for (int i = 1; i < M - 1; ++i) {
+      uint64_t maxWeight = q[i] * totalWeight;
+      auto it = std::upper_bound(
+          frequencies.begin(),
+          frequencies.end(),
+          std::make_pair(0.0, maxWeight),
+          [](auto& x, auto& y) { return x.second < y.second; });
+      auto expected =
+          it == frequencies.end() ? frequencies.back().first : it->first;
+      EXPECT_EQ(v[i], expected);
+    }
+    EXPECT_EQ(v, kll.estimateQuantiles(folly::Range(q.begin(), q.end())));
+  }
+}
+
 TEST(KllSketchTest, merge) {
   constexpr int N = 1e4;
   constexpr int M = 1001;
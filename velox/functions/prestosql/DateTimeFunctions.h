@@ -1115,12 +1115,11 @@ struct DateFormatFunction : public TimestampWithTimezoneSupport<T> {
           std::string_view(formatString.data(), formatString.size()));
     }
 
-    auto formattedResult = mysqlDateTime_->format(timestamp, sessionTimeZone_);
-    auto resultSize = formattedResult.size();
+    // Format into the string buffer of the result vector directly.
+    result.reserve(mysqlDateTime_->maxResultSize(sessionTimeZone_));
+    const auto resultSize =
+        mysqlDateTime_->format(timestamp, sessionTimeZone_, result.data());
     result.resize(resultSize);
-    if (resultSize != 0) {
-      std::memcpy(result.data(), formattedResult.data(), resultSize);
-    }
     return true;
   }
 
@@ -1207,12 +1206,11 @@ struct FormatDateTimeFunction {
           std::string_view(formatString.data(), formatString.size()));
     }
 
-    auto formattedResult = jodaDateTime_->format(timestamp, sessionTimeZone_);
-    auto resultSize = formattedResult.size();
+    // Format into the string buffer of the result vector directly.
+    result.reserve(jodaDateTime_->maxResultSize(sessionTimeZone_));
+    const auto resultSize =
+        jodaDateTime_->format(timestamp, sessionTimeZone_, result.data());
     result.resize(resultSize);
-    if (resultSize != 0) {
-      std::memcpy(result.data(), formattedResult.data(), resultSize);
-    }
     return true;
   }
 };
@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/prestosql/JsonExtractScalarRewrite.h"
+
+#include <folly/container/F14Map.h>
+
+#include "velox/expression/ConstantExpr.h"
+#include "velox/expression/DecodedArgs.h"
+#include "velox/expression/FunctionCallToSpecialForm.h"
+#include "velox/expression/SpecialFormRegistry.h"
+#include "velox/expression/StringWriter.h"
+#include "velox/expression/VectorFunction.h"
+#include "velox/functions/prestosql/SIMDJsonFunctions.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+const char* const kJsonExtractScalars = "$internal$json_extract_scalars";
+
+// $internal$json_extract_scalars(json, path1, path2,...) -> row(varchar,...)
+//
+// Returns a struct with one field per path, which is set to the result of
+// json_extract_scalar(json, path). The paths are constant. Each row is parsed
+// once for all the paths.
+class JsonExtractScalarsFunction : public exec::VectorFunction {
+ public:
+  explicit JsonExtractScalarsFunction(std::vector<std::string> paths)
+      : paths_(std::move(paths)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    exec::DecodedArgs decodedArgs(rows, {args[0]}, context);
+    auto* json = decodedArgs.at(0);
+
+    std::vector<VectorPtr> children;
+    std::vector<FlatVector<StringView>*> flatChildren;
+    children.reserve(paths_.size());
+    flatChildren.reserve(paths_.size());
+    for (auto i = 0; i < paths_.size(); ++i) {
+      children.push_back(
+          BaseVector::create(VARCHAR(), rows.end(), context.pool()));
+      flatChildren.push_back(children.back()->asFlatVector<StringView>());
+    }
+
+    // The extractor keeps the parsed document of the current row, so it is not
+    // shared between threads.
+    SIMDJsonMultiPathExtractor extractor(paths_);
+    context.applyToSelectedNoThrow(rows, [&](auto row) {
+      const bool parsed = extractor.parse(json->valueAt<StringView>(row));
+      for (auto i = 0; i < paths_.size(); ++i) {
+        JsonExtractScalarConsumer consumer;
+        if (parsed && extractor.extract(i, consumer) &&
+            consumer.result.has_value()) {
+          exec::StringWriter<false> writer(flatChildren[i], row);
+          writer.copy_from(*consumer.result);
+          writer.finalize();
+        } else {
+          flatChildren[i]->setNull(row, true);
+        }
+      }
+    });
+
+    auto localResult = std::make_shared<RowVector>(
+        context.pool(), outputType, nullptr, rows.end(), std::move(children));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+ private:
+  const std::vector<std::string> paths_;
+};
+
+// Compiles $internal$json_extract_scalars calls. This is a special form only
+// because the number of fields of the result depends on the number of
+// arguments, which a function signature cannot express.
+class JsonExtractScalarsCallToSpecialForm
+    : public exec::FunctionCallToSpecialForm {
+ public:
+  explicit JsonExtractScalarsCallToSpecialForm(std::string name)
+      : name_(std::move(name)) {}
+
+  TypePtr resolveType(const std::vector<TypePtr>& argTypes) override {
+    VELOX_CHECK_GE(argTypes.size(), 2);
+    std::vector<std::string> names;
+    std::vector<TypePtr> types;
+    for (auto i = 1; i < argTypes.size(); ++i) {
+      names.push_back(fmt::format("c{}", i));
+      types.push_back(VARCHAR());
+    }
+    return ROW(std::move(names), std::move(types));
+  }
+
+  exec::ExprPtr constructSpecialForm(
+      const TypePtr& type,
+      std::vector<exec::ExprPtr>&& compiledChildren,
+      bool trackCpuUsage,
+      const core::QueryConfig& /*config*/) override {
+    VELOX_CHECK_GE(compiledChildren.size(), 2);
+    VELOX_CHECK_EQ(type->size(), compiledChildren.size() - 1);
+    std::vector<std::string> paths;
+    for (auto i = 1; i < compiledChildren.size(); ++i) {
+      auto constant =
+          std::dynamic_pointer_cast<exec::ConstantExpr>(compiledChildren[i]);
+      VELOX_CHECK_NOT_NULL(constant, "JSON paths must be constant");
+      auto path = constant->value()->as<SimpleVector<StringView>>();
+      VELOX_CHECK(!path->isNullAt(0));
+      paths.emplace_back(path->valueAt(0));
+    }
+    return std::make_shared<exec::Expr>(
+        type,
+        std::move(compiledChildren),
+        std::make_shared<JsonExtractScalarsFunction>(std::move(paths)),
+        name_,
+        trackCpuUsage);
+  }
+
+ private:
+  const std::string name_;
+};
+
+struct ITypedExprHasher {
+  size_t operator()(const core::ITypedExpr* expr) const {
+    return expr->hash();
+  }
+};
+
+struct ITypedExprComparer {
+  bool operator()(const core::ITypedExpr* lhs, const core::ITypedExpr* rhs)
+      const {
+    return *lhs == *rhs;
+  }
+};
+
+// The json_extract_scalar calls over the same 'json' input.
+struct CallGroup {
+  core::TypedExprPtr json;
+  // Distinct paths in the order of first appearance.
+  std::vector<std::string> paths;
+  folly::F14FastMap<std::string, uint32_t> pathIndices;
+  // Set if there are at least 2 distinct paths.
+  core::TypedExprPtr fusedCall;
+};
+
+using CallGroups = folly::F14FastMap<
+    const core::ITypedExpr*,
+    CallGroup,
+    ITypedExprHasher,
+    ITypedExprComparer>;
+
+// Returns the path of a json_extract_scalar(json, path) call with a valid
+// constant path. Returns std::nullopt otherwise, e.g. an invalid path keeps
+// failing at runtime as before.
+std::optional<std::string> constantPath(
+    const std::string& name,
+    const core::TypedExprPtr& expr) {
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  if (call == nullptr || call->name() != name || call->inputs().size() != 2 ||
+      call->type()->kind() != TypeKind::VARCHAR) {
+    return std::nullopt;
+  }
+  auto constant = std::dynamic_pointer_cast<const core::ConstantTypedExpr>(
+      call->inputs()[1]);
+  if (constant == nullptr || constant->type()->kind() != TypeKind::VARCHAR) {
+    return std::nullopt;
+  }
+
+  std::string path;
+  if (constant->hasValueVector()) {
+    const auto& vector = constant->valueVector();
+    if (vector->isNullAt(0)) {
+      return std::nullopt;
+    }
+    path = vector->as<SimpleVector<StringView>>()->valueAt(0);
+  } else {
+    if (constant->value().isNull()) {
+      return std::nullopt;
+    }
+    path = constant->value().value<TypeKind::VARCHAR>();
+  }
+  if (!SIMDJsonMultiPathExtractor::isValidPath(path)) {
+    return std::nullopt;
+  }
+  return path;
+}
+
+// Returns true for the expressions whose inputs are visited and rewritten.
+// Lambdas are excluded since their bodies are compiled in a separate scope
+// that does not share common subexpressions with the enclosing expressions.
+bool isRewritable(const core::TypedExprPtr& expr) {
+  return dynamic_cast<const core::CallTypedExpr*>(expr.get()) ||
+      dynamic_cast<const core::CastTypedExpr*>(expr.get()) ||
+      dynamic_cast<const core::ConcatTypedExpr*>(expr.get()) ||
+      dynamic_cast<const core::DereferenceTypedExpr*>(expr.get()) ||
+      dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+}
+
+void collectCalls(
+    const std::string& name,
+    const core::TypedExprPtr& expr,
+    CallGroups& groups) {
+  if (auto path = constantPath(name, expr)) {
+    const auto& json = expr->inputs()[0];
+    auto& group = groups[json.get()];
+    if (group.json == nullptr) {
+      group.json = json;
+    }
+    if (group.pathIndices.emplace(*path, group.paths.size()).second) {
+      group.paths.push_back(std::move(*path));
+    }
+  }
+  if (!isRewritable(expr)) {
+    return;
+  }
+  for (const auto& input : expr->inputs()) {
+    collectCalls(name, input, groups);
+  }
+}
+
+core::TypedExprPtr makeFusedCall(
+    const std::string& fusedName,
+    const CallGroup& group) {
+  std::vector<core::TypedExprPtr> inputs{group.json};
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (auto i = 0; i < group.paths.size(); ++i) {
+    inputs.push_back(
+        std::make_shared<core::ConstantTypedExpr>(VARCHAR(), group.paths[i]));
+    names.push_back(fmt::format("c{}", i + 1));
+    types.push_back(VARCHAR());
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      ROW(std::move(names), std::move(types)), std::move(inputs), fusedName);
+}
+
+core::TypedExprPtr withInputs(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr> inputs) {
+  if (auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
+    return std::make_shared<core::CallTypedExpr>(
+        call->type(), std::move(inputs), call->name());
+  }
+  if (auto cast = dynamic_cast<const core::CastTypedExpr*>(expr.get())) {
+    return std::make_shared<core::CastTypedExpr>(
+        cast->type(), std::move(inputs), cast->nullOnFailure());
+  }
+  if (auto concat = dynamic_cast<const core::ConcatTypedExpr*>(expr.get())) {
+    return std::make_shared<core::ConcatTypedExpr>(
+        concat->type()->asRow().names(), std::move(inputs));
+  }
+  if (auto dereference =
+          dynamic_cast<const core::DereferenceTypedExpr*>(expr.get())) {
+    return std::make_shared<core::DereferenceTypedExpr>(
+        dereference->type(), std::move(inputs[0]), dereference->index());
+  }
+  auto access = dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+  VELOX_CHECK_NOT_NULL(access);
+  return std::make_shared<core::FieldAccessTypedExpr>(
+      access->type(), std::move(inputs[0]), access->name());
+}
+
+core::TypedExprPtr rewriteCalls(
+    const std::string& name,
+    const core::TypedExprPtr& expr,
+    const CallGroups& groups) {
+  if (auto path = constantPath(name, expr)) {
+    const auto& group = groups.at(expr->inputs()[0].get());
+    if (group.fusedCall != nullptr) {
+      return std::make_shared<core::DereferenceTypedExpr>(
+          VARCHAR(), group.fusedCall, group.pathIndices.at(*path));
+    }
+  }
+  if (!isRewritable(expr) || expr->inputs().empty()) {
+    return expr;
+  }
+
+  bool changed = false;
+  std::vector<core::TypedExprPtr> inputs;
+  inputs.reserve(expr->inputs().size());
+  for (const auto& input : expr->inputs()) {
+    inputs.push_back(rewriteCalls(name, input, groups));
+    changed |= inputs.back() != input;
+  }
+  return changed ? withInputs(expr, std::move(inputs)) : expr;
+}
+
+} // namespace
+
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalarCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  const auto name = prefix + "json_extract_scalar";
+  const auto fusedName = prefix + kJsonExtractScalars;
+  if (!exec::isFunctionCallToSpecialFormRegistered(fusedName)) {
+    return {};
+  }
+
+  CallGroups groups;
+  for (const auto& expr : exprs) {
+    collectCalls(name, expr, groups);
+  }
+
+  bool fused = false;
+  for (auto& [_, group] : groups) {
+    if (group.paths.size() > 1) {
+      group.fusedCall = makeFusedCall(fusedName, group);
+      fused = true;
+    }
+  }
+  if (!fused) {
+    return {};
+  }
+
+  std::vector<core::TypedExprPtr> rewritten;
+  rewritten.reserve(exprs.size());
+  for (const auto& expr : exprs) {
+    rewritten.push_back(rewriteCalls(name, expr, groups));
+  }
+  return rewritten;
+}
+
+void registerJsonExtractScalarRewrite(const std::string& prefix) {
+  const auto fusedName = prefix + kJsonExtractScalars;
+  exec::registerFunctionCallToSpecialForm(
+      fusedName,
+      std::make_unique<JsonExtractScalarsCallToSpecialForm>(fusedName));
+  exec::registerExpressionSetRewrite([prefix](const auto& exprs) {
+    return rewriteJsonExtractScalarCalls(prefix, exprs);
+  });
+}
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/core/Expressions.h"
+
+namespace facebook::velox::functions {
+
+/// Analyzes the expressions of an ExprSet to find json_extract_scalar(json,
+/// path) calls with constant paths over the same 'json' input, e.g.
+///     json_extract_scalar(c0, '$.a'), json_extract_scalar(c0, '$.b')
+/// and rewrites them into field accesses of a single internal call that
+/// parses each row once and extracts all the paths:
+///     $internal$json_extract_scalars(c0, '$.a', '$.b')[c1],
+///     $internal$json_extract_scalars(c0, '$.a', '$.b')[c2]
+/// The common subexpression elimination of the ExprSet then evaluates the
+/// internal call once. Calls inside lambdas are not rewritten.
+///
+/// Returns the new expressions or an empty list if rewrite is not possible.
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalarCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs);
+
+/// Registers the internal function used by rewriteJsonExtractScalarCalls() and
+/// the rewrite itself.
+void registerJsonExtractScalarRewrite(const std::string& prefix);
+
+} // namespace facebook::velox::functions
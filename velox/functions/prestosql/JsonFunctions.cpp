@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/expression/VectorFunction.h"
+#include "velox/functions/prestosql/json/SIMDJsonUtil.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
 namespace facebook::velox::functions {
@@ -73,14 +74,12 @@ class JsonParseFunction : public exec::VectorFunction {
     VectorPtr localResult;
 
     // Input can be constant or flat.
-    // TODO(arpitporwal2293) Replace folly::parseJson with a lightweight
-    // validation of JSON syntax that doesn't allocate memory or copy data.
     assert(args.size() > 0);
     const auto& arg = args[0];
     if (arg->isConstantEncoding()) {
       auto value = arg->as<ConstantVector<StringView>>()->valueAt(0);
       try {
-        folly::parseJson(value);
+        validate(value);
       } catch (const std::exception& e) {
         context.setErrors(rows, std::current_exception());
         return;
@@ -94,7 +93,7 @@ class JsonParseFunction : public exec::VectorFunction {
       VELOX_CHECK_LE(rows.end(), flatInput->size());
 
       context.applyToSelectedNoThrow(
-          rows, [&](auto row) { folly::parseJson(flatInput->valueAt(row)); });
+          rows, [&](auto row) { validate(flatInput->valueAt(row)); });
       localResult = std::make_shared<FlatVector<StringView>>(
           context.pool(),
           JSON(),
@@ -114,6 +113,18 @@ class JsonParseFunction : public exec::VectorFunction {
                 .argumentType("varchar")
                 .build()};
   }
+
+ private:
+  // Checks the syntax of the whole document without copying it into a tree of
+  // values. The input is returned as is.
+  static void validate(StringView json) {
+    if (auto error = simdjsonValidate(std::string_view(json))) {
+      VELOX_USER_FAIL(
+          "Cannot convert '{}' to JSON: {}",
+          json,
+          simdjson::error_message(error));
+    }
+  }
 };
 
 } // namespace
@@ -20,45 +20,26 @@
 #include "velox/functions/UDFOutputString.h"
 #include "velox/functions/prestosql/json/JsonPathTokenizer.h"
 #include "velox/functions/prestosql/json/SIMDJsonExtractor.h"
+#include "velox/functions/prestosql/json/SIMDJsonUtil.h"
 #include "velox/functions/prestosql/json/SIMDJsonWrapper.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
 namespace facebook::velox::functions {
 
-struct ParserContext {
- public:
-  explicit ParserContext() noexcept;
-  explicit ParserContext(const char* data, size_t length) noexcept
-      : padded_json(data, length) {}
-  void parseElement() {
-    jsonEle = domParser.parse(padded_json);
-  }
-  void parseDocument() {
-    jsonDoc = ondemandParser.iterate(padded_json);
-  }
-  simdjson::dom::element jsonEle;
-  simdjson::ondemand::document jsonDoc;
-
- private:
-  simdjson::padded_string padded_json;
-  simdjson::dom::parser domParser;
-  simdjson::ondemand::parser ondemandParser;
-};
-
 template <typename T>
 struct SIMDIsJsonScalarFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
   FOLLY_ALWAYS_INLINE void call(bool& result, const arg_type<Json>& json) {
-    ParserContext ctx(json.data(), json.size());
-
-    ctx.parseDocument();
+    simdjson::ondemand::document jsonDoc =
+        simdjsonParse(std::string_view(json));
 
+    const simdjson::ondemand::json_type type = jsonDoc.type();
     result =
-        (ctx.jsonDoc.type() == simdjson::ondemand::json_type::number ||
-         ctx.jsonDoc.type() == simdjson::ondemand::json_type::string ||
-         ctx.jsonDoc.type() == simdjson::ondemand::json_type::boolean ||
-         ctx.jsonDoc.type() == simdjson::ondemand::json_type::null);
+        (type == simdjson::ondemand::json_type::number ||
+         type == simdjson::ondemand::json_type::string ||
+         type == simdjson::ondemand::json_type::boolean ||
+         type == simdjson::ondemand::json_type::null);
   }
 };
 
@@ -68,20 +49,20 @@ struct SIMDJsonArrayContainsFunction {
   template <typename TInput>
   FOLLY_ALWAYS_INLINE bool
   call(bool& result, const arg_type<Json>& json, const TInput& value) {
-    ParserContext ctx(json.data(), json.size());
+    simdjson::ondemand::document jsonDoc;
     result = false;
 
     try {
-      ctx.parseDocument();
+      jsonDoc = simdjsonParse(std::string_view(json));
     } catch (const simdjson::simdjson_error&) {
       return false;
     }
 
-    if (ctx.jsonDoc.type() != simdjson::ondemand::json_type::array) {
+    if (jsonDoc.type() != simdjson::ondemand::json_type::array) {
       return false;
     }
 
-    for (auto&& v : ctx.jsonDoc) {
+    for (auto&& v : jsonDoc) {
       try {
         if constexpr (std::is_same_v<TInput, bool>) {
           if (v.type() == simdjson::ondemand::json_type::boolean &&
@@ -141,20 +122,20 @@ struct SIMDJsonArrayLengthFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
   FOLLY_ALWAYS_INLINE bool call(int64_t& len, const arg_type<Json>& json) {
-    ParserContext ctx(json.data(), json.size());
+    simdjson::ondemand::document jsonDoc;
 
     try {
-      ctx.parseDocument();
+      jsonDoc = simdjsonParse(std::string_view(json));
     } catch (const simdjson::simdjson_error&) {
       return false;
     }
 
-    if (ctx.jsonDoc.type() != simdjson::ondemand::json_type::array) {
+    if (jsonDoc.type() != simdjson::ondemand::json_type::array) {
       return false;
     }
 
     try {
-      len = ctx.jsonDoc.count_elements();
+      len = jsonDoc.count_elements();
     } catch (const simdjson::simdjson_error&) {
       return false;
     }
@@ -163,6 +144,47 @@ struct SIMDJsonArrayLengthFunction {
   }
 };
 
+// Consumes the elements of a JSON path for json_extract_scalar. 'result' is
+// set if the path selects a single scalar, otherwise it is null.
+struct JsonExtractScalarConsumer {
+  std::optional<std::string> result;
+  bool resultPopulated{false};
+
+  template <typename TValue>
+  bool operator()(TValue& v) {
+    if (resultPopulated) {
+      // We should just get a single value, if we see multiple, it's an error
+      // and we should return null.
+      result = std::nullopt;
+      return true;
+    }
+
+    resultPopulated = true;
+
+    SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
+    switch (vtype) {
+      case simdjson::ondemand::json_type::boolean: {
+        SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
+        result = vbool ? "true" : "false";
+        break;
+      }
+      case simdjson::ondemand::json_type::string: {
+        SIMDJSON_ASSIGN_OR_RAISE(result, v.get_string());
+        break;
+      }
+      case simdjson::ondemand::json_type::object:
+      case simdjson::ondemand::json_type::array:
+      case simdjson::ondemand::json_type::null:
+        // Do nothing.
+        break;
+      default: {
+        SIMDJSON_ASSIGN_OR_RAISE(result, simdjson::to_json_string(v));
+      }
+    }
+    return true;
+  }
+};
+
 // jsonExtractScalar(json, json_path) -> varchar
 // Like jsonExtract(), but returns the result value as a string (as opposed
 // to being encoded as JSON). The value referenced by json_path must be a scalar
@@ -175,48 +197,14 @@ struct SIMDJsonExtractScalarFunction {
       out_type<Varchar>& result,
       const arg_type<Json>& json,
       const arg_type<Varchar>& jsonPath) {
-    bool resultPopulated = false;
-    std::optional<std::string> resultStr;
-    auto consumer = [&resultStr, &resultPopulated](auto& v) {
-      if (resultPopulated) {
-        // We should just get a single value, if we see multiple, it's an error
-        // and we should return null.
-        resultStr = std::nullopt;
-        return true;
-      }
-
-      resultPopulated = true;
-
-      SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
-      switch (vtype) {
-        case simdjson::ondemand::json_type::boolean: {
-          SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
-          resultStr = vbool ? "true" : "false";
-          break;
-        }
-        case simdjson::ondemand::json_type::string: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
-          break;
-        }
-        case simdjson::ondemand::json_type::object:
-        case simdjson::ondemand::json_type::array:
-        case simdjson::ondemand::json_type::null:
-          // Do nothing.
-          break;
-        default: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
-        }
-      }
-      return true;
-    };
-
+    JsonExtractScalarConsumer consumer;
     if (!simdJsonExtract(json, jsonPath, consumer)) {
       // If there's an error parsing the JSON, return null.
       return false;
     }
 
-    if (resultStr.has_value()) {
-      result.copy_from(*resultStr);
+    if (consumer.result.has_value()) {
+      result.copy_from(*consumer.result);
       return true;
     } else {
       return false;
@@ -54,6 +54,16 @@ struct HllAccumulator {
     }
   }
 
+  void append(const uint64_t* hashes, int32_t numHashes) {
+    if (isSparse_) {
+      if (sparseHll_.insertHashes(hashes, numHashes)) {
+        toDense();
+      }
+    } else {
+      denseHll_.insertHashes(hashes, numHashes);
+    }
+  }
+
   int64_t cardinality() const {
     return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
   }
@@ -264,18 +274,22 @@ class ApproxDistinctAggregate : public exec::Aggregate {
     } else {
       decodeArguments(rows, args);
 
+      // Hashes all the values first and inserts them in one batch.
+      hashes_.resize(rows.countSelected());
+      int32_t numHashes = 0;
       rows.applyToSelected([&](auto row) {
-        if (decodedValue_.isNullAt(row)) {
-          return;
+        if (!decodedValue_.isNullAt(row)) {
+          hashes_[numHashes++] = hashOne(decodedValue_.valueAt<T>(row));
         }
-
-        auto accumulator = value<HllAccumulator>(group);
-        clearNull(group);
-        accumulator->setIndexBitLength(indexBitLength_);
-
-        auto hash = hashOne(decodedValue_.valueAt<T>(row));
-        accumulator->append(hash);
       });
+      if (numHashes == 0) {
+        return;
+      }
+
+      auto accumulator = value<HllAccumulator>(group);
+      clearNull(group);
+      accumulator->setIndexBitLength(indexBitLength_);
+      accumulator->append(hashes_.data(), numHashes);
     }
   }
 
@@ -389,6 +403,7 @@ class ApproxDistinctAggregate : public exec::Aggregate {
   DecodedVector decodedValue_;
   DecodedVector decodedMaxStandardError_;
   DecodedVector decodedHll_;
+  std::vector<uint64_t> hashes_;
 };
 
 template <TypeKind kind>
@@ -52,6 +52,10 @@ struct KllSketchAccumulator {
     sketch_.insert(value);
   }
 
+  void append(const T* values, size_t count) {
+    sketch_.insert(values, count);
+  }
+
   void append(T value, int64_t count) {
     constexpr size_t kMaxBufferSize = 4096;
     constexpr int64_t kMinCountToBuffer = 512;
@@ -198,7 +202,9 @@ class ApproxPercentileAggregate : public exec::Aggregate {
           [&](const KllSketch<T>& digest,
               ArrayVector* result,
               vector_size_t index) {
-            digest.estimateQuantiles(percentiles, rawValues + elementsCount);
+            digest.sortedView(sortedView_);
+            digest.estimateQuantiles(
+                sortedView_, percentiles, rawValues + elementsCount);
             result->setOffsetAndSize(index, elementsCount, percentiles.size());
             elementsCount += percentiles.size();
           });
@@ -211,8 +217,13 @@ class ApproxPercentileAggregate : public exec::Aggregate {
               FlatVector<T>* result,
               vector_size_t index) {
             VELOX_DCHECK_EQ(percentiles_->values.size(), 1);
-            result->set(
-                index, digest.estimateQuantile(percentiles_->values.back()));
+            T value;
+            digest.sortedView(sortedView_);
+            digest.estimateQuantiles(
+                sortedView_,
+                folly::Range(&percentiles_->values.back(), 1),
+                &value);
+            result->set(index, value);
           });
     }
   }
@@ -393,19 +404,15 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         accumulator->append(value, weight);
       });
     } else {
-      if (decodedValue_.mayHaveNulls()) {
-        rows.applyToSelected([&](auto row) {
-          if (decodedValue_.isNullAt(row)) {
-            return;
-          }
-
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      } else {
-        rows.applyToSelected([&](auto row) {
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      }
+      // Copies the non-null values first and inserts them in one batch.
+      values_.resize(rows.countSelected());
+      vector_size_t numValues = 0;
+      rows.applyToSelected([&](auto row) {
+        if (!decodedValue_.isNullAt(row)) {
+          values_[numValues++] = decodedValue_.valueAt<T>(row);
+        }
+      });
+      accumulator->append(values_.data(), numValues);
     }
   }
 
@@ -612,6 +619,9 @@ class ApproxPercentileAggregate : public exec::Aggregate {
   DecodedVector decodedWeight_;
   DecodedVector decodedAccuracy_;
   DecodedVector decodedDigest_;
+  // Reused across groups and batches.
+  std::vector<T> values_;
+  typename KllSketch<T>::SortedView sortedView_;
 
  private:
   template <bool kSingleGroup, bool checkIntermediateInputs>
@@ -18,6 +18,7 @@
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/Cursor.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/functions/lib/aggregates/tests/AggregationTestBase.h"
 
 using namespace facebook::velox::exec;
@@ -199,6 +200,43 @@ TEST_F(ArrayAggTest, sortedGroupBy) {
   testFunction("simple_array_agg");
 }
 
+TEST_F(ArrayAggTest, sortedGroupByWithSpilling) {
+  // Spilling needs at least 2 batches of input.
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 10; ++i) {
+    const auto start = i * 100;
+    data.push_back(makeRowVector({
+        makeFlatVector<int16_t>(100, [](auto row) { return row % 7; }),
+        makeFlatVector<int64_t>(100, [&](auto row) { return start + row; }),
+        makeFlatVector<int64_t>(
+            100, [&](auto row) { return (start + row) * 7'919 % 1'000; }),
+        makeFlatVector<std::string>(
+            100, [&](auto row) { return fmt::format("s{}", start + row); }),
+    }));
+  }
+  createDuckDbTable(data);
+
+  auto plan = PlanBuilder()
+                  .values(data)
+                  .singleAggregation(
+                      {"c0"},
+                      {"array_agg(c1 ORDER BY c2 DESC)",
+                       "sum(c1)",
+                       "array_agg(c3 ORDER BY c1)"})
+                  .planNode();
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .spillDirectory(spillDirectory->path)
+          .config(core::QueryConfig::kSpillEnabled, "true")
+          .config(core::QueryConfig::kAggregationSpillEnabled, "true")
+          .config(core::QueryConfig::kTestingSpillPct, "100")
+          .assertResults(
+              "SELECT c0, array_agg(c1 ORDER BY c2 DESC), sum(c1), array_agg(c3 ORDER BY c1) "
+              " FROM tmp GROUP BY 1");
+  EXPECT_LT(0, toPlanStats(task->taskStats()).at(plan->id()).spilledBytes);
+}
+
 TEST_F(ArrayAggTest, global) {
   auto testFunction = [this](
                           const std::string& functionName, bool ignoreNulls) {
@@ -124,6 +124,24 @@ class DateTimeBenchmark : public functions::test::FunctionBenchmarkBase {
     doRun(exprSet, data);
   }
 
+  // Runs 'expression' over c0, timestamps of the recent years, and c1, the
+  // same timestamps formatted as 'yyyy-MM-dd HH:mm:ss'.
+  void runFormat(const std::string& expression) {
+    folly::BenchmarkSuspender suspender;
+    constexpr vector_size_t size = 10'000;
+    auto timestamps = vectorMaker_.flatVector<Timestamp>(size, [](auto row) {
+      return Timestamp(1'600'000'000 + row * 7'919, 0);
+    });
+    auto strings = evaluate(
+        "format_datetime(c0, 'yyyy-MM-dd HH:mm:ss')",
+        vectorMaker_.rowVector({timestamps}));
+    auto data = vectorMaker_.rowVector({timestamps, strings});
+    auto exprSet = compileExpression(expression, data->type());
+    suspender.dismiss();
+
+    doRun(exprSet, data);
+  }
+
   void doRun(exec::ExprSet& exprSet, const RowVectorPtr& rowVector) {
     int cnt = 0;
     for (auto i = 0; i < 100; i++) {
@@ -197,6 +215,26 @@ BENCHMARK(second) {
   DateTimeBenchmark benchmark;
   benchmark.run("second");
 }
+BENCHMARK(formatDateTime) {
+  DateTimeBenchmark benchmark;
+  benchmark.runFormat("format_datetime(c0, 'yyyy-MM-dd HH:mm:ss')");
+}
+
+BENCHMARK(dateFormat) {
+  DateTimeBenchmark benchmark;
+  benchmark.runFormat("date_format(c0, '%Y-%m-%d %H:%i:%s')");
+}
+
+BENCHMARK(parseDateTime) {
+  DateTimeBenchmark benchmark;
+  benchmark.runFormat("parse_datetime(c1, 'yyyy-MM-dd HH:mm:ss')");
+}
+
+BENCHMARK(dateParse) {
+  DateTimeBenchmark benchmark;
+  benchmark.runFormat("date_parse(c1, '%Y-%m-%d %H:%i:%s')");
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -31,6 +31,22 @@ namespace {
 
 const std::string smallJson = R"({"k1":"v1"})";
 
+// json_parse() as it was implemented on folly::parseJson, to compare with.
+// The casts from JSON used to start with the same parse.
+template <typename T>
+struct FollyJsonParseFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  static constexpr int32_t reuse_strings_from_arg = 0;
+
+  FOLLY_ALWAYS_INLINE void call(
+      out_type<Json>& result,
+      const arg_type<Varchar>& json) {
+    folly::parseJson(json);
+    result.setNoCopy(json);
+  }
+};
+
 class JsonBenchmark : public velox::functions::test::FunctionBenchmarkBase {
  public:
   JsonBenchmark() : FunctionBenchmarkBase() {
@@ -59,6 +75,8 @@ class JsonBenchmark : public velox::functions::test::FunctionBenchmarkBase {
         {"folly_json_size"});
     registerFunction<SIMDJsonSizeFunction, int64_t, Json, Varchar>(
         {"simd_json_size"});
+    registerFunction<FollyJsonParseFunction, Json, Varchar>(
+        {"folly_json_parse"});
   }
 
   std::string prepareData(int jsonSize) {
@@ -70,9 +88,12 @@ class JsonBenchmark : public velox::functions::test::FunctionBenchmarkBase {
     return jsonData;
   }
 
-  velox::VectorPtr makeJsonData(const std::string& json, int vectorSize) {
+  velox::VectorPtr makeJsonData(
+      const std::string& json,
+      int vectorSize,
+      const TypePtr& type = JSON()) {
     auto jsonVector =
-        vectorMaker_.flatVector<velox::StringView>(vectorSize, JSON());
+        vectorMaker_.flatVector<velox::StringView>(vectorSize, type);
     for (auto i = 0; i < vectorSize; i++) {
       jsonVector->set(i, velox::StringView(json));
     }
@@ -95,6 +116,53 @@ class JsonBenchmark : public velox::functions::test::FunctionBenchmarkBase {
     doRun(iter, exprSet, rowVector);
   }
 
+  // Evaluates 'expression' over a column 'c0' of 'type' filled with 'json'.
+  void runWithExpression(
+      int iter,
+      int vectorSize,
+      const std::string& expression,
+      const std::string& json,
+      const TypePtr& type) {
+    folly::BenchmarkSuspender suspender;
+
+    auto jsonVector = makeJsonData(json, vectorSize, type);
+
+    auto rowVector = vectorMaker_.rowVector({jsonVector});
+    auto exprSet = compileExpression(expression, rowVector->type());
+    suspender.dismiss();
+    doRun(iter, exprSet, rowVector);
+  }
+
+  // Evaluates 'fnName'(c0, '$.k<i>') for 'numPaths' fields of the same 'c0'
+  // in one ExprSet, e.g. to compare json_extract_scalar calls that parse each
+  // row once for all the paths with calls that parse it once per path.
+  void runWithMultiplePaths(
+      int iter,
+      int vectorSize,
+      const std::string& fnName,
+      int numPaths) {
+    folly::BenchmarkSuspender suspender;
+
+    std::string json = "{";
+    for (auto i = 0; i < numPaths; ++i) {
+      json += fmt::format(R"({}"k{}":"v{}")", i > 0 ? "," : "", i, i);
+    }
+    json += "}";
+    auto jsonVector = makeJsonData(json, vectorSize);
+
+    auto rowVector = vectorMaker_.rowVector({jsonVector});
+    std::vector<core::TypedExprPtr> expressions;
+    for (auto i = 0; i < numPaths; ++i) {
+      auto untyped = parse::parseExpr(
+          fmt::format("{}(c0, '$.k{}')", fnName, i), options_);
+      expressions.push_back(core::Expressions::inferTypes(
+          untyped, rowVector->type(), execCtx_.pool()));
+    }
+    exec::ExprSet exprSet(expressions, &execCtx_);
+    suspender.dismiss();
+    doRun(iter, exprSet, rowVector);
+  }
+
   void runWithJsonExtract(
       int iter,
       int vectorSize,
@@ -211,6 +279,18 @@ void SIMDJsonExtractScalar(int iter, int vectorSize, int jsonSize) {
       iter, vectorSize, "simd_json_extract_scalar", json, "$.key[7].k1");
 }
 
+void SIMDJsonExtractScalarPerPath(int iter, int vectorSize, int numPaths) {
+  JsonBenchmark benchmark;
+  benchmark.runWithMultiplePaths(
+      iter, vectorSize, "simd_json_extract_scalar", numPaths);
+}
+
+void SIMDJsonExtractScalarMultiPath(int iter, int vectorSize, int numPaths) {
+  JsonBenchmark benchmark;
+  benchmark.runWithMultiplePaths(
+      iter, vectorSize, "json_extract_scalar", numPaths);
+}
+
 void FollyJsonExtract(int iter, int vectorSize, int jsonSize) {
   folly::BenchmarkSuspender suspender;
   JsonBenchmark benchmark;
@@ -247,8 +327,97 @@ void SIMDJsonSize(int iter, int vectorSize, int jsonSize) {
       iter, vectorSize, "simd_json_size", json, "$.key");
 }
 
+void FollyJsonParse(int iter, int vectorSize, int jsonSize) {
+  folly::BenchmarkSuspender suspender;
+  JsonBenchmark benchmark;
+  auto json = benchmark.prepareData(jsonSize);
+  suspender.dismiss();
+  benchmark.runWithExpression(
+      iter, vectorSize, "folly_json_parse(c0)", json, VARCHAR());
+}
+
+void SIMDJsonParse(int iter, int vectorSize, int jsonSize) {
+  folly::BenchmarkSuspender suspender;
+  JsonBenchmark benchmark;
+  auto json = benchmark.prepareData(jsonSize);
+  suspender.dismiss();
+  benchmark.runWithExpression(
+      iter, vectorSize, "json_parse(c0)", json, VARCHAR());
+}
+
+void SIMDCastJsonToRow(int iter, int vectorSize, int jsonSize) {
+  folly::BenchmarkSuspender suspender;
+  JsonBenchmark benchmark;
+  auto json = benchmark.prepareData(jsonSize);
+  suspender.dismiss();
+  benchmark.runWithExpression(
+      iter,
+      vectorSize,
+      "cast(c0 as row(key array(map(varchar, varchar))))",
+      json,
+      JSON());
+}
+
+void SIMDCastJsonToArray(int iter, int vectorSize, int jsonSize) {
+  folly::BenchmarkSuspender suspender;
+  JsonBenchmark benchmark;
+  auto json = benchmark.prepareData(jsonSize);
+  // Strip the top-level object: [{"k1":"v1"}, ...].
+  json = json.substr(8, json.size() - 9);
+  suspender.dismiss();
+  benchmark.runWithExpression(
+      iter,
+      vectorSize,
+      "cast(c0 as array(map(varchar, varchar)))",
+      json,
+      JSON());
+}
+
+BENCHMARK_DRAW_LINE();
+
+// The casts from JSON are compared with the folly::parseJson() they did
+// before converting the parsed values.
+BENCHMARK_NAMED_PARAM(FollyJsonParse, 100_iters_10bytes_size, 100, 10);
+BENCHMARK_RELATIVE_NAMED_PARAM(SIMDJsonParse, 100_iters_10bytes_size, 100, 10);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    SIMDCastJsonToRow,
+    100_iters_10bytes_size,
+    100,
+    10);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(FollyJsonParse, 100_iters_1000bytes_size, 100, 1000);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    SIMDJsonParse,
+    100_iters_1000bytes_size,
+    100,
+    1000);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    SIMDCastJsonToRow,
+    100_iters_1000bytes_size,
+    100,
+    1000);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    SIMDCastJsonToArray,
+    100_iters_1000bytes_size,
+    100,
+    1000);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(FollyJsonParse, 100_iters_10000bytes_size, 100, 10000);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    SIMDJsonParse,
+    100_iters_10000bytes_size,
+    100,
+    10000);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    SIMDCastJsonToRow,
+    100_iters_10000bytes_size,
+    100,
+    10000);
 BENCHMARK_DRAW_LINE();
 
+BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM(FollyIsJsonScalar, 100_iters_10bytes_size, 100, 10);
 BENCHMARK_RELATIVE_NAMED_PARAM(
     SIMDIsJsonScalar,
@@ -412,6 +581,27 @@ BENCHMARK_RELATIVE_NAMED_PARAM(
     10000);
 BENCHMARK_DRAW_LINE();
 
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(SIMDJsonExtractScalarPerPath, 100_iters_2_paths, 100, 2);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    SIMDJsonExtractScalarMultiPath,
+    100_iters_2_paths,
+    100,
+    2);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(
+    SIMDJsonExtractScalarPerPath,
+    100_iters_10_paths,
+    100,
+    10);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    SIMDJsonExtractScalarMultiPath,
+    100_iters_10_paths,
+    100,
+    10);
+BENCHMARK_DRAW_LINE();
+
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM(FollyJsonExtract, 100_iters_10bytes_size, 100, 10);
 BENCHMARK_RELATIVE_NAMED_PARAM(
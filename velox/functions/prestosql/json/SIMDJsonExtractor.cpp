@@ -101,3 +101,33 @@ bool extractArray(
   return true;
 }
 } // namespace facebook::velox::functions::detail
+
+namespace facebook::velox::functions {
+
+SIMDJsonMultiPathExtractor::SIMDJsonMultiPathExtractor(
+    const std::vector<std::string>& paths) {
+  extractors_.reserve(paths.size());
+  for (const auto& path : paths) {
+    extractors_.emplace_back(new detail::SIMDJsonExtractor(
+        folly::trimWhitespace(folly::StringPiece(path)).str()));
+  }
+}
+
+// static
+bool SIMDJsonMultiPathExtractor::isValidPath(folly::StringPiece path) {
+  try {
+    detail::SIMDJsonExtractor(folly::trimWhitespace(path).str());
+  } catch (const VeloxUserError&) {
+    return false;
+  }
+  return true;
+}
+
+bool SIMDJsonMultiPathExtractor::parse(const velox::StringView& json) {
+  json_ = json;
+  reparse_ = false;
+  SIMDJSON_ASSIGN_OR_RAISE(document_, simdjsonParse(std::string_view(json)));
+  return true;
+}
+
+} // namespace facebook::velox::functions
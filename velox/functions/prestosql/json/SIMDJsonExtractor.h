@@ -23,6 +23,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Macros.h"
 #include "velox/functions/prestosql/json/JsonPathTokenizer.h"
+#include "velox/functions/prestosql/json/SIMDJsonUtil.h"
 #include "velox/functions/prestosql/json/SIMDJsonWrapper.h"
 #include "velox/type/StringView.h"
 
@@ -44,6 +45,8 @@ bool simdJsonExtract(
     const velox::StringView& path,
     TConsumer&& consumer);
 
+class SIMDJsonMultiPathExtractor;
+
 namespace detail {
 
 using JsonVector = std::vector<simdjson::ondemand::value>;
@@ -89,6 +92,7 @@ class SIMDJsonExtractor {
       const velox::StringView& json,
       const velox::StringView& path,
       TConsumer&& consumer);
+  friend class facebook::velox::functions::SIMDJsonMultiPathExtractor;
 };
 
 bool extractObject(
@@ -194,6 +198,72 @@ bool simdJsonExtract(
   return extractor.extract(value, std::forward<TConsumer>(consumer));
 }
 
+/// Extracts the elements of several JSON paths from the same JSON document.
+/// The document is parsed once for all the paths, rather than once per path
+/// as with simdJsonExtract(), e.g. for json_extract_scalar calls over ten
+/// fields of the same column. The results are the same as simdJsonExtract()
+/// on each path.
+class SIMDJsonMultiPathExtractor {
+ public:
+  /// Throws a VeloxUserError if any of 'paths' is not a valid JSON path.
+  explicit SIMDJsonMultiPathExtractor(const std::vector<std::string>& paths);
+
+  /// Returns true if 'path' is a valid JSON path, i.e. simdJsonExtract()
+  /// would not throw for it.
+  static bool isValidPath(folly::StringPiece path);
+
+  size_t numPaths() const {
+    return extractors_.size();
+  }
+
+  /// Parses 'json' for the following calls to extract(). 'json' must stay
+  /// valid until then. Returns false if the document cannot be parsed, in
+  /// which case extract() must not be called.
+  bool parse(const velox::StringView& json);
+
+  /// Extracts the element(s) of the path at 'index' from the document passed
+  /// to the last parse(). 'consumer' is called as in simdJsonExtract(). Returns
+  /// true on success.
+  template <typename TConsumer>
+  bool extract(size_t index, TConsumer&& consumer);
+
+ private:
+  std::vector<std::unique_ptr<detail::SIMDJsonExtractor>> extractors_;
+  velox::StringView json_;
+  simdjson::ondemand::document document_;
+  // True if the document must be parsed again before the next extract(), e.g.
+  // after a failed extraction left the iterator in an error state that
+  // rewinding does not clear.
+  bool reparse_{false};
+};
+
+template <typename TConsumer>
+bool SIMDJsonMultiPathExtractor::extract(size_t index, TConsumer&& consumer) {
+  VELOX_DCHECK_LT(index, extractors_.size());
+  if (reparse_) {
+    SIMDJSON_ASSIGN_OR_RAISE(document_, simdjsonParse(std::string_view(json_)));
+    reparse_ = false;
+  } else {
+    // Only moves the iterator back to the start of the indexed document.
+    document_.rewind();
+  }
+
+  auto& extractor = *extractors_[index];
+  reparse_ = true;
+  if (extractor.isRootOnlyPath()) {
+    if (!consumer(document_)) {
+      return false;
+    }
+  } else {
+    SIMDJSON_ASSIGN_OR_RAISE(auto value, document_.get_value());
+    if (!extractor.extract(value, consumer)) {
+      return false;
+    }
+  }
+  reparse_ = false;
+  return true;
+}
+
 template <typename TConsumer>
 bool simdJsonExtract(
     const std::string& json,
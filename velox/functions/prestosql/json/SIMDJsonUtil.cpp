@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/prestosql/json/SIMDJsonUtil.h"
+
+#include <cstring>
+#include <string>
+
+namespace facebook::velox::functions {
+namespace {
+
+simdjson::error_code validateValue(simdjson::ondemand::value value);
+
+simdjson::error_code validateArray(simdjson::ondemand::array array) {
+  for (auto element : array) {
+    simdjson::ondemand::value value;
+    if (auto error = element.get(value)) {
+      return error;
+    }
+    if (auto error = validateValue(value)) {
+      return error;
+    }
+  }
+  return simdjson::SUCCESS;
+}
+
+simdjson::error_code validateObject(simdjson::ondemand::object object) {
+  for (auto field : object) {
+    std::string_view key;
+    if (auto error = field.unescaped_key().get(key)) {
+      return error;
+    }
+    if (auto error = validateValue(field.value())) {
+      return error;
+    }
+  }
+  return simdjson::SUCCESS;
+}
+
+// Reads the scalar 'value' of 'type', so that simdjson checks its syntax.
+// 'TValue' is simdjson::ondemand::value or a document with a scalar root.
+template <typename TValue>
+simdjson::error_code validateScalar(
+    TValue& value,
+    simdjson::ondemand::json_type type) {
+  switch (type) {
+    case simdjson::ondemand::json_type::number:
+      return value.get_double().error();
+    case simdjson::ondemand::json_type::string:
+      return value.get_string().error();
+    case simdjson::ondemand::json_type::boolean:
+      return value.get_bool().error();
+    case simdjson::ondemand::json_type::null: {
+      bool isNull;
+      if (auto error = value.is_null().get(isNull)) {
+        return error;
+      }
+      return isNull ? simdjson::SUCCESS : simdjson::N_ATOM_ERROR;
+    }
+    default:
+      return simdjson::INCORRECT_TYPE;
+  }
+}
+
+simdjson::error_code validateValue(simdjson::ondemand::value value) {
+  simdjson::ondemand::json_type type;
+  if (auto error = value.type().get(type)) {
+    return error;
+  }
+  switch (type) {
+    case simdjson::ondemand::json_type::array: {
+      simdjson::ondemand::array array;
+      if (auto error = value.get_array().get(array)) {
+        return error;
+      }
+      return validateArray(array);
+    }
+    case simdjson::ondemand::json_type::object: {
+      simdjson::ondemand::object object;
+      if (auto error = value.get_object().get(object)) {
+        return error;
+      }
+      return validateObject(object);
+    }
+    default:
+      return validateScalar(value, type);
+  }
+}
+
+} // namespace
+
+simdjson::simdjson_result<simdjson::ondemand::document> simdjsonParse(
+    std::string_view json) {
+  thread_local static simdjson::ondemand::parser parser;
+  thread_local static std::string buffer;
+  buffer.resize(json.size() + simdjson::SIMDJSON_PADDING);
+  if (!json.empty()) {
+    std::memcpy(buffer.data(), json.data(), json.size());
+  }
+  return parser.iterate(
+      simdjson::padded_string_view(buffer.data(), json.size(), buffer.size()));
+}
+
+simdjson::error_code simdjsonValidate(std::string_view json) {
+  simdjson::ondemand::document document;
+  if (auto error = simdjsonParse(json).get(document)) {
+    return error;
+  }
+  simdjson::ondemand::json_type type;
+  if (auto error = document.type().get(type)) {
+    return error;
+  }
+  switch (type) {
+    case simdjson::ondemand::json_type::array: {
+      simdjson::ondemand::array array;
+      if (auto error = document.get_array().get(array)) {
+        return error;
+      }
+      if (auto error = validateArray(array)) {
+        return error;
+      }
+      break;
+    }
+    case simdjson::ondemand::json_type::object: {
+      simdjson::ondemand::object object;
+      if (auto error = document.get_object().get(object)) {
+        return error;
+      }
+      if (auto error = validateObject(object)) {
+        return error;
+      }
+      break;
+    }
+    default:
+      // Reading a scalar root also checks that nothing follows it.
+      return validateScalar(document, type);
+  }
+  return document.at_end() ? simdjson::SUCCESS : simdjson::TRAILING_CONTENT;
+}
+
+} // namespace facebook::velox::functions
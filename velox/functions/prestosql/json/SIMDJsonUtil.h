@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include "velox/functions/prestosql/json/SIMDJsonWrapper.h"
+
+namespace facebook::velox::functions {
+
+/// Parses 'json' with a thread local simdjson on-demand parser. 'json' is
+/// copied into a thread local buffer with the padding simdjson needs, so
+/// that no memory is allocated per call once the buffer and the parser are
+/// large enough. The returned document is valid until the next call on the
+/// same thread. The on-demand parser only checks the parts of the document
+/// that are read, see simdjsonValidate() for checking the whole document.
+simdjson::simdjson_result<simdjson::ondemand::document> simdjsonParse(
+    std::string_view json);
+
+/// Returns simdjson::SUCCESS if 'json' is a single valid JSON value, e.g.
+/// without trailing content. Otherwise returns the first error found. Walks
+/// the whole document with simdjsonParse() and does not allocate per call.
+simdjson::error_code simdjsonValidate(std::string_view json);
+
+} // namespace facebook::velox::functions
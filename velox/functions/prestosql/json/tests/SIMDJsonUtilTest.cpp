@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/prestosql/json/SIMDJsonUtil.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+using facebook::velox::functions::simdjsonParse;
+using facebook::velox::functions::simdjsonValidate;
+
+TEST(SIMDJsonUtilTest, validate) {
+  for (const std::string json :
+       {"true",
+        "null",
+        "42",
+        "-1.5e3",
+        "12345678901234567890",
+        R"("abc")",
+        " 7 ",
+        "[1, 2, 3]",
+        "[[[]]]",
+        R"({"k1":"v1"})",
+        R"({"k1":[1,{"k2":null}],"k3":"é"})"}) {
+    EXPECT_EQ(simdjson::SUCCESS, simdjsonValidate(json)) << json;
+  }
+
+  // The errors may be in parts that the on-demand parser would skip.
+  for (const std::string json :
+       {"",
+        "  ",
+        "not_json",
+        "nul",
+        "NaN",
+        R"({"k1":})",
+        R"({:"k1"})",
+        R"("k1":)",
+        "1 2",
+        "[1] 2",
+        "[1]]",
+        "[1,]",
+        R"({"k1":1}})",
+        R"({"k1":[1,{"k2":tru}]})",
+        R"(["a" "b"])",
+        R"("\x")"}) {
+    EXPECT_NE(simdjson::SUCCESS, simdjsonValidate(json)) << json;
+  }
+}
+
+TEST(SIMDJsonUtilTest, parse) {
+  // The thread local buffer shrinks and grows between calls.
+  std::string longArray = "[";
+  for (auto i = 0; i < 1'000; ++i) {
+    longArray += std::to_string(i) + ",";
+  }
+  longArray.back() = ']';
+  const std::vector<std::pair<std::string, int64_t>> jsons = {
+      {"[0]", 1}, {longArray, 1'000}, {"[]", 0}};
+  for (const auto& [json, size] : jsons) {
+    simdjson::ondemand::document document;
+    ASSERT_EQ(simdjson::SUCCESS, simdjsonParse(json).get(document));
+    int64_t count = 0;
+    for (auto element : document.get_array()) {
+      EXPECT_EQ(count++, element.get_int64().value());
+    }
+    EXPECT_EQ(size, count);
+  }
+}
+
+} // namespace
@@ -15,6 +15,7 @@
  */
 
 #include "velox/functions/Registerer.h"
+#include "velox/functions/prestosql/JsonExtractScalarRewrite.h"
 #include "velox/functions/prestosql/JsonFunctions.h"
 #include "velox/functions/prestosql/SIMDJsonFunctions.h"
 
@@ -31,6 +32,7 @@ void registerJsonFunctions(const std::string& prefix) {
       {prefix + "json_extract_scalar"});
   registerFunction<SIMDJsonExtractScalarFunction, Varchar, Varchar, Varchar>(
       {prefix + "json_extract_scalar"});
+  registerJsonExtractScalarRewrite(prefix);
 
   registerFunction<SIMDJsonExtractFunction, Json, Json, Varchar>(
       {prefix + "json_extract"});
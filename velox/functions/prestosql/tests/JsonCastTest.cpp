@@ -770,18 +770,15 @@ TEST_F(JsonCastTest, toInteger) {
       TINYINT(),
       {"-1223456"_sv},
       "Cannot cast from Json value -1223456 to TINYINT: Negative overflow during arithmetic conversion: (signed char) -1223456");
+  // NaN and Infinity are not JSON numbers.
   testThrow<JsonNativeType, int8_t>(
-      JSON(),
-      TINYINT(),
-      {"Infinity"_sv},
-      "Cannot cast from Json value Infinity to TINYINT: value is out of range [-128, 127]: inf");
+      JSON(), TINYINT(), {"Infinity"_sv}, "Not a JSON input: Infinity");
   testThrow<JsonNativeType, int8_t>(
-      JSON(),
-      TINYINT(),
-      {"NaN"_sv},
-      "Cannot cast from Json value NaN to TINYINT: value is out of range [-128, 127]: nan");
+      JSON(), TINYINT(), {"NaN"_sv}, "Not a JSON input: NaN");
   testThrow<JsonNativeType, int8_t>(
       JSON(), TINYINT(), {""_sv}, "Not a JSON input");
+  testThrow<JsonNativeType, int64_t>(
+      JSON(), BIGINT(), {"1 2"_sv}, "Not a JSON input: 1 2");
 }
 
 TEST_F(JsonCastTest, toDouble) {
@@ -935,6 +932,16 @@ TEST_F(JsonCastTest, toMap) {
       MAP(BIGINT(), DOUBLE()),
       {"{1:1.1,2:2.2}"_sv},
       "Not a JSON input");
+  testThrow<JsonNativeType, ComplexType>(
+      JSON(),
+      MAP(VARCHAR(), BIGINT()),
+      {R"({"k1":1,"k2":2,"k1":3})"_sv},
+      "Duplicate keys (k1) are not allowed.");
+  testThrow<JsonNativeType, ComplexType>(
+      JSON(),
+      MAP(VARCHAR(), BIGINT()),
+      {R"({"k1":1} {"k2":2})"_sv},
+      "Not a JSON input");
 }
 
 TEST_F(JsonCastTest, orderOfKeys) {
@@ -1111,6 +1118,21 @@ TEST_F(JsonCastTest, toInvalid) {
       ROW({BIGINT()}),
       {R"(123)"_sv, R"(456)"_sv},
       "Only casting from JSON array or object to ROW is supported");
+  testThrow<JsonNativeType, ComplexType>(
+      JSON(),
+      ARRAY(BIGINT()),
+      {R"({"k1":1})"_sv},
+      "Cannot cast a JSON object to ARRAY<BIGINT>.");
+  testThrow<JsonNativeType, ComplexType>(
+      JSON(),
+      MAP(VARCHAR(), BIGINT()),
+      {R"([1,2])"_sv},
+      "Cannot cast a JSON array to MAP<VARCHAR,BIGINT>.");
+  testThrow<JsonNativeType, StringView>(
+      JSON(),
+      VARCHAR(),
+      {R"([1,2])"_sv},
+      "Cannot cast a JSON array to VARCHAR.");
 }
 
 TEST_F(JsonCastTest, castInTry) {
@@ -173,6 +173,83 @@ TEST_F(JsonExtractScalarTest, invalidPath) {
   EXPECT_THROW(jsonExtractScalar(R"({"k1":"v1)", "$.k1]"), VeloxUserError);
 }
 
+TEST_F(JsonExtractScalarTest, multiplePaths) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {R"({"a":1,"b":"x","c":{"d":true}})",
+           R"({"b":"y","c":{"d":null},"e":[1,2]})",
+           std::nullopt,
+           R"({"a":{"b":1}})",
+           "not_json",
+           R"({"c":{"d":false},"a":2.5})"},
+          JSON()),
+      makeFlatVector<std::string>({"1", "2", "3", "4", "5", "6"}),
+  });
+  std::vector<std::string> expressions = {
+      "json_extract_scalar(c0, '$.a')",
+      "json_extract_scalar(c0, '$.b')",
+      "concat(json_extract_scalar(c0, '$.c.d'), "
+      "json_extract_scalar(c0, '$.a'))",
+      "json_extract_scalar(c0, '$.e[1]')",
+      // Not fused since the path is not constant.
+      "json_extract_scalar(c0, c1)",
+      // An invalid path is not fused and only fails when evaluated.
+      "try(json_extract_scalar(c0, '$.a.'))",
+  };
+
+  auto exprSet = compileExpressions(expressions, asRowType(data->type()));
+  ASSERT_NE(
+      exprSet->toString().find("$internal$json_extract_scalars"),
+      std::string::npos)
+      << exprSet->toString();
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  SelectivityVector rows(data->size());
+  std::vector<VectorPtr> results(expressions.size());
+  exprSet->eval(rows, context, results);
+
+  // Evaluating each expression on its own gives the same results.
+  for (auto i = 0; i < expressions.size(); ++i) {
+    SCOPED_TRACE(expressions[i]);
+    auto singleExprSet =
+        compileExpression(expressions[i], asRowType(data->type()));
+    if (i == 0 || i == 1 || i == 3) {
+      ASSERT_EQ(
+          singleExprSet->toString().find("$internal$json_extract_scalars"),
+          std::string::npos);
+    }
+    velox::test::assertEqualVectors(
+        evaluate(*singleExprSet, data), results[i]);
+  }
+
+  velox::test::assertEqualVectors(
+      makeNullableFlatVector<std::string>(
+          {"1", std::nullopt, std::nullopt, std::nullopt, std::nullopt, "2.5"}),
+      results[0]);
+  velox::test::assertEqualVectors(
+      makeNullableFlatVector<std::string>(
+          {"x", "y", std::nullopt, std::nullopt, std::nullopt, std::nullopt}),
+      results[1]);
+  velox::test::assertEqualVectors(
+      makeNullableFlatVector<std::string>(
+          {"true1",
+           std::nullopt,
+           std::nullopt,
+           std::nullopt,
+           std::nullopt,
+           "false2.5"}),
+      results[2]);
+  velox::test::assertEqualVectors(
+      makeNullableFlatVector<std::string>(
+          {std::nullopt,
+           "2",
+           std::nullopt,
+           std::nullopt,
+           std::nullopt,
+           std::nullopt}),
+      results[3]);
+}
+
 // simdjson, like Presto java, returns the large number as-is as a string,
 // without trying to convert it to an integer.
 TEST_F(JsonExtractScalarTest, overflow) {
@@ -197,10 +197,18 @@ TEST_F(JsonFunctionsTest, jsonParse) {
   EXPECT_EQ(jsonParse(R"({"k1":"v1"})"), R"({"k1":"v1"})");
   EXPECT_EQ(jsonParse(R"(["k1", "v1"])"), R"(["k1", "v1"])");
 
-  VELOX_ASSERT_THROW(jsonParse(R"({"k1":})"), "expected json value");
   VELOX_ASSERT_THROW(
-      jsonParse(R"({:"k1"})"), "json parse error on line 0 near `:\"k1\"}");
-  VELOX_ASSERT_THROW(jsonParse(R"(not_json)"), "expected json value");
+      jsonParse(R"({"k1":})"), "Cannot convert '{\"k1\":}' to JSON");
+  VELOX_ASSERT_THROW(
+      jsonParse(R"({:"k1"})"), "Cannot convert '{:\"k1\"}' to JSON");
+  VELOX_ASSERT_THROW(
+      jsonParse(R"(not_json)"), "Cannot convert 'not_json' to JSON");
+  // Errors in nested values and trailing content are found too.
+  VELOX_ASSERT_THROW(
+      jsonParse(R"({"k1":[1,{"k2":tru}]})"),
+      "Cannot convert '{\"k1\":[1,{\"k2\":tru}]}' to JSON");
+  VELOX_ASSERT_THROW(jsonParse("[1] 2"), "Cannot convert '[1] 2' to JSON");
+  VELOX_ASSERT_THROW(jsonParse(""), "Cannot convert '' to JSON");
 
   EXPECT_EQ(jsonParseWithTry(R"(not_json)"), std::nullopt);
   EXPECT_EQ(jsonParseWithTry(R"({"k1":})"), std::nullopt);
@@ -223,7 +231,7 @@ TEST_F(JsonFunctionsTest, jsonParse) {
 
   VELOX_ASSERT_THROW(
       evaluate("json_parse(c0)", data),
-      "json parse error on line 0 near `:': parsing didn't consume all input");
+      "Cannot convert '\"k1\":' to JSON: TRAILING_CONTENT");
 
   data = makeRowVector({makeFlatVector<StringView>(
       {R"("This is a long sentence")", R"("This is some other sentence")"})});
@@ -22,7 +22,9 @@
 
 #include "folly/CPortability.h"
 #include "folly/Conv.h"
+#include "folly/container/F14Set.h"
 #include "folly/json.h"
+#include "folly/small_vector.h"
 
 #include "velox/common/base/Exceptions.h"
 #include "velox/expression/EvalCtx.h"
@@ -30,6 +32,7 @@
 #include "velox/expression/StringWriter.h"
 #include "velox/expression/VectorWriters.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
+#include "velox/functions/prestosql/json/SIMDJsonUtil.h"
 #include "velox/type/Type.h"
 
 namespace facebook::velox {
@@ -468,223 +471,392 @@ void castToJsonFromRow(
   });
 }
 
-// Write object to writer at the current offset.
+// The casts from JSON read the input with the simdjson on-demand parser and
+// write to the result without building a tree of the values first. 'TValue'
+// is simdjson::ondemand::value or, for the top-level value,
+// simdjson::ondemand::document. Syntax errors are thrown as
+// simdjson::simdjson_error.
+
 template <TypeKind kind>
-FOLLY_ALWAYS_INLINE void castFromJsonTyped(
-    const folly::dynamic& /*object*/,
-    exec::GenericWriter&
-    /*writer*/) {
-  VELOX_NYI(
-      "Casting from JSON to {} is not supported.", TypeTraits<kind>::name);
+constexpr bool isIntegerKind() {
+  return kind == TypeKind::TINYINT || kind == TypeKind::SMALLINT ||
+      kind == TypeKind::INTEGER || kind == TypeKind::BIGINT;
 }
 
-// Forward declarations.
-template <>
-FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::ARRAY>(
-    const folly::dynamic& object,
-    exec::GenericWriter& writer);
-
-template <>
-FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::MAP>(
-    const folly::dynamic& object,
-    exec::GenericWriter& writer);
-
-template <>
-FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::ROW>(
-    const folly::dynamic& object,
-    exec::GenericWriter& writer);
-
-template <>
-FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::VARCHAR>(
-    const folly::dynamic& object,
-    exec::GenericWriter& writer) {
-  if (isJsonType(writer.type())) {
-    // Sort keys to match Presto's behavior.
-    folly::json::serialization_opts opts;
-    opts.sort_keys = true;
-    writer.castTo<Varchar>().append(folly::json::serialize(object, opts));
-  } else if (object.isBool()) {
-    writer.castTo<Varchar>().append(object.asBool() ? "true" : "false");
-  } else {
-    writer.castTo<Varchar>().append(object.asString());
-  }
+template <TypeKind kind>
+constexpr bool isFloatingPointKind() {
+  return kind == TypeKind::REAL || kind == TypeKind::DOUBLE;
 }
 
-template <>
-FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::BOOLEAN>(
-    const folly::dynamic& object,
-    exec::GenericWriter& writer) {
-  writer.castTo<bool>() = object.asBool();
+const char* jsonTypeName(simdjson::ondemand::json_type type) {
+  switch (type) {
+    case simdjson::ondemand::json_type::array:
+      return "array";
+    case simdjson::ondemand::json_type::object:
+      return "object";
+    case simdjson::ondemand::json_type::number:
+      return "number";
+    case simdjson::ondemand::json_type::string:
+      return "string";
+    case simdjson::ondemand::json_type::boolean:
+      return "boolean";
+    case simdjson::ondemand::json_type::null:
+      return "null";
+  }
+  return "unknown";
 }
 
-template <typename T>
-FOLLY_ALWAYS_INLINE T castJsonToInt(const folly::dynamic& object) {
-  if (object.isDouble()) {
-    constexpr double kIntMaxAsDouble =
-        static_cast<double>(std::numeric_limits<T>::max());
-    constexpr double kIntMinAsDouble =
-        static_cast<double>(std::numeric_limits<T>::min());
-
-    double value = object.asDouble();
-    if (value <= kIntMaxAsDouble && value >= kIntMinAsDouble) {
-      return static_cast<T>(value);
-    }
+// Forward declaration.
+template <TypeKind kind, typename TValue>
+void castFromJsonTyped(TValue& value, exec::GenericWriter& writer);
 
-    VELOX_USER_FAIL(
-        "value is out of range [{}, {}]: {}",
-        kIntMinAsDouble,
-        kIntMaxAsDouble,
-        value);
+// Casts a JSON string to a primitive type. Map keys are JSON strings too.
+// Strings convert like folly::dynamic::asInt(), asDouble() and asBool().
+template <TypeKind kind>
+void castFromJsonString(std::string_view value, exec::GenericWriter& writer) {
+  using T = typename TypeTraits<kind>::NativeType;
+  if constexpr (kind == TypeKind::VARCHAR) {
+    writer.castTo<Varchar>().append(value);
+  } else if constexpr (kind == TypeKind::BOOLEAN) {
+    writer.castTo<bool>() = folly::to<bool>(folly::StringPiece(value));
+  } else if constexpr (isIntegerKind<kind>()) {
+    writer.castTo<T>() =
+        folly::to<T>(folly::to<int64_t>(folly::StringPiece(value)));
+  } else if constexpr (isFloatingPointKind<kind>()) {
+    writer.castTo<T>() =
+        folly::to<T>(folly::to<double>(folly::StringPiece(value)));
   } else {
-    return folly::to<T>(object.asInt());
+    VELOX_NYI(
+        "Casting from JSON to {} is not supported.", TypeTraits<kind>::name);
   }
 }
 
-template <>
-FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::TINYINT>(
-    const folly::dynamic& object,
-    exec::GenericWriter& writer) {
-  writer.castTo<int8_t>() = castJsonToInt<int8_t>(object);
-}
+template <typename T>
+T castJsonDoubleToInt(double value) {
+  constexpr double kIntMaxAsDouble =
+      static_cast<double>(std::numeric_limits<T>::max());
+  constexpr double kIntMinAsDouble =
+      static_cast<double>(std::numeric_limits<T>::min());
+
+  if (value <= kIntMaxAsDouble && value >= kIntMinAsDouble) {
+    return static_cast<T>(value);
+  }
 
-template <>
-FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::SMALLINT>(
-    const folly::dynamic& object,
-    exec::GenericWriter& writer) {
-  writer.castTo<int16_t>() = castJsonToInt<int16_t>(object);
+  VELOX_USER_FAIL(
+      "value is out of range [{}, {}]: {}",
+      kIntMinAsDouble,
+      kIntMaxAsDouble,
+      value);
 }
 
-template <>
-FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::INTEGER>(
-    const folly::dynamic& object,
-    exec::GenericWriter& writer) {
-  writer.castTo<int32_t>() = castJsonToInt<int32_t>(object);
+// Casts an integer JSON number to a primitive type. 'I' is int64_t or
+// uint64_t.
+template <TypeKind kind, typename I>
+void castFromJsonInteger(I value, exec::GenericWriter& writer) {
+  using T = typename TypeTraits<kind>::NativeType;
+  if constexpr (kind == TypeKind::VARCHAR) {
+    writer.castTo<Varchar>().append(folly::to<std::string>(value));
+  } else if constexpr (kind == TypeKind::BOOLEAN) {
+    writer.castTo<bool>() = value != 0;
+  } else if constexpr (isIntegerKind<kind>()) {
+    writer.castTo<T>() = folly::to<T>(value);
+  } else if constexpr (isFloatingPointKind<kind>()) {
+    writer.castTo<T>() = folly::to<T>(folly::to<double>(value));
+  }
 }
 
-template <>
-FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::BIGINT>(
-    const folly::dynamic& object,
-    exec::GenericWriter& writer) {
-  writer.castTo<int64_t>() = castJsonToInt<int64_t>(object);
+// Casts a JSON number to a primitive type. Integers that fit in neither
+// int64_t nor uint64_t are read as doubles.
+template <TypeKind kind, typename TValue>
+void castFromJsonNumber(TValue& value, exec::GenericWriter& writer) {
+  using T = typename TypeTraits<kind>::NativeType;
+  switch (value.get_number_type().value()) {
+    case simdjson::ondemand::number_type::signed_integer:
+      castFromJsonInteger<kind>(value.get_int64().value(), writer);
+      return;
+    case simdjson::ondemand::number_type::unsigned_integer:
+      castFromJsonInteger<kind>(value.get_uint64().value(), writer);
+      return;
+    default:
+      break;
+  }
+
+  const double doubleValue = value.get_double().value();
+  if constexpr (kind == TypeKind::VARCHAR) {
+    writer.castTo<Varchar>().append(folly::to<std::string>(doubleValue));
+  } else if constexpr (kind == TypeKind::BOOLEAN) {
+    writer.castTo<bool>() = doubleValue != 0;
+  } else if constexpr (isIntegerKind<kind>()) {
+    writer.castTo<T>() = castJsonDoubleToInt<T>(doubleValue);
+  } else if constexpr (isFloatingPointKind<kind>()) {
+    writer.castTo<T>() = folly::to<T>(doubleValue);
+  }
 }
 
-template <>
-FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::REAL>(
-    const folly::dynamic& object,
-    exec::GenericWriter& writer) {
-  writer.castTo<float>() = folly::to<float>(object.asDouble());
+// Casts a JSON boolean to a primitive type.
+template <TypeKind kind>
+void castFromJsonBool(bool value, exec::GenericWriter& writer) {
+  using T = typename TypeTraits<kind>::NativeType;
+  if constexpr (kind == TypeKind::VARCHAR) {
+    writer.castTo<Varchar>().append(value ? "true" : "false");
+  } else if constexpr (kind == TypeKind::BOOLEAN) {
+    writer.castTo<bool>() = value;
+  } else if constexpr (
+      isIntegerKind<kind>() || isFloatingPointKind<kind>()) {
+    writer.castTo<T>() = value ? 1 : 0;
+  }
 }
 
-template <>
-FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::DOUBLE>(
-    const folly::dynamic& object,
-    exec::GenericWriter& writer) {
-  writer.castTo<double>() = folly::to<double>(object.asDouble());
+// Writes the JSON text of 'value' to a JSON writer, e.g. for ARRAY(JSON).
+// Whitespace is removed and the keys of objects are sorted to match Presto's
+// behavior. The text is normalized with folly::parseJson() and
+// folly::json::serialize() as before. Only the values cast to JSON pay for
+// this.
+template <typename TValue>
+void castToJsonText(TValue& value, exec::GenericWriter& writer) {
+  std::string_view json;
+  switch (value.type().value()) {
+    case simdjson::ondemand::json_type::array:
+      json = value.get_array().value().raw_json().value();
+      break;
+    case simdjson::ondemand::json_type::object:
+      json = value.get_object().value().raw_json().value();
+      break;
+    default:
+      json = value.raw_json_token();
+      break;
+  }
+  folly::json::serialization_opts opts;
+  opts.sort_keys = true;
+  writer.castTo<Varchar>().append(
+      folly::json::serialize(folly::parseJson(json), opts));
 }
 
-template <>
-FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::ARRAY>(
-    const folly::dynamic& object,
-    exec::GenericWriter& writer) {
-  auto& writerTyped = writer.castTo<Array<Any>>();
+template <typename TValue>
+void castFromJsonArray(TValue& value, exec::GenericWriter& writer) {
+  const auto type = value.type().value();
+  VELOX_USER_CHECK(
+      type == simdjson::ondemand::json_type::array,
+      "Cannot cast a JSON {} to {}.",
+      jsonTypeName(type),
+      writer.type()->toString());
 
-  for (auto it = object.begin(); it != object.end(); ++it) {
-    // If casting to array of JSON, nulls in array elements should become the
-    // JSON text "null".
-    if (!isJsonType(writer.type()->childAt(0)) && it->isNull()) {
+  auto& writerTyped = writer.castTo<Array<Any>>();
+  const auto& elementType = writer.type()->childAt(0);
+  // If casting to array of JSON, nulls in array elements should become the
+  // JSON text "null".
+  const bool isJsonElement = isJsonType(elementType);
+  for (simdjson::ondemand::value element : value.get_array().value()) {
+    if (!isJsonElement &&
+        element.type().value() == simdjson::ondemand::json_type::null) {
       writerTyped.add_null();
     } else {
       VELOX_DYNAMIC_TYPE_DISPATCH(
           castFromJsonTyped,
-          writer.type()->childAt(0)->kind(),
-          *it,
+          elementType->kind(),
+          element,
           writerTyped.add_item());
     }
   }
 }
 
-template <>
-FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::MAP>(
-    const folly::dynamic& object,
-    exec::GenericWriter& writer) {
-  auto& writerTyped = writer.castTo<Map<Any, Any>>();
+template <typename TValue>
+void castFromJsonMap(TValue& value, exec::GenericWriter& writer) {
+  const auto type = value.type().value();
+  VELOX_USER_CHECK(
+      type == simdjson::ondemand::json_type::object,
+      "Cannot cast a JSON {} to {}.",
+      jsonTypeName(type),
+      writer.type()->toString());
 
-  for (const auto& pair : object.items()) {
-    // If casting to map of JSON values, nulls in map values should become the
-    // JSON text "null".
-    if (!isJsonType(writer.type()->childAt(1)) && pair.second.isNull()) {
+  auto& writerTyped = writer.castTo<Map<Any, Any>>();
+  const auto keyKind = writer.type()->childAt(0)->kind();
+  const auto& valueType = writer.type()->childAt(1);
+  // If casting to map of JSON values, nulls in map values should become the
+  // JSON text "null".
+  const bool isJsonValue = isJsonType(valueType);
+  // The unescaped keys stay valid until the next document is parsed.
+  folly::F14FastSet<std::string_view> keys;
+  for (simdjson::ondemand::field field : value.get_object().value()) {
+    const std::string_view key = field.unescaped_key().value();
+    VELOX_USER_CHECK(
+        keys.insert(key).second, "Duplicate keys ({}) are not allowed.", key);
+    simdjson::ondemand::value& fieldValue = field.value();
+    if (!isJsonValue &&
+        fieldValue.type().value() == simdjson::ondemand::json_type::null) {
       auto& keyWriter = writerTyped.add_null();
       VELOX_DYNAMIC_TYPE_DISPATCH(
-          castFromJsonTyped,
-          writer.type()->childAt(0)->kind(),
-          pair.first,
-          keyWriter);
+          castFromJsonString, keyKind, key, keyWriter);
     } else {
       auto writerPair = writerTyped.add_item();
       VELOX_DYNAMIC_TYPE_DISPATCH(
-          castFromJsonTyped,
-          writer.type()->childAt(0)->kind(),
-          pair.first,
-          std::get<0>(writerPair));
+          castFromJsonString, keyKind, key, std::get<0>(writerPair));
       VELOX_DYNAMIC_TYPE_DISPATCH(
           castFromJsonTyped,
-          writer.type()->childAt(1)->kind(),
-          pair.second,
+          valueType->kind(),
+          fieldValue,
           std::get<1>(writerPair));
     }
   }
 }
 
-template <>
-FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::ROW>(
-    const folly::dynamic& object,
-    exec::GenericWriter& writer) {
+// Returns the index of the child of 'rowType' named 'name'.
+std::optional<column_index_t> findField(
+    const RowType& rowType,
+    std::string_view name) {
+  for (column_index_t i = 0; i < rowType.size(); ++i) {
+    if (rowType.nameOf(i) == name) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+template <typename TValue>
+void castFromJsonRow(TValue& value, exec::GenericWriter& writer) {
+  const auto type = value.type().value();
   VELOX_USER_CHECK(
-      object.isArray() || object.isObject(),
+      type == simdjson::ondemand::json_type::array ||
+          type == simdjson::ondemand::json_type::object,
       "Only casting from JSON array or object to ROW is supported.");
 
   auto& writerTyped = writer.castTo<DynamicRow>();
+  const auto& rowType = writer.type()->asRow();
 
-  if (object.isArray()) {
+  if (type == simdjson::ondemand::json_type::array) {
+    auto array = value.get_array().value();
+    const auto size = array.count_elements().value();
     VELOX_USER_CHECK_EQ(
-        writer.type()->size(),
-        object.size(),
+        rowType.size(),
+        size,
         "Cannot cast a JSON array of size {} to ROW with {} fields.",
-        object.size(),
-        writer.type()->size());
+        size,
+        rowType.size());
 
     column_index_t i = 0;
-    for (auto it = object.begin(); it != object.end(); ++it, ++i) {
-      if (it->isNull()) {
+    for (simdjson::ondemand::value element : array) {
+      if (element.type().value() == simdjson::ondemand::json_type::null) {
         writerTyped.set_null_at(i);
       } else {
         VELOX_DYNAMIC_TYPE_DISPATCH(
             castFromJsonTyped,
-            writer.type()->childAt(i)->kind(),
-            *it,
+            rowType.childAt(i)->kind(),
+            element,
             writerTyped.get_writer_at(i));
       }
+      ++i;
     }
-  } else {
-    auto rowType = writer.type()->asRow();
-    column_index_t fieldCount = rowType.size();
-    auto notFound = object.items().end();
+    return;
+  }
 
-    for (column_index_t i = 0; i < fieldCount; ++i) {
-      auto it = object.find(rowType.nameOf(i));
-      if (it == notFound || it->second.isNull()) {
-        writerTyped.set_null_at(i);
+  // A field that appears more than once takes its last value. The first pass
+  // finds the position of the last value of each field and the second pass
+  // casts these values.
+  auto object = value.get_object().value();
+  folly::small_vector<int32_t, 8> fieldChildren;
+  folly::small_vector<int32_t, 8> childPositions(rowType.size(), -1);
+  for (simdjson::ondemand::field field : object) {
+    const auto child = findField(rowType, field.unescaped_key().value());
+    if (child.has_value()) {
+      childPositions[*child] = fieldChildren.size();
+      fieldChildren.push_back(*child);
+    } else {
+      fieldChildren.push_back(-1);
+    }
+  }
+
+  if (auto error = object.reset().error()) {
+    throw simdjson::simdjson_error(error);
+  }
+  int32_t position = 0;
+  for (simdjson::ondemand::field field : object) {
+    const auto child = fieldChildren[position];
+    if (child >= 0 && childPositions[child] == position) {
+      simdjson::ondemand::value& fieldValue = field.value();
+      if (fieldValue.type().value() == simdjson::ondemand::json_type::null) {
+        writerTyped.set_null_at(child);
       } else {
         VELOX_DYNAMIC_TYPE_DISPATCH(
             castFromJsonTyped,
-            rowType.childAt(i)->kind(),
-            it->second,
-            writerTyped.get_writer_at(i));
+            rowType.childAt(child)->kind(),
+            fieldValue,
+            writerTyped.get_writer_at(child));
       }
     }
+    ++position;
+  }
+
+  for (column_index_t i = 0; i < rowType.size(); ++i) {
+    if (childPositions[i] < 0) {
+      writerTyped.set_null_at(i);
+    }
+  }
+}
+
+// Write 'value' to writer at the current offset.
+template <TypeKind kind, typename TValue>
+void castFromJsonTyped(TValue& value, exec::GenericWriter& writer) {
+  if constexpr (kind == TypeKind::ARRAY) {
+    castFromJsonArray(value, writer);
+  } else if constexpr (kind == TypeKind::MAP) {
+    castFromJsonMap(value, writer);
+  } else if constexpr (kind == TypeKind::ROW) {
+    castFromJsonRow(value, writer);
+  } else if constexpr (
+      kind == TypeKind::VARCHAR || kind == TypeKind::BOOLEAN ||
+      isIntegerKind<kind>() || isFloatingPointKind<kind>()) {
+    if constexpr (kind == TypeKind::VARCHAR) {
+      if (isJsonType(writer.type())) {
+        castToJsonText(value, writer);
+        return;
+      }
+    }
+    const auto type = value.type().value();
+    switch (type) {
+      case simdjson::ondemand::json_type::string:
+        castFromJsonString<kind>(value.get_string().value(), writer);
+        break;
+      case simdjson::ondemand::json_type::number:
+        castFromJsonNumber<kind>(value, writer);
+        break;
+      case simdjson::ondemand::json_type::boolean:
+        castFromJsonBool<kind>(value.get_bool().value(), writer);
+        break;
+      default:
+        VELOX_USER_FAIL(
+            "Cannot cast a JSON {} to {}.",
+            jsonTypeName(type),
+            writer.type()->toString());
+    }
+  } else {
+    VELOX_NYI(
+        "Casting from JSON to {} is not supported.", TypeTraits<kind>::name);
   }
 }
 
+// Casts the JSON text 'json' to 'writer'. Returns false if 'json' is the JSON
+// null.
+template <TypeKind kind>
+bool castFromJsonDocument(std::string_view json, exec::GenericWriter& writer) {
+  simdjson::ondemand::document document = functions::simdjsonParse(json);
+  const auto type = document.type().value();
+  if (type == simdjson::ondemand::json_type::null) {
+    if (!document.is_null().value()) {
+      throw simdjson::simdjson_error(simdjson::N_ATOM_ERROR);
+    }
+    return false;
+  }
+
+  castFromJsonTyped<kind>(document, writer);
+  // Reading a scalar top-level value checks that nothing follows it.
+  if ((type == simdjson::ondemand::json_type::array ||
+       type == simdjson::ondemand::json_type::object) &&
+      !document.at_end()) {
+    throw simdjson::simdjson_error(simdjson::TRAILING_CONTENT);
+  }
+  return true;
+}
+
 template <TypeKind kind>
 void castFromJson(
     const BaseVector& input,
@@ -699,46 +871,43 @@ void castFromJson(
   // input is guaranteed to be in flat or constant encodings when passed in.
   auto* inputVector = input.as<SimpleVector<StringView>>();
 
-  folly::dynamic object;
   context.applyToSelectedNoThrow(rows, [&](auto row) {
     writer.setOffset(row);
 
     if (inputVector->isNullAt(row)) {
       writer.commitNull();
-    } else {
-      try {
-        object = folly::parseJson(inputVector->valueAt(row));
-      } catch (const std::exception& e) {
-        writer.commitNull();
-        VELOX_USER_FAIL("Not a JSON input: {}", inputVector->valueAt(row));
-      }
+      return;
+    }
 
-      if (object.isNull()) {
+    const auto json = inputVector->valueAt(row);
+    try {
+      if (!castFromJsonDocument<kind>(
+              std::string_view(json), writer.current())) {
         writer.commitNull();
-      } else {
-        try {
-          castFromJsonTyped<kind>(object, writer.current());
-        } catch (const VeloxException& ve) {
-          if (!ve.isUserError()) {
-            throw;
-          }
-          writer.commitNull();
-          VELOX_USER_FAIL(
-              "Cannot cast from Json value {} to {}: {}",
-              inputVector->valueAt(row),
-              result.type()->toString(),
-              ve.message());
-        } catch (const std::exception& e) {
-          writer.commitNull();
-          VELOX_USER_FAIL(
-              "Cannot cast from Json value {} to {}: {}",
-              inputVector->valueAt(row),
-              result.type()->toString(),
-              e.what());
-        }
-        writer.commit(true);
+        return;
+      }
+    } catch (const simdjson::simdjson_error&) {
+      writer.commitNull();
+      VELOX_USER_FAIL("Not a JSON input: {}", json);
+    } catch (const VeloxException& ve) {
+      if (!ve.isUserError()) {
+        throw;
       }
+      writer.commitNull();
+      VELOX_USER_FAIL(
+          "Cannot cast from Json value {} to {}: {}",
+          json,
+          result.type()->toString(),
+          ve.message());
+    } catch (const std::exception& e) {
+      writer.commitNull();
+      VELOX_USER_FAIL(
+          "Cannot cast from Json value {} to {}: {}",
+          json,
+          result.type()->toString(),
+          e.what());
     }
+    writer.commit(true);
   });
   writer.finish();
 }
@@ -18,6 +18,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/external/date/tz.h"
 #include "velox/type/tz/TimeZoneMap.h"
+#include "velox/type/tz/TimeZoneTransitions.h"
 
 namespace facebook::velox {
 namespace {
@@ -45,6 +46,10 @@ Timestamp Timestamp::now() {
 }
 
 void Timestamp::toGMT(const date::time_zone& zone) {
+  if (auto seconds = util::TimeZoneTransitions::get(zone).toGMT(seconds_)) {
+    seconds_ = *seconds;
+    return;
+  }
   // Magic number -2^39 + 24*3600. This number and any number lower than that
   // will cause time_zone::to_sys() to SIGABRT. We don't want that to happen.
   if (seconds_ <= (-1096193779200l + 86400l)) {
@@ -65,6 +70,11 @@ void Timestamp::toGMT(int16_t tzID) {
     seconds_ -= getPrestoTZOffsetInSeconds(tzID);
   } else {
     // Other ids go this path.
+    const auto& transitions = util::TimeZoneTransitions::get(tzID);
+    if (auto seconds = transitions.toGMT(seconds_)) {
+      seconds_ = *seconds;
+      return;
+    }
     toGMT(*date::locate_zone(util::getTimeZoneName(tzID)));
   }
 }
@@ -101,6 +111,10 @@ Timestamp::toTimePoint() const {
 }
 
 void Timestamp::toTimezone(const date::time_zone& zone) {
+  if (auto seconds = util::TimeZoneTransitions::get(zone).toLocal(seconds_)) {
+    seconds_ = *seconds;
+    return;
+  }
   auto tp = toTimePoint();
   auto epoch = zone.to_local(tp).time_since_epoch();
   // NOTE: Round down to get the seconds of the current time point.
@@ -114,6 +128,11 @@ void Timestamp::toTimezone(int16_t tzID) {
     seconds_ += getPrestoTZOffsetInSeconds(tzID);
   } else {
     // Other ids go this path.
+    const auto& transitions = util::TimeZoneTransitions::get(tzID);
+    if (auto seconds = transitions.toLocal(seconds_)) {
+      seconds_ = *seconds;
+      return;
+    }
     toTimezone(*date::locate_zone(util::getTimeZoneName(tzID)));
   }
 }
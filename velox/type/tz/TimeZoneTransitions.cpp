@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/type/tz/TimeZoneTransitions.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/external/date/tz.h"
+#include "velox/type/tz/TimeZoneMap.h"
+
+namespace facebook::velox::util {
+
+// static
+const TimeZoneTransitions& TimeZoneTransitions::get(
+    const date::time_zone& zone) {
+  // Most batches convert many values with the same time zone.
+  thread_local const date::time_zone* lastZone = nullptr;
+  thread_local const TimeZoneTransitions* lastTransitions = nullptr;
+  if (lastZone == &zone) {
+    return *lastTransitions;
+  }
+  static folly::Synchronized<folly::F14FastMap<
+      const date::time_zone*,
+      std::unique_ptr<TimeZoneTransitions>>>
+      transitionsByZone;
+  const TimeZoneTransitions* transitions = nullptr;
+  {
+    auto rlock = transitionsByZone.rlock();
+    auto it = rlock->find(&zone);
+    if (it != rlock->end()) {
+      transitions = it->second.get();
+    }
+  }
+  if (transitions == nullptr) {
+    auto wlock = transitionsByZone.wlock();
+    auto& entry = (*wlock)[&zone];
+    if (entry == nullptr) {
+      entry = std::make_unique<TimeZoneTransitions>(zone);
+    }
+    transitions = entry.get();
+  }
+  lastZone = &zone;
+  lastTransitions = transitions;
+  return *transitions;
+}
+
+// static
+const TimeZoneTransitions& TimeZoneTransitions::get(int16_t tzID) {
+  thread_local int16_t lastID = 0;
+  thread_local const TimeZoneTransitions* lastTransitions = nullptr;
+  if (lastTransitions != nullptr && lastID == tzID) {
+    return *lastTransitions;
+  }
+  // Saves looking up the time zone by name when the ID changes between rows.
+  static folly::Synchronized<
+      folly::F14FastMap<int16_t, const TimeZoneTransitions*>>
+      transitionsByID;
+  const TimeZoneTransitions* transitions = nullptr;
+  {
+    auto rlock = transitionsByID.rlock();
+    auto it = rlock->find(tzID);
+    if (it != rlock->end()) {
+      transitions = it->second;
+    }
+  }
+  if (transitions == nullptr) {
+    transitions = &get(*date::locate_zone(getTimeZoneName(tzID)));
+    transitionsByID.wlock()->emplace(tzID, transitions);
+  }
+  lastID = tzID;
+  lastTransitions = transitions;
+  return *transitions;
+}
+
+TimeZoneTransitions::TimeZoneTransitions(const date::time_zone& zone) {
+  using std::chrono::seconds;
+  auto info = zone.get_info(date::sys_seconds(seconds(kMinSeconds)));
+  offsets_.push_back(info.offset.count());
+  while (info.end < date::sys_seconds(seconds(kMaxSeconds))) {
+    const auto transition = info.end.time_since_epoch().count();
+    info = zone.get_info(info.end);
+    // Changes of the abbreviation or the daylight saving part alone keep the
+    // offset.
+    if (info.offset.count() != offsets_.back()) {
+      transitions_.push_back(transition);
+      offsets_.push_back(info.offset.count());
+    }
+  }
+  localStarts_.reserve(transitions_.size());
+  for (auto i = 0; i < transitions_.size(); ++i) {
+    localStarts_.push_back(transitions_[i] + offsets_[i + 1]);
+  }
+}
+
+// static
+size_t TimeZoneTransitions::upperBound(
+    const std::vector<int64_t>& values,
+    int64_t value) {
+  return std::upper_bound(values.begin(), values.end(), value) -
+      values.begin();
+}
+
+} // namespace facebook::velox::util
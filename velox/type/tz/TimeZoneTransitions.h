@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace date {
+class time_zone;
+}
+
+namespace facebook::velox::util {
+
+/// The UTC offsets of a time zone and the moments they change, read once from
+/// the time zone database. Converting a timestamp with the time zone database
+/// looks up the time zone rules for every value, while this is a binary search
+/// in a few hundred transitions. Covers the years [1900, 2100), which is where
+/// the tz database has rules worth looking up. The conversions return
+/// std::nullopt outside of that range and the caller falls back to the time
+/// zone database. The tables live until the process exits.
+class TimeZoneTransitions {
+ public:
+  /// Seconds since epoch of 1900-01-01 and 2100-01-01 00:00:00 UTC.
+  static constexpr int64_t kMinSeconds = -2'208'988'800;
+  static constexpr int64_t kMaxSeconds = 4'102'444'800;
+
+  /// Returns the transitions of 'zone', building them on first use.
+  static const TimeZoneTransitions& get(const date::time_zone& zone);
+
+  /// Same as above, but accepts a PrestoDB time zone ID of a named time zone,
+  /// e.g. not a fixed offset.
+  static const TimeZoneTransitions& get(int16_t tzID);
+
+  explicit TimeZoneTransitions(const date::time_zone& zone);
+
+  /// Returns the local time in seconds at the moment 'gmtSeconds'. Same as
+  /// date::time_zone::to_local().
+  std::optional<int64_t> toLocal(int64_t gmtSeconds) const {
+    if (gmtSeconds < kMinSeconds || gmtSeconds >= kMaxSeconds) {
+      return std::nullopt;
+    }
+    return gmtSeconds + offsets_[periodOf(gmtSeconds)];
+  }
+
+  /// Returns the GMT seconds for the local time 'localSeconds'. Same as
+  /// date::time_zone::to_sys() with date::choose::latest: a local time that
+  /// is skipped by a transition maps to the moment of the transition and a
+  /// local time that repeats maps to the later moment.
+  std::optional<int64_t> toGMT(int64_t localSeconds) const {
+    if (localSeconds < kMinSeconds + kMaxOffset ||
+        localSeconds >= kMaxSeconds - kMaxOffset) {
+      return std::nullopt;
+    }
+    // The first period that starts after 'localSeconds' in local time.
+    const auto period = upperBound(localStarts_, localSeconds);
+    if (period < transitions_.size() &&
+        localSeconds >= transitions_[period] + offsets_[period]) {
+      // In the gap before the start of 'period'.
+      return transitions_[period];
+    }
+    return localSeconds - offsets_[period];
+  }
+
+  /// Returns the number of offset changes in [kMinSeconds, kMaxSeconds).
+  size_t numTransitions() const {
+    return transitions_.size();
+  }
+
+ private:
+  // Larger than the UTC offset of any time zone.
+  static constexpr int64_t kMaxOffset = 2 * 24 * 60 * 60;
+
+  static size_t upperBound(const std::vector<int64_t>& values, int64_t value);
+
+  size_t periodOf(int64_t gmtSeconds) const {
+    return upperBound(transitions_, gmtSeconds);
+  }
+
+  // The GMT seconds at which the offset changes, ascending.
+  std::vector<int64_t> transitions_;
+
+  // The offset in seconds before each transition and after the last one.
+  std::vector<int64_t> offsets_;
+
+  // The local time in seconds at which each period after a transition
+  // starts, e.g. transitions_[i] + offsets_[i + 1].
+  std::vector<int64_t> localStarts_;
+};
+
+} // namespace facebook::velox::util
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/external/date/tz.h"
+#include "velox/type/tz/TimeZoneMap.h"
+#include "velox/type/tz/TimeZoneTransitions.h"
+
+namespace facebook::velox::util {
+namespace {
+
+using std::chrono::seconds;
+
+int64_t expectedLocal(const date::time_zone& zone, int64_t gmtSeconds) {
+  return zone.to_local(date::sys_seconds(seconds(gmtSeconds)))
+      .time_since_epoch()
+      .count();
+}
+
+int64_t expectedGMT(const date::time_zone& zone, int64_t localSeconds) {
+  return zone
+      .to_sys(
+          date::local_seconds(seconds(localSeconds)), date::choose::latest)
+      .time_since_epoch()
+      .count();
+}
+
+TEST(TimeZoneTransitionsTest, losAngeles) {
+  const auto* zone = date::locate_zone("America/Los_Angeles");
+  const auto& transitions = TimeZoneTransitions::get(*zone);
+  EXPECT_EQ(&transitions, &TimeZoneTransitions::get(*zone));
+  EXPECT_EQ(&transitions, &TimeZoneTransitions::get(1825));
+
+  // 2023-03-12 02:00:00 local does not exist, 2:30 maps to the transition at
+  // 10:00:00 GMT.
+  EXPECT_EQ(1678615200, transitions.toGMT(1678588200));
+  EXPECT_EQ(1678584600, transitions.toLocal(1678613400));
+  // 2023-11-05 01:30:00 local repeats, the later moment is 09:30:00 GMT.
+  EXPECT_EQ(1699176600, transitions.toGMT(1699147800));
+  EXPECT_EQ(1699147800, transitions.toLocal(1699176600));
+  EXPECT_EQ(1699147800, transitions.toLocal(1699173000));
+
+  // Outside of the table.
+  EXPECT_EQ(
+      std::nullopt, transitions.toLocal(TimeZoneTransitions::kMaxSeconds));
+  EXPECT_EQ(std::nullopt, transitions.toGMT(TimeZoneTransitions::kMaxSeconds));
+  EXPECT_EQ(
+      std::nullopt, transitions.toLocal(TimeZoneTransitions::kMinSeconds - 1));
+  EXPECT_EQ(std::nullopt, transitions.toGMT(TimeZoneTransitions::kMinSeconds));
+}
+
+TEST(TimeZoneTransitionsTest, matchesTimeZoneDatabase) {
+  for (const auto* name :
+       {"America/Los_Angeles",
+        "America/Sao_Paulo",
+        "Europe/London",
+        "Europe/Moscow",
+        "Asia/Kolkata",
+        "Asia/Kathmandu",
+        "Australia/Lord_Howe",
+        "Pacific/Apia",
+        "Pacific/Kiritimati",
+        "Africa/Casablanca",
+        "UTC"}) {
+    SCOPED_TRACE(name);
+    const auto* zone = date::locate_zone(name);
+    const auto& transitions = TimeZoneTransitions::get(*zone);
+
+    // Around every change of the offset and in between.
+    std::vector<int64_t> times;
+    auto info = zone->get_info(date::sys_seconds(
+        seconds(TimeZoneTransitions::kMinSeconds + 3 * 86'400)));
+    while (info.end < date::sys_seconds(seconds(
+                          TimeZoneTransitions::kMaxSeconds - 3 * 86'400))) {
+      const auto transition = info.end.time_since_epoch().count();
+      for (auto delta = -2 * 86'400; delta <= 2 * 86'400; delta += 599) {
+        times.push_back(transition + delta);
+      }
+      times.push_back(transition - 1);
+      times.push_back(transition);
+      times.push_back(transition + 1);
+      info = zone->get_info(info.end);
+    }
+    for (auto i = TimeZoneTransitions::kMinSeconds + 3 * 86'400;
+         i < TimeZoneTransitions::kMaxSeconds - 3 * 86'400;
+         i += 86'400 * 7 + 3'607) {
+      times.push_back(i);
+    }
+
+    for (auto time : times) {
+      ASSERT_EQ(expectedLocal(*zone, time), transitions.toLocal(time))
+          << time;
+      ASSERT_EQ(expectedGMT(*zone, time), transitions.toGMT(time)) << time;
+    }
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::util